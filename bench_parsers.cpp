@@ -0,0 +1,176 @@
+// Parser Throughput Benchmark - Claude Generated 2026
+// Generates synthetic XYZ/VTF/PDB/MOL2 files and reports parse throughput (MB/s)
+// of the TextScanner-based parsers. A QTextStream + regex split pass over the
+// same XYZ file is timed as a reference for the pre-TextScanner code path.
+//
+// Usage: bench_parsers [atoms=2000] [frames=200] [repeats=3]
+
+#include "mol2parser.h"
+#include "pdbparser.h"
+#include "vtfparser.h"
+#include "xyzparser.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <limits>
+
+namespace {
+const char* const kElements[] = { "C", "H", "N", "O", "S" };
+
+float coord(QRandomGenerator& rng, double extent)
+{
+    return float(rng.generateDouble() * extent);
+}
+
+void writeXyz(const QString& path, int atoms, int frames)
+{
+    QFile f(path);
+    f.open(QIODevice::WriteOnly);
+    QTextStream out(&f);
+    QRandomGenerator rng(42);
+    for (int fr = 0; fr < frames; ++fr) {
+        out << atoms << "\nframe " << fr << "\n";
+        for (int i = 0; i < atoms; ++i)
+            out << kElements[i % 5] << QString::asprintf(" %12.6f %12.6f %12.6f\n",
+                coord(rng, 40), coord(rng, 40), coord(rng, 40));
+    }
+}
+
+void writeVtf(const QString& path, int atoms, int frames)
+{
+    QFile f(path);
+    f.open(QIODevice::WriteOnly);
+    QTextStream out(&f);
+    QRandomGenerator rng(42);
+    for (int i = 0; i < atoms; ++i)
+        out << "atom " << i << " radius 0.20000E+01 type ppo1 name " << i << "\n";
+    for (int i = 1; i < atoms; ++i)
+        out << "bond " << (i - 1) << ":" << i << "\n";
+    out << "unitcell 40.0 40.0 40.0\n";
+    for (int fr = 0; fr < frames; ++fr) {
+        out << "# Start of image " << fr << "\ntimestep ordered\n";
+        for (int i = 0; i < atoms; ++i)
+            out << QString::asprintf("%.5E %.5E %.5E\n", coord(rng, 40), coord(rng, 40), coord(rng, 40));
+        out << "# End Image\n";
+    }
+}
+
+void writePdb(const QString& path, int atoms, int frames)
+{
+    QFile f(path);
+    f.open(QIODevice::WriteOnly);
+    QTextStream out(&f);
+    QRandomGenerator rng(42);
+    // CONECT records make the bond list explicit, so the benchmark measures
+    // parsing rather than distance-based bond perception.
+    for (int fr = 0; fr < frames; ++fr) {
+        out << QString::asprintf("MODEL     %4d\n", fr + 1);
+        for (int i = 0; i < atoms; ++i)
+            out << QString::asprintf("ATOM  %5d  CA  ALA A%4d    %8.3f%8.3f%8.3f  1.00  0.00           %s\n",
+                (i % 99999) + 1, (i / 10) % 9999 + 1, coord(rng, 40), coord(rng, 40), coord(rng, 40),
+                kElements[i % 5]);
+        out << "ENDMDL\n";
+    }
+    for (int i = 1; i < qMin(atoms, 99999); ++i)
+        out << QString::asprintf("CONECT%5d%5d\n", i, i + 1);
+    out << "END\n";
+}
+
+void writeMol2(const QString& path, int atoms)
+{
+    QFile f(path);
+    f.open(QIODevice::WriteOnly);
+    QTextStream out(&f);
+    QRandomGenerator rng(42);
+    out << "@<TRIPOS>MOLECULE\nbench\n" << atoms << " " << (atoms - 1) << " 0 0 0\nSMALL\nNO_CHARGES\n\n";
+    out << "@<TRIPOS>ATOM\n";
+    for (int i = 0; i < atoms; ++i)
+        out << QString::asprintf("%7d %s%-4d %10.4f %10.4f %10.4f %s.3 1 RES 0.0000\n",
+            i + 1, kElements[i % 5], i + 1, coord(rng, 40), coord(rng, 40), coord(rng, 40), kElements[i % 5]);
+    out << "@<TRIPOS>BOND\n";
+    for (int i = 1; i < atoms; ++i)
+        out << QString::asprintf("%6d %5d %5d 1\n", i, i, i + 1);
+}
+
+// Legacy reference: the QTextStream + QRegularExpression loop XYZParser used before.
+int parseXyzQTextStream(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return 0;
+    QTextStream stream(&file);
+    int atoms = 0;
+    while (!stream.atEnd()) {
+        bool ok = false;
+        const int n = stream.readLine().trimmed().toInt(&ok);
+        if (!ok || n <= 0)
+            continue;
+        stream.readLine();
+        for (int i = 0; i < n && !stream.atEnd(); ++i) {
+            const QStringList parts = stream.readLine().trimmed().split(QRegularExpression("\\s+"));
+            if (parts.size() >= 4 && parts[1].toFloat() + parts[2].toFloat() + parts[3].toFloat() != -1.0f)
+                ++atoms;
+        }
+    }
+    return atoms;
+}
+
+void report(const char* label, const QString& path, int repeats, const std::function<bool()>& parse)
+{
+    const double mb = QFileInfo(path).size() / (1024.0 * 1024.0);
+    qint64 best = std::numeric_limits<qint64>::max();
+    bool ok = true;
+    for (int r = 0; r < repeats; ++r) {
+        QElapsedTimer timer;
+        timer.start();
+        ok = parse() && ok;
+        best = std::min(best, timer.nsecsElapsed());
+    }
+    const double seconds = best / 1e9;
+    std::printf("%-22s %9.2f MB  %9.2f ms  %9.1f MB/s%s\n", label, mb, seconds * 1e3,
+        seconds > 0 ? mb / seconds : 0.0, ok ? "" : "  (PARSE FAILED)");
+}
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    const int atoms = args.size() > 1 ? args[1].toInt() : 2000;
+    const int frames = args.size() > 2 ? args[2].toInt() : 200;
+    const int repeats = qMax(1, args.size() > 3 ? args[3].toInt() : 3);
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::fprintf(stderr, "Cannot create temporary directory\n");
+        return 1;
+    }
+    const QString xyz = dir.filePath("bench.xyz");
+    const QString vtf = dir.filePath("bench.vtf");
+    const QString pdb = dir.filePath("bench.pdb");
+    const QString mol2 = dir.filePath("bench.mol2");
+    std::printf("Generating %d atoms x %d frames ...\n", atoms, frames);
+    writeXyz(xyz, atoms, frames);
+    writeVtf(vtf, atoms, frames);
+    writePdb(pdb, atoms, frames);
+    // MOL2 is single-structure; scale the atom count so the file is comparable in size.
+    writeMol2(mol2, atoms * qMax(1, frames / 4));
+
+    std::printf("%-22s %12s  %12s  %14s (best of %d)\n", "format", "size", "time", "throughput", repeats);
+    report("xyz (QTextStream ref)", xyz, repeats, [&] { return parseXyzQTextStream(xyz) > 0; });
+    report("xyz", xyz, repeats, [&] { XYZParser p; return p.parseTrajectory(xyz); });
+    report("vtf", vtf, repeats, [&] { VTFParser p; return p.parseTrajectory(vtf); });
+    report("pdb", pdb, repeats, [&] { PDBParser p; return p.parseTrajectory(pdb); });
+    report("mol2", mol2, repeats, [&] { MOL2Parser p; MOL2Parser::MOL2Molecule m; return p.parseFile(mol2, m); });
+    return 0;
+}
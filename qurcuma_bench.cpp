@@ -0,0 +1,529 @@
+// Qurcuma Benchmark Suite - Claude Generated 2026
+// Reproducible timings of the hot paths on synthetic systems, written as JSON so results
+// can be compared between releases:
+//
+//   parse.xyz / parse.vtf / parse.pdb / parse.mol2   single-structure files (MB/s)
+//   bonds.detect, bonds.hysteresis                   covalent-radius bond perception
+//   scene.setStructure, scene.updatePositions        SceneController rebuild / per-frame patch
+//   instancing.atoms                                 AtomInstancing::setItems (table rebuild)
+//   force.distribute                                 forceinjector adjacency + shell BFS
+//   md.step                                          SimulationWorker batch-mode steps/s
+//
+// Systems: "carbon" (simple cubic C grid, 1.54 A - the spikes/ stress test), "water"
+// (box of randomly oriented H2O, 3.1 A apart), "protein" (poly-alanine backbone folded into
+// rows). Every generator is seeded, so a given size always yields the same coordinates.
+// Runs offscreen; no window, no RHI.
+//
+// Usage: qurcuma_bench [--sizes 1000,10000,100000,1000000] [--systems carbon,water,protein]
+//                      [--benchmarks parse,bonds,scene,instancing,force,md] [--repeats 5]
+//                      [--md-steps 200] [--md-max-atoms 10000] [--method uff] [--output f.json]
+
+#include "atominstancing.h"
+#include "bondperception.h"
+#include "elementdata.h"
+#include "forceinjector.h"
+#include "mol2parser.h"
+#include "pdbparser.h"
+#include "scenecontroller.h"
+#include "simulationworker.h"
+#include "vtfparser.h"
+#include "xyzparser.h"
+
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+// curcuma's ParameterRegistry must be populated before any method is constructed
+// (see src/main.cpp).
+#include "generated/parameter_registry.h"
+
+namespace {
+using Atoms = QVector<MoleculeViewer::Atom>;
+using Bonds = QVector<MoleculeViewer::Bond>;
+
+constexpr quint32 kSeed = 20260101;
+
+void addAtom(Atoms& atoms, const char* element, const QVector3D& position)
+{
+    MoleculeViewer::Atom a;
+    a.position = position;
+    a.element = QString::fromLatin1(element);
+    a.atomicNumber = quint8(elem::atomicNumber(a.element));
+    atoms.append(a);
+}
+
+// Simple cubic carbon grid, 1.54 A spacing (6 bonds per inner atom).
+Atoms carbonGrid(int count)
+{
+    const int side = int(std::ceil(std::cbrt(double(count))));
+    Atoms atoms;
+    atoms.reserve(count);
+    for (int i = 0; i < count; ++i)
+        addAtom(atoms, "C", 1.54f * QVector3D(i % side, (i / side) % side, i / (side * side)));
+    return atoms;
+}
+
+// Water box: O on a 3.1 A grid, H-O-H 0.9572 A / 104.52 deg in a random orientation.
+Atoms waterBox(int count)
+{
+    const int molecules = std::max(1, count / 3);
+    const int side = int(std::ceil(std::cbrt(double(molecules))));
+    const float angle = qDegreesToRadians(104.52f);
+    QRandomGenerator rng(kSeed);
+    auto randomUnit = [&rng]() {
+        QVector3D v;
+        do {
+            v = QVector3D(float(rng.generateDouble()) * 2 - 1, float(rng.generateDouble()) * 2 - 1,
+                float(rng.generateDouble()) * 2 - 1);
+        } while (v.lengthSquared() < 1e-3f || v.lengthSquared() > 1.0f);
+        return v.normalized();
+    };
+    Atoms atoms;
+    atoms.reserve(3 * molecules);
+    for (int m = 0; m < molecules; ++m) {
+        const QVector3D o = 3.1f * QVector3D(m % side, (m / side) % side, m / (side * side));
+        const QVector3D u = randomUnit();
+        const QVector3D v = QVector3D::crossProduct(u, randomUnit()).normalized();
+        addAtom(atoms, "O", o);
+        addAtom(atoms, "H", o + 0.9572f * u);
+        addAtom(atoms, "H", o + 0.9572f * (std::cos(angle) * u + std::sin(angle) * v));
+    }
+    return atoms;
+}
+
+// Poly-alanine: 10 atoms per residue (N H CA HA CB 3xHB C O), CA every 3.8 A along rows
+// that turn back and forth; rows 6 A apart, layers 6 A apart.
+Atoms protein(int count)
+{
+    const int residues = std::max(1, count / 10);
+    const int perRow = std::max(4, int(std::ceil(std::cbrt(double(residues)))));
+    const int rowsPerLayer = perRow;
+    const QVector3D z(0, 0, 1);
+    Atoms atoms;
+    atoms.reserve(10 * residues);
+    for (int r = 0; r < residues; ++r) {
+        const int row = r / perRow, col = r % perRow;
+        const float dir = (row % 2) ? -1.0f : 1.0f;
+        const QVector3D t(dir, 0, 0);
+        const QVector3D d(0, (r % 2) ? -1.0f : 1.0f, 0);  // zig-zag side
+        const float x = (row % 2) ? (perRow - 1 - col) * 3.8f : col * 3.8f;
+        const QVector3D ca(x, 6.0f * (row % rowsPerLayer) + 3.0f, 6.0f * (row / rowsPerLayer) + 3.0f);
+        const QVector3D n = ca - 1.27f * t + 0.45f * d;
+        const QVector3D c = ca + 1.27f * t + 0.45f * d;
+        const QVector3D cb = ca - 1.53f * d;
+        addAtom(atoms, "N", n);
+        addAtom(atoms, "H", n + 1.01f * d);
+        addAtom(atoms, "C", ca);
+        addAtom(atoms, "H", ca + 1.09f * z);
+        addAtom(atoms, "C", cb);
+        addAtom(atoms, "H", cb - 1.09f * d);
+        addAtom(atoms, "H", cb + 1.09f * z);
+        addAtom(atoms, "H", cb - 1.09f * z);
+        addAtom(atoms, "C", c);
+        addAtom(atoms, "O", c + 1.23f * d);
+    }
+    return atoms;
+}
+
+Atoms generate(const QString& system, int count)
+{
+    if (system == QLatin1String("water"))
+        return waterBox(count);
+    if (system == QLatin1String("protein"))
+        return protein(count);
+    return carbonGrid(count);
+}
+
+// Every coordinate displaced by up to +-0.05 A (one "MD frame" later).
+QVector<QVector3D> jitter(const Atoms& atoms)
+{
+    QRandomGenerator rng(kSeed + 1);
+    QVector<QVector3D> positions(atoms.size());
+    for (int i = 0; i < atoms.size(); ++i)
+        positions[i] = atoms[i].position
+            + 0.05f * QVector3D(float(rng.generateDouble()) * 2 - 1, float(rng.generateDouble()) * 2 - 1,
+                float(rng.generateDouble()) * 2 - 1);
+    return positions;
+}
+
+// --- file writers (buffered; the generated files reach several hundred MB at 10^6 atoms) ---
+
+class LineWriter
+{
+public:
+    explicit LineWriter(const QString& path)
+        : m_file(path)
+    {
+        m_ok = m_file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        m_buffer.reserve(kFlush + 256);
+    }
+    ~LineWriter()
+    {
+        if (m_ok)
+            m_file.write(m_buffer);
+    }
+    template <typename... Args>
+    void line(const char* format, Args... args)
+    {
+        char text[160];
+        const int n = std::snprintf(text, sizeof(text), format, args...);
+        m_buffer.append(text, std::min<int>(n, int(sizeof(text)) - 1));
+        if (m_buffer.size() > kFlush) {
+            m_file.write(m_buffer);
+            m_buffer.clear();
+        }
+    }
+    bool ok() const { return m_ok; }
+
+private:
+    static constexpr int kFlush = 1 << 20;
+    QFile m_file;
+    QByteArray m_buffer;
+    bool m_ok = false;
+};
+
+const char* symbol(const MoleculeViewer::Atom& a)
+{
+    return a.atomicNumber == 1 ? "H" : a.atomicNumber == 7 ? "N" : a.atomicNumber == 8 ? "O" : "C";
+}
+
+void writeXyz(const QString& path, const Atoms& atoms)
+{
+    LineWriter out(path);
+    out.line("%d\nqurcuma_bench\n", int(atoms.size()));
+    for (const auto& a : atoms)
+        out.line("%s %12.6f %12.6f %12.6f\n", symbol(a), a.position.x(), a.position.y(), a.position.z());
+}
+
+void writeVtf(const QString& path, const Atoms& atoms, const Bonds& bonds)
+{
+    LineWriter out(path);
+    for (int i = 0; i < atoms.size(); ++i)
+        out.line("atom %d radius 1.0 type %s name %s\n", i, symbol(atoms[i]), symbol(atoms[i]));
+    for (const auto& b : bonds)
+        out.line("bond %d:%d\n", b.atom1, b.atom2);
+    out.line("# Start of image 0\ntimestep ordered\n");
+    for (const auto& a : atoms)
+        out.line("%.5E %.5E %.5E\n", a.position.x(), a.position.y(), a.position.z());
+    out.line("# End Image\n");
+}
+
+// No CONECT records: single-model PDB files go through the parser's own bond perception,
+// as real structures without CONECT do.
+void writePdb(const QString& path, const Atoms& atoms)
+{
+    LineWriter out(path);
+    for (int i = 0; i < atoms.size(); ++i) {
+        const auto& a = atoms[i];
+        out.line("ATOM  %5d  %-3s ALA A%4d    %8.3f%8.3f%8.3f  1.00  0.00          %2s\n",
+            (i % 99999) + 1, symbol(a), (i / 10) % 9999 + 1, a.position.x(), a.position.y(),
+            a.position.z(), symbol(a));
+    }
+    out.line("END\n");
+}
+
+void writeMol2(const QString& path, const Atoms& atoms, const Bonds& bonds)
+{
+    LineWriter out(path);
+    out.line("@<TRIPOS>MOLECULE\nqurcuma_bench\n%d %d 0 0 0\nSMALL\nNO_CHARGES\n\n@<TRIPOS>ATOM\n",
+        int(atoms.size()), int(bonds.size()));
+    for (int i = 0; i < atoms.size(); ++i) {
+        const auto& a = atoms[i];
+        out.line("%7d %-4s %10.4f %10.4f %10.4f %s.3 1 RES 0.0000\n", i + 1, symbol(a),
+            a.position.x(), a.position.y(), a.position.z(), symbol(a));
+    }
+    out.line("@<TRIPOS>BOND\n");
+    for (int i = 0; i < bonds.size(); ++i)
+        out.line("%6d %5d %5d 1\n", i + 1, bonds[i].atom1 + 1, bonds[i].atom2 + 1);
+}
+
+// --- timing / reporting ---
+
+struct Context {
+    QString system;
+    int atoms = 0;
+    int bonds = 0;
+    int repeats = 5;
+};
+
+QJsonArray g_results;
+
+QJsonObject summary(QVector<double> ms)
+{
+    std::sort(ms.begin(), ms.end());
+    double sum = 0.0;
+    for (double v : ms)
+        sum += v;
+    const int n = ms.size();
+    return QJsonObject{ { "min_ms", ms.front() }, { "max_ms", ms.back() },
+        { "mean_ms", sum / n },
+        { "median_ms", n % 2 ? ms[n / 2] : 0.5 * (ms[n / 2 - 1] + ms[n / 2]) } };
+}
+
+// One warm-up call, then ctx.repeats timed calls of @p body. @p work / @p unit turn the
+// median into a throughput (work per second).
+void measure(const char* name, const Context& ctx, const std::function<void()>& body,
+    double work = 0.0, const char* unit = nullptr)
+{
+    body();
+    QVector<double> samples;
+    for (int r = 0; r < ctx.repeats; ++r) {
+        QElapsedTimer timer;
+        timer.start();
+        body();
+        samples.append(timer.nsecsElapsed() * 1e-6);
+    }
+    QJsonObject result = summary(samples);
+    result.insert("benchmark", QString::fromLatin1(name));
+    result.insert("system", ctx.system);
+    result.insert("atoms", ctx.atoms);
+    result.insert("bonds", ctx.bonds);
+    result.insert("repeats", ctx.repeats);
+    const double median = result.value("median_ms").toDouble();
+    if (unit && median > 0.0) {
+        result.insert("throughput", work / (median * 1e-3));
+        result.insert("throughput_unit", QString::fromLatin1(unit));
+    }
+    g_results.append(result);
+    std::fprintf(stderr, "%-20s %-8s %8d atoms  median %10.3f ms", name, qPrintable(ctx.system),
+        ctx.atoms, median);
+    if (unit && median > 0.0)
+        std::fprintf(stderr, "  %12.1f %s", work / (median * 1e-3), unit);
+    std::fprintf(stderr, "\n");
+}
+
+void benchParsers(const Context& ctx, const Atoms& atoms, const Bonds& bonds, const QTemporaryDir& dir)
+{
+    const QString xyz = dir.filePath("bench.xyz"), vtf = dir.filePath("bench.vtf");
+    const QString pdb = dir.filePath("bench.pdb"), mol2 = dir.filePath("bench.mol2");
+    writeXyz(xyz, atoms);
+    writeVtf(vtf, atoms, bonds);
+    writePdb(pdb, atoms);
+    writeMol2(mol2, atoms, bonds);
+    const auto mb = [](const QString& path) { return QFileInfo(path).size() / (1024.0 * 1024.0); };
+    measure("parse.xyz", ctx, [&] { XYZParser p; p.parseTrajectory(xyz); }, mb(xyz), "MB/s");
+    measure("parse.vtf", ctx, [&] { VTFParser p; p.parseTrajectory(vtf); }, mb(vtf), "MB/s");
+    measure("parse.pdb", ctx, [&] { PDBParser p; p.parseTrajectory(pdb); }, mb(pdb), "MB/s");
+    measure("parse.mol2", ctx, [&] {
+        MOL2Parser p;
+        MOL2Parser::MOL2Molecule m;
+        p.parseFile(mol2, m);
+    }, mb(mol2), "MB/s");
+    for (const QString& path : { xyz, vtf, pdb, mol2 })
+        QFile::remove(path);
+}
+
+void benchBonds(const Context& ctx, const Atoms& atoms, const Bonds& bonds)
+{
+    measure("bonds.detect", ctx, [&] { bondperception::detect(atoms); }, atoms.size(), "atoms/s");
+    // Per-frame path: persistent grid, incremental re-binning; alternates between two
+    // slightly different frames so every call moves atoms.
+    Atoms moved = atoms;
+    const QVector<QVector3D> positions = jitter(atoms);
+    for (int i = 0; i < moved.size(); ++i)
+        moved[i].position = positions[i];
+    NeighborGrid grid;
+    bondperception::detectHysteresis(atoms, bonds, grid);
+    bool flip = false;
+    measure("bonds.hysteresis", ctx, [&] {
+        bondperception::detectHysteresis((flip = !flip) ? moved : atoms, bonds, grid);
+    }, atoms.size(), "atoms/s");
+}
+
+void benchScene(const Context& ctx, const Atoms& atoms, const Bonds& bonds)
+{
+    QVector<SceneController::AtomDatum> data(atoms.size());
+    for (int i = 0; i < atoms.size(); ++i)
+        data[i] = { atoms[i].position, atoms[i].element, 0.0f, atoms[i].atomicNumber };
+    QVector<SceneController::BondDatum> bondData(bonds.size());
+    for (int i = 0; i < bonds.size(); ++i)
+        bondData[i] = { bonds[i].atom1, bonds[i].atom2, bonds[i].bondOrder };
+
+    SceneController scene;
+    scene.setViewportSize(1920, 1080);
+    measure("scene.setStructure", ctx, [&] { scene.setStructure(data, bondData); }, atoms.size(), "atoms/s");
+    const QVector<QVector3D> a = jitter(atoms);
+    QVector<QVector3D> b(atoms.size());
+    for (int i = 0; i < atoms.size(); ++i)
+        b[i] = atoms[i].position;
+    bool flip = false;
+    measure("scene.updatePositions", ctx, [&] {
+        scene.updatePositions((flip = !flip) ? PositionSpan(a) : PositionSpan(b));
+    }, atoms.size(), "atoms/s");
+}
+
+void benchInstancing(const Context& ctx, const Atoms& atoms)
+{
+    QVector<AtomInstancing::Item> items(atoms.size());
+    for (int i = 0; i < atoms.size(); ++i)
+        items[i] = { atoms[i].position, 0.3f * elem::vdwRadius(atoms[i].element),
+            QColor::fromRgbF(0.5f, 0.5f, 0.5f) };
+    AtomInstancing instancing;
+    measure("instancing.atoms", ctx, [&] { instancing.setItems(items); }, atoms.size(), "atoms/s");
+}
+
+void benchForce(const Context& ctx, const Atoms& atoms, const Bonds& bonds)
+{
+    // Viewer defaults for a grab (alpha 0.4, 3 shells) on an atom in the middle.
+    const int n = atoms.size();
+    measure("force.distribute", ctx, [&] {
+        const forceinjector::Adjacency adjacency = forceinjector::buildAdjacency(n, bonds);
+        forceinjector::distributeForce(n / 2, Eigen::Vector3d(0.01, 0.0, 0.0), adjacency, 0.4, 3, n);
+    }, n, "atoms/s");
+}
+
+// Batch-mode MD on the calling thread, one frame per step. The clock starts at the first
+// frame, so force-field setup (reported separately) does not count towards steps/s.
+void benchMD(const Context& ctx, const Atoms& atoms, const Bonds& bonds, const QString& method, int steps)
+{
+    SimulationConfig config;
+    config.method = method;
+    config.steps = steps;
+    config.fpsLimit = 0;
+    SimulationWorker worker;
+    worker.setMolecule(atoms);
+    worker.setBonds(bonds);
+    worker.setConfig(config);
+    worker.setBatchMode(1);
+
+    QElapsedTimer clock;
+    qint64 firstFrame = -1, lastFrame = -1;
+    int frames = 0;
+    QString error;
+    QEventLoop loop;
+    QObject::connect(&worker, &SimulationWorker::frameReady, &loop, [&](SimulationFramePtr) {
+        lastFrame = clock.nsecsElapsed();
+        if (firstFrame < 0)
+            firstFrame = lastFrame;
+        ++frames;
+    });
+    QObject::connect(&worker, &SimulationWorker::errorOccurred, &loop,
+        [&](const QString& message) { error = message; });
+    QObject::connect(&worker, &SimulationWorker::finished, &loop, &QEventLoop::quit, Qt::QueuedConnection);
+    clock.start();
+    worker.run();
+    loop.exec();
+
+    if (frames < 2) {
+        std::fprintf(stderr, "%-20s %-8s %8d atoms  failed: %s\n", "md.step", qPrintable(ctx.system),
+            ctx.atoms, qPrintable(error.isEmpty() ? QStringLiteral("no frames") : error));
+        return;
+    }
+    const double stepMs = (lastFrame - firstFrame) * 1e-6 / (frames - 1);
+    QJsonObject result{ { "benchmark", "md.step" }, { "system", ctx.system }, { "atoms", ctx.atoms },
+        { "bonds", ctx.bonds }, { "method", method }, { "steps", frames },
+        { "setup_ms", firstFrame * 1e-6 }, { "mean_ms", stepMs },
+        { "throughput", 1000.0 / stepMs }, { "throughput_unit", "steps/s" },
+        { "ns_per_day", 1000.0 / stepMs * config.timestep * 86400.0 * 1e-6 } };
+    g_results.append(result);
+    std::fprintf(stderr, "%-20s %-8s %8d atoms  mean   %10.3f ms  %12.1f steps/s  (setup %.0f ms)\n",
+        "md.step", qPrintable(ctx.system), ctx.atoms, stepMs, 1000.0 / stepMs, firstFrame * 1e-6);
+}
+
+QStringList splitList(const QString& value)
+{
+    return value.split(QLatin1Char(','), Qt::SkipEmptyParts);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    // SceneController and the instancing tables are QQuick3D objects: they need a
+    // QGuiApplication, but never a window or GPU.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    initialize_generated_registry();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Qurcuma benchmark suite (JSON on stdout or --output)"));
+    parser.addHelpOption();
+    const QCommandLineOption sizesOpt("sizes", "Atom counts.", "list", "1000,10000,100000,1000000");
+    const QCommandLineOption systemsOpt("systems", "carbon, water, protein.", "list", "carbon,water,protein");
+    const QCommandLineOption benchOpt("benchmarks", "parse, bonds, scene, instancing, force, md.",
+        "list", "parse,bonds,scene,instancing,force,md");
+    const QCommandLineOption repeatsOpt("repeats", "Timed repetitions (after one warm-up).", "n", "5");
+    const QCommandLineOption stepsOpt("md-steps", "MD steps per system.", "n", "200");
+    const QCommandLineOption mdMaxOpt("md-max-atoms", "Largest system that runs MD.", "n", "10000");
+    const QCommandLineOption methodOpt("method", "Energy method for md.step.", "name", "uff");
+    const QCommandLineOption outputOpt("output", "Write the JSON report to <file>.", "file");
+    parser.addOptions({ sizesOpt, systemsOpt, benchOpt, repeatsOpt, stepsOpt, mdMaxOpt, methodOpt, outputOpt });
+    parser.process(app);
+
+    QVector<int> sizes;
+    for (const QString& s : splitList(parser.value(sizesOpt)))
+        if (s.toInt() > 0)
+            sizes.append(s.toInt());
+    const QStringList systems = splitList(parser.value(systemsOpt));
+    const QStringList benchmarks = splitList(parser.value(benchOpt));
+    const int repeats = std::max(1, parser.value(repeatsOpt).toInt());
+    const int mdSteps = std::max(2, parser.value(stepsOpt).toInt());
+    const int mdMaxAtoms = parser.value(mdMaxOpt).toInt();
+    const QString method = parser.value(methodOpt);
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::fprintf(stderr, "qurcuma_bench: cannot create a temporary directory\n");
+        return 1;
+    }
+
+    for (const QString& system : systems) {
+        for (int size : sizes) {
+            const Atoms atoms = generate(system, size);
+            const Bonds bonds = bondperception::detect(atoms);
+            Context ctx;
+            ctx.system = system;
+            ctx.atoms = atoms.size();
+            ctx.bonds = bonds.size();
+            ctx.repeats = repeats;
+            if (benchmarks.contains("parse"))
+                benchParsers(ctx, atoms, bonds, dir);
+            if (benchmarks.contains("bonds"))
+                benchBonds(ctx, atoms, bonds);
+            if (benchmarks.contains("scene"))
+                benchScene(ctx, atoms, bonds);
+            if (benchmarks.contains("instancing"))
+                benchInstancing(ctx, atoms);
+            if (benchmarks.contains("force"))
+                benchForce(ctx, atoms, bonds);
+            if (benchmarks.contains("md") && ctx.atoms <= mdMaxAtoms)
+                benchMD(ctx, atoms, bonds, method, mdSteps);
+        }
+    }
+
+    const QJsonObject report{ { "schema", 1 }, { "qurcuma_version", QStringLiteral(QURCUMA_VERSION) },
+        { "qt_version", QString::fromLatin1(qVersion()) },
+        { "timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate) },
+        { "host", QJsonObject{ { "cpu", QSysInfo::currentCpuArchitecture() },
+                      { "threads", QThread::idealThreadCount() },
+                      { "os", QSysInfo::prettyProductName() } } },
+        { "seed", qint64(kSeed) }, { "results", g_results } };
+    const QByteArray json = QJsonDocument(report).toJson();
+    if (parser.isSet(outputOpt)) {
+        QFile file(parser.value(outputOpt));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+            std::fprintf(stderr, "qurcuma_bench: cannot write %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+    } else {
+        std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,263 @@
+// atombvh.cpp - Bounding-volume hierarchy over atom spheres
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "atombvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr int kMaxDepth = 64;  // traversal stack; median splits keep depth ~log2(n / 4)
+
+// Entry/exit distances of the ray against a node box (slab test).
+inline bool rayBox(const float lo[3], const float hi[3], const float origin[3],
+    const float invDir[3], float tMax, float& tEnter)
+{
+    float t0 = 0.0f;
+    float t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+        float tNear = (lo[a] - origin[a]) * invDir[a];
+        float tFar = (hi[a] - origin[a]) * invDir[a];
+        if (tNear > tFar)
+            std::swap(tNear, tFar);
+        t0 = std::max(t0, tNear);
+        t1 = std::min(t1, tFar);
+        if (t0 > t1)
+            return false;
+    }
+    tEnter = t0;
+    return true;
+}
+}
+
+void AtomBvh::clear()
+{
+    m_nodes.clear();
+    m_spheres.clear();
+    m_order.clear();
+    m_builtArea = 0.0f;
+}
+
+void AtomBvh::build(const QVector3D* positions, const float* radii, int count)
+{
+    clear();
+    if (count <= 0)
+        return;
+    m_order.resize(count);
+    for (int i = 0; i < count; ++i)
+        m_order[i] = i;
+    m_nodes.reserve(2 * (count / kLeafSize + 1));
+    buildRange(positions, 0, count);
+
+    m_spheres.resize(count);
+    for (int k = 0; k < count; ++k) {
+        const int i = m_order[k];
+        m_spheres[k] = QVector4D(positions[i], radii[i]);
+    }
+    m_builtArea = fitNodes();
+}
+
+int AtomBvh::buildRange(const QVector3D* positions, int first, int count)
+{
+    const int index = m_nodes.size();
+    m_nodes.append(Node{ {}, {}, first, count, -1 });
+    if (count <= kLeafSize)
+        return index;
+
+    // Split at the median centre along the widest axis of the centre bounds.
+    QVector3D lo(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max());
+    QVector3D hi = -lo;
+    for (int k = first; k < first + count; ++k) {
+        const QVector3D& p = positions[m_order[k]];
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], p[a]);
+            hi[a] = std::max(hi[a], p[a]);
+        }
+    }
+    const QVector3D extent = hi - lo;
+    const int axis = (extent.x() >= extent.y() && extent.x() >= extent.z()) ? 0
+        : (extent.y() >= extent.z() ? 1 : 2);
+    const int half = count / 2;
+    int* begin = m_order.data() + first;
+    std::nth_element(begin, begin + half, begin + count,
+        [positions, axis](int a, int b) { return positions[a][axis] < positions[b][axis]; });
+
+    buildRange(positions, first, half);
+    const int right = buildRange(positions, first + half, count - half);
+    m_nodes[index].right = right;
+    return index;
+}
+
+void AtomBvh::fitLeaf(Node& node) const
+{
+    for (int a = 0; a < 3; ++a) {
+        node.lo[a] = std::numeric_limits<float>::max();
+        node.hi[a] = -std::numeric_limits<float>::max();
+    }
+    for (int k = node.first; k < node.first + node.count; ++k) {
+        const QVector4D& s = m_spheres[k];
+        for (int a = 0; a < 3; ++a) {
+            node.lo[a] = std::min(node.lo[a], s[a] - s.w());
+            node.hi[a] = std::max(node.hi[a], s[a] + s.w());
+        }
+    }
+}
+
+float AtomBvh::fitNodes()
+{
+    // Children follow their parent in m_nodes, so a reverse sweep sees them first.
+    float area = 0.0f;
+    for (int n = m_nodes.size() - 1; n >= 0; --n) {
+        Node& node = m_nodes[n];
+        if (node.right < 0) {
+            fitLeaf(node);
+        } else {
+            const Node& l = m_nodes[n + 1];
+            const Node& r = m_nodes[node.right];
+            for (int a = 0; a < 3; ++a) {
+                node.lo[a] = std::min(l.lo[a], r.lo[a]);
+                node.hi[a] = std::max(l.hi[a], r.hi[a]);
+            }
+        }
+        const float dx = node.hi[0] - node.lo[0];
+        const float dy = node.hi[1] - node.lo[1];
+        const float dz = node.hi[2] - node.lo[2];
+        area += dx * dy + dy * dz + dz * dx;
+    }
+    return area;
+}
+
+void AtomBvh::refit(const QVector3D* positions)
+{
+    if (m_nodes.isEmpty())
+        return;
+    for (int k = 0; k < m_spheres.size(); ++k) {
+        const QVector3D& p = positions[m_order[k]];
+        m_spheres[k].setX(p.x());
+        m_spheres[k].setY(p.y());
+        m_spheres[k].setZ(p.z());
+    }
+    if (fitNodes() <= 2.0f * m_builtArea)
+        return;
+
+    // Boxes overlap too much after large motions: rebuild from the current spheres.
+    const int count = m_order.size();
+    QVector<QVector3D> pos(count);
+    QVector<float> radii(count);
+    for (int k = 0; k < count; ++k) {
+        pos[m_order[k]] = m_spheres[k].toVector3D();
+        radii[m_order[k]] = m_spheres[k].w();
+    }
+    build(pos.constData(), radii.constData(), count);
+}
+
+int AtomBvh::raycast(const QVector3D& origin, const QVector3D& dir, float* tHit) const
+{
+    if (m_nodes.isEmpty())
+        return -1;
+    const float o[3] = { origin.x(), origin.y(), origin.z() };
+    float inv[3];
+    for (int a = 0; a < 3; ++a)
+        inv[a] = std::abs(dir[a]) > 1e-12f ? 1.0f / dir[a] : std::copysign(1e30f, dir[a]);
+
+    int best = -1;
+    float bestT = std::numeric_limits<float>::max();
+    int stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        float tEnter = 0.0f;  // re-tested on pop: bestT may have shrunk since the push
+        if (!rayBox(node.lo, node.hi, o, inv, bestT, tEnter))
+            continue;
+        if (node.right >= 0) {
+            // Visit the nearer child first so bestT shrinks early and prunes the other.
+            const int l = int(&node - m_nodes.constData()) + 1;
+            const int r = node.right;
+            float tl = 0.0f, tr = 0.0f;
+            const bool hitL = rayBox(m_nodes[l].lo, m_nodes[l].hi, o, inv, bestT, tl);
+            const bool hitR = rayBox(m_nodes[r].lo, m_nodes[r].hi, o, inv, bestT, tr);
+            if (hitL && hitR) {
+                stack[top++] = tl <= tr ? r : l;
+                stack[top++] = tl <= tr ? l : r;
+            } else if (hitL) {
+                stack[top++] = l;
+            } else if (hitR) {
+                stack[top++] = r;
+            }
+            continue;
+        }
+        for (int k = node.first; k < node.first + node.count; ++k) {
+            const QVector4D& s = m_spheres[k];
+            const QVector3D oc = origin - s.toVector3D();
+            const float b = QVector3D::dotProduct(oc, dir);
+            const float c = QVector3D::dotProduct(oc, oc) - s.w() * s.w();
+            const float disc = b * b - c;
+            if (disc < 0.0f)
+                continue;
+            const float sq = std::sqrt(disc);
+            float t = -b - sq;
+            if (t < 0.0f)
+                t = -b + sq;  // origin inside the sphere
+            if (t > 0.0f && t < bestT) {
+                bestT = t;
+                best = m_order[k];
+            }
+        }
+    }
+    if (best >= 0 && tHit)
+        *tHit = bestT;
+    return best;
+}
+
+void AtomBvh::centersInside(const QVector4D* planes, int planeCount, QVector<int>& out) const
+{
+    if (m_nodes.isEmpty())
+        return;
+    int stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const int index = stack[--top];
+        const Node& node = m_nodes[index];
+        // Per plane, the box corner furthest along / against the normal decides whether the
+        // box is fully outside (skip) or fully inside (take the whole subtree).
+        bool outside = false;
+        bool inside = true;
+        for (int p = 0; p < planeCount && !outside; ++p) {
+            const QVector4D& pl = planes[p];
+            float maxD = pl.w();
+            float minD = pl.w();
+            for (int a = 0; a < 3; ++a) {
+                const float lo = pl[a] * node.lo[a];
+                const float hi = pl[a] * node.hi[a];
+                maxD += std::max(lo, hi);
+                minD += std::min(lo, hi);
+            }
+            outside = maxD < 0.0f;
+            inside = inside && minD >= 0.0f;
+        }
+        if (outside)
+            continue;
+        if (inside) {
+            for (int k = node.first; k < node.first + node.count; ++k)
+                out.append(m_order[k]);
+            continue;
+        }
+        if (node.right >= 0) {
+            stack[top++] = node.right;
+            stack[top++] = index + 1;
+            continue;
+        }
+        for (int k = node.first; k < node.first + node.count; ++k) {
+            const QVector3D c = m_spheres[k].toVector3D();
+            bool in = true;
+            for (int p = 0; p < planeCount && in; ++p)
+                in = QVector3D::dotProduct(planes[p].toVector3D(), c) + planes[p].w() >= 0.0f;
+            if (in)
+                out.append(m_order[k]);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+// atombvh.h - Bounding-volume hierarchy over atom spheres
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - log-time picking for SceneController.
+//
+// Axis-aligned boxes over the atom spheres in model (intrinsic) coordinates, built by
+// median splits along the widest axis (leaves of up to kLeafSize atoms). Nodes are stored
+// in depth-first order, so a parent always precedes its children and refit() is a single
+// reverse sweep. The spheres are kept in leaf order next to the nodes, i.e. a leaf test
+// reads one contiguous run instead of scattering over the caller's atom array.
+//
+// Positions change every MD/playback frame while the topology stays; refit() only
+// recomputes the boxes. When the atoms have drifted far enough that the refitted tree is
+// markedly worse than a fresh one (summed node surface area doubled), refit() rebuilds.
+
+#pragma once
+
+#include <QVector3D>
+#include <QVector4D>
+#include <QVector>
+
+class AtomBvh
+{
+public:
+    static constexpr int kLeafSize = 4;
+
+    /** Build over @p count spheres (@p positions / @p radii indexed by atom). */
+    void build(const QVector3D* positions, const float* radii, int count);
+    /** Same atoms, new @p positions (indexed by atom): recompute the boxes. */
+    void refit(const QVector3D* positions);
+    void clear();
+
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+    int count() const { return m_order.size(); }
+
+    /** Nearest sphere hit by the ray @p origin + t * @p dir (t > 0, @p dir normalised).
+     *  @return atom index or -1; the hit distance goes to @p tHit when given. */
+    int raycast(const QVector3D& origin, const QVector3D& dir, float* tHit = nullptr) const;
+
+    /** Atoms whose centre satisfies n.p + d >= 0 for all @p planeCount @p planes
+     *  (QVector4D(n, d)), appended to @p out in no particular order. */
+    void centersInside(const QVector4D* planes, int planeCount, QVector<int>& out) const;
+
+private:
+    struct Node {
+        float lo[3];
+        float hi[3];
+        int first;  // spheres [first, first + count) of the whole subtree
+        int count;
+        int right;  // inner: index of the right child (left = this + 1); leaf: -1
+    };
+
+    int buildRange(const QVector3D* positions, int first, int count);
+    void fitLeaf(Node& node) const;
+    float fitNodes();  // bottom-up boxes; returns the summed node surface area
+
+    QVector<Node> m_nodes;
+    QVector<QVector4D> m_spheres;  // (centre, radius) in leaf order
+    QVector<int> m_order;          // leaf order -> atom index
+    float m_builtArea = 0.0f;      // fitNodes() right after build()
+};
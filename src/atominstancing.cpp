@@ -1,6 +1,7 @@
 // Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
 // Atom sphere instancing for the Qt Quick 3D viewer. Claude Generated.
 #include "atominstancing.h"
+#include "profiler.h"
 
 namespace {
 // Quick3D built-in "#Sphere" has base radius 50; divide the desired scene-unit
@@ -13,14 +14,40 @@ AtomInstancing::AtomInstancing(QQuick3DObject* parent)
 {
 }
 
-void AtomInstancing::setItems(const QVector<Item>& items)
+void AtomInstancing::setItems(const QVector<Item>& items, const QVector<int>& atomIndex)
 {
     m_items = items;
+    m_atomIndex = atomIndex.size() == items.size() ? atomIndex : QVector<int>();
     if (m_highlight >= m_items.size())
         m_highlight = -1;
     rebuild();
 }
 
+void AtomInstancing::updatePositions(PositionSpan positions)
+{
+    ProfileScope profile("instancing.atoms");
+    if (positions.size <= 0 || m_count == 0)
+        return;
+    // Spheres carry no rotation, so only row0.w/row1.w/row2.w (translation) change.
+    auto* entry = reinterpret_cast<InstanceTableEntry*>(m_buffer.data());
+    auto place = [&](int slot, const QVector3D& p) {
+        entry[slot].row0.setW(p.x());
+        entry[slot].row1.setW(p.y());
+        entry[slot].row2.setW(p.z());
+        m_items[slot].position = p;
+    };
+    if (m_atomIndex.isEmpty()) {
+        const int n = qMin(positions.size, m_count);
+        for (int i = 0; i < n; ++i)
+            place(i, positions[i]);
+    } else {
+        for (int slot = 0; slot < m_count; ++slot)
+            if (m_atomIndex[slot] < positions.size)
+                place(slot, positions[m_atomIndex[slot]]);
+    }
+    markDirty();
+}
+
 void AtomInstancing::setHighlight(int index, const QColor& color)
 {
     if (index >= m_items.size())
@@ -34,6 +61,7 @@ void AtomInstancing::setHighlight(int index, const QColor& color)
 
 void AtomInstancing::rebuild()
 {
+    ProfileScope profile("instancing.atoms");
     m_count = m_items.size();
     m_buffer.resize(m_count * int(sizeof(InstanceTableEntry)));
     auto* entry = reinterpret_cast<InstanceTableEntry*>(m_buffer.data());
@@ -5,6 +5,8 @@
 // Validated in spikes/quick3d. Claude Generated.
 #pragma once
 
+#include "positionspan.h"
+
 #include <QColor>
 #include <QQuick3DInstancing>
 #include <QVector3D>
@@ -24,7 +26,12 @@ public:
     };
 
     /// Replace the full instance list and re-upload (cheap enough per frame).
-    void setItems(const QVector<Item>& items);
+    /// Claude Generated 2026 - @p atomIndex maps instance slot -> atom index when the list is
+    /// a subset (culled / LOD-split primary structure); empty = instance i is atom i.
+    void setItems(const QVector<Item>& items, const QVector<int>& atomIndex = {});
+    /// Claude Generated 2026 - move the instances of atoms [0, positions.size) without
+    /// touching scale/colour: patches the translation column of the existing table in place.
+    void updatePositions(PositionSpan positions);
     /// Recolour a single instance as the picked atom (-1 = none).
     void setHighlight(int index, const QColor& color);
 
@@ -35,6 +42,7 @@ private:
     void rebuild();
 
     QVector<Item> m_items;
+    QVector<int> m_atomIndex; // slot -> atom index (empty = identity)
     int m_highlight = -1;
     QColor m_highlightColor{ 255, 0, 255 };
     QByteArray m_buffer;
@@ -0,0 +1,241 @@
+// batchrunner.cpp - Headless MD / optimisation / trajectory analysis (qurcuma --batch)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+
+#include "batchrunner.h"
+
+#include "lesson.h"  // simConfigFromJson
+#include "rmsdwidget.h"  // RMSDWidget::loadStructureFile (static, no widgets involved)
+#include "xyztrajectoryreader.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+
+#include <cmath>
+#include <cstdio>
+
+BatchRunner::BatchRunner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+QString BatchRunner::outputPath(const QString& suffix) const
+{
+    return m_prefix + suffix;
+}
+
+bool BatchRunner::load(const QString& jobPath, QString* error)
+{
+    auto failed = [error](const QString& message) {
+        if (error)
+            *error = message;
+        return false;
+    };
+
+    QFile file(jobPath);
+    if (!file.open(QIODevice::ReadOnly))
+        return failed(tr("Cannot read job file %1").arg(jobPath));
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!doc.isObject())
+        return failed(tr("%1: %2").arg(jobPath, parseError.errorString()));
+    const QJsonObject job = doc.object();
+
+    const QFileInfo jobInfo(jobPath);
+    const QDir dir = jobInfo.absoluteDir();
+    m_prefix = dir.absoluteFilePath(job.value("output").toString(jobInfo.completeBaseName()));
+    m_frameInterval = std::max(1, job.value("frameInterval").toInt(1));
+
+    m_runSimulation = job.contains("sim");
+    if (m_runSimulation) {
+        m_config = simConfigFromJson(job.value("sim").toObject());
+        const QString structure = job.value("structure").toString();
+        if (structure.isEmpty())
+            return failed(tr("%1: \"sim\" needs a \"structure\"").arg(jobPath));
+        QVector<MoleculeViewer::Bond> bonds;
+        if (!RMSDWidget::loadStructureFile(dir.absoluteFilePath(structure), m_atoms, bonds))
+            return failed(tr("Cannot load structure %1").arg(dir.absoluteFilePath(structure)));
+    } else {
+        const QString trajectory = job.value("trajectory").toString();
+        if (trajectory.isEmpty())
+            return failed(tr("%1: neither \"sim\" nor \"trajectory\" given").arg(jobPath));
+        m_trajectoryPath = dir.absoluteFilePath(trajectory);
+    }
+
+    m_runAnalysis = job.contains("analysis");
+    if (m_runAnalysis) {
+        const QJsonObject analysis = job.value("analysis").toObject();
+        m_analysisOptions.referenceFrame = analysis.value("referenceFrame").toInt(0);
+        m_analysisOptions.fitAtoms = analysis.value("fitAtoms").toString() == QLatin1String("heavy")
+            ? TrajectoryAnalysis::FitAtoms::Heavy
+            : TrajectoryAnalysis::FitAtoms::All;
+    } else if (!m_runSimulation) {
+        return failed(tr("%1: nothing to do (no \"sim\", no \"analysis\")").arg(jobPath));
+    }
+    return true;
+}
+
+void BatchRunner::fail(const QString& message)
+{
+    std::fprintf(stderr, "qurcuma --batch: %s\n", qPrintable(message));
+    emit finished(1);
+}
+
+void BatchRunner::start()
+{
+    m_clock.start();
+    if (!m_runSimulation) {
+        startAnalysis(m_trajectoryPath);
+        return;
+    }
+
+    m_trajectoryFile.setFileName(outputPath(QStringLiteral(".trj.xyz")));
+    m_energyFile.setFileName(outputPath(QStringLiteral(".energy.dat")));
+    if (!m_trajectoryFile.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || !m_energyFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fail(tr("Cannot write %1.*").arg(m_prefix));
+        return;
+    }
+    m_trajectory.setDevice(&m_trajectoryFile);
+    m_energy.setDevice(&m_energyFile);
+    m_energy << "# step  Epot[Eh]  Ekin[Eh]  Etot[Eh]  T[K]  T_target[K]\n";
+
+    // Same thread as the writers: frames arrive by direct call, nothing queues up.
+    m_worker = new SimulationWorker(this);
+    m_worker->setMolecule(m_atoms);
+    m_worker->setConfig(m_config);
+    m_worker->setBatchMode(m_frameInterval);
+    connect(m_worker, &SimulationWorker::frameReady, this, &BatchRunner::onFrame);
+    connect(m_worker, &SimulationWorker::errorOccurred, this,
+        [this](const QString& message) { m_error = message; });
+    connect(m_worker, &SimulationWorker::finished, this, &BatchRunner::onSimulationFinished,
+        Qt::QueuedConnection);  // Opt emits it from inside run()
+    m_worker->run();
+}
+
+void BatchRunner::onFrame(SimulationFramePtr frame)
+{
+    const int n = std::min(int(frame->positions.size()), int(m_atoms.size()));
+    m_trajectory << n << '\n'
+                 << "step " << frame->step << " energy " << QString::number(frame->energy, 'f', 10)
+                 << '\n';
+    for (int i = 0; i < n; ++i) {
+        const QVector3D& p = frame->positions[i];
+        m_trajectory << QString("%1 %2 %3 %4\n")
+                            .arg(m_atoms[i].element)
+                            .arg(p.x(), 12, 'f', 6)
+                            .arg(p.y(), 12, 'f', 6)
+                            .arg(p.z(), 12, 'f', 6);
+    }
+    m_energy << frame->step << ' ' << QString::number(frame->energy, 'f', 10) << ' '
+             << QString::number(frame->ekin, 'f', 10) << ' '
+             << QString::number(frame->energy + frame->ekin, 'f', 10) << ' '
+             << QString::number(frame->temperature, 'f', 3) << ' '
+             << QString::number(frame->targetTemperature, 'f', 3) << '\n';
+    ++m_framesWritten;
+    m_lastStep = frame->step;
+}
+
+void BatchRunner::onSimulationFinished()
+{
+    m_trajectory.flush();
+    m_energy.flush();
+    m_trajectoryFile.close();
+    m_energyFile.close();
+    m_worker->deleteLater();
+    m_worker = nullptr;
+
+    const double seconds = m_clock.nsecsElapsed() * 1e-9;
+    const bool md = m_config.mode == SimulationConfig::Mode::MolecularDynamics;
+    std::printf("%s %d atoms: %d %s in %.3f s (%.1f/s), %d frames -> %s\n",
+        md ? "md" : "opt", int(m_atoms.size()), m_lastStep, md ? "steps" : "iterations", seconds,
+        seconds > 0.0 ? m_lastStep / seconds : 0.0, m_framesWritten,
+        qPrintable(m_trajectoryFile.fileName()));
+    std::fflush(stdout);
+
+    if (!m_error.isEmpty()) {
+        fail(m_error);
+        return;
+    }
+    if (m_runAnalysis)
+        startAnalysis(m_trajectoryFile.fileName());
+    else
+        emit finished(0);
+}
+
+void BatchRunner::startAnalysis(const QString& trajectoryPath)
+{
+    // Same per-worker XYZTrajectoryReader set-up as MoleculeViewer::trajectoryFrameSource().
+    XYZTrajectoryReader probe;
+    QVector<MoleculeViewer::Atom> first;
+    if (!probe.open(trajectoryPath) || !probe.frameAtoms(0, first) || first.isEmpty()) {
+        fail(tr("Cannot read trajectory %1").arg(trajectoryPath));
+        return;
+    }
+    TrajectoryFrameSource source;
+    source.frameCount = probe.frameCount();
+    for (const MoleculeViewer::Atom& a : first)
+        source.atomicNumbers.append(a.atomicNumber);
+    const int atomCount = first.size();
+    source.openReader = [trajectoryPath, atomCount]() -> TrajectoryFrameReader {
+        auto reader = QSharedPointer<XYZTrajectoryReader>::create(atomCount);
+        if (!reader->open(trajectoryPath))
+            return {};
+        auto atoms = QSharedPointer<QVector<MoleculeViewer::Atom>>::create();
+        return [reader, atoms](int frame, QVector<QVector3D>& coords) {
+            if (!reader->frameAtoms(frame, *atoms))
+                return false;
+            coords.resize(atoms->size());
+            for (int i = 0; i < atoms->size(); ++i)
+                coords[i] = (*atoms)[i].position;
+            return true;
+        };
+    };
+
+    m_clock.restart();
+    m_analysis = new TrajectoryAnalysis(this);
+    connect(m_analysis, &TrajectoryAnalysis::finished, this, &BatchRunner::onAnalysisFinished);
+    if (!m_analysis->start(source, m_analysisOptions))
+        fail(tr("Cannot read reference frame %1 of %2")
+                 .arg(m_analysisOptions.referenceFrame)
+                 .arg(trajectoryPath));
+}
+
+void BatchRunner::onAnalysisFinished(bool completed)
+{
+    if (!completed) {
+        fail(tr("Trajectory analysis failed"));
+        return;
+    }
+    const double seconds = m_clock.nsecsElapsed() * 1e-9;
+    std::printf("analysis: %d frames in %.3f s (%.1f/s)\n", m_analysis->frameCount(), seconds,
+        seconds > 0.0 ? m_analysis->frameCount() / seconds : 0.0);
+    std::fflush(stdout);
+    if (!writeAnalysis()) {
+        fail(tr("Cannot write %1.rmsd.dat / .rmsf.dat").arg(m_prefix));
+        return;
+    }
+    emit finished(0);
+}
+
+bool BatchRunner::writeAnalysis()
+{
+    QFile rmsdFile(outputPath(QStringLiteral(".rmsd.dat")));
+    QFile rmsfFile(outputPath(QStringLiteral(".rmsf.dat")));
+    if (!rmsdFile.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || !rmsfFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    QTextStream rmsd(&rmsdFile);
+    rmsd << "# frame  RMSD[A]  (frames unreadable or with another atom count omitted)\n";
+    const QVector<float>& values = m_analysis->rmsd();
+    for (int f = 0; f < values.size(); ++f)
+        if (!std::isnan(values[f]))
+            rmsd << f << ' ' << QString::number(values[f], 'f', 5) << '\n';
+    QTextStream rmsf(&rmsfFile);
+    rmsf << "# atom  RMSF[A]\n";
+    const QVector<float>& fluctuations = m_analysis->rmsf();
+    for (int i = 0; i < fluctuations.size(); ++i)
+        rmsf << i + 1 << ' ' << QString::number(fluctuations[i], 'f', 5) << '\n';
+    return true;
+}
@@ -0,0 +1,81 @@
+// batchrunner.h - Headless MD / optimisation / trajectory analysis (qurcuma --batch)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - window-less runs on compute nodes.
+//
+// `qurcuma --batch job.json` runs under a QCoreApplication: no MainWindow, no QML engine,
+// no RHI. The job file names a structure, a "sim" object in the lesson's SimulationConfig
+// schema (simConfigToJson / simConfigFromJson), an output prefix and optionally a
+// trajectory analysis:
+//
+//   {
+//     "structure": "mol.xyz",          // relative paths: relative to the job file
+//     "output": "run1",                // prefix; default: job file name without suffix
+//     "sim": { "mode": "md", "method": "gfnff", "steps": 5000, "temperature": 300 },
+//     "frameInterval": 10,             // every Nth step/iteration is written (default 1)
+//     "analysis": { "referenceFrame": 0, "fitAtoms": "heavy" }
+//   }
+//
+// Without "sim", "trajectory" names an existing multi-frame XYZ and only the analysis runs.
+// Outputs: <prefix>.trj.xyz (sampled frames), <prefix>.energy.dat (step, energies,
+// temperatures), <prefix>.rmsd.dat / <prefix>.rmsf.dat for the analysis, and a one-line
+// throughput summary on stdout. SimulationWorker runs on the main thread in batch mode
+// (SimulationWorker::setBatchMode), so frames reach the writers by direct call.
+
+#pragma once
+
+#include "simulationframe.h"
+#include "simulationworker.h"
+#include "trajectoryanalysis.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+
+class BatchRunner : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BatchRunner(QObject* parent = nullptr);
+
+    /** Read and validate the job file (and the input structure). */
+    bool load(const QString& jobPath, QString* error);
+
+    /** Run the job; finished() reports the process exit code. */
+    void start();
+
+signals:
+    void finished(int exitCode);
+
+private:
+    void onFrame(SimulationFramePtr frame);
+    void onSimulationFinished();
+    void startAnalysis(const QString& trajectoryPath);
+    void onAnalysisFinished(bool completed);
+    bool writeAnalysis();
+    void fail(const QString& message);
+    QString outputPath(const QString& suffix) const;
+
+    QString m_prefix;
+    bool m_runSimulation = false;
+    SimulationConfig m_config;
+    int m_frameInterval = 1;
+    QVector<MoleculeViewer::Atom> m_atoms;   // input structure (topology of every frame)
+    QString m_trajectoryPath;                // analysis-only input
+    bool m_runAnalysis = false;
+    TrajectoryAnalysis::Options m_analysisOptions;
+
+    SimulationWorker* m_worker = nullptr;
+    TrajectoryAnalysis* m_analysis = nullptr;
+    QFile m_trajectoryFile;
+    QFile m_energyFile;
+    QTextStream m_trajectory;
+    QTextStream m_energy;
+    QString m_error;
+    int m_framesWritten = 0;
+    int m_lastStep = 0;
+    QElapsedTimer m_clock;
+};
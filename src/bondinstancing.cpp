@@ -1,6 +1,18 @@
 // Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
 // Bond cylinder instancing for the Qt Quick 3D viewer. Claude Generated.
 #include "bondinstancing.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Quick3D built-in "#Cylinder": radius 50, height 100 (cf. scenecontroller.cpp).
+constexpr float kCylBaseRadius = 50.0f;
+constexpr float kCylBaseHalfHeight = 50.0f;
+constexpr int kBlock = 256;            // bonds per packed block (~14 KB of stack arrays)
+constexpr int kParallelBonds = 16384;  // below this the thread fan-out costs more than it saves
+}
 
 BondInstancing::BondInstancing(QQuick3DObject* parent)
     : QQuick3DInstancing(parent)
@@ -19,6 +31,110 @@ void BondInstancing::setSegments(const QVector<Segment>& segments)
     markDirty();
 }
 
+void BondInstancing::setHalfBonds(const QVector3D* positions, const int* atomA, const int* atomB,
+    int count, float radius, const QVector4D* colors)
+{
+    ProfileScope profile("instancing.bonds");
+    m_count = 2 * count;
+    m_buffer.resize(m_count * int(sizeof(InstanceTableEntry)));
+    writeHalfBonds(reinterpret_cast<InstanceTableEntry*>(m_buffer.data()), positions, atomA, atomB,
+        nullptr, count, radius, colors);
+    markDirty();
+}
+
+void BondInstancing::updateHalfBonds(const QVector3D* positions, const int* atomA, const int* atomB,
+    const int* bonds, int count, float radius)
+{
+    ProfileScope profile("instancing.bonds");
+    if (count <= 0)
+        return;
+    writeHalfBonds(reinterpret_cast<InstanceTableEntry*>(m_buffer.data()), positions, atomA, atomB,
+        bonds, count, radius, nullptr);
+    markDirty();
+}
+
+QVector4D BondInstancing::tableColor(const QColor& color)
+{
+    return calculateTableEntry(QVector3D(), QVector3D(1, 1, 1), QVector3D(), color).color;
+}
+
+// Rotation taking the cylinder's local +Y onto the unit bond direction n = (x, y, z), in
+// closed form (Rodrigues about y x n), so there is no acos/quaternion per bond:
+//
+//       | |y| + k z^2    x    -s k x z  |
+//   R = |   -s x         y      -z      |      s = sign(y), k = 1 / (1 + |y|)
+//       |  -k x z        z    y + s k x^2 |
+//
+// For y < 0 this is the rotation onto -n composed with the 180 degree turn about X that
+// bondRotation() uses for anti-parallel bonds, which keeps k bounded (no cancellation near
+// n = -Y). The two branches differ only by a twist about the cylinder axis (invisible).
+// Instance rows are R scaled per column by (radius, halfLength, radius) plus the centre.
+void BondInstancing::writeHalfBonds(InstanceTableEntry* table, const QVector3D* positions,
+    const int* atomA, const int* atomB, const int* bonds, int count, float radius,
+    const QVector4D* colors)
+{
+    const float sxz = radius / kCylBaseRadius;
+    const int blocks = (count + kBlock - 1) / kBlock;
+
+#pragma omp parallel for schedule(static) if (count >= kParallelBonds)
+    for (int blk = 0; blk < blocks; ++blk) {
+        const int begin = blk * kBlock;
+        const int n = qMin(kBlock, count - begin);
+
+        // Gather endpoints into packed arrays (positions are indexed, hence not contiguous).
+        alignas(32) float ax[kBlock], ay[kBlock], az[kBlock];
+        alignas(32) float bx[kBlock], by[kBlock], bz[kBlock];
+        for (int j = 0; j < n; ++j) {
+            const int k = bonds ? bonds[begin + j] : begin + j;
+            const QVector3D& a = positions[atomA[k]];
+            const QVector3D& b = positions[atomB[k]];
+            ax[j] = a.x(); ay[j] = a.y(); az[j] = a.z();
+            bx[j] = b.x(); by[j] = b.y(); bz[j] = b.z();
+        }
+
+        alignas(32) float r00[kBlock], r02[kBlock], r10[kBlock], r20[kBlock], r22[kBlock];
+        alignas(32) float nx[kBlock], ny[kBlock], nz[kBlock], sr[kBlock], sh[kBlock];
+#pragma omp simd
+        for (int j = 0; j < n; ++j) {
+            const float dx = bx[j] - ax[j], dy = by[j] - ay[j], dz = bz[j] - az[j];
+            const float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const float inv = (len < 1e-4f ? 0.0f : 1.0f) / std::max(len, 1e-4f);
+            const float x = dx * inv, y = dy * inv, z = dz * inv;
+            const float s = y < 0.0f ? -1.0f : 1.0f;
+            const float k = 1.0f / (1.0f + s * y);
+            r00[j] = s * y + k * z * z;
+            r02[j] = -s * k * x * z;
+            r10[j] = -s * x;
+            r20[j] = -k * x * z;
+            r22[j] = y + s * k * x * x;
+            nx[j] = x;
+            ny[j] = y;
+            nz[j] = z;
+            sr[j] = len < 1e-4f ? 0.0f : sxz;                 // coincident endpoints: invisible
+            sh[j] = len * 0.25f / kCylBaseHalfHeight;          // half of the half-bond length
+        }
+
+        for (int j = 0; j < n; ++j) {
+            const int k = bonds ? bonds[begin + j] : begin + j;
+            InstanceTableEntry& ea = table[2 * k];
+            InstanceTableEntry& eb = table[2 * k + 1];
+            const float r = sr[j], h = sh[j];
+            // Half-cylinder centres at 1/4 and 3/4 along A->B.
+            ea.row0 = QVector4D(r00[j] * r, nx[j] * h, r02[j] * r, 0.75f * ax[j] + 0.25f * bx[j]);
+            ea.row1 = QVector4D(r10[j] * r, ny[j] * h, -nz[j] * r, 0.75f * ay[j] + 0.25f * by[j]);
+            ea.row2 = QVector4D(r20[j] * r, nz[j] * h, r22[j] * r, 0.75f * az[j] + 0.25f * bz[j]);
+            eb.row0 = QVector4D(ea.row0.x(), ea.row0.y(), ea.row0.z(), 0.25f * ax[j] + 0.75f * bx[j]);
+            eb.row1 = QVector4D(ea.row1.x(), ea.row1.y(), ea.row1.z(), 0.25f * ay[j] + 0.75f * by[j]);
+            eb.row2 = QVector4D(ea.row2.x(), ea.row2.y(), ea.row2.z(), 0.25f * az[j] + 0.75f * bz[j]);
+            if (colors) {
+                ea.color = colors[atomA[k]];
+                eb.color = colors[atomB[k]];
+                ea.instanceData = eb.instanceData = QVector4D();
+            }
+        }
+    }
+}
+
 QByteArray BondInstancing::getInstanceBuffer(int* instanceCount)
 {
     if (instanceCount)
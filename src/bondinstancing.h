@@ -10,6 +10,7 @@
 #include <QQuaternion>
 #include <QQuick3DInstancing>
 #include <QVector3D>
+#include <QVector4D>
 
 class BondInstancing : public QQuick3DInstancing
 {
@@ -26,10 +27,27 @@ public:
 
     void setSegments(const QVector<Segment>& segments);
 
+    // Claude Generated 2026 - batched half-bond kernel for the primary structure. Bond k
+    // joins atoms atomA[k]/atomB[k] and owns instances 2k (A half, colour colors[atomA[k]])
+    // and 2k+1. Transforms are computed on packed float blocks (SIMD) straight into the
+    // instance table, split across threads for large bond counts; no Segment list is built.
+    // Coincident endpoints give zero-scale (invisible) instances, so the count never changes.
+    void setHalfBonds(const QVector3D* positions, const int* atomA, const int* atomB, int count,
+        float radius, const QVector4D* colors);
+    /// Recompute the transforms of bonds @p bonds[0..count) (all bonds when null); colours kept.
+    void updateHalfBonds(const QVector3D* positions, const int* atomA, const int* atomB,
+        const int* bonds, int count, float radius);
+    /// @p color as stored in the instance table (same conversion as calculateTableEntry).
+    static QVector4D tableColor(const QColor& color);
+
 protected:
     QByteArray getInstanceBuffer(int* instanceCount) override;
 
 private:
+    static void writeHalfBonds(InstanceTableEntry* table, const QVector3D* positions,
+        const int* atomA, const int* atomB, const int* bonds, int count, float radius,
+        const QVector4D* colors);
+
     QByteArray m_buffer;
     int m_count = 0;
 };
@@ -0,0 +1,105 @@
+// bondperception.cpp - Distance-based (covalent radius) bond perception
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026
+
+#include "bondperception.h"
+#include "elementdata.h"
+#include "profiler.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+namespace bondperception {
+
+namespace {
+// Packed positions + per-atom covalent radii (looked up once per atom) for the grid search.
+void gatherInput(const QVector<MoleculeViewer::Atom>& atoms, QVector<QVector3D>& positions,
+    QVector<float>& radii, float& maxRadius)
+{
+    const int n = atoms.size();
+    positions.resize(n);
+    radii.resize(n);
+    maxRadius = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        positions[i] = atoms[i].position;
+        radii[i] = elem::covalentRadius(atoms[i].atomicNumber);
+        maxRadius = qMax(maxRadius, radii[i]);
+    }
+}
+
+// Grid traversal yields pairs in cell order; keep the (i, j)-ascending order of the former
+// all-pairs loop so bond indices stay stable for instancing and file output.
+void sortBonds(QVector<MoleculeViewer::Bond>& bonds)
+{
+    std::sort(bonds.begin(), bonds.end(), [](const MoleculeViewer::Bond& a, const MoleculeViewer::Bond& b) {
+        return a.atom1 != b.atom1 ? a.atom1 < b.atom1 : a.atom2 < b.atom2;
+    });
+}
+
+quint64 pairKey(int i, int j)
+{
+    return (static_cast<quint64>(qMin(i, j)) << 32) | static_cast<quint32>(qMax(i, j));
+}
+} // namespace
+
+// Per-atom covalent radii are looked up once (not per pair), and only pairs in adjacent
+// NeighborGrid cells (edge = largest possible bond cutoff of the structure) are
+// distance-tested, so detection is O(N) instead of O(N^2).
+QVector<MoleculeViewer::Bond> detect(const QVector<MoleculeViewer::Atom>& atoms)
+{
+    ProfileScope profile("bonds.detect");
+    QVector<QVector3D> pos;
+    QVector<float> radii;
+    float maxR = 0.0f;
+    gatherInput(atoms, pos, radii, maxR);
+
+    const float cutoff = 2.0f * maxR * kFormTolerance;
+    NeighborGrid grid;
+    grid.build(pos, cutoff);
+
+    QVector<MoleculeViewer::Bond> detectedBonds;
+    grid.forEachPair(pos.constData(), cutoff, [&](int i, int j, float d2) {
+        const float threshold = (radii[i] + radii[j]) * kFormTolerance;
+        if (d2 <= threshold * threshold)
+            detectedBonds.append({ i, j, 1 });
+    });
+    sortBonds(detectedBonds);
+    return detectedBonds;
+}
+
+// A currently-bonded pair is kept until it stretches past the looser BREAK threshold; an
+// unbonded pair only forms a bond within the tighter FORM threshold. The gap between the two
+// suppresses on/off flicker for bonds that vibrate near the cutoff at finite temperature.
+QVector<MoleculeViewer::Bond> detectHysteresis(const QVector<MoleculeViewer::Atom>& atoms,
+    const QVector<MoleculeViewer::Bond>& previous, NeighborGrid& grid)
+{
+    ProfileScope profile("bonds.hysteresis");
+    QSet<quint64> bonded;
+    bonded.reserve(previous.size());
+    for (const MoleculeViewer::Bond& b : previous)
+        bonded.insert(pairKey(b.atom1, b.atom2));
+
+    QVector<QVector3D> pos;
+    QVector<float> radii;
+    float maxR = 0.0f;
+    gatherInput(atoms, pos, radii, maxR);
+
+    const float cutoff = 2.0f * maxR * kBreakTolerance;
+    if (grid.isEmpty() || grid.cellSize() < cutoff)
+        grid.build(pos, cutoff);
+    else
+        grid.update(pos.constData(), pos.size());
+
+    QVector<MoleculeViewer::Bond> result;
+    grid.forEachPair(pos.constData(), cutoff, [&](int i, int j, float d2) {
+        const float r = radii[i] + radii[j];
+        const float tol = bonded.contains(pairKey(i, j)) ? kBreakTolerance : kFormTolerance;
+        if (d2 <= r * r * tol * tol)
+            result.append({ i, j, 1 });
+    });
+    sortBonds(result);
+    return result;
+}
+
+} // namespace bondperception
@@ -0,0 +1,28 @@
+// bondperception.h - Distance-based (covalent radius) bond perception
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - split out of MoleculeViewer so it runs (and is benchmarked)
+// without a viewer.
+
+#pragma once
+
+#include <QVector>
+
+#include "neighborgrid.h"
+#include "view.h"
+
+namespace bondperception {
+
+constexpr float kFormTolerance = 1.25f;   // bond if d <= (r_i + r_j) * 1.25
+constexpr float kBreakTolerance = 1.45f;  // existing bond kept until d > (r_i + r_j) * 1.45
+
+/** All pairs within kFormTolerance times the sum of their covalent radii, sorted by
+ *  (atom1, atom2), bond order 1. */
+QVector<MoleculeViewer::Bond> detect(const QVector<MoleculeViewer::Atom>& atoms);
+
+/** Per-frame re-detection with hysteresis: pairs in @p previous are kept up to
+ *  kBreakTolerance, new pairs form at kFormTolerance. @p grid persists across calls
+ *  and is re-binned incrementally while the atom count and cutoff stay the same. */
+QVector<MoleculeViewer::Bond> detectHysteresis(const QVector<MoleculeViewer::Atom>& atoms,
+    const QVector<MoleculeViewer::Bond>& previous, NeighborGrid& grid);
+
+} // namespace bondperception
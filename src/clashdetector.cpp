@@ -0,0 +1,159 @@
+// clashdetector.cpp - Grid-backed steric clash detection for structure editing
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "clashdetector.h"
+
+#include "elementdata.h"
+
+#include <algorithm>
+
+void ClashDetector::clear()
+{
+    m_maxRadius = 0.0f;
+    m_positions.clear();
+    m_radius.clear();
+    m_bondOffsets.clear();
+    m_bondNeighbors.clear();
+    m_rigid.clear();
+    m_marked.clear();
+    m_partners.clear();
+    m_clashing.clear();
+    m_clashSlot.clear();
+    m_grid.clear();
+}
+
+void ClashDetector::setStructure(const QVector<MoleculeViewer::Atom>& atoms,
+    const QVector<MoleculeViewer::Bond>& bonds, const QVector<int>& rigidGroup)
+{
+    clear();
+    const int n = atoms.size();
+    if (n == 0)
+        return;
+
+    m_positions.resize(n);
+    m_radius.resize(n);
+    for (int i = 0; i < n; ++i) {
+        m_positions[i] = atoms[i].position;
+        m_radius[i] = elem::vdwRadius(atoms[i].atomicNumber);
+        m_maxRadius = std::max(m_maxRadius, m_radius[i]);
+    }
+
+    // CSR exclusions: count degrees, prefix-sum into row offsets, scatter, sort rows.
+    m_bondOffsets.fill(0, n + 1);
+    for (const MoleculeViewer::Bond& b : bonds) {
+        if (b.atom1 < 0 || b.atom2 < 0 || b.atom1 >= n || b.atom2 >= n || b.atom1 == b.atom2)
+            continue;
+        ++m_bondOffsets[b.atom1 + 1];
+        ++m_bondOffsets[b.atom2 + 1];
+    }
+    for (int i = 0; i < n; ++i)
+        m_bondOffsets[i + 1] += m_bondOffsets[i];
+    m_bondNeighbors.resize(m_bondOffsets[n]);
+    QVector<int> fill(m_bondOffsets.begin(), m_bondOffsets.end() - 1);
+    for (const MoleculeViewer::Bond& b : bonds) {
+        if (b.atom1 < 0 || b.atom2 < 0 || b.atom1 >= n || b.atom2 >= n || b.atom1 == b.atom2)
+            continue;
+        m_bondNeighbors[fill[b.atom1]++] = b.atom2;
+        m_bondNeighbors[fill[b.atom2]++] = b.atom1;
+    }
+    for (int i = 0; i < n; ++i)
+        std::sort(m_bondNeighbors.begin() + m_bondOffsets[i], m_bondNeighbors.begin() + m_bondOffsets[i + 1]);
+
+    m_rigid.fill(0, n);
+    for (int i : rigidGroup)
+        if (i >= 0 && i < n)
+            m_rigid[i] = 1;
+    m_marked.fill(0, n);
+
+    m_grid.build(m_positions, 2.0f * m_maxRadius * m_factor);
+    recomputeAll();
+}
+
+bool ClashDetector::isBonded(int i, int j) const
+{
+    const auto first = m_bondNeighbors.cbegin() + m_bondOffsets[i];
+    const auto last = m_bondNeighbors.cbegin() + m_bondOffsets[i + 1];
+    return std::binary_search(first, last, j);
+}
+
+void ClashDetector::recomputeAll()
+{
+    const int n = m_positions.size();
+    m_partners.fill(0, n);
+    m_clashSlot.fill(-1, n);
+    m_clashing.clear();
+    m_grid.forEachPair(m_positions.constData(), 2.0f * m_maxRadius * m_factor,
+        [this](int i, int j, float d2) {
+            if (excluded(i, j))
+                return;
+            const float thr = threshold(i, j);
+            if (d2 < thr * thr) {
+                addCount(i, 1);
+                addCount(j, 1);
+            }
+        });
+}
+
+void ClashDetector::addCount(int atom, int delta)
+{
+    const int before = m_partners[atom];
+    m_partners[atom] += delta;
+    if (before == 0 && m_partners[atom] > 0) {
+        m_clashSlot[atom] = m_clashing.size();
+        m_clashing.append(atom);
+    } else if (before > 0 && m_partners[atom] == 0) {
+        // Swap-remove keeps the list compact in O(1).
+        const int slot = m_clashSlot[atom];
+        const int last = m_clashing.last();
+        m_clashing[slot] = last;
+        m_clashSlot[last] = slot;
+        m_clashing.removeLast();
+        m_clashSlot[atom] = -1;
+    }
+}
+
+void ClashDetector::accumulate(int atom, int sign)
+{
+    forEachClash(atom, [&](int j, const QVector3D&, float, float) {
+        if (m_marked[j] && j < atom)
+            return;  // pair already handled from j
+        addCount(atom, sign);
+        addCount(j, sign);
+    });
+}
+
+void ClashDetector::moveAtoms(const QVector<int>& moved, const QVector<MoleculeViewer::Atom>& atoms)
+{
+    const int n = m_positions.size();
+    if (n == 0 || atoms.size() != n)
+        return;
+    for (int i : moved)
+        if (i >= 0 && i < n)
+            m_marked[i] = 1;
+
+    for (int i : moved)
+        if (i >= 0 && i < n)
+            accumulate(i, -1);
+
+    bool rebuild = false;
+    for (int i : moved) {
+        if (i < 0 || i >= n)
+            continue;
+        m_positions[i] = atoms[i].position;
+        if (!rebuild && !m_grid.move(i, m_positions[i]))
+            rebuild = true;  // left the padded grid bounds
+    }
+
+    if (rebuild) {
+        m_grid.build(m_positions, 2.0f * m_maxRadius * m_factor);
+        recomputeAll();
+    } else {
+        for (int i : moved)
+            if (i >= 0 && i < n)
+                accumulate(i, +1);
+    }
+
+    for (int i : moved)
+        if (i >= 0 && i < n)
+            m_marked[i] = 0;
+}
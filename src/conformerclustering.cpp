@@ -0,0 +1,210 @@
+// conformerclustering.cpp - Pairwise-RMSD conformer clustering with lower-bound pruning
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "conformerclustering.h"
+
+#include <src/capabilities/rmsd/rmsd_functions.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+// Centred fit coordinates of one conformer plus its rotation invariants.
+struct Prepared {
+    bool valid = false;
+    Geometry geometry;
+    double rg = 0.0;           // radius of gyration
+    double axes[3] = { 0.0 };  // sqrt of the gyration-tensor eigenvalues, ascending
+};
+
+Prepared prepare(const QVector<MoleculeViewer::Atom>& atoms, bool includeH)
+{
+    Prepared p;
+    int n = 0;
+    for (const MoleculeViewer::Atom& a : atoms)
+        if (includeH || a.atomicNumber != 1)
+            ++n;
+    if (n == 0)
+        return p;
+    p.geometry = Geometry(n, 3);
+    int k = 0;
+    for (const MoleculeViewer::Atom& a : atoms) {
+        if (!includeH && a.atomicNumber == 1)
+            continue;
+        p.geometry(k, 0) = a.position.x();
+        p.geometry(k, 1) = a.position.y();
+        p.geometry(k, 2) = a.position.z();
+        ++k;
+    }
+    const Eigen::RowVector3d centroid = p.geometry.colwise().mean();
+    p.geometry.rowwise() -= centroid;
+
+    const Eigen::Matrix3d gyration = p.geometry.transpose() * p.geometry / double(n);
+    const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eig(gyration, Eigen::EigenvaluesOnly);
+    for (int a = 0; a < 3; ++a)
+        p.axes[a] = std::sqrt(std::max(0.0, eig.eigenvalues()(a)));
+    p.rg = std::sqrt(std::max(0.0, gyration.trace()));
+    p.valid = true;
+    return p;
+}
+
+inline qint64 triangleIndex(int i, int j, int n)  // i < j
+{
+    return qint64(i) * (2 * qint64(n) - i - 1) / 2 + (j - i - 1);
+}
+}
+
+float ConformerClustering::Result::value(int i, int j) const
+{
+    if (i == j)
+        return 0.0f;
+    if (i > j)
+        std::swap(i, j);
+    return matrix[triangleIndex(i, j, conformerCount)];
+}
+
+ConformerClustering::Result ConformerClustering::run(
+    const QVector<QVector<MoleculeViewer::Atom>>& conformers, const Options& options,
+    const QAtomicInt* cancel, const std::function<void(qint64, qint64)>& progress)
+{
+    Result result;
+    const int n = conformers.size();
+    result.conformerCount = n;
+    if (n == 0)
+        return result;
+
+    // Same atoms in the same order as conformer 0, otherwise the conformer is left out.
+    QVector<Prepared> prepared(n);
+    const QVector<MoleculeViewer::Atom>& first = conformers[0];
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < n; ++c) {
+        const QVector<MoleculeViewer::Atom>& atoms = conformers[c];
+        bool same = atoms.size() == first.size();
+        for (int i = 0; same && i < atoms.size(); ++i)
+            same = atoms[i].atomicNumber == first[i].atomicNumber;
+        if (same)
+            prepared[c] = prepare(atoms, options.includeHydrogens);
+    }
+
+    // --- pair matrix, tile by tile ---
+    const qint64 total = qint64(n) * (n - 1) / 2;
+    result.matrix.fill(std::numeric_limits<float>::infinity(), total);
+    float* matrix = result.matrix.data();
+    const int tileCount = (n + kTile - 1) / kTile;
+    QVector<QPair<int, int>> tiles;
+    tiles.reserve(tileCount * (tileCount + 1) / 2);
+    for (int ti = 0; ti < tileCount; ++ti)
+        for (int tj = ti; tj < tileCount; ++tj)
+            tiles.append({ ti, tj });
+
+    const double threshold = options.threshold;
+    std::atomic<qint64> done{ 0 };
+    std::atomic<qint64> pairs{ 0 };
+    std::atomic<qint64> pruned{ 0 };
+#pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < tiles.size(); ++t) {
+        if (cancel && cancel->loadRelaxed())
+            continue;  // an OpenMP loop cannot break; drain the remaining tiles
+        const int i0 = tiles[t].first * kTile;
+        const int j0 = tiles[t].second * kTile;
+        const int i1 = std::min(n, i0 + kTile);
+        const int j1 = std::min(n, j0 + kTile);
+        qint64 tilePairs = 0;
+        qint64 tileEvaluated = 0;
+        qint64 tilePruned = 0;
+        for (int i = i0; i < i1; ++i) {
+            const Prepared& a = prepared[i];
+            for (int j = std::max(j0, i + 1); j < j1; ++j) {
+                ++tilePairs;
+                const Prepared& b = prepared[j];
+                if (!a.valid || !b.valid)
+                    continue;  // stays +inf
+                ++tileEvaluated;
+                float& out = matrix[triangleIndex(i, j, n)];
+                const double rgBound = std::abs(a.rg - b.rg);
+                if (rgBound >= threshold) {
+                    out = float(rgBound);
+                    ++tilePruned;
+                    continue;
+                }
+                double axesBound = 0.0;
+                for (int k = 0; k < 3; ++k)
+                    axesBound += (a.axes[k] - b.axes[k]) * (a.axes[k] - b.axes[k]);
+                axesBound = std::sqrt(axesBound);
+                if (axesBound >= threshold) {
+                    out = float(axesBound);
+                    ++tilePruned;
+                    continue;
+                }
+                const Eigen::Matrix3d R = RMSDFunctions::BestFitRotation(a.geometry, b.geometry);
+                const Geometry aligned = RMSDFunctions::applyRotation(b.geometry, R);
+                out = float(RMSDFunctions::getRMSD(a.geometry, aligned));
+            }
+        }
+        pairs += tileEvaluated;
+        pruned += tilePruned;
+        const qint64 now = done += tilePairs;
+        if (progress)
+            progress(now, total);
+    }
+    result.pairs = pairs;
+    result.pruned = pruned;
+    if (cancel && cancel->loadRelaxed()) {
+        result.cancelled = true;
+        return result;
+    }
+
+    // --- GROMOS clustering on the neighbour graph (RMSD < threshold) ---
+    QVector<int> degree(n, 0);
+    for (int i = 0; i < n; ++i)
+        for (int j = i + 1; j < n; ++j)
+            if (matrix[triangleIndex(i, j, n)] < threshold) {
+                ++degree[i];
+                ++degree[j];
+            }
+    QVector<int> offsets(n + 1, 0);
+    for (int i = 0; i < n; ++i)
+        offsets[i + 1] = offsets[i] + degree[i];
+    QVector<int> neighbours(offsets[n]);
+    QVector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < n; ++i)
+        for (int j = i + 1; j < n; ++j)
+            if (matrix[triangleIndex(i, j, n)] < threshold) {
+                neighbours[fill[i]++] = j;
+                neighbours[fill[j]++] = i;
+            }
+
+    result.assignment.fill(-1, n);
+    QVector<int> open = degree;  // unclustered neighbours per conformer
+    int remaining = 0;
+    for (int i = 0; i < n; ++i)
+        if (prepared[i].valid)
+            ++remaining;
+    QVector<int> members;
+    while (remaining > 0) {
+        int centre = -1;
+        for (int i = 0; i < n; ++i)  // ties: lowest index (CREST ensembles are energy-sorted)
+            if (prepared[i].valid && result.assignment[i] < 0 && (centre < 0 || open[i] > open[centre]))
+                centre = i;
+        const int cluster = result.representatives.size();
+        members.clear();
+        members.append(centre);
+        for (int k = offsets[centre]; k < offsets[centre + 1]; ++k)
+            if (result.assignment[neighbours[k]] < 0)
+                members.append(neighbours[k]);
+        for (int m : members)
+            result.assignment[m] = cluster;
+        for (int m : members)
+            for (int k = offsets[m]; k < offsets[m + 1]; ++k)
+                --open[neighbours[k]];
+        result.representatives.append(centre);
+        result.clusterSizes.append(members.size());
+        remaining -= members.size();
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+// conformerclustering.h - Pairwise-RMSD conformer clustering with lower-bound pruning
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - clustering mode of the RMSD workspace (RMSDWidget).
+//
+// Conformers (same atoms in the same order, e.g. a CREST ensemble or MD snapshots) are
+// compared by best-fit RMSD in the given atom order, as the plain RMSD column does. The
+// upper triangle of the pair matrix is evaluated in square tiles distributed over OpenMP
+// threads. Most pairs of a diverse ensemble never reach the Kabsch fit: best-fit RMSD
+// is translation- and rotation-free, and two invariants of each centred conformer bound
+// it from below at O(1) per pair:
+//
+//   RMSD >= |Rg_a - Rg_b|                          (radius of gyration, triangle inequality)
+//   RMSD >= sqrt(sum_k (sqrt(l_k^a) - sqrt(l_k^b))^2)   (sorted gyration-tensor
+//                                                   eigenvalues l_k, von Neumann trace bound)
+//
+// A pair whose bound already reaches the threshold is stored with that bound instead of
+// its RMSD. Clusters are then formed GROMOS-style (Daura et al.): the conformer with the
+// most unclustered neighbours within the threshold becomes a representative and takes
+// those neighbours, until every conformer is assigned.
+
+#pragma once
+
+#include "view.h"
+
+#include <QAtomicInt>
+#include <QVector>
+
+#include <functional>
+
+class ConformerClustering
+{
+public:
+    static constexpr int kTile = 32;  // conformers per tile edge
+
+    struct Options {
+        double threshold = 0.5;        // Angstrom
+        bool includeHydrogens = true;
+    };
+
+    struct Result {
+        int conformerCount = 0;
+        QVector<float> matrix;          // upper triangle (i < j); pruned pairs hold their bound
+        QVector<int> assignment;        // cluster per conformer; -1: topology differs from #0
+        QVector<int> representatives;   // one conformer per cluster, largest cluster first
+        QVector<int> clusterSizes;
+        qint64 pairs = 0;
+        qint64 pruned = 0;              // pairs decided by a lower bound alone
+        bool cancelled = false;
+
+        /// RMSD (or, for pruned pairs, its lower bound) between conformers @p i != @p j.
+        float value(int i, int j) const;
+    };
+
+    /** Cluster @p conformers. Blocking (call off the GUI thread); @p cancel is polled per
+     *  tile, @p progress (pairs done, pairs total) is called from the worker threads. */
+    static Result run(const QVector<QVector<MoleculeViewer::Atom>>& conformers,
+        const Options& options, const QAtomicInt* cancel = nullptr,
+        const std::function<void(qint64, qint64)>& progress = {});
+};
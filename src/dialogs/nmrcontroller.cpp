@@ -5,6 +5,7 @@
 #include <QFileInfo>
 #include <QTextStream>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 NMRController::NMRController(NMRDataStore* dataStore, QObject* parent)
@@ -53,6 +54,26 @@ void NMRController::loadStructure(const QString& filename, const QString& name)
     }
 }
 
+void NMRController::loadStructures(const std::vector<std::pair<QString, QString>>& files)
+{
+    NMR_CONTROLLER_LOG("Loading " << files.size() << " structures");
+
+    const int first = m_dataStore->getStructureCount();
+    const QStringList failed = m_dataStore->addStructures(files);
+
+    // Sortiere Konformere einmal pro Verbindung statt einmal pro Datei
+    std::set<QString> formulas;
+    for (int i = first; i < m_dataStore->getStructureCount(); ++i)
+        formulas.insert(m_dataStore->getStructure(i)->formula);
+    for (const QString& formula : formulas)
+        sortCompoundConformers(formula);
+
+    if (!failed.isEmpty()) {
+        NMR_CONTROLLER_LOG("Failed to load " << failed.size() << " structures");
+        emit spectrumGenerationFailed(tr("Fehler beim Laden der Struktur: %1").arg(failed.join(QLatin1Char('\n'))));
+    }
+}
+
 void NMRController::removeStructure(int index)
 {
     NMR_CONTROLLER_LOG("Removing structure with index: " << index);
@@ -63,6 +84,7 @@ void NMRController::clearAllStructures()
 {
     NMR_CONTROLLER_LOG("Clearing all structures");
     m_dataStore->clearAllStructures();
+    m_spectrumEngine.clear();
     emit allStructuresCleared();
 }
 
@@ -144,6 +166,37 @@ bool NMRController::generateSpectrum(int plotPoints, double lineWidth)
     // Berechne den Spektrumsbereich
     m_spectrumRange = calculateSpectrumRange(m_compoundElementShifts);
 
+    // Linienspektren: ein Beitrag je sichtbarer Struktur und Element. Unveränderte
+    // Beiträge werden wiederverwendet, nur neue werden berechnet.
+    NMRSpectrumEngine::Settings settings;
+    settings.xMin = m_spectrumRange.first;
+    settings.xMax = m_spectrumRange.second;
+    settings.points = std::max(plotPoints, 2);
+    settings.lineWidth = lineWidth;
+    settings.shape = m_lineShape;
+    settings.eta = m_voigtEta;
+    m_spectrumEngine.setSettings(settings);
+
+    m_spectrumEngine.beginUpdate();
+    for (const auto& structure : m_dataStore->getAllStructures()) {
+        if (!structure.visible)
+            continue;
+        for (const auto& [element, nuclei] : structure.nuclei) {
+            if (!m_dataStore->isElementVisible(element))
+                continue;
+            std::vector<double> shifts;
+            shifts.reserve(nuclei.size());
+            for (const auto& nucleus : nuclei) {
+                if (nucleus.visible)
+                    shifts.push_back(nucleus.shift);
+            }
+            m_spectrumEngine.addContribution({ structure.formula, element }, std::move(shifts));
+        }
+    }
+    m_spectrumEngine.endUpdate();
+    NMR_CONTROLLER_LOG("Line spectra: " << m_spectrumEngine.renderedPartials() << " contributions computed, "
+                                        << m_spectrumEngine.reusedPartials() << " reused");
+
     NMR_CONTROLLER_LOG("Spectrum generation successful");
     emit spectrumGenerated();
     return true;
@@ -154,6 +207,13 @@ std::pair<double, double> NMRController::getSpectrumRange() const
     return m_spectrumRange;
 }
 
+void NMRController::setLineShape(NMRSpectrumEngine::LineShape shape, double eta)
+{
+    NMR_CONTROLLER_LOG("Setting line shape to " << int(shape) << " (eta " << eta << ")");
+    m_lineShape = shape;
+    m_voigtEta = eta;
+}
+
 bool NMRController::exportData(const QString& filename)
 {
     NMR_CONTROLLER_LOG("Exporting data to file: " << filename);
@@ -226,6 +286,9 @@ std::pair<double, double> NMRController::calculateSpectrumRange(
         }
     }
 
-    // Add padding to range
-    return { xMin - padding, xMax + padding };
+    // Add padding to range, snapped outwards to multiples of the padding: toggling a
+    // nucleus near the edge then keeps the sampling grid, and with it the cached line spectra
+    if (padding <= 0.0)
+        return { xMin, xMax };
+    return { std::floor((xMin - padding) / padding) * padding, std::ceil((xMax + padding) / padding) * padding };
 }
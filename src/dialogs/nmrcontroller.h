@@ -2,11 +2,15 @@
 #ifndef NMRCONTROLLER_H
 #define NMRCONTROLLER_H
 
+#include "nmrspectrumengine.h"
+
 #include <QObject>
 #include <QString>
 #include <QStringList>
 #include <map>
 #include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 
 class NMRDataStore;
@@ -31,6 +35,8 @@ public:
 
     // Struktur-Management
     void loadStructure(const QString& filename, const QString& name);
+    // Claude Generated 2026 - batch form, files are parsed in parallel
+    void loadStructures(const std::vector<std::pair<QString, QString>>& files);
     void removeStructure(int index);
     void clearAllStructures();
     void setReference(int index);
@@ -47,6 +53,10 @@ public:
     // Spektrum-Generierung
     bool generateSpectrum(int plotPoints, double lineWidth);
     std::pair<double, double> getSpectrumRange() const;
+    // Claude Generated 2026 - line shape of the next generateSpectrum(); the summed,
+    // unscaled curves per (compound, element) are read from spectrumEngine()
+    void setLineShape(NMRSpectrumEngine::LineShape shape, double eta = 0.5);
+    const NMRSpectrumEngine& spectrumEngine() const { return m_spectrumEngine; }
 
     // Datenexport
     bool exportData(const QString& filename);
@@ -83,6 +93,9 @@ private:
     std::map<QString, std::map<QString, std::vector<double>>> m_compoundElementShifts;
     std::map<QString, double> m_compoundScaleFactors;
     std::pair<double, double> m_spectrumRange;
+    NMRSpectrumEngine m_spectrumEngine;
+    NMRSpectrumEngine::LineShape m_lineShape = NMRSpectrumEngine::LineShape::Gaussian;
+    double m_voigtEta = 0.5;
 
     // Hilfsmethoden
     static std::pair<double, double> calculateSpectrumRange(
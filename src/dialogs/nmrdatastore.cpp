@@ -1,15 +1,14 @@
 // nmrdatastore.cpp
 #include "nmrdatastore.h"
-#include <QFile>
-#include <QFileInfo>
-#include <QRegularExpression>
-#include <QTextStream>
+#include "orcanmrreader.h"
+#include <QThreadPool>
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
 NMRDataStore::NMRDataStore(QObject* parent)
     : QObject(parent)
+    , m_loadPool(new QThreadPool(this))
 {
     NMR_DATASTORE_LOG("DataStore created");
 }
@@ -20,37 +19,74 @@ int NMRDataStore::addStructure(const QString& filename, const QString& name)
 
     try {
         // Parse file and create structure
-        auto structure = parseOrcaOutput(filename, name);
+        int index = insertStructure(parseOrcaOutput(filename, name));
 
-        // Calculate formula
-        structure.formula = deriveFormula(structure);
+        emit dataChanged();
 
-        // Add to structures vector
-        m_structures.push_back(std::move(structure));
-        int index = m_structures.size() - 1;
+        return index;
+    } catch (const std::exception& e) {
+        NMR_DATASTORE_LOG("Error adding structure: " << e.what());
+        throw;
+    }
+}
 
-        // Check if this should be set as reference (TMS or first structure)
-        if (isTMS(m_structures[index]) || m_structures.size() == 1) {
-            setReference(index);
-        }
+QStringList NMRDataStore::addStructures(const std::vector<std::pair<QString, QString>>& files)
+{
+    NMR_DATASTORE_LOG("Adding " << files.size() << " structures");
 
-        // Set default visibility
-        for (auto& [element, nuclei] : m_structures[index].nuclei) {
-            for (auto& nucleus : nuclei) {
-                // Default: H is visible, others are not
-                nucleus.visible = (element == "H");
+    // Parse on the pool, one task per file; each task writes only its own slot.
+    std::vector<NMRStructure> parsed(files.size());
+    std::vector<QString> errors(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        m_loadPool->start([&files, &parsed, &errors, i] {
+            try {
+                parsed[i] = parseOrcaOutput(files[i].first, files[i].second);
+            } catch (const std::exception& e) {
+                errors[i] = QString::fromUtf8(e.what());
             }
-        }
+        });
+    }
+    m_loadPool->waitForDone();
 
-        // Emit signal
-        emit structureAdded(index);
+    // Merge in input order, so indices and the default reference match addStructure().
+    QStringList failed;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!errors[i].isEmpty()) {
+            NMR_DATASTORE_LOG("Error adding structure: " << files[i].first << errors[i]);
+            failed.append(QStringLiteral("%1: %2").arg(files[i].first, errors[i]));
+            continue;
+        }
+        insertStructure(std::move(parsed[i]));
+    }
+    if (failed.size() < static_cast<int>(files.size()))
         emit dataChanged();
+    return failed;
+}
 
-        return index;
-    } catch (const std::exception& e) {
-        NMR_DATASTORE_LOG("Error adding structure: " << e.what());
-        throw;
+int NMRDataStore::insertStructure(NMRStructure&& structure)
+{
+    // Calculate formula
+    structure.formula = deriveFormula(structure);
+
+    // Add to structures vector
+    m_structures.push_back(std::move(structure));
+    int index = m_structures.size() - 1;
+
+    // Check if this should be set as reference (TMS or first structure)
+    if (isTMS(m_structures[index]) || m_structures.size() == 1) {
+        setReference(index);
+    }
+
+    // Set default visibility
+    for (auto& [element, nuclei] : m_structures[index].nuclei) {
+        for (auto& nucleus : nuclei) {
+            // Default: H is visible, others are not
+            nucleus.visible = (element == "H");
+        }
     }
+
+    emit structureAdded(index);
+    return index;
 }
 
 void NMRDataStore::removeStructure(int index)
@@ -648,75 +684,31 @@ bool NMRDataStore::isConformation(const NMRStructure& str1, const NMRStructure&
     return true;
 }
 
-NMRDataStore::NMRStructure NMRDataStore::parseOrcaOutput(const QString& filename, const QString& name) const
+NMRDataStore::NMRStructure NMRDataStore::parseOrcaOutput(const QString& filename, const QString& name)
 {
     NMR_DATASTORE_LOG("Parsing ORCA output file: " << filename);
 
+    const OrcaNMRReader::Result result = OrcaNMRReader::read(filename);
+    if (!result.ok) {
+        NMR_DATASTORE_LOG("Failed to parse " << filename << ": " << result.error);
+        throw std::runtime_error(result.error.toStdString());
+    }
+
     NMRStructure structure;
     structure.name = name;
     structure.filename = filename;
     structure.isReference = false;
+    structure.energy = result.energy;
 
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        NMR_DATASTORE_LOG("Failed to open file: " << filename);
-        throw std::runtime_error("Datei konnte nicht geöffnet werden");
-    }
-
-    QTextStream in(&file);
-    QString content = in.readAll();
-
-    // Extract energy
-    structure.energy = extractEnergy(content);
-    NMR_DATASTORE_LOG("Extracted energy: " << structure.energy);
-
-    // Parse NMR shieldings
-    parseNMRShieldings(content, structure);
-
-    NMR_DATASTORE_LOG("Parsing completed successfully");
-    return structure;
-}
-
-void NMRDataStore::parseNMRShieldings(const QString& content, NMRStructure& structure) const
-{
-    QRegularExpression rx("(\\d+)\\s+([A-Za-z]+)\\s+([-]?\\d+\\.\\d+)\\s+([-]?\\d+\\.\\d+)");
-    QRegularExpression headerRx("CHEMICAL SHIELDING SUMMARY \\(ppm\\)");
-
-    auto headerMatch = headerRx.match(content);
-    if (!headerMatch.hasMatch()) {
-        NMR_DATASTORE_LOG("Failed to find NMR shielding data in file");
-        throw std::runtime_error("NMR Daten nicht gefunden");
-    }
-
-    auto matches = rx.globalMatch(content, headerMatch.capturedEnd());
-    while (matches.hasNext()) {
-        auto match = matches.next();
-
-        int nucleusIndex = match.captured(1).toInt();
-        QString element = match.captured(2);
-        double shielding = match.captured(3).toDouble();
-        double anisotropy = match.captured(4).toDouble();
-
+    for (const auto& shielding : result.shieldings) {
         NucleusData nucleus;
-        nucleus.index = nucleusIndex;
-        nucleus.shielding = shielding;
-        nucleus.anisotropy = anisotropy;
-
-        structure.nuclei[element].push_back(nucleus);
-        NMR_DATASTORE_LOG("Added shielding: " << element << "_" << nucleusIndex << " = " << shielding);
+        nucleus.index = shielding.index;
+        nucleus.shielding = shielding.isotropic;
+        nucleus.anisotropy = shielding.anisotropy;
+        structure.nuclei[shielding.element].push_back(nucleus);
     }
 
-    NMR_DATASTORE_LOG("Found " << structure.nuclei.size() << " elements with shieldings");
-}
-
-double NMRDataStore::extractEnergy(const QString& content) const
-{
-    QRegularExpression rx("FINAL SINGLE POINT ENERGY\\s+(-?\\d+\\.\\d+)");
-    auto match = rx.match(content);
-    if (match.hasMatch()) {
-        return match.captured(1).toDouble();
-    }
-
-    NMR_DATASTORE_LOG("Failed to extract energy from file");
-    throw std::runtime_error("Energie nicht gefunden");
+    NMR_DATASTORE_LOG("Parsed " << result.shieldings.size() << " shieldings in "
+                                << structure.nuclei.size() << " elements, energy " << structure.energy);
+    return structure;
 }
@@ -9,8 +9,11 @@
 #include <map>
 #include <memory>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+class QThreadPool;
+
 // Debug-Makros zur einfachen Fehlersuche
 #ifndef NMR_DEBUG
 #define NMR_DEBUG 1
@@ -64,6 +67,9 @@ public:
 
     // Struktur-Management
     int addStructure(const QString& filename, const QString& name);
+    // Claude Generated 2026 - parses all (filename, name) pairs in parallel and appends them
+    // in the given order; returns "filename: error" for every file that could not be added.
+    QStringList addStructures(const std::vector<std::pair<QString, QString>>& files);
     void removeStructure(int index);
     void setReference(int index);
     void setStructureVisible(int index, bool visible);
@@ -117,10 +123,12 @@ private:
     const double m_kBoltzmann = 0.001987204258; // kcal/(mol·K)
     const double m_temperature = 298.15; // K
 
+    QThreadPool* m_loadPool = nullptr;
+
     // Private Hilfsmethoden
-    NMRStructure parseOrcaOutput(const QString& filename, const QString& name) const;
-    void parseNMRShieldings(const QString& content, NMRStructure& structure) const;
-    double extractEnergy(const QString& content) const;
+    // Reentrant: runs on the load pool's worker threads (OrcaNMRReader).
+    static NMRStructure parseOrcaOutput(const QString& filename, const QString& name);
+    int insertStructure(NMRStructure&& structure);
 };
 
 #endif // NMRDATASTORE_H
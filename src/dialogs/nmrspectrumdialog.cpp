@@ -120,6 +120,14 @@ void NMRSpectrumDialog::setupUI()
     configLayout->addWidget(new QLabel(tr("Linienbreite: "), this));
     configLayout->addWidget(m_lineWidthBox);
 
+    // Line shape (Claude Generated 2026)
+    m_lineShapeBox = new QComboBox(this);
+    m_lineShapeBox->addItem(tr("Gauß"), int(NMRSpectrumEngine::LineShape::Gaussian));
+    m_lineShapeBox->addItem(tr("Lorentz"), int(NMRSpectrumEngine::LineShape::Lorentzian));
+    m_lineShapeBox->addItem(tr("Pseudo-Voigt"), int(NMRSpectrumEngine::LineShape::PseudoVoigt));
+    configLayout->addWidget(new QLabel(tr("Linienform: "), this));
+    configLayout->addWidget(m_lineShapeBox);
+
     // Buttons
     auto actionButtonLayout = new QHBoxLayout();
     m_generateButton = new QPushButton(tr("Spektrum generieren"), this);
@@ -141,7 +149,7 @@ void NMRSpectrumDialog::setupUI()
 
     m_updateTimer = new QTimer(this);
     m_updateTimer->setSingleShot(true);
-    m_updateTimer->setInterval(500); // 500 ms delay
+    m_updateTimer->setInterval(100); // coalesces bursts of toggles; redraws are incremental
 
     NMR_DIALOG_LOG("UI setup completed");
 }
@@ -161,6 +169,7 @@ void NMRSpectrumDialog::connectSignals()
     // Configuration changes
     connect(m_maxPoints, QOverload<int>::of(&QSpinBox::valueChanged), this, &NMRSpectrumDialog::setPlotPoints);
     connect(m_lineWidthBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &NMRSpectrumDialog::setLineWidth);
+    connect(m_lineShapeBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &NMRSpectrumDialog::setLineShape);
 
     // TreeView selection
     connect(m_structureView->selectionModel(), &QItemSelectionModel::selectionChanged,
@@ -317,6 +326,18 @@ void NMRSpectrumDialog::setLineWidth(double width)
     NMR_DIALOG_LOG("Line width set to " << width);
 }
 
+/**
+ * Sets the line shape and schedules a redraw
+ * @param comboIndex Index in the line shape box
+ */
+void NMRSpectrumDialog::setLineShape(int comboIndex)
+{
+    const auto shape = NMRSpectrumEngine::LineShape(m_lineShapeBox->itemData(comboIndex).toInt());
+    m_controller->setLineShape(shape);
+    NMR_DIALOG_LOG("Line shape set to " << m_lineShapeBox->itemText(comboIndex));
+    m_updateTimer->start();
+}
+
 /**
  * Sets up the table for displaying chemical shifts
  */
@@ -341,6 +362,13 @@ void NMRSpectrumDialog::addStructure(const QString& filename, const QString& nam
     NMR_DIALOG_LOG("Added structure: " << name);
 }
 
+void NMRSpectrumDialog::addStructures(const std::vector<std::pair<QString, QString>>& files)
+{
+    m_controller->loadStructures(files);
+    updateElementFilters();
+    NMR_DIALOG_LOG("Added " << files.size() << " structures");
+}
+
 /**
  * Selects structure files when the add structure button is clicked
  */
@@ -352,12 +380,14 @@ void NMRSpectrumDialog::selectStructureFiles()
         QString(),
         tr("ORCA Output (*.out);;Alle Dateien (*)"));
 
+    std::vector<std::pair<QString, QString>> files;
+    files.reserve(filenames.size());
     for (const QString& filename : filenames) {
-        m_controller->loadStructure(filename, QFileInfo(filename).fileName());
+        files.emplace_back(filename, QFileInfo(filename).fileName());
     }
 
-    // Update element filters after adding structures
-    updateElementFilters();
+    // Parses in parallel and updates the element filters afterwards
+    addStructures(files);
 }
 
 /**
@@ -429,9 +459,6 @@ void NMRSpectrumDialog::updatePlot()
     auto compoundElementShifts = m_dataStore->getCompoundElementShifts();
     auto compoundScaleFactors = m_dataStore->getCompoundScaleFactors();
 
-    // Calculate spectrum range
-    auto [xMin, xMax] = m_controller->getSpectrumRange();
-
     // Static color map for elements
     static const QMap<QString, QColor> elementColors{
         { "H", QColor(255, 0, 0) },
@@ -454,15 +481,9 @@ void NMRSpectrumDialog::updatePlot()
         }
     }
 
-    // Pre-calculate x-values for performance
-    std::vector<double> xValues(m_plotPoints);
-    const double xStep = (xMax - xMin) / (m_plotPoints - 1);
-    for (int i = 0; i < m_plotPoints; ++i) {
-        xValues[i] = xMin + i * xStep;
-    }
-
-    // Precompute gaussian function parameters
-    const double lineWidth2 = 2 * std::pow(m_lineWidth, 2);
+    // Summed line shapes per compound/element (Claude Generated 2026 - NMRSpectrumEngine)
+    const NMRSpectrumEngine& engine = m_controller->spectrumEngine();
+    const int points = engine.settings().points;
 
     // Generate series for each compound and element
     int seriesIndex = 0;
@@ -484,24 +505,17 @@ void NMRSpectrumDialog::updatePlot()
             QString seriesName = QString("%1_%2").arg(compound).arg(element);
 
             // Create continuous spectrum series
-            QVector<QPointF> points(m_plotPoints);
-            for (int i = 0; i < m_plotPoints; ++i) {
-                points[i] = QPointF(xValues[i], 0.0);
-            }
-
-            // Add all peaks
-            for (double shift : shifts) {
-                for (int i = 0; i < m_plotPoints; ++i) {
-                    double x = xValues[i];
-                    points[i].setY(points[i].y() + scaleFactor * std::exp(-std::pow(x - shift, 2) / lineWidth2));
-                }
+            const std::vector<double>* curve = engine.curve({ compound, element });
+            QVector<QPointF> spectrum(curve ? points : 0);
+            for (int i = 0; i < spectrum.size(); ++i) {
+                spectrum[i] = QPointF(engine.x(i), scaleFactor * (*curve)[i]);
             }
 
             // Create and add series
             auto lineSeries = new QLineSeries();
             lineSeries->setName(seriesName);
             lineSeries->setColor(blendedColor);
-            lineSeries->replace(points);
+            lineSeries->replace(spectrum);
 
             m_chart->addSeries(lineSeries, seriesIndex, blendedColor, seriesName, false);
 
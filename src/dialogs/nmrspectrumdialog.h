@@ -6,6 +6,8 @@
 #include <QModelIndex>
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 // Debug-Makros zur einfachen Fehlersuche
 #ifndef NMR_DEBUG
@@ -54,6 +56,8 @@ public:
      * @param name The name of the structure
      */
     void addStructure(const QString& filename, const QString& name);
+    // Claude Generated 2026 - (filename, name) pairs, parsed in parallel
+    void addStructures(const std::vector<std::pair<QString, QString>>& files);
 private slots:
     /**
      * Selects structure files to add
@@ -80,6 +84,11 @@ private slots:
      */
     void setLineWidth(double width);
 
+    /**
+     * Sets the line shape (Gauß, Lorentz, Pseudo-Voigt)
+     */
+    void setLineShape(int comboIndex);
+
     /**
      * Generates the NMR spectrum
      */
@@ -124,6 +133,7 @@ private:
     QTableWidget* m_shiftTable = nullptr;
     QSpinBox* m_maxPoints = nullptr;
     QDoubleSpinBox* m_lineWidthBox = nullptr;
+    QComboBox* m_lineShapeBox = nullptr;
     QPushButton* m_generateButton = nullptr;
     QPushButton* m_exportButton = nullptr;
     QPushButton* m_clearButton = nullptr;
@@ -0,0 +1,234 @@
+// nmrspectrumengine.cpp - Windowed, incremental synthesis of NMR line spectra
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026
+#include "nmrspectrumengine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace {
+// Incremental add/subtract accumulates rounding; the sum is rebuilt from its partials
+// after this many updates.
+constexpr int kRebuildAfter = 64;
+
+// e^x for x <= 0 in float, branch-free so `omp simd` vectorises it (std::exp does not
+// without a vector math library). Cephes expf: x = n ln2 + r, |r| <= ln2/2, degree-6
+// polynomial for e^r, 2^n through the exponent bits. Relative error ~2e-7.
+inline float fastExp(float x)
+{
+    x = std::max(x, -87.0f);   // keeps 2^n normal; peaks are cut far above this
+    constexpr float kRound = 12582912.0f;   // 1.5 * 2^23: adding it rounds to integer
+    const float n = (x * 1.44269504088896341f + kRound) - kRound;
+    const float r = x - n * 0.693359375f + n * 2.12194440e-4f;
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * r * r + r + 1.0f;
+    const std::int32_t bits = (std::int32_t(n) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// out[j] += shape(d0 + j * step) for one peak; d is the distance to the peak in ppm.
+void addGaussian(float* out, int n, float d0, float step, float a)
+{
+#pragma omp simd
+    for (int j = 0; j < n; ++j) {
+        const float d = d0 + float(j) * step;
+        out[j] += fastExp(-d * d * a);
+    }
+}
+
+void addLorentzian(float* out, int n, float d0, float step, float b)
+{
+#pragma omp simd
+    for (int j = 0; j < n; ++j) {
+        const float d = d0 + float(j) * step;
+        out[j] += 1.0f / (1.0f + d * d * b);
+    }
+}
+
+void addPseudoVoigt(float* out, int n, float d0, float step, float a, float b, float eta)
+{
+    const float gauss = 1.0f - eta;
+#pragma omp simd
+    for (int j = 0; j < n; ++j) {
+        const float d = d0 + float(j) * step;
+        const float d2 = d * d;
+        out[j] += eta / (1.0f + d2 * b) + gauss * fastExp(-d2 * a);
+    }
+}
+}
+
+void NMRSpectrumEngine::setSettings(const Settings& settings)
+{
+    if (settings == m_settings)
+        return;
+    clear();
+    m_settings = settings;
+    m_step = settings.points > 1 ? (settings.xMax - settings.xMin) / (settings.points - 1) : 0.0;
+}
+
+void NMRSpectrumEngine::clear()
+{
+    m_partials.clear();
+    m_series.clear();
+    m_pending.clear();
+}
+
+void NMRSpectrumEngine::beginUpdate()
+{
+    m_pending.clear();
+    m_rendered = 0;
+    m_reused = 0;
+}
+
+void NMRSpectrumEngine::addContribution(const SeriesKey& series, std::vector<double> shifts)
+{
+    if (shifts.empty() || m_settings.points < 2)
+        return;
+    auto it = m_partials.find(shifts);
+    if (it == m_partials.end()) {
+        Partial partial = render(shifts);
+        it = m_partials.emplace(std::move(shifts), std::move(partial)).first;
+        ++m_rendered;
+    } else {
+        ++m_reused;
+    }
+    m_pending[series].push_back(&it->second);
+}
+
+void NMRSpectrumEngine::endUpdate()
+{
+    std::vector<const Partial*> removed, added;
+    for (auto& [key, members] : m_pending) {
+        std::sort(members.begin(), members.end());
+        Series& series = m_series[key];
+        if (series.sum.size() != size_t(m_settings.points)) {
+            series.sum.assign(m_settings.points, 0.0);
+            series.members.clear();
+            series.updates = 0;
+        }
+
+        // Multiset difference: identical partials may be members more than once.
+        removed.clear();
+        added.clear();
+        std::set_difference(series.members.begin(), series.members.end(),
+            members.begin(), members.end(), std::back_inserter(removed));
+        std::set_difference(members.begin(), members.end(),
+            series.members.begin(), series.members.end(), std::back_inserter(added));
+
+        const int changes = int(removed.size() + added.size());
+        if (changes > int(members.size()) || series.updates + changes > kRebuildAfter) {
+            std::fill(series.sum.begin(), series.sum.end(), 0.0);
+            for (const Partial* partial : members)
+                accumulate(series.sum, *partial, 1.0);
+            series.updates = 0;
+        } else {
+            for (const Partial* partial : removed)
+                accumulate(series.sum, *partial, -1.0);
+            for (const Partial* partial : added)
+                accumulate(series.sum, *partial, 1.0);
+            series.updates += changes;
+        }
+        series.members = members;
+    }
+
+    // Drop series that lost all contributions, then partials no series refers to.
+    for (auto it = m_series.begin(); it != m_series.end();)
+        it = m_pending.count(it->first) ? std::next(it) : m_series.erase(it);
+    std::vector<const Partial*> used;
+    for (const auto& [key, series] : m_series)
+        used.insert(used.end(), series.members.begin(), series.members.end());
+    std::sort(used.begin(), used.end());
+    for (auto it = m_partials.begin(); it != m_partials.end();)
+        it = std::binary_search(used.begin(), used.end(), &it->second) ? std::next(it) : m_partials.erase(it);
+    m_pending.clear();
+}
+
+const std::vector<double>* NMRSpectrumEngine::curve(const SeriesKey& series) const
+{
+    auto it = m_series.find(series);
+    return it == m_series.end() ? nullptr : &it->second.sum;
+}
+
+NMRSpectrumEngine::Partial NMRSpectrumEngine::render(const std::vector<double>& shifts) const
+{
+    const double w = m_settings.lineWidth;
+    const double eta = std::clamp(m_settings.eta, 0.0, 1.0);
+    // Gaussian exp(-d²/2w²); Lorentzian 1/(1 + d²/g²) with the same FWHM: g = w sqrt(2 ln 2).
+    const double a = 1.0 / (2.0 * w * w);
+    const double g = w * std::sqrt(2.0 * std::log(2.0));
+    const double b = 1.0 / (g * g);
+    const double gaussReach = w * std::sqrt(2.0 * std::log(1.0 / kTailCutoff));
+    auto lorentzReach = [&](double height) {
+        return height > kTailCutoff ? g * std::sqrt(height / kTailCutoff - 1.0) : 0.0;
+    };
+    double reach = gaussReach;
+    if (m_settings.shape == LineShape::Lorentzian)
+        reach = lorentzReach(1.0);
+    else if (m_settings.shape == LineShape::PseudoVoigt)
+        reach = std::max(gaussReach, lorentzReach(eta));
+
+    const int last = m_settings.points - 1;
+    auto window = [&](double shift) {
+        const double lo = std::ceil((shift - reach - m_settings.xMin) / m_step);
+        const double hi = std::floor((shift + reach - m_settings.xMin) / m_step);
+        return std::make_pair(int(std::clamp(lo, 0.0, double(last + 1))),
+            int(std::clamp(hi, -1.0, double(last))));
+    };
+
+    Partial partial;
+    int first = std::numeric_limits<int>::max(), end = -1;
+    for (double shift : shifts) {
+        const auto [lo, hi] = window(shift);
+        if (lo <= hi) {
+            first = std::min(first, lo);
+            end = std::max(end, hi);
+        }
+    }
+    if (end < 0)
+        return partial;   // every peak outside the grid
+    partial.first = first;
+    partial.values.assign(end - first + 1, 0.0f);
+
+    const float step = float(m_step);
+    for (double shift : shifts) {
+        const auto [lo, hi] = window(shift);
+        if (lo > hi)
+            continue;
+        float* out = partial.values.data() + (lo - first);
+        const int n = hi - lo + 1;
+        const float d0 = float(x(lo) - shift);
+        switch (m_settings.shape) {
+        case LineShape::Gaussian:
+            addGaussian(out, n, d0, step, float(a));
+            break;
+        case LineShape::Lorentzian:
+            addLorentzian(out, n, d0, step, float(b));
+            break;
+        case LineShape::PseudoVoigt:
+            addPseudoVoigt(out, n, d0, step, float(a), float(b), float(eta));
+            break;
+        }
+    }
+    return partial;
+}
+
+void NMRSpectrumEngine::accumulate(std::vector<double>& sum, const Partial& partial, double sign)
+{
+    double* out = sum.data() + partial.first;
+    const float* in = partial.values.data();
+    const int n = int(partial.values.size());
+#pragma omp simd
+    for (int j = 0; j < n; ++j)
+        out[j] += sign * double(in[j]);
+}
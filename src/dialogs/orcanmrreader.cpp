@@ -0,0 +1,172 @@
+// orcanmrreader.cpp - Indexed reader for the NMR results of ORCA output files
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026
+#include "orcanmrreader.h"
+#include "textscanner.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+constexpr quint32 kCacheMagic = 0x514E4D31;  // "QNM1"
+constexpr quint32 kCacheVersion = 1;
+
+const QByteArrayView kEnergyTag("FINAL SINGLE POINT ENERGY");
+const QByteArrayView kShieldingTag("CHEMICAL SHIELDING SUMMARY (ppm)");
+// Dashes, blank lines and the column header between the title and the first row.
+constexpr int kMaxHeaderLines = 10;
+
+bool isElement(QByteArrayView s)
+{
+    for (char c : s) {
+        if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')))
+            return false;
+    }
+    return !s.isEmpty();
+}
+
+// "  12   H    29.876   5.432" -> true
+bool parseRow(QByteArrayView line, OrcaNMRReader::Shielding& row)
+{
+    QByteArrayView fields[4];
+    if (TextScanner::splitFields(line, fields, 4) < 4)
+        return false;
+    if (!TextScanner::parseInt(fields[0], row.index) || !isElement(fields[1])
+        || !TextScanner::parseFloat(fields[2], row.isotropic)
+        || !TextScanner::parseFloat(fields[3], row.anisotropy))
+        return false;
+    row.element = QString::fromLatin1(fields[1].data(), fields[1].size());
+    return true;
+}
+}
+
+QString OrcaNMRReader::cachePath(const QString& filePath)
+{
+    const QByteArray key = QCryptographicHash::hash(
+        QFileInfo(filePath).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QStringLiteral("/nmr-shieldings/") + QString::fromLatin1(key) + QStringLiteral(".qnmr");
+}
+
+OrcaNMRReader::Result OrcaNMRReader::read(const QString& filePath)
+{
+    const QFileInfo info(filePath);
+    const qint64 size = info.size();
+    const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    const QString cacheFile = cachePath(filePath);
+
+    Result result;
+    if (info.exists() && loadCache(cacheFile, size, mtime, result))
+        return result;
+
+    TextScanner scanner;
+    if (!scanner.open(filePath)) {
+        result.error = QStringLiteral("Datei konnte nicht geöffnet werden");
+        return result;
+    }
+    result = parse(scanner.data());
+    if (result.ok)
+        saveCache(cacheFile, size, mtime, result);
+    return result;
+}
+
+OrcaNMRReader::Result OrcaNMRReader::parse(QByteArrayView data)
+{
+    Result result;
+
+    // Both sections are near the end; a backwards search touches only the tail pages.
+    // The last occurrence wins, i.e. the final geometry of an Opt + NMR job.
+    const qsizetype energyAt = data.lastIndexOf(kEnergyTag);
+    if (energyAt < 0) {
+        result.error = QStringLiteral("Energie nicht gefunden");
+        return result;
+    }
+    TextScanner scanner;
+    scanner.setData(data);
+    scanner.seek(energyAt + kEnergyTag.size());
+    QByteArrayView value;
+    if (TextScanner::splitFields(scanner.readLine(), &value, 1) != 1
+        || !TextScanner::parseFloat(value, result.energy)) {
+        result.error = QStringLiteral("Energie nicht gefunden");
+        return result;
+    }
+
+    const qsizetype tableAt = data.lastIndexOf(kShieldingTag);
+    if (tableAt < 0) {
+        result.error = QStringLiteral("NMR Daten nicht gefunden");
+        return result;
+    }
+    scanner.seek(tableAt);
+    scanner.readLine();   // the title itself
+    Shielding row;
+    bool inTable = false;
+    for (int skipped = 0; !scanner.atEnd();) {
+        const QByteArrayView line = scanner.readLine();
+        if (parseRow(line, row)) {
+            inTable = true;
+            result.shieldings.append(row);
+        } else if (inTable || ++skipped > kMaxHeaderLines) {
+            break;   // first line after the table
+        }
+    }
+    if (result.shieldings.isEmpty()) {
+        result.error = QStringLiteral("NMR Daten nicht gefunden");
+        return result;
+    }
+    result.ok = true;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Cache. The header pins the output's size + mtime; a rewritten or still growing
+// output is parsed again. Only successful parses are stored.
+// ---------------------------------------------------------------------------
+bool OrcaNMRReader::loadCache(const QString& cacheFile, qint64 size, qint64 mtime, Result& result)
+{
+    QFile f(cacheFile);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&f);
+    quint32 magic = 0, version = 0;
+    qint64 cachedSize = -1, cachedMTime = -1;
+    in >> magic >> version >> cachedSize >> cachedMTime;
+    if (magic != kCacheMagic || version != kCacheVersion || cachedSize != size || cachedMTime != mtime)
+        return false;
+    qint32 count = 0;
+    in >> result.energy >> count;
+    if (in.status() != QDataStream::Ok || count <= 0)
+        return false;
+    result.shieldings.resize(count);
+    for (Shielding& s : result.shieldings) {
+        qint32 index = 0;
+        in >> index >> s.element >> s.isotropic >> s.anisotropy;
+        s.index = index;
+    }
+    if (in.status() != QDataStream::Ok) {
+        result.shieldings.clear();
+        return false;
+    }
+    result.ok = true;
+    return true;
+}
+
+void OrcaNMRReader::saveCache(const QString& cacheFile, qint64 size, qint64 mtime, const Result& result)
+{
+    // Best effort: an unwritable cache only costs a re-parse next time.
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QSaveFile f(cacheFile);
+    if (!f.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&f);
+    out << kCacheMagic << kCacheVersion << size << mtime << result.energy
+        << qint32(result.shieldings.size());
+    for (const Shielding& s : result.shieldings)
+        out << qint32(s.index) << s.element << s.isotropic << s.anisotropy;
+    if (out.status() == QDataStream::Ok)
+        f.commit();
+}
@@ -0,0 +1,47 @@
+// orcanmrreader.h - Indexed reader for the NMR results of ORCA output files
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - replaces NMRDataStore's readAll() + QRegularExpression parsing.
+//
+// The output is mapped (TextScanner) and searched backwards from its end for the last
+// "FINAL SINGLE POINT ENERGY" and the last "CHEMICAL SHIELDING SUMMARY (ppm)", both of
+// which ORCA prints near the end; the megabytes of SCF/CPSCF iterations before them are
+// never touched. The summary table is read row by row with TextScanner's field splitter
+// and stops at the first line that is not a table row. Results are cached per file
+// (size + mtime checked on load), so re-adding a conformer set costs one small read per
+// file. read() is reentrant and may run on worker threads.
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QString>
+#include <QVector>
+
+class OrcaNMRReader
+{
+public:
+    struct Shielding {
+        int index = 0;
+        QString element;
+        double isotropic = 0.0;
+        double anisotropy = 0.0;
+    };
+
+    struct Result {
+        bool ok = false;
+        double energy = 0.0;
+        QVector<Shielding> shieldings;
+        QString error;   // German, shown to the user like the former runtime_error texts
+    };
+
+    /// Parse @p filePath, using the persistent cache when it is still valid.
+    static Result read(const QString& filePath);
+    /// Parse an ORCA output held in memory (no cache).
+    static Result parse(QByteArrayView data);
+
+    /// Per-user cache file for @p filePath.
+    static QString cachePath(const QString& filePath);
+
+private:
+    static bool loadCache(const QString& cacheFile, qint64 size, qint64 mtime, Result& result);
+    static void saveCache(const QString& cacheFile, qint64 size, qint64 mtime, const Result& result);
+};
@@ -5,12 +5,15 @@
 // Claude Generated 2026 - Dock system restructuring.
 
 #include "outputdock.h"
+#include "logview.h"
 
+#include <QGuiApplication>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QLineEdit>
 #include <QPushButton>
-#include <QScrollBar>
-#include <QTextEdit>
+#include <QShortcut>
+#include <QToolButton>
 #include <QVBoxLayout>
 
 OutputDock::OutputDock(QWidget* parent)
@@ -32,6 +35,26 @@ void OutputDock::setupUI()
     outputHeaderLayout->addWidget(outputLabel);
     outputHeaderLayout->addStretch();
 
+    // Claude Generated 2026 - search over the whole log (Enter = next, Shift+Enter = previous).
+    m_findEdit = new QLineEdit;
+    m_findEdit->setPlaceholderText(tr("Find in output"));
+    m_findEdit->setClearButtonEnabled(true);
+    m_findEdit->setMaximumWidth(220);
+    connect(m_findEdit, &QLineEdit::returnPressed, this, [this]() {
+        findNext(QGuiApplication::keyboardModifiers().testFlag(Qt::ShiftModifier));
+    });
+    outputHeaderLayout->addWidget(m_findEdit);
+    QToolButton* findPrevious = new QToolButton;
+    findPrevious->setArrowType(Qt::UpArrow);
+    findPrevious->setToolTip(tr("Previous match (Shift+Enter)"));
+    connect(findPrevious, &QToolButton::clicked, this, [this]() { findNext(true); });
+    outputHeaderLayout->addWidget(findPrevious);
+    QToolButton* findNextButton = new QToolButton;
+    findNextButton->setArrowType(Qt::DownArrow);
+    findNextButton->setToolTip(tr("Next match (Enter)"));
+    connect(findNextButton, &QToolButton::clicked, this, [this]() { findNext(false); });
+    outputHeaderLayout->addWidget(findNextButton);
+
     QPushButton* clearOutputButton = new QPushButton;
     clearOutputButton->setIcon(QIcon::fromTheme(QStringLiteral("edit-clear")));
     clearOutputButton->setToolTip(tr("Clear output (Ctrl+L)"));
@@ -41,15 +64,19 @@ void OutputDock::setupUI()
     outputHeaderLayout->addWidget(clearOutputButton);
     outputLayout->addLayout(outputHeaderLayout);
 
-    m_outputView = new QTextEdit;
-    m_outputView->setPlaceholderText(tr("Output"));
-    m_outputView->setReadOnly(true);
+    m_outputView = new LogView;
     outputLayout->addWidget(m_outputView);
+    QShortcut* findShortcut = new QShortcut(QKeySequence::Find, outputWidget);
+    findShortcut->setContext(Qt::WidgetWithChildrenShortcut);
+    connect(findShortcut, &QShortcut::activated, this, [this]() {
+        m_findEdit->setFocus();
+        m_findEdit->selectAll();
+    });
 
     setWidget(outputWidget);
 }
 
-QTextEdit* OutputDock::outputView() const
+LogView* OutputDock::outputView() const
 {
     return m_outputView;
 }
@@ -58,12 +85,18 @@ void OutputDock::appendOutput(const QString& text)
 {
     if (m_outputView) {
         m_outputView->append(text);
-        QScrollBar* bar = m_outputView->verticalScrollBar();
-        if (bar)
-            bar->setValue(bar->maximum());
+        m_outputView->scrollToBottom();
     }
 }
 
+void OutputDock::findNext(bool backward)
+{
+    if (!m_outputView || m_findEdit->text().isEmpty())
+        return;
+    const bool found = m_outputView->find(m_findEdit->text(), backward);
+    m_findEdit->setStyleSheet(found ? QString() : QStringLiteral("background-color: #ffd0d0;"));
+}
+
 void OutputDock::clearOutput()
 {
     if (m_outputView)
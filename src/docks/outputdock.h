@@ -2,6 +2,7 @@
 //
 // OutputDock — bottom dock holding the read-only calculation/output log.
 // Replaces the inline output QTextEdit previously created in MainWindow.
+// Claude Generated 2026 - the log is a virtualised LogView (tail-follow, search field).
 //
 // Claude Generated 2026 - Dock system restructuring.
 
@@ -11,7 +12,8 @@
 
 #include <QDockWidget>
 
-class QTextEdit;
+class LogView;
+class QLineEdit;
 
 class OutputDock : public QDockWidget
 {
@@ -21,7 +23,7 @@ public:
     explicit OutputDock(QWidget* parent = nullptr);
 
     /// Raw access to the log view for callers that already append text directly.
-    QTextEdit* outputView() const;
+    LogView* outputView() const;
 
 public slots:
     void appendOutput(const QString& text);
@@ -33,6 +35,8 @@ signals:
 
 private:
     void setupUI();
+    void findNext(bool backward);
 
-    QTextEdit* m_outputView = nullptr;
+    LogView* m_outputView = nullptr;
+    QLineEdit* m_findEdit = nullptr;
 };
@@ -3,20 +3,101 @@
 // Element colour/radius tables shared by the Qt Quick 3D viewer and overlays.
 // Extracted so the renderer is independent of MoleculeViewer's private helpers.
 // Claude Generated.
+//
+// Claude Generated 2026 - the tables are constexpr arrays indexed by atomic number Z
+// (1..118, index 0 = unknown symbol), so per-atom/per-bond lookups in the render and
+// bond loops are plain array loads. Symbols are resolved to Z once, when a structure is
+// parsed or edited, and carried as MoleculeViewer::Atom::atomicNumber.
 #pragma once
 
 #include <QColor>
 #include <QString>
+#include <QStringView>
 
 namespace elem {
 
-/// Standard CPK element colour (light grey fallback for unknown elements).
-QColor cpkColor(const QString& element);
+constexpr int kMaxAtomicNumber = 118;
+
+/// Atomic number of an element symbol (case-insensitive; trailing labels such as the
+/// "1" in "C1" are ignored). 0 for unknown symbols.
+int atomicNumber(QStringView symbol);
+
+/// Canonical symbol for @p z ("C", "Cl", ...); empty for 0 / out of range.
+QString symbol(int z);
+
+namespace detail {
+// CPK (Jmol) colours as 0xRRGGBB. The 16 elements the viewer originally knew keep their
+// established colours; Z 110-118 have no reference colour and use the unknown grey.
+inline constexpr unsigned kCpkRgb[kMaxAtomicNumber + 1] = {
+    0xC8C8C8,
+    0xFFFFFF, 0xD9FFFF, 0xCC80FF, 0xC2FF00, 0xFFB5B5, 0x808080, 0x0000FF, 0xFF0000,
+    0xDAA520, 0xB3E3F5, 0x0000AA, 0x00FF00, 0xBFA6A6, 0xF0C8A0, 0xFFA500, 0xFFFF00,
+    0x00FF00, 0x80D1E3, 0x8F7CC3, 0x808090, 0xE6E6E6, 0xBFC2C7, 0xA6A6AB, 0x8A99C7,
+    0x9C7AC7, 0xFFA500, 0xF090A0, 0x50D050, 0xC88033, 0xA5A5A5, 0xC28F8F, 0x668F8F,
+    0xBD80E3, 0xFFA100, 0xA52A2A, 0x5CB8D1, 0x702EB0, 0x00FF00, 0x94FFFF, 0x94E0E0,
+    0x73C2C9, 0x54B5B5, 0x3B9E9E, 0x248F8F, 0x0A7D8C, 0x006985, 0xC0C0C0, 0xFFD98F,
+    0xA67573, 0x668080, 0x9E63B5, 0xD47A00, 0x9400D3, 0x429EB0, 0x57178F, 0x00C900,
+    0x70D4FF, 0xFFFFC7, 0xD9FFC7, 0xC7FFC7, 0xA3FFC7, 0x8FFFC7, 0x61FFC7, 0x45FFC7,
+    0x30FFC7, 0x1FFFC7, 0x00FF9C, 0x00E675, 0x00D452, 0x00BF38, 0x00AB24, 0x4DC2FF,
+    0x4DA6FF, 0x2194D6, 0x267DAB, 0x266696, 0x175487, 0xD0D0E0, 0xFFD123, 0xB8B8D0,
+    0xA6544D, 0x575961, 0x9E4FB5, 0xAB5C00, 0x754F45, 0x428296, 0x420066, 0x007D00,
+    0x70ABFA, 0x00BAFF, 0x00A1FF, 0x008FFF, 0x0080FF, 0x006BFF, 0x545CF2, 0x785CE3,
+    0x8A4FE3, 0xA136D4, 0xB31FD4, 0xB31FBA, 0xB30DA6, 0xBD0D87, 0xC70066, 0xCC0059,
+    0xD1004F, 0xD90045, 0xE00038, 0xE6002E, 0xEB0026, 0xC8C8C8, 0xC8C8C8, 0xC8C8C8,
+    0xC8C8C8, 0xC8C8C8, 0xC8C8C8, 0xC8C8C8, 0xC8C8C8, 0xC8C8C8,
+};
+
+// Display radii in Angstrom (scaled so ball-and-stick stays readable, not true vdW radii).
+// Elements without a hand-tuned value use 0.92 x covalent radius, clamped to [0.5, 2.2].
+inline constexpr float kVdwRadius[kMaxAtomicNumber + 1] = {
+    0.70f,
+    0.50f, 0.50f, 1.18f, 0.88f, 0.77f, 0.70f, 0.65f, 0.60f, 0.50f, 0.53f,
+    1.80f, 1.70f, 1.11f, 1.02f, 1.00f, 1.00f, 1.00f, 0.98f, 2.20f, 2.00f,
+    1.56f, 1.47f, 1.41f, 1.28f, 1.28f, 1.40f, 1.16f, 1.14f, 1.21f, 1.35f,
+    1.12f, 1.10f, 1.09f, 1.10f, 1.15f, 1.07f, 2.02f, 1.79f, 1.75f, 1.61f,
+    1.51f, 1.42f, 1.35f, 1.34f, 1.31f, 1.28f, 1.33f, 1.32f, 1.31f, 1.28f,
+    1.28f, 1.27f, 1.40f, 1.29f, 2.20f, 1.98f, 1.90f, 1.88f, 1.87f, 1.85f,
+    1.83f, 1.82f, 1.82f, 1.80f, 1.78f, 1.77f, 1.77f, 1.74f, 1.75f, 1.72f,
+    1.72f, 1.61f, 1.56f, 1.49f, 1.39f, 1.32f, 1.30f, 1.25f, 1.25f, 1.21f,
+    1.33f, 1.34f, 1.36f, 1.29f, 1.38f, 1.38f, 2.20f, 2.03f, 1.98f, 1.90f,
+    1.84f, 1.80f, 1.75f, 1.72f, 1.66f, 1.55f, 1.55f, 1.55f, 1.52f, 1.54f,
+    1.59f, 1.62f, 1.48f, 1.44f, 1.37f, 1.32f, 1.30f, 1.23f, 1.19f, 1.18f,
+    1.11f, 1.12f, 1.25f, 1.32f, 1.49f, 1.61f, 1.52f, 1.44f,
+};
 
-/// Van-der-Waals-style display radius in Angstrom (carbon-like fallback).
-float vdwRadius(const QString& element);
+// Covalent radii in Angstrom (Cordero et al. 2008; Pyykkoe single-bond radii beyond Cm).
+// The original 16 elements keep the values bond perception has always used.
+inline constexpr float kCovalentRadius[kMaxAtomicNumber + 1] = {
+    0.76f,
+    0.31f, 0.28f, 1.28f, 0.96f, 0.84f, 0.76f, 0.71f, 0.66f, 0.64f, 0.58f,
+    1.54f, 1.30f, 1.21f, 1.11f, 1.07f, 1.05f, 1.02f, 1.06f, 1.96f, 1.76f,
+    1.70f, 1.60f, 1.53f, 1.39f, 1.39f, 1.32f, 1.26f, 1.24f, 1.32f, 1.22f,
+    1.22f, 1.20f, 1.19f, 1.20f, 1.20f, 1.16f, 2.20f, 1.95f, 1.90f, 1.75f,
+    1.64f, 1.54f, 1.47f, 1.46f, 1.42f, 1.39f, 1.45f, 1.44f, 1.42f, 1.39f,
+    1.39f, 1.38f, 1.39f, 1.40f, 2.44f, 2.15f, 2.07f, 2.04f, 2.03f, 2.01f,
+    1.99f, 1.98f, 1.98f, 1.96f, 1.94f, 1.92f, 1.92f, 1.89f, 1.90f, 1.87f,
+    1.87f, 1.75f, 1.70f, 1.62f, 1.51f, 1.44f, 1.41f, 1.36f, 1.36f, 1.32f,
+    1.45f, 1.46f, 1.48f, 1.40f, 1.50f, 1.50f, 2.60f, 2.21f, 2.15f, 2.06f,
+    2.00f, 1.96f, 1.90f, 1.87f, 1.80f, 1.69f, 1.68f, 1.68f, 1.65f, 1.67f,
+    1.73f, 1.76f, 1.61f, 1.57f, 1.49f, 1.43f, 1.41f, 1.34f, 1.29f, 1.28f,
+    1.21f, 1.22f, 1.36f, 1.43f, 1.62f, 1.75f, 1.65f, 1.57f,
+};
+
+constexpr int index(int z) { return (z > 0 && z <= kMaxAtomicNumber) ? z : 0; }
+} // namespace detail
+
+/// Standard CPK element colour (light grey for unknown elements).
+inline QColor cpkColor(int z) { return QColor(QRgb(detail::kCpkRgb[detail::index(z)])); }
+
+/// Van-der-Waals-style display radius in Angstrom (carbon-like for unknown elements).
+constexpr float vdwRadius(int z) { return detail::kVdwRadius[detail::index(z)]; }
 
 /// Covalent radius in Angstrom for distance-based bond detection.
-float covalentRadius(const QString& element);
+constexpr float covalentRadius(int z) { return detail::kCovalentRadius[detail::index(z)]; }
+
+// Symbol overloads for UI code that only has the string; hot loops use the Z overloads.
+inline QColor cpkColor(const QString& element) { return cpkColor(atomicNumber(element)); }
+inline float vdwRadius(const QString& element) { return vdwRadius(atomicNumber(element)); }
+inline float covalentRadius(const QString& element) { return covalentRadius(atomicNumber(element)); }
 
 } // namespace elem
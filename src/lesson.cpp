@@ -3,6 +3,7 @@
 // Claude Generated 2026 - see lesson.h for the design overview.
 
 #include "lesson.h"
+#include "elementdata.h"
 
 #include <QDir>
 #include <QFile>
@@ -60,6 +61,7 @@ QJsonObject simConfigToJson(const SimulationConfig& cfg)
     o["convergence"] = cfg.convergence;
     o["optKeepParameters"] = cfg.optKeepParameters;
     o["writeTrajectory"] = cfg.writeTrajectory;
+    o["recordSession"] = cfg.recordSession;
     o["fpsLimit"] = cfg.fpsLimit;
     o["performanceAnalysis"] = cfg.performanceAnalysis;
     o["performanceInterval"] = cfg.performanceInterval;
@@ -134,6 +136,7 @@ SimulationConfig simConfigFromJson(const QJsonObject& o)
     cfg.convergence = o.value("convergence").toDouble(cfg.convergence);
     cfg.optKeepParameters = o.value("optKeepParameters").toBool(cfg.optKeepParameters);
     cfg.writeTrajectory = o.value("writeTrajectory").toBool(cfg.writeTrajectory);
+    cfg.recordSession = o.value("recordSession").toBool(cfg.recordSession);
     cfg.fpsLimit = o.value("fpsLimit").toInt(cfg.fpsLimit);
     cfg.performanceAnalysis = o.value("performanceAnalysis").toBool(cfg.performanceAnalysis);
     cfg.performanceInterval = o.value("performanceInterval").toInt(cfg.performanceInterval);
@@ -316,6 +319,7 @@ bool xyzToAtoms(const QString& xyz, QVector<MoleculeViewer::Atom>& atoms)
             continue;
         MoleculeViewer::Atom a;
         a.element = t.at(0);
+        a.atomicNumber = quint8(elem::atomicNumber(a.element));
         a.position = QVector3D(t.at(1).toFloat(), t.at(2).toFloat(), t.at(3).toFloat());
         atoms.push_back(a);
     }
@@ -0,0 +1,149 @@
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Tessellation-selectable sphere / cylinder meshes (mesh LOD). Claude Generated 2026.
+#include "lodgeometry.h"
+
+#include <QByteArray>
+#include <QVector3D>
+#include <QtMath>
+
+#include <algorithm>
+
+namespace {
+constexpr float kBaseRadius = 50.0f;     // == #Sphere / #Cylinder radius
+constexpr float kBaseHalfHeight = 50.0f; // == #Cylinder half height
+
+// Interleaved position + normal, 6 floats per vertex.
+struct MeshBuffers {
+    QByteArray vertices;
+    QByteArray indices;
+    int vertexCount = 0;
+
+    void vertex(const QVector3D& p, const QVector3D& n)
+    {
+        const float v[6] = { p.x(), p.y(), p.z(), n.x(), n.y(), n.z() };
+        vertices.append(reinterpret_cast<const char*>(v), sizeof(v));
+        ++vertexCount;
+    }
+    void triangle(quint32 a, quint32 b, quint32 c)
+    {
+        const quint32 t[3] = { a, b, c };
+        indices.append(reinterpret_cast<const char*>(t), sizeof(t));
+    }
+};
+
+void upload(QQuick3DGeometry* geometry, const MeshBuffers& mesh, const QVector3D& lo, const QVector3D& hi)
+{
+    geometry->clear();
+    geometry->setStride(6 * sizeof(float));
+    geometry->setPrimitiveType(QQuick3DGeometry::PrimitiveType::Triangles);
+    geometry->addAttribute(QQuick3DGeometry::Attribute::PositionSemantic, 0,
+        QQuick3DGeometry::Attribute::F32Type);
+    geometry->addAttribute(QQuick3DGeometry::Attribute::NormalSemantic, 3 * sizeof(float),
+        QQuick3DGeometry::Attribute::F32Type);
+    geometry->addAttribute(QQuick3DGeometry::Attribute::IndexSemantic, 0,
+        QQuick3DGeometry::Attribute::U32Type);
+    geometry->setVertexData(mesh.vertices);
+    geometry->setIndexData(mesh.indices);
+    geometry->setBounds(lo, hi);
+    geometry->update();
+}
+}
+
+SphereGeometry::SphereGeometry(QQuick3DObject* parent)
+    : QQuick3DGeometry(parent)
+{
+    setDetail(32, 32);
+}
+
+void SphereGeometry::setDetail(int rings, int slices)
+{
+    rings = std::max(3, rings);
+    slices = std::max(3, slices);
+    if (rings == m_rings && slices == m_slices)
+        return;
+    m_rings = rings;
+    m_slices = slices;
+    generate();
+}
+
+void SphereGeometry::generate()
+{
+    // (rings + 1) x (slices + 1) grid from the +Y pole down; the seam column is
+    // duplicated so every quad indexes its own four corners. Counter-clockwise seen
+    // from outside (Quick3D front faces).
+    MeshBuffers mesh;
+    for (int r = 0; r <= m_rings; ++r) {
+        const float theta = float(M_PI) * r / m_rings;
+        const float sinT = std::sin(theta), cosT = std::cos(theta);
+        for (int s = 0; s <= m_slices; ++s) {
+            const float phi = 2.0f * float(M_PI) * s / m_slices;
+            const QVector3D n(sinT * std::cos(phi), cosT, sinT * std::sin(phi));
+            mesh.vertex(kBaseRadius * n, n);
+        }
+    }
+    const quint32 row = quint32(m_slices + 1);
+    for (int r = 0; r < m_rings; ++r) {
+        for (int s = 0; s < m_slices; ++s) {
+            const quint32 a = quint32(r) * row + quint32(s);
+            const quint32 b = a + row;
+            if (r > 0)
+                mesh.triangle(a, a + 1, b);
+            if (r < m_rings - 1)
+                mesh.triangle(a + 1, b + 1, b);
+        }
+    }
+    upload(this, mesh, QVector3D(-kBaseRadius, -kBaseRadius, -kBaseRadius),
+        QVector3D(kBaseRadius, kBaseRadius, kBaseRadius));
+}
+
+CylinderGeometry::CylinderGeometry(QQuick3DObject* parent)
+    : QQuick3DGeometry(parent)
+{
+    setSlices(16);
+}
+
+void CylinderGeometry::setSlices(int slices)
+{
+    slices = std::max(3, slices);
+    if (slices == m_slices)
+        return;
+    m_slices = slices;
+    generate();
+}
+
+void CylinderGeometry::generate()
+{
+    MeshBuffers mesh;
+    // Side: top/bottom vertex per segment (seam duplicated), radial normals.
+    for (int s = 0; s <= m_slices; ++s) {
+        const float phi = 2.0f * float(M_PI) * s / m_slices;
+        const QVector3D n(std::cos(phi), 0.0f, std::sin(phi));
+        mesh.vertex(QVector3D(kBaseRadius * n.x(), kBaseHalfHeight, kBaseRadius * n.z()), n);
+        mesh.vertex(QVector3D(kBaseRadius * n.x(), -kBaseHalfHeight, kBaseRadius * n.z()), n);
+    }
+    for (int s = 0; s < m_slices; ++s) {
+        const quint32 top = quint32(2 * s), bottom = top + 1;
+        mesh.triangle(top, top + 2, bottom);
+        mesh.triangle(top + 2, bottom + 2, bottom);
+    }
+    // Caps: centre fan with axial normals (hidden inside the atoms in ball-and-stick,
+    // visible at the ends in sticks-only mode).
+    for (const float y : { kBaseHalfHeight, -kBaseHalfHeight }) {
+        const QVector3D n(0.0f, y > 0.0f ? 1.0f : -1.0f, 0.0f);
+        const quint32 centre = quint32(mesh.vertexCount);
+        mesh.vertex(QVector3D(0.0f, y, 0.0f), n);
+        for (int s = 0; s <= m_slices; ++s) {
+            const float phi = 2.0f * float(M_PI) * s / m_slices;
+            mesh.vertex(QVector3D(kBaseRadius * std::cos(phi), y, kBaseRadius * std::sin(phi)), n);
+        }
+        for (int s = 0; s < m_slices; ++s) {
+            const quint32 a = centre + 1 + quint32(s);
+            if (y > 0.0f)
+                mesh.triangle(centre, a + 1, a);
+            else
+                mesh.triangle(centre, a, a + 1);
+        }
+    }
+    upload(this, mesh, QVector3D(-kBaseRadius, -kBaseHalfHeight, -kBaseRadius),
+        QVector3D(kBaseRadius, kBaseHalfHeight, kBaseRadius));
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+//
+// Procedural sphere / cylinder meshes with selectable tessellation for the Quick3D
+// viewer. They replace the fixed built-in "#Sphere" / "#Cylinder" on the primary
+// structure so PerformanceOptimizer's rings/slices finally reach the GPU. Same base
+// dimensions as the built-ins (radius 50, cylinder 100 tall along +Y, centred), so the
+// instance tables written by AtomInstancing / BondInstancing stay unchanged.
+// Claude Generated 2026.
+#pragma once
+
+#include <QQuick3DGeometry>
+
+class SphereGeometry : public QQuick3DGeometry
+{
+    Q_OBJECT
+public:
+    explicit SphereGeometry(QQuick3DObject* parent = nullptr);
+
+    /// Latitude bands x longitude segments; regenerates only when the detail changes.
+    void setDetail(int rings, int slices);
+    int rings() const { return m_rings; }
+    int slices() const { return m_slices; }
+
+private:
+    void generate();
+
+    int m_rings = 0;
+    int m_slices = 0;
+};
+
+class CylinderGeometry : public QQuick3DGeometry
+{
+    Q_OBJECT
+public:
+    explicit CylinderGeometry(QQuick3DObject* parent = nullptr);
+
+    /// Segments around the axis (side + both caps).
+    void setSlices(int slices);
+    int slices() const { return m_slices; }
+
+private:
+    void generate();
+
+    int m_slices = 0;
+};
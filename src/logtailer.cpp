@@ -0,0 +1,82 @@
+// logtailer.cpp - Incremental "tail -f" reader for calculation output files
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026
+
+#include "logtailer.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+LogTailer::LogTailer(QObject* parent)
+    : QObject(parent)
+{
+    m_readTimer.setSingleShot(true);
+    connect(&m_readTimer, &QTimer::timeout, this, &LogTailer::poll);
+    m_fallbackTimer.setInterval(kFallbackPollMs);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &LogTailer::poll);
+
+    auto changed = [this]() {
+        watch();   // a replaced file drops out of the watcher; a created one must be added
+        if (!m_readTimer.isActive())
+            m_readTimer.start(50);
+    };
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, changed);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, changed);
+}
+
+void LogTailer::follow(const QString& path)
+{
+    stop();
+    m_path = path;
+    m_offset = 0;
+    watch();
+    m_fallbackTimer.start();
+    m_readTimer.start(0);
+}
+
+void LogTailer::stop()
+{
+    if (!m_watcher.files().isEmpty())
+        m_watcher.removePaths(m_watcher.files());
+    if (!m_watcher.directories().isEmpty())
+        m_watcher.removePaths(m_watcher.directories());
+    m_fallbackTimer.stop();
+    m_readTimer.stop();
+    m_path.clear();
+    m_offset = 0;
+}
+
+void LogTailer::watch()
+{
+    if (m_path.isEmpty())
+        return;
+    // The directory is watched as well, so creation and replacement of the file are seen.
+    const QString dir = QFileInfo(m_path).absolutePath();
+    if (!m_watcher.directories().contains(dir))
+        m_watcher.addPath(dir);
+    if (QFile::exists(m_path) && !m_watcher.files().contains(m_path))
+        m_watcher.addPath(m_path);
+}
+
+void LogTailer::poll()
+{
+    if (m_path.isEmpty())
+        return;
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly))
+        return;   // not created yet
+    const qint64 size = file.size();
+    if (size < m_offset) {
+        m_offset = 0;
+        emit truncated();
+    }
+    if (size == m_offset || !file.seek(m_offset))
+        return;
+    const QByteArray bytes = file.read(qMin(size - m_offset, kReadChunk));
+    if (bytes.isEmpty())
+        return;
+    m_offset += bytes.size();
+    emit appended(bytes);
+    if (m_offset < size)
+        m_readTimer.start(0);   // continue the backlog after the event loop had a turn
+}
@@ -0,0 +1,55 @@
+// logtailer.h - Incremental "tail -f" reader for calculation output files
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - replaces the 1 s readAll()/setPlainText() refresh of the output log.
+//
+// LogTailer remembers how far it has read and only ever reads the bytes appended since.
+// Changes are noticed through QFileSystemWatcher (inotify / kqueue / ReadDirectoryChangesW);
+// a slow size poll backs it up for file systems without notifications (NFS, SSHFS). A
+// backlog (first open of a 200 MB ORCA output) is read in kReadChunk slices, one per event
+// loop turn, so the GUI stays responsive while catching up.
+
+#pragma once
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class LogTailer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 kReadChunk = 4LL * 1024 * 1024;
+    static constexpr int kFallbackPollMs = 1000;
+
+    explicit LogTailer(QObject* parent = nullptr);
+
+    /// Start following @p path from its first byte; the file need not exist yet.
+    void follow(const QString& path);
+    void stop();
+
+    QString path() const { return m_path; }
+    qint64 offset() const { return m_offset; }
+    bool isFollowing() const { return !m_path.isEmpty(); }
+
+public slots:
+    /// Read what was appended since the last call (at most kReadChunk, the rest is
+    /// scheduled). Called by the watcher and the fallback timer; may be called directly.
+    void poll();
+
+signals:
+    /// Bytes appended to the file, in order.
+    void appended(const QByteArray& bytes);
+    /// The file shrank or was replaced; reading restarts at offset 0.
+    void truncated();
+
+private:
+    void watch();
+
+    QFileSystemWatcher m_watcher;
+    QTimer m_fallbackTimer;
+    QTimer m_readTimer;   // coalesces bursts of change notifications / continues a backlog
+    QString m_path;
+    qint64 m_offset = 0;
+};
@@ -0,0 +1,332 @@
+// logview.cpp - Virtualised, line-indexed view for large calculation logs
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026
+
+#include "logview.h"
+#include "logtailer.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QFontDatabase>
+#include <QHeaderView>
+#include <QKeyEvent>
+#include <QScrollBar>
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// LogModel
+// ---------------------------------------------------------------------------
+LogModel::LogModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int LogModel::completeLines() const
+{
+    return m_chunks.isEmpty() ? 0 : m_firstRow.last() + int(m_chunks.last().starts.size());
+}
+
+int LogModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return completeLines() + (m_partial.isEmpty() ? 0 : 1);
+}
+
+int LogModel::chunkOf(int row) const
+{
+    return int(std::upper_bound(m_firstRow.begin(), m_firstRow.end(), row) - m_firstRow.begin()) - 1;
+}
+
+QByteArray LogModel::rawLine(int row) const
+{
+    if (row < 0)
+        return {};
+    if (row >= completeLines())
+        return row == completeLines() ? m_partial : QByteArray();
+    const int c = chunkOf(row);
+    const Chunk& chunk = m_chunks[c];
+    const int k = row - m_firstRow[c];
+    const int begin = int(chunk.starts[k]);
+    int end = k + 1 < chunk.starts.size() ? int(chunk.starts[k + 1]) : int(chunk.bytes.size());
+    while (end > begin && (chunk.bytes[end - 1] == '\n' || chunk.bytes[end - 1] == '\r'))
+        --end;
+    return chunk.bytes.mid(begin, end - begin);
+}
+
+QString LogModel::line(int row) const
+{
+    return QString::fromUtf8(rawLine(row));
+}
+
+QVariant LogModel::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid())
+        return {};
+    return line(index.row());
+}
+
+void LogModel::addLine(const char* data, int size)
+{
+    if (m_chunks.isEmpty()
+        || (m_chunks.last().bytes.size() + size > kChunkBytes && !m_chunks.last().bytes.isEmpty())) {
+        m_firstRow.append(completeLines());
+        m_chunks.append(Chunk());
+        m_chunks.last().bytes.reserve(qMax(kChunkBytes, size));
+    }
+    Chunk& chunk = m_chunks.last();
+    chunk.starts.append(quint32(chunk.bytes.size()));
+    chunk.bytes.append(data, size);
+    m_longestLine = qMax(m_longestLine, size - 1);
+}
+
+void LogModel::appendBytes(const QByteArray& bytes)
+{
+    if (bytes.isEmpty())
+        return;
+    // Rows after this call: every '\n' completes a line; bytes after the last one (or the
+    // extended partial line) form one more row.
+    const int oldRows = rowCount();
+    const bool hadPartial = !m_partial.isEmpty();
+    const qsizetype lastNewline = bytes.lastIndexOf('\n');
+    const bool partialAfter = lastNewline < 0 || lastNewline + 1 < bytes.size();
+    const int newRows = completeLines() + int(bytes.count('\n')) + (partialAfter ? 1 : 0);
+
+    if (newRows > oldRows)
+        beginInsertRows(QModelIndex(), oldRows, newRows - 1);
+    qsizetype pos = 0;
+    for (qsizetype nl; (nl = bytes.indexOf('\n', pos)) >= 0; pos = nl + 1) {
+        if (!m_partial.isEmpty()) {
+            m_partial.append(bytes.constData() + pos, nl - pos + 1);
+            addLine(m_partial.constData(), int(m_partial.size()));
+            m_partial.clear();
+        } else {
+            addLine(bytes.constData() + pos, int(nl - pos + 1));
+        }
+    }
+    m_partial.append(bytes.constData() + pos, bytes.size() - pos);
+    m_longestLine = qMax(m_longestLine, int(m_partial.size()));
+    if (newRows > oldRows)
+        endInsertRows();
+    if (hadPartial)   // the former last row was extended or completed
+        emit dataChanged(index(oldRows - 1), index(oldRows - 1));
+}
+
+void LogModel::clear()
+{
+    beginResetModel();
+    m_chunks.clear();
+    m_firstRow.clear();
+    m_partial.clear();
+    m_longestLine = 0;
+    endResetModel();
+}
+
+int LogModel::searchChunk(int c, const QByteArray& needle, bool fold, int lo, int hi, bool backward) const
+{
+    // One indexOf over the chunk's bytes instead of decoding every line; the hit offset is
+    // mapped back to its row through the line offsets.
+    const Chunk& chunk = m_chunks[c];
+    const QByteArray hay = fold ? chunk.bytes.toLower() : chunk.bytes;
+    const int base = m_firstRow[c];
+    auto rowAt = [&](qsizetype offset) {
+        return base + int(std::upper_bound(chunk.starts.begin(), chunk.starts.end(), quint32(offset)) - chunk.starts.begin()) - 1;
+    };
+    if (!backward) {
+        const qsizetype at = hay.indexOf(needle, chunk.starts[lo - base]);
+        if (at >= 0 && rowAt(at) <= hi)
+            return rowAt(at);
+        return -1;
+    }
+    const int k = hi - base + 1;
+    const qsizetype end = k < chunk.starts.size() ? qsizetype(chunk.starts[k]) : hay.size();
+    if (end - needle.size() < 0)
+        return -1;
+    const qsizetype at = hay.lastIndexOf(needle, end - needle.size());
+    if (at >= 0 && rowAt(at) >= lo)
+        return rowAt(at);
+    return -1;
+}
+
+int LogModel::searchRows(const QByteArray& needle, bool fold, int lo, int hi, bool backward) const
+{
+    if (lo > hi)
+        return -1;
+    const int complete = completeLines();
+    auto partialMatches = [&]() {
+        return hi >= complete && !m_partial.isEmpty()
+            && (fold ? m_partial.toLower() : m_partial).contains(needle);
+    };
+    if (backward && partialMatches())
+        return complete;
+    const int last = qMin(hi, complete - 1);
+    if (lo <= last) {
+        const int first = chunkOf(lo), final = chunkOf(last);
+        for (int i = 0; i <= final - first; ++i) {
+            const int c = backward ? final - i : first + i;
+            const int chunkLast = m_firstRow[c] + int(m_chunks[c].starts.size()) - 1;
+            const int row = searchChunk(c, needle, fold, qMax(lo, m_firstRow[c]), qMin(last, chunkLast), backward);
+            if (row >= 0)
+                return row;
+        }
+    }
+    if (!backward && partialMatches())
+        return complete;
+    return -1;
+}
+
+int LogModel::find(const QString& text, int fromRow, bool backward, Qt::CaseSensitivity cs) const
+{
+    const int rows = rowCount();
+    if (text.isEmpty() || rows == 0)
+        return -1;
+    const bool fold = cs == Qt::CaseInsensitive;
+    const QByteArray needle = fold ? text.toUtf8().toLower() : text.toUtf8();
+    fromRow = qBound(-1, fromRow, rows);
+    int row = backward ? searchRows(needle, fold, 0, fromRow - 1, true)
+                       : searchRows(needle, fold, fromRow + 1, rows - 1, false);
+    if (row < 0)   // wrap around
+        row = backward ? searchRows(needle, fold, qMax(0, fromRow), rows - 1, true)
+                       : searchRows(needle, fold, 0, qMin(fromRow, rows - 1), false);
+    return row;
+}
+
+// ---------------------------------------------------------------------------
+// LogView
+// ---------------------------------------------------------------------------
+LogView::LogView(QWidget* parent)
+    : QTableView(parent)
+    , m_model(new LogModel(this))
+    , m_tailer(new LogTailer(this))
+{
+    setModel(m_model);
+    const QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    setFont(font);
+    const QFontMetrics metrics(font);
+    m_charWidth = metrics.horizontalAdvance(QLatin1Char('M'));
+
+    // Fixed row height: the header needs no per-row sizes, so millions of rows stay cheap.
+    verticalHeader()->hide();
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(metrics.height() + 2);
+    horizontalHeader()->hide();
+    setShowGrid(false);
+    setWordWrap(false);
+    setTextElideMode(Qt::ElideNone);
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+    setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setCornerButtonEnabled(false);
+
+    connect(m_tailer, &LogTailer::appended, this, &LogView::appendBytes);
+    connect(m_tailer, &LogTailer::truncated, m_model, &LogModel::clear);
+}
+
+void LogView::followFile(const QString& path)
+{
+    if (m_tailer->path() == path) {
+        refresh();
+        return;
+    }
+    m_model->clear();
+    m_tailer->follow(path);
+}
+
+void LogView::stopFollowing()
+{
+    m_tailer->stop();
+}
+
+QString LogView::followedFile() const
+{
+    return m_tailer->path();
+}
+
+void LogView::refresh()
+{
+    m_tailer->poll();
+}
+
+void LogView::setPlainText(const QString& text)
+{
+    stopFollowing();
+    m_model->clear();
+    appendBytes(text.toUtf8());
+}
+
+void LogView::append(const QString& text)
+{
+    // Like QTextEdit::append(): always starts a new line.
+    QByteArray bytes;
+    if (m_model->hasPartialLine())
+        bytes.append('\n');
+    bytes.append(text.toUtf8());
+    bytes.append('\n');
+    appendBytes(bytes);
+}
+
+void LogView::clear()
+{
+    m_model->clear();
+    updateColumnWidth();
+}
+
+void LogView::appendBytes(const QByteArray& bytes)
+{
+    // Tail -f: stay at the end while the user has not scrolled away from it.
+    const bool atBottom = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+    m_model->appendBytes(bytes);
+    updateColumnWidth();
+    if (atBottom)
+        scrollToBottom();
+}
+
+void LogView::updateColumnWidth()
+{
+    const int needed = (m_model->longestLineBytes() + 2) * m_charWidth;
+    const int width = qMax(viewport()->width(), needed);
+    if (columnWidth(0) != width)
+        setColumnWidth(0, width);
+}
+
+void LogView::resizeEvent(QResizeEvent* event)
+{
+    QTableView::resizeEvent(event);
+    updateColumnWidth();
+}
+
+bool LogView::find(const QString& text, bool backward, Qt::CaseSensitivity cs)
+{
+    const QModelIndex current = currentIndex();
+    const int from = current.isValid() ? current.row() : (backward ? m_model->rowCount() : -1);
+    const int row = m_model->find(text, from, backward, cs);
+    if (row < 0)
+        return false;
+    const QModelIndex index = m_model->index(row);
+    setCurrentIndex(index);
+    scrollTo(index, QAbstractItemView::PositionAtCenter);
+    return true;
+}
+
+void LogView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy)) {
+        copySelection();
+        return;
+    }
+    QTableView::keyPressEvent(event);
+}
+
+void LogView::copySelection() const
+{
+    QModelIndexList rows = selectionModel()->selectedRows();
+    std::sort(rows.begin(), rows.end(),
+        [](const QModelIndex& a, const QModelIndex& b) { return a.row() < b.row(); });
+    QStringList lines;
+    lines.reserve(rows.size());
+    for (const QModelIndex& index : rows)
+        lines.append(m_model->line(index.row()));
+    QApplication::clipboard()->setText(lines.join(QLatin1Char('\n')));
+}
@@ -0,0 +1,97 @@
+// logview.h - Virtualised, line-indexed view for large calculation logs
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - replaces the output QTextEdit, whose QTextDocument layout of a
+// multi-hundred-MB ORCA output took seconds per refresh and GBs of memory.
+//
+// LogModel keeps the raw bytes in ~1 MB chunks plus one 32-bit line offset per line (no
+// QString, no layout); a line is decoded only when the view paints it. LogView is a
+// single-column QTableView with fixed row height, so only the visible rows are touched no
+// matter how long the log is. A LogTailer feeds it incrementally while a job runs.
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QTableView>
+#include <QVector>
+
+class LogTailer;
+
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kChunkBytes = 1 << 20;
+
+    explicit LogModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /// Append raw bytes; a trailing incomplete line is shown and completed by the next call.
+    void appendBytes(const QByteArray& bytes);
+    void clear();
+
+    bool hasPartialLine() const { return !m_partial.isEmpty(); }
+    QString line(int row) const;
+    int longestLineBytes() const { return m_longestLine; }
+    /// First row after (before, if @p backward) @p fromRow containing @p text, wrapping
+    /// around; -1 if none. Case-insensitive matching folds ASCII only.
+    int find(const QString& text, int fromRow, bool backward, Qt::CaseSensitivity cs) const;
+
+private:
+    struct Chunk {
+        QByteArray bytes;        // complete lines, each with its '\n'
+        QVector<quint32> starts; // byte offset of every line in bytes
+    };
+    void addLine(const char* data, int size);
+    int completeLines() const;
+    int chunkOf(int row) const;
+    QByteArray rawLine(int row) const;
+    int searchChunk(int chunk, const QByteArray& needle, bool fold, int lo, int hi, bool backward) const;
+    int searchRows(const QByteArray& needle, bool fold, int lo, int hi, bool backward) const;
+
+    QVector<Chunk> m_chunks;
+    QVector<int> m_firstRow;     // first global row of each chunk
+    QByteArray m_partial;        // bytes after the last '\n'
+    int m_longestLine = 0;
+};
+
+class LogView : public QTableView
+{
+    Q_OBJECT
+
+public:
+    explicit LogView(QWidget* parent = nullptr);
+
+    /// Show @p path and keep appending whatever is written to it (LogTailer).
+    void followFile(const QString& path);
+    void stopFollowing();
+    QString followedFile() const;
+    /// Read what the followed file gained since the last read (e.g. when the job ended).
+    void refresh();
+
+    // QTextEdit-compatible subset used by MainWindow. clear() keeps following the file,
+    // so only output written afterwards is shown; setPlainText() stops following.
+    void setPlainText(const QString& text);
+    void append(const QString& text);
+    void clear();
+
+    /// Select the next (previous) line containing @p text; false if there is none.
+    bool find(const QString& text, bool backward = false,
+        Qt::CaseSensitivity cs = Qt::CaseInsensitive);
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    void appendBytes(const QByteArray& bytes);
+    void updateColumnWidth();
+    void copySelection() const;
+
+    LogModel* m_model = nullptr;
+    LogTailer* m_tailer = nullptr;
+    int m_charWidth = 8;
+};
@@ -2,6 +2,7 @@
 #include <QApplication>
 #include <QCommandLineOption>
 #include <QCommandLineParser>
+#include <QCoreApplication>
 #include <QDir>
 #include <QQuickWindow>
 #include <QSGRendererInterface>
@@ -11,6 +12,9 @@
 #include <QVulkanInstance>
 #endif
 
+#include <cstdio>
+
+#include "batchrunner.h"
 #include "mainwindow.h"
 
 // Claude Generated - Populate curcuma's ParameterRegistry with all module
@@ -20,10 +24,61 @@
 // or ConfigManager::get<T>() throws "Parameter '...' not found in module ...".
 #include "generated/parameter_registry.h"
 
+namespace {
+// Claude Generated 2026 - `qurcuma --batch job.json` (BatchRunner) runs without a window.
+// Decided by a plain argv scan BEFORE any application object exists, so batch runs never
+// create a QGuiApplication, probe Vulkan or build the QML scene.
+bool isBatchInvocation(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        const QByteArray arg(argv[i]);
+        if (arg == "--batch" || arg == "-batch" || arg.startsWith("--batch="))
+            return true;
+    }
+    return false;
+}
+
+QCommandLineOption batchOption()
+{
+    return QCommandLineOption(QStringLiteral("batch"),
+        QStringLiteral("Run the MD / optimisation / trajectory analysis described by <job.json> "
+                       "without a window and exit"),
+        QStringLiteral("job.json"));
+}
+
+int runBatch(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QStringLiteral(QURCUMA_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Qurcuma batch mode - headless simulation and trajectory analysis"));
+    parser.addHelpOption();
+    parser.setSingleDashWordOptionMode(QCommandLineParser::ParseAsLongOptions);
+    const QCommandLineOption batchOpt = batchOption();
+    parser.addOption(batchOpt);
+    parser.process(app);
+
+    BatchRunner runner;
+    QString error;
+    if (!runner.load(parser.value(batchOpt), &error)) {
+        std::fprintf(stderr, "qurcuma --batch: %s\n", qPrintable(error));
+        return 1;
+    }
+    QObject::connect(&runner, &BatchRunner::finished, &app, &QCoreApplication::exit);
+    QTimer::singleShot(0, &runner, &BatchRunner::start);
+    return app.exec();
+}
+}
+
 int main(int argc, char *argv[])
 {
     initialize_generated_registry();
 
+    if (isBatchInvocation(argc, argv))
+        return runBatch(argc, argv);
+
     {
         QSurfaceFormat fmt = QSurfaceFormat::defaultFormat();
         fmt.setDepthBufferSize(24);
@@ -82,6 +137,7 @@ int main(int argc, char *argv[])
         QStringLiteral("Auto-start geometry optimization after loading the file"));
     parser.addOption(mdOpt);
     parser.addOption(optOpt);
+    parser.addOption(batchOption());  // listed in --help; handled by runBatch() above
     // Allow `qurcuma file.xyz -md` (flag after the positional file argument):
     // ParseAsOptions parses options even when they appear after a positional.
     parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsOptions);
@@ -67,10 +67,15 @@
 #include <QTextStream>
 #include <QString>
 #include "view.h"
+#include "xyztrajectoryreader.h"  // Claude Generated 2026 - streamed XYZ trajectories
+#include "sessionrecording.h"  // Claude Generated 2026 - .qrec session recording / replay
+#include "profiler.h"  // Claude Generated 2026 - frame-time HUD / Chrome trace
+#include "trajectorystore.h"
 #include "frequencydialog.h"
 #include "displaypanel.h"
 #include "widgets/commandpalette.h"
 #include "widgets/simulationchart.h"  // Claude Generated 2026 - live MD temperature/energy charts
+#include "widgets/trajectoryanalysiswidget.h"  // Claude Generated 2026 - trajectory RMSD / RMSF
 
 #include "dialogs/nmrspectrumdialog.h"
 #include "rmsdwidget.h"  // Claude Generated 2026 - RMSD / align tool (Analysis dock)
@@ -82,6 +87,7 @@
 #include "docks/simulationdock.h"  // Claude Generated 2026 - Dock system restructuring
 #include "docks/displaydock.h"  // Claude Generated 2026 - Dock system restructuring
 #include "docks/outputdock.h"  // Claude Generated 2026 - Dock system restructuring
+#include "logview.h"  // Claude Generated 2026 - virtualised tail-follow output log
 #include "docks/bookmarkwidget.h"  // Claude Generated 2026 - Dock system restructuring
 #include "docks/workspacepanel.h"  // Claude Generated 2026 - Dock system restructuring
 #include "docks/remotedirectoriespanel.h"  // Claude Generated 2026 - Dock system restructuring
@@ -156,6 +162,27 @@ MainWindow::MainWindow(const QString& invocationDir, QWidget *parent)
     m_vtfParser = new VTFParser();
     m_xyzParser = new XYZParser();
 
+    // Claude Generated 2026 - Background XYZ/VTF loading with a progress bar and an abort
+    // button in the status bar; both only show up once a load takes noticeably long.
+    m_structureLoader = new StructureLoader(this);
+    m_loadProgressBar = new QProgressBar(this);
+    m_loadProgressBar->setRange(0, 1000);
+    m_loadProgressBar->setMaximumWidth(240);
+    m_loadProgressBar->setTextVisible(true);
+    m_loadAbortButton = new QToolButton(this);
+    m_loadAbortButton->setIcon(QIcon::fromTheme("process-stop"));
+    m_loadAbortButton->setToolTip(tr("Abort loading"));
+    m_loadAbortButton->setAutoRaise(true);
+    statusBar()->addPermanentWidget(m_loadProgressBar);
+    statusBar()->addPermanentWidget(m_loadAbortButton);
+    setLoadProgressVisible(false);
+    connect(m_loadAbortButton, &QToolButton::clicked, m_structureLoader, &StructureLoader::cancel);
+    connect(m_structureLoader, &StructureLoader::firstFrameReady, this, &MainWindow::onStructureFirstFrame);
+    connect(m_structureLoader, &StructureLoader::progress, this, &MainWindow::onStructureLoadProgress);
+    connect(m_structureLoader, &StructureLoader::finished, this, &MainWindow::onStructureLoaded);
+    connect(m_structureLoader, &StructureLoader::failed, this, &MainWindow::onStructureLoadFailed);
+    connect(m_structureLoader, &StructureLoader::cancelled, this, &MainWindow::onStructureLoadCancelled);
+
     // Claude Generated - Visual Polish: Load dark mode setting and update checkbox
     m_darkModeEnabled = m_settings.darkModeEnabled();
     if (m_darkModeAction) {
@@ -572,11 +599,13 @@ void MainWindow::setupContextMenu()
                 connect(nmrstruktur, &QAction::triggered, [this, filePath]() {
                     if (QMessageBox::question(this, tr("NMR Spektren"), tr("Do you want to load all files with the name filename from each directory?"), QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
                         QString dirname = QFileInfo(filePath).dir().path().split(QDir::separator()).last();
+                        std::vector<std::pair<QString, QString>> files;
                         for (const QString& subdir : this->currentSubdirectories()) {
                             QString current = filePath;
                             current.replace(dirname, subdir);
-                            m_nmrDialog->addStructure(current, subdir);
+                            files.emplace_back(current, subdir);
                         }
+                        m_nmrDialog->addStructures(files); // Claude Generated 2026 - parsed in parallel
                     } else {
                         QString dirname = QFileInfo(filePath).dir().path().split(QDir::separator()).last();
                         m_nmrDialog->addStructure(filePath, dirname);
@@ -804,7 +833,7 @@ void MainWindow::createMenus()
         const QString path = QFileDialog::getOpenFileName(this,
             tr("Open Molecule File"),
             startDir,
-            tr("Molecule Files (*.xyz *.vtf *.pdb *.mol2);;All Files (*)"));
+            tr("Molecule Files (*.xyz *.vtf *.pdb *.mol2 *.qrec);;All Files (*)"));
         if (path.isEmpty()) return;
         loadMoleculeFile(path);
     });
@@ -883,6 +912,14 @@ void MainWindow::createMenus()
             m_moleculeView->exportImageDialog(m_workingDirectory, &m_settings);
     });
 
+    // Claude Generated 2026 - trajectory movie: offscreen frames encoded on worker threads.
+    QAction* exportVideoAction = fileMenu->addAction(
+        QIcon::fromTheme("video-x-generic"), tr("Export &Video..."));
+    connect(exportVideoAction, &QAction::triggered, this, [this]() {
+        if (m_moleculeView)
+            m_moleculeView->exportVideoDialog(m_workingDirectory);
+    });
+
     fileMenu->addSeparator();
 
     // Claude Generated 2026 - Lesson (OER teaching scenario) menu. A lesson is a
@@ -1047,6 +1084,37 @@ void MainWindow::createMenus()
     displayOptionsAction->setToolTip(tr("Open the Display panel (style, effects, lighting, tools)"));
     connect(displayOptionsAction, &QAction::triggered, this, &MainWindow::openVisualizationSettings);
 
+    // Claude Generated 2026 - frame-time instrumentation (see profiler.h).
+    QAction *profilerHudAction = viewMenu->addAction(tr("Frame-Time &HUD"));
+    profilerHudAction->setCheckable(true);
+    profilerHudAction->setToolTip(tr("Overlay per-stage frame timings (p50/p95/p99) on the 3D view"));
+    connect(profilerHudAction, &QAction::toggled, this, [this](bool on) {
+        if (m_moleculeView)
+            m_moleculeView->setProfilerHudVisible(on);
+    });
+    QAction *traceAction = viewMenu->addAction(tr("Record Performance &Trace"));
+    traceAction->setCheckable(true);
+    traceAction->setToolTip(tr("Record every profiled stage; unchecking saves a Chrome trace (chrome://tracing, Perfetto)"));
+    connect(traceAction, &QAction::toggled, this, [this](bool on) {
+        Profiler& profiler = Profiler::instance();
+        if (on) {
+            profiler.setTracing(true);
+            statusBar()->showMessage(tr("Recording performance trace…"), 2000);
+            return;
+        }
+        profiler.setTracing(false);
+        const QString path = QFileDialog::getSaveFileName(this, tr("Save Performance Trace"),
+            QDir::home().filePath(QStringLiteral("qurcuma-trace.json")), tr("Chrome trace (*.json)"));
+        if (path.isEmpty())
+            return;
+        QString error;
+        if (profiler.writeChromeTrace(path, &error))
+            statusBar()->showMessage(tr("Trace with %1 events written to %2")
+                .arg(profiler.traceEventCount()).arg(QFileInfo(path).fileName()), 4000);
+        else
+            QMessageBox::warning(this, tr("Save Performance Trace"), error);
+    });
+
     viewMenu->addSeparator();
 
     // Reset layout: restore the captured baseline (drops preset caches so they re-derive).
@@ -1132,6 +1200,19 @@ void MainWindow::createMenus()
         m_simulationChartDialog->activateWindow();
     });
 
+    // Claude Generated 2026 - RMSD-vs-frame / RMSF over the loaded trajectory (modeless dialog).
+    QAction *trajectoryAnalysisAction = moleculeMenu->addAction(
+        QIcon::fromTheme("office-chart-line"), tr("&Trajectory RMSD / RMSF…"));
+    trajectoryAnalysisAction->setToolTip(
+        tr("Fit every trajectory frame to a reference frame and plot RMSD per frame and RMSF per atom."));
+    connect(trajectoryAnalysisAction, &QAction::triggered, this, [this]() {
+        if (!m_trajectoryAnalysisDialog)
+            return;
+        m_trajectoryAnalysisDialog->show();
+        m_trajectoryAnalysisDialog->raise();
+        m_trajectoryAnalysisDialog->activateWindow();
+    });
+
     moleculeMenu->addSeparator();
 
     QAction *rmsdAction = moleculeMenu->addAction(QIcon::fromTheme("view-object-histogram-linear"),
@@ -1248,19 +1329,15 @@ void MainWindow::setupConnections()
             QString filePath = filePathFromContentIndex(index);
             QString suffix = QFileInfo(filePath).suffix().toLower();
             QString basename = QFileInfo(filePath).baseName();
-            if (suffix == "xyz" || suffix == "vtf") {
+            if (suffix == "xyz" || suffix == "vtf" || suffix == "qrec") {
                 // Claude Generated 2026 - Route molecule files through the
                 // central loadMoleculeFile() which handles snapshots, simulation
                 // dock sync, save-path tracking, and modified-state flags.
                 loadMoleculeFile(filePath);
             }
             else if (suffix == "log" || suffix == "out" || suffix == "txt") {
-                // Log/Output-Dateien in Output View laden
-                QFile file(filePath);
-                if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                    m_outputView->setPlainText(QString::fromUtf8(file.readAll()));
-                    file.close();
-                }
+                // Log/Output-Dateien in Output View laden (Claude Generated 2026 - chunked, follows appends)
+                m_outputView->followFile(filePath);
             }
             else if (suffix == "inp" || basename == "input") {
                 // Input-Dateien in Input View laden
@@ -1314,6 +1391,28 @@ void MainWindow::setupConnections()
     // viewer Edit mode, else structure text). A second QShortcut here caused an
     // "Ambiguous shortcut overload: Ctrl+V" so paste stopped working. Claude Generated 2026.
 
+    if (m_moleculeView) {
+        // Claude Generated 2026 - Session replay: recorded step, energies and the last
+        // interactive event for the displayed frame.
+        connect(m_moleculeView, &MoleculeViewer::frameChanged, this, [this](int frame) {
+            if (!m_sessionRecording || m_moleculeView->getFrameCount() != m_sessionRecording->frameCount())
+                return;
+            const SessionRecording::FrameInfo info = m_sessionRecording->frameInfo(frame);
+            QString message = tr("Step %1 | E = %2 Eh | Ekin = %3 Eh | T = %4 K (target %5 K)")
+                                  .arg(info.step)
+                                  .arg(info.energy, 0, 'f', 8)
+                                  .arg(info.ekin, 0, 'f', 6)
+                                  .arg(info.temperature, 0, 'f', 1)
+                                  .arg(info.targetTemperature, 0, 'f', 1);
+            const int event = m_sessionRecording->lastEventAt(frame);
+            if (event >= 0) {
+                const SessionEvent& e = m_sessionRecording->events()[event];
+                message += tr(" | last event @%1: %2").arg(e.frame).arg(e.describe());
+            }
+            statusBar()->showMessage(message, 0);
+        });
+    }
+
     // Claude Generated - Phase 2C: AtomListPanel Connections
     if (m_atomListPanel && m_moleculeView) {
         // When MoleculeViewer selection changes → Update AtomListPanel
@@ -1799,14 +1898,11 @@ void MainWindow::createNewDirectory()
 
 void MainWindow::updateOutputView(const QString& logFile, bool scrollToBottom)
 {
-    QFile file(logFile);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        m_outputView->setPlainText(QString::fromUtf8(file.readAll()));
-        file.close();
-    }
-    if (scrollToBottom) {
-        m_outputView->verticalScrollBar()->setValue(m_outputView->verticalScrollBar()->maximum());
-    }
+    // Claude Generated 2026 - only the bytes appended since the last read are loaded; the
+    // LogView keeps following the file (QFileSystemWatcher) until another one is shown.
+    m_outputView->followFile(logFile);
+    if (scrollToBottom)
+        m_outputView->scrollToBottom();
 }
 
 void MainWindow::runSimulation()
@@ -2007,21 +2103,10 @@ void MainWindow::runSimulation()
 
     });
 
-    // Timer zum regelmäßigen Aktualisieren der Ausgabedatei
-    QPointer<QTimer> outputUpdateTimer = new QTimer(this);
-    connect(outputUpdateTimer, &QTimer::timeout, [this, outputFile]() {
-        updateOutputView(currentCalculationDir() + QDir::separator() + outputFile, true);
-    });
-    outputUpdateTimer->start(1000); // Aktualisiere alle 1000 ms (1 Sekunde)
-
-    // Stoppe den Timer, wenn der Prozess beendet ist
-    connect(m_currentProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-        [outputUpdateTimer](int, QProcess::ExitStatus) {
-            if (outputUpdateTimer) {
-                outputUpdateTimer->stop();
-                outputUpdateTimer->deleteLater();
-            }
-        });
+    // Claude Generated 2026 - tail-follow the output file: the LogView appends whatever the
+    // job writes (file-change notifications, 1 s size poll as fallback) instead of re-reading
+    // the whole file every second. The finished handler above reads the last bytes.
+    updateOutputView(currentCalculationDir() + QDir::separator() + outputFile, true);
 
     // Zeige eine Information und setze den Cursor auf "Warten"
     statusBar()->showMessage(tr("Calculation running..."));
@@ -2363,22 +2448,11 @@ void MainWindow::syncRightView()
     // Output-Dateien suchen und laden (*.log oder *.out)
     QStringList outputFiles = dir.entryList(QStringList() << "*.log" << "*.out", QDir::Files);
     if (!outputFiles.isEmpty()) {
-        QFile outputFile(dir.filePath(outputFiles.first()));
-        if (outputFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            // Show progress for large output files
-            if (outputFile.size() > LARGE_FILE_THRESHOLD) {
-                if (!loadingProgress) {
-                    loadingProgress = new QProgressDialog(tr("Loading output file..."), tr("Cancel"), 0, 0, this);
-                    loadingProgress->setWindowModality(Qt::WindowModal);
-                }
-                loadingProgress->setLabelText(tr("Loading output file..."));
-                loadingProgress->show();
-                QApplication::processEvents();
-            }
-            m_outputView->setPlainText(QString::fromUtf8(outputFile.readAll()));
-            outputFile.close();
-        }
+        // Claude Generated 2026 - read in slices on the event loop (no blocking readAll),
+        // then followed in case a job is still writing to it.
+        m_outputView->followFile(dir.filePath(outputFiles.first()));
     } else {
+        m_outputView->stopFollowing();
         m_outputView->clear();
     }
 
@@ -2702,8 +2776,6 @@ void MainWindow::saveCurrentEditor()
         currentEditor = m_structureView;
     } else if (m_inputView->hasFocus()) {
         currentEditor = m_inputView;
-    } else if (m_outputView->hasFocus()) {
-        currentEditor = m_outputView;
     }
 
     if (currentEditor) {
@@ -4129,6 +4201,7 @@ void MainWindow::updateWorkspaceMenu(QMenu* menu)
 // Claude Generated - SFTP: Load molecule file from local or remote path
 void MainWindow::loadMoleculeFile(const QString& filePath)
 {
+    ProfileScope profile("load.file");
     if (filePath.isEmpty() || !QFile::exists(filePath)) {
         qWarning() << "File does not exist:" << filePath;
         return;
@@ -4164,153 +4237,60 @@ void MainWindow::loadMoleculeFile(const QString& filePath)
             return;  // user cancelled Save-As — keep the unsaved structure
         // Discard falls through silently.
     }
+    // Claude Generated 2026 - a new file replaces a load still in progress
+    m_structureLoader->cancel();
 
     QString suffix = QFileInfo(filePath).suffix().toLower();
     QString basename = QFileInfo(filePath).baseName();
+    m_sessionRecording.reset();
 
     // Claude Generated 2026 - tracks whether at least one parser successfully
     // loaded the file. Only used at the end to decide whether to auto-switch
     // the working directory to the file's parent directory.
     bool fileLoaded = false;
 
-    if (suffix == "xyz") {
-        // XYZ file loading
-        if (m_xyzParser->parseTrajectory(filePath)) {
-            // Load XYZ data as text
-            QFile file(filePath);
-            if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                m_structureView->setPlainText(QString::fromUtf8(file.readAll()));
-                m_structureFileEdit->setText(QFileInfo(filePath).fileName());
-                file.close();
-            }
-
-            // Get frame count and setup trajectory data
-            int frameCount = m_xyzParser->getFrameCount();
-            DEBUG_LOG << "XYZ: frameCount =" << frameCount;
-            m_moleculeView->setFrameCount(frameCount);
-
-            // Reset molecule viewer for new file
+    if (StructureLoader::canLoad(filePath)) {
+        // Claude Generated 2026 - XYZ/VTF: read, parsed and bond-perceived on a worker
+        // thread; onStructureFirstFrame / onStructureLoaded finish the job on this thread.
+        StructureLoader::Options options;
+        options.center = m_centerOnLoad;
+        m_loadFirstFrameShown = false;
+        m_structureLoader->start(filePath, options);
+    }
+    else if (suffix == "qrec") {
+        // Claude Generated 2026 - Recorded interactive session: frames stay in the file
+        // mapping (TrajectoryStore::Compression::Mapped), so opening costs O(atoms) and
+        // scrubbing touches one frame. Not centred: that would copy every frame into memory.
+        auto recording = QSharedPointer<SessionRecording>::create();
+        if (recording->open(filePath)) {
             m_moleculeView->clearScenePublic();
+            m_sessionRecording = recording;  // before the first frameChanged
+            m_moleculeView->setTrajectoryStore(SessionRecording::trajectoryStore(recording));
+            m_structureView->setPlainText(atomsToXyz(m_moleculeView->getCurrentFrameAtoms(),
+                QFileInfo(filePath).fileName()));
+            m_structureFileEdit->setText(QFileInfo(filePath).fileName());
 
-            // Convert all frames to trajectory data
-            QVector<QVector<MoleculeViewer::Atom>> allAtoms;
-            QVector<QVector<MoleculeViewer::Bond>> allBonds;
-
-            for (int i = 0; i < frameCount; ++i) {
-                XYZParser::XYZFrame frame;
-                if (m_xyzParser->getFrame(i, frame)) {
-                    QVector<MoleculeViewer::Atom> atoms;
-                    QVector<MoleculeViewer::Bond> bonds;
-                    XYZParser::convertToMoleculeViewer(frame, atoms, bonds);
-                    allAtoms.append(atoms);
-                    allBonds.append(bonds);
-                    DEBUG_LOG << "XYZ: Loaded frame" << i << "- atoms:" << atoms.size() << "bonds:" << bonds.size();
-                } else {
-                    DEBUG_LOG << "XYZ: Failed to load frame" << i;
-                }
-            }
-
-            DEBUG_LOG << "XYZ: Total frames loaded:" << allAtoms.size();
-            m_moleculeView->setTrajectoryData(allAtoms, allBonds);
-            if (m_centerOnLoad) m_moleculeView->centerAtOrigin();
-
-            // Claude Generated - Feed the loaded molecule into the inline
-            // simulation widget so the user can start a run without manually
-            // re-selecting it. First frame is used as the simulation input.
-            if (m_simulationControlWidget && !allAtoms.isEmpty())
-                m_simulationControlWidget->setMolecule(m_moleculeView->getCurrentFrameAtoms(),
-                    m_moleculeView->getCurrentFrameBonds());
-            // Claude Generated 2026 - Fresh load: clear the modified flag, cache
-            // the new source path (so a follow-up Save overwrites it), and
-            // enable the File>Save actions. The Save action is enabled as soon
-            // as a molecule is on screen, regardless of modification state.
-            m_currentMoleculeFilePath = filePath;
-            m_structureModified = false;
             if (m_simulationControlWidget)
-                m_simulationControlWidget->setStructureModified(false);
-            if (m_saveAction) m_saveAction->setEnabled(true);
-            if (m_saveAsAction) m_saveAsAction->setEnabled(true);
-            // Store an in-memory snapshot of the original geometry so the
-            // in-dock Reset button can restore it without reloading the file.
-            // Snapshot 0 is the automatic load-time snapshot and also seeds the
-            // manual snapshot history list.
-            if (!allAtoms.isEmpty()) {
-                captureInitialSnapshot(filePath, m_moleculeView->getCurrentFrameAtoms(),
-                    m_moleculeView->getCurrentFrameBonds());
-            }
-            fileLoaded = true;
-        } else {
-            m_moleculeView->clearScenePublic();
-            qWarning() << "Failed to parse XYZ file:" << filePath;
-        }
-    }
-    else if (suffix == "vtf") {
-        m_vtfParser = new VTFParser();
-        if (m_vtfParser->parseTrajectory(filePath)) {
-            // Load VTF data as text
-            QFile file(filePath);
-            if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                m_structureView->setPlainText(QString::fromUtf8(file.readAll()));
-                m_structureFileEdit->setText(QFileInfo(filePath).fileName());
-                file.close();
-            }
-
-            // Get frame count and setup trajectory data
-            int frameCount = m_vtfParser->getFrameCount();
-            DEBUG_LOG << "VTF: frameCount =" << frameCount;
-            m_moleculeView->setFrameCount(frameCount);
-
-            // Reset molecule viewer for new file
-            m_moleculeView->clearScenePublic();
-
-            // Convert all frames to trajectory data
-            QVector<QVector<MoleculeViewer::Atom>> allAtoms;
-            QVector<QVector<MoleculeViewer::Bond>> allBonds;
-
-            for (int i = 0; i < frameCount; ++i) {
-                VTFParser::VTFFrame frame;
-                if (m_vtfParser->getFrame(i, frame)) {
-                    QVector<MoleculeViewer::Atom> atoms;
-                    QVector<MoleculeViewer::Bond> bonds;
-                    VTFParser::convertToMoleculeViewer(frame, atoms, bonds);
-                    allAtoms.append(atoms);
-                    allBonds.append(bonds);
-                    DEBUG_LOG << "VTF: Loaded frame" << i << "- atoms:" << atoms.size() << "bonds:" << bonds.size();
-                } else {
-                    DEBUG_LOG << "VTF: Failed to load frame" << i;
-                }
-            }
-
-            DEBUG_LOG << "VTF: Total frames loaded:" << allAtoms.size();
-            m_moleculeView->setTrajectoryData(allAtoms, allBonds);
-            if (m_centerOnLoad) m_moleculeView->centerAtOrigin();
-
-            // Claude Generated - Feed first frame into the simulation widget.
-            if (m_simulationControlWidget && !allAtoms.isEmpty())
                 m_simulationControlWidget->setMolecule(m_moleculeView->getCurrentFrameAtoms(),
                     m_moleculeView->getCurrentFrameBonds());
-            // Claude Generated 2026 - Fresh load: clear the modified flag, cache
-            // the new source path (so a follow-up Save overwrites it), and
-            // enable the File>Save actions. The Save action is enabled as soon
-            // as a molecule is on screen, regardless of modification state.
             m_currentMoleculeFilePath = filePath;
             m_structureModified = false;
             if (m_simulationControlWidget)
                 m_simulationControlWidget->setStructureModified(false);
             if (m_saveAction) m_saveAction->setEnabled(true);
             if (m_saveAsAction) m_saveAsAction->setEnabled(true);
-            // Store an in-memory snapshot of the original geometry so the
-            // in-dock Reset button can restore it without reloading the file.
-            // Snapshot 0 is the automatic load-time snapshot and also seeds the
-            // manual snapshot history list.
-            if (!allAtoms.isEmpty()) {
-                captureInitialSnapshot(filePath, m_moleculeView->getCurrentFrameAtoms(),
-                    m_moleculeView->getCurrentFrameBonds());
-            }
+            captureInitialSnapshot(filePath, m_moleculeView->getCurrentFrameAtoms(),
+                m_moleculeView->getCurrentFrameBonds());
+            statusBar()->showMessage(tr("Session %1: %2 frames, %3 events%4")
+                .arg(QFileInfo(filePath).fileName())
+                .arg(recording->frameCount())
+                .arg(recording->events().size())
+                .arg(recording->recovered() ? tr(" (recording was not closed; events lost)") : QString()), 5000);
             fileLoaded = true;
         } else {
             m_moleculeView->clearScenePublic();
-            qWarning() << "Failed to parse VTF file:" << filePath;
+            qWarning() << "Failed to open session recording:" << recording->lastError();
+            statusBar()->showMessage(recording->lastError(), 5000);
         }
     }
     else if (suffix == "pdb" || suffix == "mol2") {
@@ -4321,27 +4301,167 @@ void MainWindow::loadMoleculeFile(const QString& filePath)
         statusBar()->showMessage(tr("Unsupported file format: %1").arg(suffix), 2000);
     }
 
-    // Claude Generated 2026 - "Open file follows its own directory" semantics.
-    // When a file is loaded successfully, the user almost always wants to
-    // work next to the file (output files, sidecar data, related files).
-    // We auto-switch the Working Directory to the file's parent directory.
-    // Failure cases (parse error, unsupported format) leave the current
-    // Working Directory untouched. switchWorkingDirectory already shows a
-    // status-bar message and updates recent files.
-    if (fileLoaded) {
-        const QString fileDir = QFileInfo(filePath).absolutePath();
-        if (!fileDir.isEmpty() && QDir(fileDir).exists() && fileDir != m_workingDirectory) {
-            switchWorkingDirectory(fileDir);
+    if (fileLoaded)
+        afterMoleculeFileLoaded(filePath);
+}
+
+// Claude Generated 2026 - "Open file follows its own directory" semantics.
+// When a file is loaded successfully, the user almost always wants to
+// work next to the file (output files, sidecar data, related files).
+// We auto-switch the Working Directory to the file's parent directory.
+// Failure cases (parse error, unsupported format) leave the current
+// Working Directory untouched. switchWorkingDirectory already shows a
+// status-bar message and updates recent files.
+void MainWindow::afterMoleculeFileLoaded(const QString& filePath)
+{
+    const QString fileDir = QFileInfo(filePath).absolutePath();
+    if (!fileDir.isEmpty() && QDir(fileDir).exists() && fileDir != m_workingDirectory) {
+        switchWorkingDirectory(fileDir);
+    }
+    // A fresh molecule resets the scene (clears any RMSD overlays); reset the RMSD
+    // workspace too so it does not keep stale aligned structures.
+    if (m_rmsdWidget)
+        m_rmsdWidget->clearWorkspace();
+    // Claude Generated 2026 - If this file belongs to an unpacked lesson (a
+    // lesson.json sidecar in its directory references it), restore the stored
+    // simulation conditions into the dock. No-op for ordinary files.
+    applyLessonConditions(filePath);
+}
+
+// Claude Generated 2026 - StructureLoader, frame 0: on screen right away. Until the load
+// finishes the window holds no file (no Save over the old path with a partial structure).
+void MainWindow::onStructureFirstFrame(const QString& filePath, const QVector<MoleculeViewer::Atom>& atoms,
+    const QVector<MoleculeViewer::Bond>& bonds, const QString& text)
+{
+    m_structSyncing = true;
+    auto syncGuard = qScopeGuard([this]() { m_structSyncing = false; });
+
+    m_structureView->setPlainText(text);
+    m_structureFileEdit->setText(QFileInfo(filePath).fileName());
+    m_moleculeView->clearScenePublic();
+    m_moleculeView->setTrajectoryData({ atoms }, { bonds });
+
+    m_currentMoleculeFilePath.clear();
+    if (m_saveAction) m_saveAction->setEnabled(false);
+    if (m_saveAsAction) m_saveAsAction->setEnabled(false);
+    m_loadFirstFrameShown = true;
+    statusBar()->showMessage(tr("Loading %1...").arg(QFileInfo(filePath).fileName()));
+}
+
+void MainWindow::onStructureLoadProgress(StructureLoader::Stage stage, qint64 done, qint64 total, int frames)
+{
+    QString label;
+    switch (stage) {
+    case StructureLoader::Stage::Parsing:
+        label = tr("Parsing: %1 frames").arg(frames);
+        break;
+    case StructureLoader::Stage::Indexing:
+        label = tr("Indexing");
+        break;
+    case StructureLoader::Stage::Bonds:
+        label = tr("Bonds");
+        break;
+    }
+    m_loadProgressBar->setFormat(label + QStringLiteral(" %p%"));
+    m_loadProgressBar->setValue(total > 0 ? int(1000 * done / total) : 0);
+    setLoadProgressVisible(true);
+}
+
+// Claude Generated 2026 - StructureLoader, whole file: hand the frames to the viewer and
+// do the bookkeeping of a finished load.
+void MainWindow::onStructureLoaded(const StructureLoader::Result& result)
+{
+    ProfileScope profile("load.upload");
+    m_structSyncing = true;
+    auto syncGuard = qScopeGuard([this]() { m_structSyncing = false; });
+    setLoadProgressVisible(false);
+    const QString filePath = result.filePath;
+    const QString fileName = QFileInfo(filePath).fileName();
+
+    if (result.streamed) {
+        // The worker built the frame index; this reader only loads the sidecar.
+        auto reader = QSharedPointer<XYZTrajectoryReader>::create();
+        if (!reader->open(filePath)) {
+            onStructureLoadFailed(filePath, reader->lastError());
+            return;
         }
-        // A fresh molecule resets the scene (clears any RMSD overlays); reset the RMSD
-        // workspace too so it does not keep stale aligned structures.
-        if (m_rmsdWidget)
-            m_rmsdWidget->clearWorkspace();
-        // Claude Generated 2026 - If this file belongs to an unpacked lesson (a
-        // lesson.json sidecar in its directory references it), restore the stored
-        // simulation conditions into the dock. No-op for ordinary files.
-        applyLessonConditions(filePath);
+        m_moleculeView->clearScenePublic();
+        m_moleculeView->setTrajectoryReader(reader);
+        if (m_centerOnLoad) m_moleculeView->centerAtOrigin();
+    } else if (result.store && result.frameCount > 1) {
+        // Frame 0 stays on screen; the viewer switches over to the packed trajectory.
+        m_moleculeView->setTrajectoryStore(result.store, result.bonds, result.explicitBonds);
+    } else if (!result.frames.isEmpty()) {
+        m_moleculeView->setTrajectoryData(result.frames, result.bonds);
+    }
+    // A single frame is already on screen as it is.
+    DEBUG_LOG << "StructureLoader:" << filePath << result.frameCount << "frames"
+              << (result.fromCache ? "(cache)" : result.streamed ? "(streamed)" : "");
+
+    if (m_simulationControlWidget)
+        m_simulationControlWidget->setMolecule(m_moleculeView->getCurrentFrameAtoms(),
+            m_moleculeView->getCurrentFrameBonds());
+    // Fresh load: clear the modified flag, cache the new source path (so a follow-up
+    // Save overwrites it), and enable the File>Save actions.
+    m_currentMoleculeFilePath = filePath;
+    m_structureModified = false;
+    if (m_simulationControlWidget)
+        m_simulationControlWidget->setStructureModified(false);
+    if (m_saveAction) m_saveAction->setEnabled(true);
+    if (m_saveAsAction) m_saveAsAction->setEnabled(true);
+    // Snapshot 0 is the automatic load-time snapshot (in-dock Reset button).
+    captureInitialSnapshot(filePath, m_moleculeView->getCurrentFrameAtoms(),
+        m_moleculeView->getCurrentFrameBonds());
+    if (result.streamed)
+        statusBar()->showMessage(tr("Streaming %1 frames from %2").arg(result.frameCount).arg(fileName), 3000);
+    else if (result.fromCache)
+        statusBar()->showMessage(tr("Loaded %1 (%2 frames) from cache").arg(fileName).arg(result.frameCount), 3000);
+    else
+        statusBar()->showMessage(tr("Loaded %1 (%2 frames)").arg(fileName).arg(result.frameCount), 3000);
+    syncGuard.dismiss();
+    m_structSyncing = false;
+
+    afterMoleculeFileLoaded(filePath);
+    if (m_pendingAutoStart) {
+        const SimulationConfig::Mode mode = *m_pendingAutoStart;
+        m_pendingAutoStart.reset();
+        autoStartSimulation(mode);
+    }
+}
+
+void MainWindow::onStructureLoadFailed(const QString& filePath, const QString& error)
+{
+    setLoadProgressVisible(false);
+    m_pendingAutoStart.reset();
+    m_moleculeView->clearScenePublic();
+    qWarning() << "Failed to load" << filePath << ":" << error;
+    statusBar()->showMessage(error, 5000);
+}
+
+void MainWindow::onStructureLoadCancelled(const QString& filePath)
+{
+    setLoadProgressVisible(false);
+    m_pendingAutoStart.reset();
+    if (m_loadFirstFrameShown) {
+        // Frame 0 alone is not the file; don't leave it looking like a loaded structure.
+        // Also runs from inside loadMoleculeFile, which holds m_structSyncing itself.
+        const bool wasSyncing = m_structSyncing;
+        m_structSyncing = true;
+        m_moleculeView->clearScenePublic();
+        m_structureView->clear();
+        m_structureFileEdit->clear();
+        m_structSyncing = wasSyncing;
+        m_loadFirstFrameShown = false;
     }
+    statusBar()->showMessage(tr("Loading of %1 aborted").arg(QFileInfo(filePath).fileName()), 3000);
+}
+
+void MainWindow::setLoadProgressVisible(bool visible)
+{
+    if (!visible)
+        m_loadProgressBar->reset();
+    m_loadProgressBar->setVisible(visible);
+    m_loadAbortButton->setVisible(visible);
 }
 
 #ifdef USE_SFTP
@@ -4943,9 +5063,7 @@ void MainWindow::createDockWidgets()
         m_outputView = m_outputViewDock->outputView();
     if (!m_outputView) {
         // Fallback if DockManager was not initialized; should not happen.
-        m_outputView = new QTextEdit;
-        m_outputView->setPlaceholderText(tr("Output"));
-        m_outputView->setReadOnly(true);
+        m_outputView = new LogView;
     }
     connect(m_outputViewDock, &OutputDock::clearRequested,
             this, &MainWindow::clearOutputView);
@@ -4966,6 +5084,26 @@ void MainWindow::createDockWidgets()
     chartDialogLayout->setContentsMargins(4, 4, 4, 4);
     chartDialogLayout->addWidget(m_simulationChartWidget);
 
+    // Claude Generated 2026 - trajectory RMSD / RMSF (TrajectoryAnalysis), same modeless
+    // pattern. Frames are read through the viewer's thread-safe frame source; the analysis
+    // stops when the trajectory is replaced or its stored coordinates are rewritten.
+    m_trajectoryAnalysisDialog = new QDialog(this);
+    m_trajectoryAnalysisDialog->setObjectName("TrajectoryAnalysisDialog");
+    m_trajectoryAnalysisDialog->setWindowTitle(tr("Trajectory RMSD / RMSF"));
+    m_trajectoryAnalysisDialog->setModal(false);
+    m_trajectoryAnalysisDialog->resize(720, 600);
+    m_trajectoryAnalysisWidget = new TrajectoryAnalysisWidget(m_trajectoryAnalysisDialog);
+    auto* analysisDialogLayout = new QVBoxLayout(m_trajectoryAnalysisDialog);
+    analysisDialogLayout->setContentsMargins(4, 4, 4, 4);
+    analysisDialogLayout->addWidget(m_trajectoryAnalysisWidget);
+    m_trajectoryAnalysisWidget->setSourceProvider(
+        [this]() { return m_moleculeView->trajectoryFrameSource(); });
+    m_trajectoryAnalysisWidget->trajectoryChanged(m_moleculeView->getFrameCount());
+    connect(m_moleculeView, &MoleculeViewer::trajectoryLoaded,
+        m_trajectoryAnalysisWidget, &TrajectoryAnalysisWidget::trajectoryChanged);
+    connect(m_moleculeView, &MoleculeViewer::frameDataAboutToChange,
+        m_trajectoryAnalysisWidget, &TrajectoryAnalysisWidget::stop);
+
     // ==================== INITIAL PLACEMENT ====================
     // Phase 4: all docks are now owned by DockManager. Ask it to place them in the
     // default areas and tabify/split as configured.
@@ -5121,6 +5259,13 @@ void MainWindow::wireSimulationWorker(SimulationWorker* worker)
         connect(worker, &SimulationWorker::frameReady,
             m_moleculeView, &MoleculeViewer::updateSimulationFrame,
             Qt::QueuedConnection);
+        // Claude Generated 2026 - Uncapped MD (fpsLimit 0) publishes into the worker's frame
+        // ring instead of emitting frameReady; the viewer pulls the newest step once per
+        // rendered frame and re-emits it as simulationFramePresented (wired below).
+        m_moleculeView->setSimulationFrameRing(worker->frameRing());
+        connect(worker, &SimulationWorker::framesAvailable,
+            m_moleculeView, &MoleculeViewer::requestSimulationFrame,
+            Qt::QueuedConnection);
         // Claude Generated 2026 - Phase 6: viewer drag → worker force injection.
         // QueuedConnection marshals the force matrix to the worker thread safely.
         connect(m_moleculeView, &MoleculeViewer::atomForceRequested,
@@ -5161,12 +5306,26 @@ void MainWindow::wireSimulationWorker(SimulationWorker* worker)
 
     // Claude Generated 2026 - Live charts: clear for the new run, then append every frame
     // (temperature + energies). The widget throttles its own axis rescaling.
+    for (const QMetaObject::Connection& c : std::as_const(m_presentedFrameConnections))
+        disconnect(c);
+    m_presentedFrameConnections.clear();
+    // Every frame consumer below listens to both paths; a run only uses one of them. The
+    // presented frame is only valid during delivery, hence direct (same-thread) connections.
+    auto connectPresented = [this](auto* receiver, auto slot) {
+        if (m_moleculeView)
+            m_presentedFrameConnections.append(connect(m_moleculeView,
+                &MoleculeViewer::simulationFramePresented, receiver, slot, Qt::DirectConnection));
+    };
+
     if (m_simulationChartWidget) {
         m_simulationChartWidget->reset();
         connect(worker, &SimulationWorker::frameReady,
             m_simulationChartWidget, &SimulationChartWidget::appendFrame,
             Qt::QueuedConnection);
+        connectPresented(m_simulationChartWidget, &SimulationChartWidget::appendFrame);
     }
+    if (m_simulationControlWidget)
+        connectPresented(m_simulationControlWidget, &SimulationControlWidget::onFrameReady);
 
     // Claude Generated 2026 - Re-sync the sim-dock m_atoms cache with the
     // viewer's *current* geometry before the new run starts. The
@@ -5183,36 +5342,63 @@ void MainWindow::wireSimulationWorker(SimulationWorker* worker)
 
     // Status-bar slot is a lambda so we don't need a Qt slot declaration.
     // Throttled to ~5 Hz to reduce per-frame GUI overhead.
-    connect(worker, &SimulationWorker::frameReady,
-        this, [this](SimulationFramePtr frame) {
-            if (!frame) return;
-            if (m_simStatusBarTimer.isValid() && m_simStatusBarTimer.elapsed() < 200)
-                return;
-            m_simStatusBarTimer.restart();
-            statusBar()->showMessage(
-                tr("Simulation step %1 | E = %2 Eh | Ekin = %3 Eh")
-                    .arg(frame->step)
-                    .arg(frame->energy, 0, 'f', 8)
-                    .arg(frame->ekin, 0, 'f', 6),
-                0);
-        },
-        Qt::QueuedConnection);
+    auto showStatus = [this](SimulationFramePtr frame) {
+        if (!frame) return;
+        if (m_simStatusBarTimer.isValid() && m_simStatusBarTimer.elapsed() < 200)
+            return;
+        m_simStatusBarTimer.restart();
+        statusBar()->showMessage(
+            tr("Simulation step %1 | E = %2 Eh | Ekin = %3 Eh")
+                .arg(frame->step)
+                .arg(frame->energy, 0, 'f', 8)
+                .arg(frame->ekin, 0, 'f', 6),
+            0);
+    };
+    connect(worker, &SimulationWorker::frameReady, this, showStatus, Qt::QueuedConnection);
+    connectPresented(this, showStatus);
+
+    // Claude Generated 2026 - Session recording: the worker opens the file when run()
+    // starts (Step-only workers never do) and closes it before finished().
+    if (m_simulationControlWidget && m_simulationControlWidget->currentConfig().recordSession) {
+        const QString dir = m_workingDirectory.isEmpty() ? QDir::currentPath() : m_workingDirectory;
+        const QString base = m_currentMoleculeFilePath.isEmpty()
+            ? QStringLiteral("session")
+            : QFileInfo(m_currentMoleculeFilePath).completeBaseName();
+        const QString path = QDir(dir).absoluteFilePath(QString("%1-%2.qrec")
+            .arg(base, QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+        auto recorder = QSharedPointer<SessionRecorder>::create(path);
+        worker->setRecorder(recorder);
+        connect(worker, &SimulationWorker::finished, this, [this, path]() {
+            if (QFileInfo::exists(path))
+                statusBar()->showMessage(tr("Session recorded to %1").arg(QFileInfo(path).fileName()), 5000);
+        });
+    }
 
     // Claude Generated 2026 - Auto-snapshot stride: if the user sets N > 0 in the
     // Snapshots tab, capture a snapshot every N-th simulation step/iteration.
+    // (Uncapped MD presents only some steps, so a stride step may be skipped there.)
+    auto autoSnapshot = [this](int step) {
+        if (step <= 0)
+            return;
+        const int stride = m_simulationControlWidget
+            ? m_simulationControlWidget->autoStride() : 0;
+        if (stride <= 0)
+            return;
+        if (step % stride != 0)
+            return;
+        takeSnapshot(tr("Auto step %1").arg(step));
+    };
     connect(worker, &SimulationWorker::frameReady,
-        this, [this](SimulationFramePtr frame) {
-            if (!frame || frame->step <= 0)
-                return;
-            const int stride = m_simulationControlWidget
-                ? m_simulationControlWidget->autoStride() : 0;
-            if (stride <= 0)
-                return;
-            if (frame->step % stride != 0)
-                return;
-            takeSnapshot(tr("Auto step %1").arg(frame->step));
+        this, [autoSnapshot](SimulationFramePtr frame) {
+            if (frame)
+                autoSnapshot(frame->step);
         },
         Qt::QueuedConnection);
+    // Presented frames arrive inside the render loop; snapshot after it returns.
+    connectPresented(this, [this, autoSnapshot](SimulationFramePtr frame) {
+        if (frame)
+            QTimer::singleShot(0, this, [autoSnapshot, step = frame->step]() { autoSnapshot(step); });
+    });
 }
 
 // Claude Generated (Apr 2026): Entry point for command-line file argument loading.
@@ -5240,6 +5426,10 @@ void MainWindow::autoStartSimulation(SimulationConfig::Mode mode)
 {
     if (!m_simulationControlWidget)
         return;
+    if (m_structureLoader && m_structureLoader->isLoading()) {
+        m_pendingAutoStart = mode;  // run by onStructureLoaded
+        return;
+    }
     if (m_simulationControlWidget->currentAtoms().isEmpty())
         return;  // load produced no molecule
     qDebug() << "autoStartSimulation: mode=" << static_cast<int>(mode)
@@ -24,8 +24,10 @@
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QPointer>  // Claude Generated - For dialog pointer management
+#include <QProgressBar>
 #include <QProcess>
 #include <QPushButton>
+#include <QSharedPointer>
 #include <QSpinBox>
 #include <QProgressDialog>
 #include <QStatusBar>
@@ -39,12 +41,14 @@
 #include <QVBoxLayout>
 #include <QWidget>
 #include <functional>
+#include <optional>
 
 #include "dialogs/nmrspectrumdialog.h"
 #include "modifiabletextedit.h"
 #include "widgets/breadcrumbbar.h"
 #include "snapshotswidget.h"  // Claude Generated 2026 - global MoleculeSnapshot + SnapshotsWidget
 #include "simulationworker.h"  // Claude Generated - for SimulationConfig
+#include "structureloader.h"  // Claude Generated 2026 - background XYZ/VTF loading
 #include "lesson.h"  // Claude Generated 2026 - OER teaching scenarios (Lesson model)
 class MoleculeViewer;
 class DisplayPanel;  // Claude Generated 2026 - docked viewer display options (replaces the modal dialog)
@@ -54,6 +58,7 @@ class WorkspaceManager;  // Claude Generated Phase 4 - Workspace management
 class AtomListPanel;  // Claude Generated Phase 2C - Atom list panel with table view
 class DockManager;          // Claude Generated 2026 - owns all docks and layout presets
 class OutputDock;           // Claude Generated 2026 - Output dock wrapper
+class LogView;              // Claude Generated 2026 - virtualised tail-follow output log
 class SimulationDock;       // Claude Generated 2026 - Simulation dock wrapper
 class DisplayDock; // Claude Generated 2026 - Structure & Display dock wrapper
 class ProjectDock;            // Claude Generated 2026 - Project dock wrapper
@@ -64,6 +69,8 @@ class SftpItemModel;  // Claude Generated - Remote Directory Mounting
 class SimulationControlWidget;  // Claude Generated - Interactive Simulation Integration
 class LessonStructureModel;     // Claude Generated 2026 - in-memory lesson structure list model
 class SimulationChartWidget;    // Claude Generated 2026 - live MD temperature/energy charts
+class SessionRecording;         // Claude Generated 2026 - memory-mapped .qrec session replay
+class TrajectoryAnalysisWidget; // Claude Generated 2026 - trajectory RMSD / RMSF charts
 class QDialog;                  // Claude Generated 2026 - host for the modeless charts dialog
 
 
@@ -365,7 +372,7 @@ private:
     QComboBox* m_programSelector;
     ModifiableTextEdit* m_structureView;  // Claude Generated - Phase 2.3
     ModifiableTextEdit* m_inputView;      // Claude Generated - Phase 2.3
-    QTextEdit* m_outputView;
+    LogView* m_outputView;  // Claude Generated 2026 - was QTextEdit (full re-read every second)
     QPushButton *m_newCalculationButton, *m_chooseDirectory, *m_runCalculation;
     QCheckBox* m_uniqueFileNames;
     QSpinBox* m_threads;
@@ -480,6 +487,21 @@ private:
     void captureInitialSnapshot(const QString& filePath,
         const QVector<MoleculeViewer::Atom>& atoms,
         const QVector<MoleculeViewer::Bond>& bonds);
+    // Claude Generated 2026 - XYZ/VTF files load in the background (StructureLoader):
+    // frame 0 is shown as soon as it is parsed, the trajectory once the file is read.
+    StructureLoader* m_structureLoader = nullptr;
+    QProgressBar* m_loadProgressBar = nullptr;    // status bar, only while a load runs
+    QToolButton* m_loadAbortButton = nullptr;
+    bool m_loadFirstFrameShown = false;
+    std::optional<SimulationConfig::Mode> m_pendingAutoStart;  // -md / -opt waiting for the load
+    void onStructureFirstFrame(const QString& filePath, const QVector<MoleculeViewer::Atom>& atoms,
+        const QVector<MoleculeViewer::Bond>& bonds, const QString& text);
+    void onStructureLoadProgress(StructureLoader::Stage stage, qint64 done, qint64 total, int frames);
+    void onStructureLoaded(const StructureLoader::Result& result);
+    void onStructureLoadFailed(const QString& filePath, const QString& error);
+    void onStructureLoadCancelled(const QString& filePath);
+    void setLoadProgressVisible(bool visible);
+    void afterMoleculeFileLoaded(const QString& filePath);
 
 #ifdef USE_SFTP
     QMenu* m_recentConnectionsMenu = nullptr;
@@ -525,6 +547,7 @@ private:
     SimulationDock* m_simulationDock = nullptr;     // Right: Simulation/Snapshots/RMSD/Input tabs (tabified with Structure&Display)
     OutputDock* m_outputViewDock = nullptr;         // Bottom: output log
     QDialog* m_simulationChartDialog = nullptr;     // Modeless dialog: live MD temperature/energy charts
+    QDialog* m_trajectoryAnalysisDialog = nullptr;  // Modeless dialog: trajectory RMSD / RMSF
     QTabWidget* m_simulationTabs = nullptr;         // Internal tabs inside m_simulationDock
 
     // Claude Generated 2026 - P2: Explore/Compute mode switch
@@ -535,11 +558,17 @@ private:
     QToolButton* m_computeButton = nullptr;
     SimulationControlWidget* m_simulationControlWidget = nullptr;  // Claude Generated
     SimulationChartWidget* m_simulationChartWidget = nullptr;     // Claude Generated 2026 - live T/energy charts
+    TrajectoryAnalysisWidget* m_trajectoryAnalysisWidget = nullptr;  // Claude Generated 2026 - RMSD/RMSF over frames
     SimulationConfig m_simulationConfig;             // Claude Generated - Shared config, edited from dock
 
     // Claude Generated - Interactive Simulation Integration
     QElapsedTimer m_simStatusBarTimer;  // Throttle status bar updates to ~5 Hz
+    // Claude Generated 2026 - Loaded .qrec session: per-frame step/energy/event status line.
+    QSharedPointer<SessionRecording> m_sessionRecording;
     void wireSimulationWorker(SimulationWorker* worker);  // Claude Generated - Direct worker->view wiring
+    // Claude Generated 2026 - per-run connections to MoleculeViewer::simulationFramePresented
+    // (uncapped MD); dropped when the next worker is wired.
+    QVector<QMetaObject::Connection> m_presentedFrameConnections;
     void onSimulationConfigChanged(SimulationConfig cfg);
 
 #ifdef USE_SFTP
@@ -2,51 +2,45 @@
 // Claude Generated - Phase 5C: Tripos MOL2 format support
 
 #include "mol2parser.h"
-#include <QStringList>
-#include <QFileInfo>
-#include <QRegularExpression>
+#include "elementdata.h"
+#include <climits>
 
 bool MOL2Parser::parseFile(const QString& filePath, MOL2Molecule& molecule)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    TextScanner in;
+    if (!in.open(filePath)) {
         m_lastError = QString("Cannot open file: %1").arg(filePath);
         return false;
     }
 
-    QTextStream in(&file);
     molecule.atoms.clear();
     molecule.bonds.clear();
+    m_symbols = SymbolCache();
 
-    QString line;
+    int atomCount = 0, bondCount = 0;
     while (!in.atEnd()) {
-        line = in.readLine().trimmed();
+        const QByteArrayView line = TextScanner::trimmed(in.readLine());
 
         // Look for section headers
         if (line == "@<TRIPOS>MOLECULE") {
-            int atomCount = 0, bondCount = 0;
             if (!parseMoleculeSection(in, molecule, atomCount, bondCount)) {
                 m_lastError = "Failed to parse MOLECULE section";
-                file.close();
                 return false;
             }
         } else if (line == "@<TRIPOS>ATOM") {
-            if (!parseAtomSection(in, molecule, molecule.atoms.capacity())) {
+            // Counts come from the MOLECULE record; without one, read until the next section
+            if (!parseAtomSection(in, molecule, atomCount > 0 ? atomCount : INT_MAX)) {
                 m_lastError = "Failed to parse ATOM section";
-                file.close();
                 return false;
             }
         } else if (line == "@<TRIPOS>BOND") {
-            if (!parseBondSection(in, molecule, molecule.bonds.capacity())) {
+            if (!parseBondSection(in, molecule, bondCount > 0 ? bondCount : INT_MAX)) {
                 m_lastError = "Failed to parse BOND section";
-                file.close();
                 return false;
             }
         }
     }
 
-    file.close();
-
     if (molecule.atoms.isEmpty()) {
         m_lastError = "No atoms found in MOL2 file";
         return false;
@@ -55,16 +49,15 @@ bool MOL2Parser::parseFile(const QString& filePath, MOL2Molecule& molecule)
     return true;
 }
 
-bool MOL2Parser::parseMoleculeSection(QTextStream& in, MOL2Molecule& molecule, int& atomCount, int& bondCount)
+bool MOL2Parser::parseMoleculeSection(TextScanner& in, MOL2Molecule& molecule, int& atomCount, int& bondCount)
 {
-    QString line;
-
     // First line after @<TRIPOS>MOLECULE is the molecule name
-    line = in.readLine();
+    QByteArrayView line = in.readLine();
     if (line.isEmpty()) {
         return false;
     }
-    molecule.name = line.trimmed();
+    line = TextScanner::trimmed(line);
+    molecule.name = QString::fromUtf8(line.data(), line.size());
 
     // Second line: counts and type
     line = in.readLine();
@@ -72,21 +65,22 @@ bool MOL2Parser::parseMoleculeSection(QTextStream& in, MOL2Molecule& molecule, i
         return false;
     }
 
-    QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-    if (parts.size() < 2) {
+    QByteArrayView parts[6];
+    const int count = TextScanner::splitFields(line, parts, 6);
+    if (count < 2) {
         return false;
     }
 
-    atomCount = parts[0].toInt();
-    bondCount = parts.size() > 1 ? parts[1].toInt() : 0;
-    molecule.type = parts.size() > 5 ? parts[5] : "SMALL";
+    atomCount = TextScanner::toInt(parts[0]);
+    bondCount = TextScanner::toInt(parts[1]);
+    molecule.type = count > 5 ? QString::fromLatin1(parts[5].data(), parts[5].size()) : QString("SMALL");
 
     // Skip comment and other lines until next section
     while (!in.atEnd()) {
-        qint64 pos = in.pos();
-        line = in.readLine().trimmed();
+        const qsizetype pos = in.pos();
+        line = TextScanner::trimmed(in.readLine());
 
-        if (line.startsWith("@")) {
+        if (line.startsWith('@')) {
             // Seek back to re-read this line in main loop
             in.seek(pos);
             break;
@@ -95,117 +89,117 @@ bool MOL2Parser::parseMoleculeSection(QTextStream& in, MOL2Molecule& molecule, i
         // Try to parse as molecule type or property
         if (line == "NO_CHARGES") {
             // Skip
-        } else if (!line.isEmpty() && !line.startsWith("#")) {
-            molecule.comment = line;
+        } else if (!line.isEmpty() && !line.startsWith('#')) {
+            molecule.comment = QString::fromUtf8(line.data(), line.size());
         }
     }
 
     return true;
 }
 
-bool MOL2Parser::parseAtomSection(QTextStream& in, MOL2Molecule& molecule, int atomCount)
+bool MOL2Parser::parseAtomSection(TextScanner& in, MOL2Molecule& molecule, int atomCount)
 {
-    QString line;
+    QByteArrayView parts[7];
     int parsed = 0;
 
+    if (atomCount != INT_MAX) {
+        molecule.atoms.reserve(atomCount);
+    }
+
     while (!in.atEnd() && parsed < atomCount) {
-        line = in.readLine().trimmed();
+        const qsizetype pos = in.pos();
+        const QByteArrayView line = TextScanner::trimmed(in.readLine());
 
-        if (line.isEmpty() || line.startsWith("@")) {
+        if (line.isEmpty() || line.startsWith('@')) {
             // End of atom section
-            if (line.startsWith("@")) {
+            if (line.startsWith('@')) {
                 // Seek back to re-read section header
-                qint64 pos = in.pos();
-                in.seek(pos - line.length() - 1);
+                in.seek(pos);
             }
             break;
         }
 
-        if (line.startsWith("#")) {
+        if (line.startsWith('#')) {
             // Comment line
             continue;
         }
 
-        QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-        if (parts.size() < 5) {
-            // Not enough fields
+        // Fields: atom_id name x y z atom_type [charge ...]
+        const int count = TextScanner::splitFields(line, parts, 7);
+        if (count < 6) {
+            // Not enough fields (atom_type is required)
             continue;
         }
 
         MOL2Atom atom;
-        try {
-            // Fields: atom_id name x y z atom_type [charge ...]
-            // atom_id is index (skip it)
-            atom.name = parts[1];
-            atom.x = parts[2].toFloat();
-            atom.y = parts[3].toFloat();
-            atom.z = parts[4].toFloat();
-            atom.type = parts[5];
-
-            // Charge is optional (field 7)
-            if (parts.size() > 6) {
-                atom.charge = parts[6];
-            }
-
-            molecule.atoms.append(atom);
-            parsed++;
-
-        } catch (...) {
-            // Skip malformed line
-            continue;
+        // atom_id is index (skip it)
+        atom.name = QString::fromLatin1(parts[1].data(), parts[1].size());  // unique per atom (C1, C2, ...)
+        atom.x = TextScanner::toFloat(parts[2]);
+        atom.y = TextScanner::toFloat(parts[3]);
+        atom.z = TextScanner::toFloat(parts[4]);
+        atom.type = m_symbols.intern(parts[5]);
+
+        // Charge is optional (field 7)
+        if (count > 6) {
+            atom.charge = QString::fromLatin1(parts[6].data(), parts[6].size());
         }
+
+        molecule.atoms.append(atom);
+        parsed++;
     }
 
     return parsed > 0;
 }
 
-bool MOL2Parser::parseBondSection(QTextStream& in, MOL2Molecule& molecule, int bondCount)
+bool MOL2Parser::parseBondSection(TextScanner& in, MOL2Molecule& molecule, int bondCount)
 {
-    QString line;
+    QByteArrayView parts[4];
     int parsed = 0;
 
-    while (!in.atEnd()) {
-        line = in.readLine().trimmed();
+    if (bondCount != INT_MAX) {
+        molecule.bonds.reserve(bondCount);
+    }
+
+    while (!in.atEnd() && parsed < bondCount) {
+        const qsizetype pos = in.pos();
+        const QByteArrayView line = TextScanner::trimmed(in.readLine());
 
-        if (line.isEmpty() || line.startsWith("@")) {
+        if (line.isEmpty() || line.startsWith('@')) {
             // End of bond section
+            if (line.startsWith('@')) {
+                in.seek(pos);
+            }
             break;
         }
 
-        if (line.startsWith("#")) {
+        if (line.startsWith('#')) {
             // Comment line
             continue;
         }
 
-        QStringList parts = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-        if (parts.size() < 3) {
+        // Fields: bond_id atom1 atom2 bond_type [status ...]
+        const int count = TextScanner::splitFields(line, parts, 4);
+        if (count < 3) {
             // Not enough fields
             continue;
         }
 
-        try {
-            MOL2Bond bond;
-            // Fields: bond_id atom1 atom2 bond_type [status ...]
-            bond.atom1 = parts[1].toInt() - 1;  // Convert to 0-based
-            bond.atom2 = parts[2].toInt() - 1;  // Convert to 0-based
-            bond.bondType = parseBondType(parts[3]);
-
-            // Sanity check
-            if (bond.atom1 >= 0 && bond.atom2 >= 0 && bond.atom1 != bond.atom2) {
-                molecule.bonds.append(bond);
-                parsed++;
-            }
+        MOL2Bond bond;
+        bond.atom1 = TextScanner::toInt(parts[1]) - 1;  // Convert to 0-based
+        bond.atom2 = TextScanner::toInt(parts[2]) - 1;  // Convert to 0-based
+        bond.bondType = count > 3 ? parseBondType(parts[3]) : 1;
 
-        } catch (...) {
-            // Skip malformed line
-            continue;
+        // Sanity check
+        if (bond.atom1 >= 0 && bond.atom2 >= 0 && bond.atom1 != bond.atom2) {
+            molecule.bonds.append(bond);
+            parsed++;
         }
     }
 
     return true;  // Bonds are optional
 }
 
-int MOL2Parser::parseBondType(const QString& typeStr)
+int MOL2Parser::parseBondType(QByteArrayView typeStr)
 {
     if (typeStr == "1") return 1;      // Single
     if (typeStr == "2") return 2;      // Double
@@ -241,6 +235,7 @@ void MOL2Parser::convertToMoleculeViewer(const MOL2Molecule& mol2Molecule,
     for (const MOL2Atom& mol2Atom : mol2Molecule.atoms) {
         MoleculeViewer::Atom atom;
         atom.element = extractElementFromSybylType(mol2Atom.type);
+        atom.atomicNumber = quint8(elem::atomicNumber(atom.element));
         atom.position = QVector3D(mol2Atom.x, mol2Atom.y, mol2Atom.z);
         atom.charge = 0.0f;  // Could parse from mol2Atom.charge if needed
         atoms.append(atom);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "textscanner.h"
 #include "view.h"
 #include <QString>
 #include <QVector>
@@ -89,22 +90,23 @@ private:
     /**
      * Parse MOLECULE section
      */
-    bool parseMoleculeSection(QTextStream& in, MOL2Molecule& molecule, int& atomCount, int& bondCount);
+    bool parseMoleculeSection(TextScanner& in, MOL2Molecule& molecule, int& atomCount, int& bondCount);
 
     /**
      * Parse ATOM section
      */
-    bool parseAtomSection(QTextStream& in, MOL2Molecule& molecule, int atomCount);
+    bool parseAtomSection(TextScanner& in, MOL2Molecule& molecule, int atomCount);
 
     /**
      * Parse BOND section
      */
-    bool parseBondSection(QTextStream& in, MOL2Molecule& molecule, int bondCount);
+    bool parseBondSection(TextScanner& in, MOL2Molecule& molecule, int bondCount);
 
     /**
      * Convert Sybyl bond type to integer (1=single, 2=double, 3=triple, 4=aromatic)
      */
-    static int parseBondType(const QString& typeStr);
+    static int parseBondType(QByteArrayView typeStr);
 
     QString m_lastError;  // Error message for debugging
+    SymbolCache m_symbols;  // Shared Sybyl types of the current parse
 };
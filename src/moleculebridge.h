@@ -8,6 +8,7 @@
 // the simulation code.
 #pragma once
 
+#include "elementdata.h"
 #include "view.h"  // MoleculeViewer::Atom
 
 #include <src/core/elements.h>
@@ -55,6 +56,7 @@ inline QVector<MoleculeViewer::Atom> moleculeToAtoms(const curcuma::Molecule& mo
         atom.element = (Z >= 0 && Z < static_cast<int>(Elements::ElementAbbr.size()))
             ? QString::fromStdString(Elements::ElementAbbr[Z])
             : QStringLiteral("X");
+        atom.atomicNumber = (Z > 0 && Z <= elem::kMaxAtomicNumber) ? quint8(Z) : 0;
         atom.position = QVector3D(static_cast<float>(a.second.x()),
             static_cast<float>(a.second.y()),
             static_cast<float>(a.second.z()));
@@ -0,0 +1,164 @@
+// neighborgrid.cpp - Uniform-grid (cell list) neighbour search
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "neighborgrid.h"
+
+#include <algorithm>
+
+namespace {
+// Upper bound on the number of cells relative to the atom count. Sparse gas-phase
+// snapshots (two fragments far apart) would otherwise allocate a huge, almost empty
+// grid; the cell edge is grown instead (correct for any cutoff <= cell edge).
+constexpr qint64 kMaxCellsPerAtom = 8;
+constexpr qint64 kMinCellBudget = 4096;
+}
+
+void NeighborGrid::clear()
+{
+    m_count = 0;
+    m_nx = m_ny = m_nz = 0;
+    m_head.clear();
+    m_next.clear();
+    m_prev.clear();
+    m_cellOf.clear();
+}
+
+void NeighborGrid::build(const QVector3D* positions, int count, float cellSize)
+{
+    clear();
+    if (count <= 0 || cellSize <= 0.0f)
+        return;
+
+    // Bounds over binnable atoms only; with none at all the grid is a single padded cell.
+    QVector3D mn, mx;
+    bool any = false;
+    for (int i = 0; i < count; ++i) {
+        const QVector3D& p = positions[i];
+        if (!isBinnable(p))
+            continue;
+        if (!any) {
+            mn = mx = p;
+            any = true;
+            continue;
+        }
+        mn = QVector3D(qMin(mn.x(), p.x()), qMin(mn.y(), p.y()), qMin(mn.z(), p.z()));
+        mx = QVector3D(qMax(mx.x(), p.x()), qMax(mx.y(), p.y()), qMax(mx.z(), p.z()));
+    }
+
+    // One spare cell on each side absorbs per-frame drift before update() has to
+    // fall back to a rebuild.
+    const qint64 budget = std::max(kMinCellBudget, kMaxCellsPerAtom * count);
+    float edge = cellSize;
+    qint64 nx = 0, ny = 0, nz = 0;
+    for (;;) {
+        const QVector3D extent = mx - mn;
+        nx = static_cast<qint64>(extent.x() / edge) + 3;
+        ny = static_cast<qint64>(extent.y() / edge) + 3;
+        nz = static_cast<qint64>(extent.z() / edge) + 3;
+        if (nx * ny * nz <= budget)
+            break;
+        edge *= 1.5f;
+    }
+
+    m_cellSize = edge;
+    m_invCell = 1.0f / edge;
+    m_origin = mn - QVector3D(edge, edge, edge);
+    m_nx = static_cast<int>(nx);
+    m_ny = static_cast<int>(ny);
+    m_nz = static_cast<int>(nz);
+    m_count = count;
+
+    m_head.fill(-1, m_nx * m_ny * m_nz);
+    m_next.fill(-1, count);
+    m_prev.fill(-1, count);
+    m_cellOf.fill(-1, count);
+    // Link in reverse so each cell list ends up in ascending atom order.
+    for (int i = count - 1; i >= 0; --i) {
+        const int c = cellOf(positions[i]);
+        if (c >= 0)
+            link(i, c);
+    }
+}
+
+bool NeighborGrid::update(const QVector3D* positions, int count)
+{
+    if (count != m_count || m_count == 0) {
+        build(positions, count, m_cellSize);
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        bool inside = true;
+        const int c = cellOf(positions[i], &inside);
+        if (!inside) {
+            build(positions, count, m_cellSize);
+            return false;
+        }
+        if (c != m_cellOf[i]) {
+            if (m_cellOf[i] >= 0)
+                unlink(i);
+            if (c >= 0)
+                link(i, c);
+        }
+    }
+    return true;
+}
+
+bool NeighborGrid::move(int atom, const QVector3D& position)
+{
+    bool inside = true;
+    const int c = cellOf(position, &inside);
+    if (!inside)
+        return false;
+    if (c != m_cellOf[atom]) {
+        if (m_cellOf[atom] >= 0)
+            unlink(atom);
+        if (c >= 0)
+            link(atom, c);
+    }
+    return true;
+}
+
+int NeighborGrid::cellOf(const QVector3D& p, bool* inside) const
+{
+    if (!isBinnable(p)) {
+        if (inside)
+            *inside = true;
+        return -1;
+    }
+    const QVector3D rel = (p - m_origin) * m_invCell;
+    int x = static_cast<int>(std::floor(rel.x()));
+    int y = static_cast<int>(std::floor(rel.y()));
+    int z = static_cast<int>(std::floor(rel.z()));
+    const bool in = x >= 0 && y >= 0 && z >= 0 && x < m_nx && y < m_ny && z < m_nz;
+    if (inside)
+        *inside = in;
+    x = qBound(0, x, m_nx - 1);
+    y = qBound(0, y, m_ny - 1);
+    z = qBound(0, z, m_nz - 1);
+    return (z * m_ny + y) * m_nx + x;
+}
+
+void NeighborGrid::link(int atom, int cell)
+{
+    const int h = m_head[cell];
+    m_next[atom] = h;
+    m_prev[atom] = -1;
+    if (h >= 0)
+        m_prev[h] = atom;
+    m_head[cell] = atom;
+    m_cellOf[atom] = cell;
+}
+
+void NeighborGrid::unlink(int atom)
+{
+    const int p = m_prev[atom];
+    const int n = m_next[atom];
+    if (p >= 0)
+        m_next[p] = n;
+    else
+        m_head[m_cellOf[atom]] = n;
+    if (n >= 0)
+        m_prev[n] = p;
+    m_next[atom] = m_prev[atom] = -1;
+    m_cellOf[atom] = -1;
+}
@@ -0,0 +1,144 @@
+// neighborgrid.h - Uniform-grid (cell list) neighbour search
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - O(N) bond perception / neighbour queries.
+//
+// Space is partitioned into cubic cells of edge >= the largest interaction cutoff,
+// so every pair within the cutoff lies in the same or an adjacent cell. Cells are
+// kept as intrusive doubly linked lists (head/next/prev index arrays), which makes
+// moving an atom between cells O(1): update() re-bins only atoms whose cell changed
+// since the previous frame (live MD) instead of rebuilding from scratch.
+//
+// Non-finite positions (NaN/inf read from a file, a blown-up MD step) and absurdly
+// distant ones are not binned: such atoms have no neighbours until they move back.
+
+#pragma once
+
+#include <QVector3D>
+#include <QVector>
+
+#include <cmath>
+
+class NeighborGrid
+{
+public:
+    NeighborGrid() = default;
+
+    /** Bin @p count positions into cells of edge @p cellSize (Angstrom). The grid
+     *  bounds are padded by a margin so small per-frame drifts stay inside. */
+    void build(const QVector3D* positions, int count, float cellSize);
+    void build(const QVector<QVector3D>& positions, float cellSize)
+    {
+        build(positions.constData(), positions.size(), cellSize);
+    }
+
+    /** Incrementally re-bin after the positions moved (same atom count). Only atoms
+     *  that crossed a cell boundary are relinked. Falls back to a full build() when
+     *  the count changed or an atom left the padded bounds.
+     *  @return true if the update was incremental, false if a rebuild was needed. */
+    bool update(const QVector3D* positions, int count);
+
+    /** Re-bin a single atom that moved to @p position (O(1)). A non-finite position
+     *  just unbins the atom.
+     *  @return false if it left the padded bounds; the caller must build() again. */
+    bool move(int atom, const QVector3D& position);
+
+    void clear();
+    bool isEmpty() const { return m_count == 0; }
+    int atomCount() const { return m_count; }
+    float cellSize() const { return m_cellSize; }
+
+    /** Visit every unordered candidate pair (i < j) whose distance is <= @p cutoff
+     *  (must not exceed cellSize()). @p fn is called as fn(i, j, distanceSquared). */
+    template <typename Fn>
+    void forEachPair(const QVector3D* positions, float cutoff, Fn&& fn) const;
+
+    /** Visit every atom within @p cutoff (<= cellSize()) of @p point.
+     *  @p fn is called as fn(j, distanceSquared). */
+    template <typename Fn>
+    void forEachNeighbor(const QVector3D* positions, const QVector3D& point, float cutoff, Fn&& fn) const;
+
+private:
+    // Beyond this (Angstrom) a coordinate is garbage; it also keeps extent / edge in qint64.
+    static constexpr float kMaxCoordinate = 1.0e9f;
+    static bool isBinnable(const QVector3D& p)
+    {
+        return std::abs(p.x()) <= kMaxCoordinate && std::abs(p.y()) <= kMaxCoordinate
+            && std::abs(p.z()) <= kMaxCoordinate;  // false for NaN as well
+    }
+    /// Cell of @p p, -1 if it is not binnable (@p inside is true then: a rebuild won't help).
+    int cellOf(const QVector3D& p, bool* inside = nullptr) const;
+    void link(int atom, int cell);
+    void unlink(int atom);
+
+    float m_cellSize = 0.0f;
+    float m_invCell = 0.0f;
+    QVector3D m_origin;
+    int m_nx = 0, m_ny = 0, m_nz = 0;
+    int m_count = 0;
+
+    QVector<int> m_head;    // first atom per cell (-1 = empty)
+    QVector<int> m_next;    // next atom in the same cell (-1 = end)
+    QVector<int> m_prev;    // previous atom in the same cell (-1 = head)
+    QVector<int> m_cellOf;  // current cell of each atom (-1 = not binned)
+};
+
+template <typename Fn>
+void NeighborGrid::forEachPair(const QVector3D* positions, float cutoff, Fn&& fn) const
+{
+    if (m_count == 0)
+        return;
+    const float cut2 = cutoff * cutoff;
+    // Half-shell stencil: the own cell plus 13 of the 26 neighbours, so each cell
+    // pair is visited exactly once.
+    static const int kStencil[13][3] = {
+        { 1, 0, 0 }, { -1, 1, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+        { -1, -1, 1 }, { 0, -1, 1 }, { 1, -1, 1 }, { -1, 0, 1 }, { 0, 0, 1 },
+        { 1, 0, 1 }, { -1, 1, 1 }, { 0, 1, 1 }, { 1, 1, 1 }
+    };
+    for (int cz = 0; cz < m_nz; ++cz) {
+        for (int cy = 0; cy < m_ny; ++cy) {
+            for (int cx = 0; cx < m_nx; ++cx) {
+                const int c = (cz * m_ny + cy) * m_nx + cx;
+                for (int i = m_head[c]; i >= 0; i = m_next[i]) {
+                    const QVector3D pi = positions[i];
+                    // Same cell: pairs after i in the list.
+                    for (int j = m_next[i]; j >= 0; j = m_next[j]) {
+                        const float d2 = (positions[j] - pi).lengthSquared();
+                        if (d2 <= cut2)
+                            fn(qMin(i, j), qMax(i, j), d2);
+                    }
+                    for (const auto& s : kStencil) {
+                        const int nx = cx + s[0], ny = cy + s[1], nz = cz + s[2];
+                        if (nx < 0 || ny < 0 || nz < 0 || nx >= m_nx || ny >= m_ny || nz >= m_nz)
+                            continue;
+                        for (int j = m_head[(nz * m_ny + ny) * m_nx + nx]; j >= 0; j = m_next[j]) {
+                            const float d2 = (positions[j] - pi).lengthSquared();
+                            if (d2 <= cut2)
+                                fn(qMin(i, j), qMax(i, j), d2);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void NeighborGrid::forEachNeighbor(const QVector3D* positions, const QVector3D& point, float cutoff, Fn&& fn) const
+{
+    if (m_count == 0 || !isBinnable(point))
+        return;
+    const float cut2 = cutoff * cutoff;
+    const QVector3D rel = (point - m_origin) * m_invCell;
+    const int px = static_cast<int>(std::floor(rel.x()));
+    const int py = static_cast<int>(std::floor(rel.y()));
+    const int pz = static_cast<int>(std::floor(rel.z()));
+    for (int nz = qMax(pz - 1, 0); nz <= qMin(pz + 1, m_nz - 1); ++nz)
+        for (int ny = qMax(py - 1, 0); ny <= qMin(py + 1, m_ny - 1); ++ny)
+            for (int nx = qMax(px - 1, 0); nx <= qMin(px + 1, m_nx - 1); ++nx)
+                for (int j = m_head[(nz * m_ny + ny) * m_nx + nx]; j >= 0; j = m_next[j]) {
+                    const float d2 = (positions[j] - point).lengthSquared();
+                    if (d2 <= cut2)
+                        fn(j, d2);
+                }
+}
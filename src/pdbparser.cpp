@@ -2,41 +2,44 @@
 // Claude Generated - Phase 5C: Protein Data Bank format support
 
 #include "pdbparser.h"
+#include "elementdata.h"
+#include "neighborgrid.h"
+#include "profiler.h"
+#include "textscanner.h"
 #include <QStringList>
 #include <QFileInfo>
+#include <algorithm>
 #include <cmath>
 
 bool PDBParser::parseFile(const QString& filePath, PDBFrame& frame)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    TextScanner in;
+    if (!in.open(filePath)) {
         m_lastError = QString("Cannot open file: %1").arg(filePath);
         return false;
     }
 
-    m_frames.clear();
-    m_bonds.clear();
+    resetParseState();
 
-    QTextStream in(&file);
     PDBFrame currentFrame;
     currentFrame.title = "";
     currentFrame.remark = "";
 
     while (!in.atEnd()) {
-        QString line = in.readLine();
+        const QByteArrayView line = in.readLine();
         if (line.isEmpty()) continue;
 
-        QString record = line.mid(0, 6).trimmed();  // Record name
+        const QByteArrayView record = TextScanner::column(line, 0, 6);  // Record name
 
         if (record == "TITLE") {
             // Extract title (columns 11-80)
-            currentFrame.title += line.mid(10);
+            currentFrame.title += restOfLine(line, 10);
         } else if (record == "REMARK") {
             // Store remark
             if (!currentFrame.remark.isEmpty()) {
                 currentFrame.remark += "\n";
             }
-            currentFrame.remark += line.mid(10);
+            currentFrame.remark += restOfLine(line, 10);
         } else if (record == "ATOM" || record == "HETATM") {
             // Parse atom record
             PDBAtom atom;
@@ -63,8 +66,6 @@ bool PDBParser::parseFile(const QString& filePath, PDBFrame& frame)
         m_frames.append(currentFrame);
     }
 
-    file.close();
-
     if (m_frames.isEmpty()) {
         m_lastError = "No atoms found in PDB file";
         return false;
@@ -81,23 +82,22 @@ bool PDBParser::parseFile(const QString& filePath, PDBFrame& frame)
 
 bool PDBParser::parseTrajectory(const QString& filePath)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    ProfileScope profile("parse.pdb");
+    TextScanner in;
+    if (!in.open(filePath)) {
         m_lastError = QString("Cannot open file: %1").arg(filePath);
         return false;
     }
 
-    m_frames.clear();
-    m_bonds.clear();
+    resetParseState();
 
-    QTextStream in(&file);
     PDBFrame currentFrame;
 
     while (!in.atEnd()) {
-        QString line = in.readLine();
+        const QByteArrayView line = in.readLine();
         if (line.isEmpty()) continue;
 
-        QString record = line.mid(0, 6).trimmed();
+        const QByteArrayView record = TextScanner::column(line, 0, 6);
 
         if (record == "ATOM" || record == "HETATM") {
             PDBAtom atom;
@@ -121,8 +121,6 @@ bool PDBParser::parseTrajectory(const QString& filePath)
         m_frames.append(currentFrame);
     }
 
-    file.close();
-
     if (m_frames.isEmpty()) {
         m_lastError = "No atoms found in PDB file";
         return false;
@@ -145,123 +143,90 @@ bool PDBParser::getFrame(int frameIndex, PDBFrame& frame) const
     return true;
 }
 
-bool PDBParser::parseAtomRecord(const QString& line, PDBAtom& atom)
+void PDBParser::resetParseState()
+{
+    m_frames.clear();
+    m_bonds.clear();
+    m_bondKeys.clear();
+    m_symbols = SymbolCache();
+}
+
+QString PDBParser::restOfLine(QByteArrayView line, qsizetype from)
+{
+    return from < line.size() ? QString::fromLatin1(line.data() + from, line.size() - from) : QString();
+}
+
+bool PDBParser::parseAtomRecord(QByteArrayView line, PDBAtom& atom)
 {
     // PDB format uses fixed columns (1-based in spec, 0-based in code)
-    if (line.length() < 54) {  // Minimum length for coordinates
+    if (line.size() < 54) {  // Minimum length for coordinates
         return false;
     }
 
-    try {
-        // Serial number (columns 7-11)
-        int serial = line.mid(6, 5).trimmed().toInt();
-
-        // Atom name (columns 13-16) - includes space for chirality
-        QString atomName = line.mid(12, 4).trimmed();
-
-        // Alternate location (column 17) - skip if not blank or 'A'
-        QChar altLoc = line.length() > 16 ? line[16] : ' ';
-        if (altLoc != ' ' && altLoc != 'A') {
-            return false;  // Skip alternate conformations
-        }
-
-        // Residue name (columns 18-20)
-        QString residueName = line.mid(17, 3).trimmed();
-
-        // Chain identifier (column 22)
-        char chain = line.length() > 21 ? line[21].toLatin1() : ' ';
+    // Alternate location (column 17) - skip if not blank or 'A'
+    const char altLoc = line[16];
+    if (altLoc != ' ' && altLoc != 'A') {
+        return false;  // Skip alternate conformations
+    }
 
-        // Residue number (columns 23-26)
-        int residueNumber = line.mid(22, 4).trimmed().toInt();
+    // Atom name (columns 13-16) - includes space for chirality
+    const QByteArrayView atomName = TextScanner::column(line, 12, 4);
 
-        // Coordinates (columns 31-38, 39-46, 47-54)
-        float x = line.mid(30, 8).trimmed().toFloat();
-        float y = line.mid(38, 8).trimmed().toFloat();
-        float z = line.mid(46, 8).trimmed().toFloat();
+    // Residue name (columns 18-20)
+    const QByteArrayView residueName = TextScanner::column(line, 17, 3);
 
-        // Occupancy (columns 55-60) - default 1.0
-        float occupancy = 1.0f;
-        if (line.length() >= 60) {
-            QString occStr = line.mid(54, 6).trimmed();
-            if (!occStr.isEmpty()) {
-                occupancy = occStr.toFloat();
-            }
-        }
+    // Chain identifier (column 22)
+    atom.chain = line[21];
 
-        // Temperature factor (columns 61-66) - default 0.0
-        float temperature = 0.0f;
-        if (line.length() >= 66) {
-            QString tempStr = line.mid(60, 6).trimmed();
-            if (!tempStr.isEmpty()) {
-                temperature = tempStr.toFloat();
-            }
-        }
+    // Residue number (columns 23-26)
+    atom.residueNumber = TextScanner::toInt(TextScanner::column(line, 22, 4));
 
-        // Element symbol (columns 77-78) - try explicit, otherwise derive from name
-        QString element = "";
-        if (line.length() >= 78) {
-            element = line.mid(76, 2).trimmed();
-        }
-        if (element.isEmpty()) {
-            element = extractElementSymbol(atomName);
-        }
+    // Coordinates (columns 31-38, 39-46, 47-54)
+    atom.x = TextScanner::toFloat(TextScanner::column(line, 30, 8));
+    atom.y = TextScanner::toFloat(TextScanner::column(line, 38, 8));
+    atom.z = TextScanner::toFloat(TextScanner::column(line, 46, 8));
 
-        atom.element = element;
-        atom.name = atomName;
-        atom.residueName = residueName;
-        atom.chain = chain;
-        atom.residueNumber = residueNumber;
-        atom.x = x;
-        atom.y = y;
-        atom.z = z;
-        atom.occupancy = occupancy;
-        atom.temperature = temperature;
+    // Occupancy (columns 55-60) - default 1.0; temperature factor (61-66) - default 0.0
+    atom.occupancy = TextScanner::toFloat(TextScanner::column(line, 54, 6), 1.0f);
+    atom.temperature = TextScanner::toFloat(TextScanner::column(line, 60, 6), 0.0f);
 
-        return true;
+    // Names repeat across residues and models: share one QString per distinct token.
+    atom.name = m_symbols.intern(atomName);
+    atom.residueName = m_symbols.intern(residueName);
 
-    } catch (...) {
-        return false;
+    // Element symbol (columns 77-78) - try explicit, otherwise derive from name
+    const QByteArrayView element = TextScanner::column(line, 76, 2);
+    if (element.isEmpty()) {
+        atom.element = extractElementSymbol(atom.name);
+        atom.atomicNumber = quint8(elem::atomicNumber(atom.element));
+    } else {
+        atom.element = m_symbols.intern(element, atom.atomicNumber);
     }
+
+    return true;
 }
 
-void PDBParser::parseConectRecord(const QString& line)
+void PDBParser::parseConectRecord(QByteArrayView line)
 {
     // CONECT records: columns 7-11 (main atom), then pairs of columns 12-16, 17-21, 22-26, 27-31
-    if (line.length() < 11) return;
+    if (line.size() < 11) return;
 
-    int atom1 = line.mid(6, 5).trimmed().toInt();
+    const int atom1 = TextScanner::toInt(TextScanner::column(line, 6, 5));
 
-    // Parse bonded atom indices
-    QVector<int> bonded;
     for (int i = 0; i < 4; ++i) {
-        int startCol = 11 + (i * 5);
-        if (line.length() > startCol + 5) {
-            QString bondStr = line.mid(startCol, 5).trimmed();
-            if (!bondStr.isEmpty()) {
-                int atom2 = bondStr.toInt();
-                if (atom2 > 0 && atom2 != atom1) {
-                    bonded.append(atom2);
-                }
-            }
+        const int atom2 = TextScanner::toInt(TextScanner::column(line, 11 + (i * 5), 5));
+        if (atom2 <= 0 || atom2 == atom1) {
+            continue;
         }
-    }
 
-    // Add bonds (avoid duplicates)
-    for (int atom2 : bonded) {
         PDBBond bond;
         bond.atom1 = qMin(atom1, atom2);
         bond.atom2 = qMax(atom1, atom2);
 
-        // Check if bond already exists
-        bool exists = false;
-        for (const PDBBond& existing : m_bonds) {
-            if (existing.atom1 == bond.atom1 && existing.atom2 == bond.atom2) {
-                exists = true;
-                break;
-            }
-        }
-
-        if (!exists) {
+        // CONECT lists every bond from both ends; keep the first occurrence only
+        const quint64 key = (quint64(quint32(bond.atom1)) << 32) | quint32(bond.atom2);
+        if (!m_bondKeys.contains(key)) {
+            m_bondKeys.insert(key);
             m_bonds.append(bond);
         }
     }
@@ -283,7 +248,7 @@ QString PDBParser::extractElementSymbol(const QString& atomName, const QString&
     QString second = atomName[1].toLower();
 
     // Two-letter elements
-    QStringList twoLetterElements = {"He", "Li", "Be", "Ne", "Na", "Mg", "Al", "Si", "Cl", "Ar", "Ca", "Ti", "Cr", "Mn", "Fe", "Co", "Ni", "Cu", "Zn", "Br", "Kr", "Sr", "Zr", "Ag", "Cd", "Sn", "Xe", "Ba", "Pt", "Au", "Hg", "Pb"};
+    static const QStringList twoLetterElements = {"He", "Li", "Be", "Ne", "Na", "Mg", "Al", "Si", "Cl", "Ar", "Ca", "Ti", "Cr", "Mn", "Fe", "Co", "Ni", "Cu", "Zn", "Br", "Kr", "Sr", "Zr", "Ag", "Cd", "Sn", "Xe", "Ba", "Pt", "Au", "Hg", "Pb"};
 
     QString twoLetter = first + second;
     if (twoLetterElements.contains(twoLetter)) {
@@ -294,52 +259,55 @@ QString PDBParser::extractElementSymbol(const QString& atomName, const QString&
     return first;
 }
 
-float PDBParser::getCovalentRadius(const QString& element)
+float PDBParser::getCovalentRadius(int atomicNumber)
 {
-    // Covalent radii (in Angstroms) from CRC Handbook
-    static const QMap<QString, float> radii = {
-        {"H", 0.31f},  {"C", 0.76f},  {"N", 0.71f},  {"O", 0.66f},
-        {"P", 1.07f},  {"S", 1.05f},  {"Cl", 1.02f}, {"Br", 1.20f},
-        {"I", 1.39f},  {"Fe", 1.32f}, {"Cu", 1.32f}, {"Zn", 1.22f},
-        {"Se", 1.22f}, {"As", 1.19f}, {"F", 0.64f},  {"B", 0.84f},
-    };
-
-    return radii.value(element, 1.5f);  // Default 1.5Å for unknown elements
+    // Covalent radii (in Angstroms) from the shared periodic table
+    return atomicNumber > 0 ? elem::covalentRadius(atomicNumber) : 1.5f;  // Default 1.5Å for unknown elements
 }
 
 void PDBParser::detectBonds(const PDBFrame& frame)
 {
     m_bonds.clear();
 
-    const float BOND_DISTANCE_CUTOFF = 1.8f;  // Angstroms
-
-    for (int i = 0; i < frame.atoms.size(); ++i) {
-        for (int j = i + 1; j < frame.atoms.size(); ++j) {
-            const PDBAtom& a1 = frame.atoms[i];
-            const PDBAtom& a2 = frame.atoms[j];
-
-            // Skip bonds between different chains
-            if (a1.chain != a2.chain && a1.chain != ' ' && a2.chain != ' ') {
-                continue;
-            }
+    const float BOND_SLACK = 0.4f;  // Angstroms added to the sum of covalent radii
+
+    // Claude Generated 2026 - cell-list search (NeighborGrid, shared with MoleculeViewer):
+    // radii are resolved once per atom and only atoms in adjacent cells are compared.
+    const int n = frame.atoms.size();
+    QVector<QVector3D> pos(n);
+    QVector<float> radii(n);
+    float maxR = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        const PDBAtom& a = frame.atoms[i];
+        pos[i] = QVector3D(a.x, a.y, a.z);
+        radii[i] = getCovalentRadius(a.atomicNumber);
+        maxR = qMax(maxR, radii[i]);
+    }
 
-            // Calculate distance
-            float dx = a2.x - a1.x;
-            float dy = a2.y - a1.y;
-            float dz = a2.z - a1.z;
-            float distance = std::sqrt(dx*dx + dy*dy + dz*dz);
+    const float cutoff = 2.0f * maxR + BOND_SLACK;
+    NeighborGrid grid;
+    grid.build(pos, cutoff);
+    grid.forEachPair(pos.constData(), cutoff, [&](int i, int j, float d2) {
+        const PDBAtom& a1 = frame.atoms[i];
+        const PDBAtom& a2 = frame.atoms[j];
 
-            // Sum of covalent radii + threshold
-            float maxDist = getCovalentRadius(a1.element) + getCovalentRadius(a2.element) + 0.4f;
+        // Skip bonds between different chains
+        if (a1.chain != a2.chain && a1.chain != ' ' && a2.chain != ' ') {
+            return;
+        }
 
-            if (distance < maxDist && distance > 0.1f) {  // >0.1 to avoid zero distance
-                PDBBond bond;
-                bond.atom1 = i;
-                bond.atom2 = j;
-                m_bonds.append(bond);
-            }
+        // Sum of covalent radii + threshold; >0.1 to avoid zero distance
+        const float maxDist = radii[i] + radii[j] + BOND_SLACK;
+        if (d2 < maxDist * maxDist && d2 > 0.01f) {
+            PDBBond bond;
+            bond.atom1 = i;
+            bond.atom2 = j;
+            m_bonds.append(bond);
         }
-    }
+    });
+    std::sort(m_bonds.begin(), m_bonds.end(), [](const PDBBond& a, const PDBBond& b) {
+        return a.atom1 != b.atom1 ? a.atom1 < b.atom1 : a.atom2 < b.atom2;
+    });
 }
 
 void PDBParser::convertToMoleculeViewer(const PDBFrame& pdbFrame,
@@ -354,6 +322,7 @@ void PDBParser::convertToMoleculeViewer(const PDBFrame& pdbFrame,
     for (const PDBAtom& pdbAtom : pdbFrame.atoms) {
         MoleculeViewer::Atom atom;
         atom.element = pdbAtom.element;
+        atom.atomicNumber = pdbAtom.atomicNumber;
         atom.position = QVector3D(pdbAtom.x, pdbAtom.y, pdbAtom.z);
         atom.charge = 0.0f;  // PDB doesn't typically contain charge
         atoms.append(atom);
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include "textscanner.h"
 #include "view.h"
+#include <QByteArrayView>
+#include <QSet>
 #include <QString>
 #include <QVector>
 #include <QFile>
@@ -47,6 +50,7 @@ public:
         float x, y, z;            // Coordinates in Angstroms
         float occupancy;          // Occupancy factor (0-1)
         float temperature;        // B-factor (temperature factor)
+        quint8 atomicNumber = 0;  // Resolved from element (elem::atomicNumber)
     };
 
     struct PDBFrame {
@@ -123,12 +127,18 @@ private:
      * Parse ATOM/HETATM record
      * Fixed-width format per PDB specification
      */
-    bool parseAtomRecord(const QString& line, PDBAtom& atom);
+    bool parseAtomRecord(QByteArrayView line, PDBAtom& atom);
 
     /**
      * Parse CONECT (connectivity) record
      */
-    void parseConectRecord(const QString& line);
+    void parseConectRecord(QByteArrayView line);
+
+    /// Clear frames, bonds and interned symbols before a new parse
+    void resetParseState();
+
+    /// Columns [from, end) of a record as text (TITLE/REMARK payloads)
+    static QString restOfLine(QByteArrayView line, qsizetype from);
 
     /**
      * Extract element symbol from atom name
@@ -137,11 +147,13 @@ private:
     QString extractElementSymbol(const QString& atomName, const QString& explicit_element = "");
 
     /**
-     * Get covalent radius for element (in Angstroms)
+     * Get covalent radius for an atomic number (in Angstroms)
      */
-    static float getCovalentRadius(const QString& element);
+    static float getCovalentRadius(int atomicNumber);
 
     QVector<PDBFrame> m_frames;   // All models from file
     QVector<PDBBond> m_bonds;     // Explicit bonds from CONECT records
+    QSet<quint64> m_bondKeys;     // (atom1, atom2) keys of m_bonds for O(1) de-duplication
+    SymbolCache m_symbols;        // Shared atom/residue/element strings of the current parse
     QString m_lastError;          // Error message for debugging
 };
@@ -35,6 +35,7 @@ void PerformanceOptimizer::setQualityMode(QualityMode mode)
             case Fast: modeName = "Fast (LOD reduced)"; break;
             case Balanced: modeName = "Balanced"; break;
             case HighQuality: modeName = "High Quality"; break;
+            case Impostor: modeName = "Impostors (ray-cast spheres/cylinders)"; break;
         }
 
         emit qualityModeChanged(mode);
@@ -45,6 +46,7 @@ void PerformanceOptimizer::setQualityMode(QualityMode mode)
 int PerformanceOptimizer::getSphereRings() const
 {
     switch (m_qualityMode) {
+        case Impostor:
         case Fast: return 8;
         case Balanced: return 16;
         case HighQuality: return 32;
@@ -55,6 +57,7 @@ int PerformanceOptimizer::getSphereRings() const
 int PerformanceOptimizer::getSphereSlices() const
 {
     switch (m_qualityMode) {
+        case Impostor:
         case Fast: return 8;
         case Balanced: return 16;
         case HighQuality: return 32;
@@ -65,6 +68,7 @@ int PerformanceOptimizer::getSphereSlices() const
 int PerformanceOptimizer::getBondSlices() const
 {
     switch (m_qualityMode) {
+        case Impostor:
         case Fast: return 8;
         case Balanced: return 16;
         case HighQuality: return 16;
@@ -72,6 +76,19 @@ int PerformanceOptimizer::getBondSlices() const
     return 16;
 }
 
+float PerformanceOptimizer::getImpostorThreshold() const
+{
+    // Claude Generated 2026 - fraction of the view height (atom diameter) below which a
+    // mesh sphere is indistinguishable from its impostor
+    switch (m_qualityMode) {
+        case Fast: return 0.02f;
+        case Balanced: return 0.01f;
+        case HighQuality:
+        case Impostor: return 0.0f;
+    }
+    return 0.0f;
+}
+
 void PerformanceOptimizer::setFrustumCullingEnabled(bool enabled)
 {
     if (m_frustumCullingEnabled != enabled) {
@@ -117,17 +134,55 @@ void PerformanceOptimizer::recordFrame()
 {
     m_framesSinceLastUpdate++;
     m_frameCount++;
+}
 
-    // Adaptive quality adjustment
-    if (m_adaptiveQualityEnabled && m_frameCount % 60 == 0) {
-        updateAdaptiveQuality();
+void PerformanceOptimizer::recordFrameTime(double ms)
+{
+    // Claude Generated 2026 - frame-time driven tier selection. The viewer renders on
+    // demand, so only real frames are sampled; idle time never counts as slow. A window
+    // over budget lowers the ceiling one tier for the current structure; it is never
+    // raised again automatically (that would oscillate between a slow and a fast tier).
+    recordFrame();
+    m_frameTimeSum += ms;
+    if (++m_frameSamples < kFrameSamples)
+        return;
+    m_frameTimeMs = m_frameTimeSum / m_frameSamples;
+    m_frameTimeSum = 0.0;
+    m_frameSamples = 0;
+    if (!m_adaptiveQualityEnabled || m_frameTimeMs <= kFrameBudgetMs || m_qualityMode == Impostor)
+        return;
+
+    switch (m_qualityMode) {
+        case HighQuality: m_ceiling = Balanced; break;
+        case Balanced: m_ceiling = Fast; break;
+        case Fast:
+        case Impostor: m_ceiling = Impostor; break;
+    }
+    emit optimizationStatusChanged(QString("Frame time %1 ms over the %2 ms budget, reducing detail")
+                                       .arg(m_frameTimeMs, 0, 'f', 1)
+                                       .arg(kFrameBudgetMs, 0, 'f', 1));
+    updateAdaptiveQuality();
+}
+
+int PerformanceOptimizer::detailRank(QualityMode mode)
+{
+    switch (mode) {
+        case Impostor: return 0;
+        case Fast: return 1;
+        case Balanced: return 2;
+        case HighQuality: return 3;
     }
+    return 2;
 }
 
 void PerformanceOptimizer::setAtomCount(int count)
 {
     if (m_atomCount != count) {
         m_atomCount = count;
+        // Claude Generated 2026 - a new structure starts from its atom-count recommendation
+        m_ceiling = HighQuality;
+        m_frameTimeSum = 0.0;
+        m_frameSamples = 0;
 
         if (m_adaptiveQualityEnabled) {
             updateAdaptiveQuality();
@@ -139,6 +194,9 @@ void PerformanceOptimizer::updateAdaptiveQuality()
 {
     // Claude Generated - Phase 3B: Adaptive quality based on atom count
     QualityMode recommendedMode = recommendQualityMode(m_atomCount);
+    // Claude Generated 2026 - capped by what the measured frame times allowed
+    if (detailRank(recommendedMode) > detailRank(m_ceiling))
+        recommendedMode = m_ceiling;
 
     if (recommendedMode != m_qualityMode) {
         QString warning = getPerformanceWarning(m_atomCount);
@@ -153,7 +211,9 @@ void PerformanceOptimizer::updateAdaptiveQuality()
 
 QString PerformanceOptimizer::getPerformanceWarning(int atomCount) const
 {
-    if (atomCount > 5000) {
+    if (atomCount > 20000) {
+        return "Very large structure (>20000 atoms). Rendering ray-cast impostors instead of meshes.";
+    } else if (atomCount > 5000) {
         return "Large molecule detected (>5000 atoms). Performance may be reduced. Consider using Fast mode.";
     } else if (atomCount > 2000) {
         return "Medium-large molecule (>2000 atoms). Performance optimizations recommended.";
@@ -167,7 +227,9 @@ QString PerformanceOptimizer::getPerformanceWarning(int atomCount) const
 PerformanceOptimizer::QualityMode PerformanceOptimizer::recommendQualityMode(int atomCount) const
 {
     // Claude Generated - Phase 3B: Auto-select quality based on atom count
-    if (atomCount > 5000) {
+    if (atomCount > 20000) {
+        return Impostor;  // Claude Generated 2026 - 12 triangles per bond, 2 per atom
+    } else if (atomCount > 5000) {
         return Fast;  // <30 rings/slices
     } else if (atomCount > 2000) {
         return Fast;
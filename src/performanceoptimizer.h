@@ -14,6 +14,11 @@
  * - Frustum culling: Skip rendering off-screen atoms
  * - Quality presets: Fast/Balanced/High-Quality modes
  * - Performance monitoring: FPS tracking and bottleneck detection
+ *
+ * Claude Generated 2026 - the settings now reach the Quick3D renderer through
+ * SceneController::setLevelOfDetail() (view.cpp). The starting mode follows the atom
+ * count; measured frame costs (recordFrameTime(), sync + render + swap of each frame)
+ * step it down while they exceed kFrameBudgetMs, down to the ray-cast Impostor tier.
  */
 class PerformanceOptimizer : public QObject
 {
@@ -23,9 +28,14 @@ public:
     enum QualityMode {
         Fast = 0,         // Low quality, high speed (LOD: 8 rings/slices)
         Balanced = 1,     // Medium quality, medium speed (LOD: 16 rings/slices)
-        HighQuality = 2   // High quality, lower speed (LOD: 32 rings/slices)
+        HighQuality = 2,  // High quality, lower speed (LOD: 32 rings/slices)
+        Impostor = 3      // Claude Generated 2026 - ray-cast sphere/cylinder impostors, no meshes
     };
 
+    // Claude Generated 2026 - adaptive tier selection from measured frame times
+    static constexpr double kFrameBudgetMs = 1000.0 / 30.0;  // costlier frames step the tier down
+    static constexpr int kFrameSamples = 60;                 // frames per adaptive decision
+
     explicit PerformanceOptimizer(QObject *parent = nullptr);
     ~PerformanceOptimizer();
 
@@ -40,6 +50,10 @@ public:
     // Bond geometry quality
     int getBondSlices() const;
 
+    // Claude Generated 2026 - distance LOD: atoms covering less than this fraction of the
+    // view height are drawn as impostors even in the mesh modes (0 = never)
+    float getImpostorThreshold() const;
+
     // Optimization features
     void setFrustumCullingEnabled(bool enabled);
     bool isFrustumCullingEnabled() const { return m_frustumCullingEnabled; }
@@ -51,6 +65,7 @@ public:
     void startMonitoring();
     void stopMonitoring();
     float getAverageFPS() const { return m_averageFPS; }
+    double getAverageFrameTime() const { return m_frameTimeMs; }  // ms, mean of the last window
     int getFrameCount() const { return m_frameCount; }
     int getAtomCount() const { return m_atomCount; }
 
@@ -65,13 +80,15 @@ signals:
 
 public slots:
     void recordFrame();  // Call once per frame to track FPS
+    void recordFrameTime(double ms);  // Claude Generated 2026 - recordFrame() + cost of that frame
     void setAtomCount(int count);
 
 private:
     void updateAdaptiveQuality();
+    static int detailRank(QualityMode mode);   // Impostor < Fast < Balanced < HighQuality
 
     QualityMode m_qualityMode = Balanced;
-    bool m_frustumCullingEnabled = false;
+    bool m_frustumCullingEnabled = true;
     bool m_adaptiveQualityEnabled = true;
 
     // Performance monitoring
@@ -80,6 +97,12 @@ private:
     int m_frameCount = 0;
     int m_framesSinceLastUpdate = 0;
     int m_atomCount = 0;
+
+    // Claude Generated 2026 - frame-time feedback
+    double m_frameTimeMs = 0.0;
+    double m_frameTimeSum = 0.0;    // current decision window
+    int m_frameSamples = 0;
+    QualityMode m_ceiling = HighQuality;  // best mode still allowed for this structure
 };
 
 #endif // PERFORMANCEOPTIMIZER_H
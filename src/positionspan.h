@@ -0,0 +1,32 @@
+// positionspan.h - Read-only view of a contiguous coordinate block
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - shared by TrajectoryStore, MoleculeViewer and SceneController
+// (C++17: no std::span).
+
+#pragma once
+
+#include <QVector3D>
+#include <QVector>
+
+/// Read-only view of one frame's coordinates (QVector3D == 3 contiguous floats).
+struct PositionSpan {
+    const QVector3D* data = nullptr;
+    int size = 0;
+
+    PositionSpan() = default;
+    PositionSpan(const QVector3D* d, int n)
+        : data(d)
+        , size(n)
+    {
+    }
+    PositionSpan(const QVector<QVector3D>& v)
+        : data(v.constData())
+        , size(int(v.size()))
+    {
+    }
+
+    bool isEmpty() const { return size == 0; }
+    const QVector3D& operator[](int i) const { return data[i]; }
+    const QVector3D* begin() const { return data; }
+    const QVector3D* end() const { return data + size; }
+};
@@ -0,0 +1,243 @@
+// profiler.cpp - Per-stage frame-time instrumentation (HUD statistics + Chrome trace)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+
+#include "profiler.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+
+namespace {
+const QElapsedTimer& profilerClock()
+{
+    static const QElapsedTimer timer = [] {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+// Nearest-rank percentile of an unsorted window (reorders @p v).
+double percentile(QVector<float>& v, double p)
+{
+    if (v.isEmpty())
+        return 0.0;
+    const int k = std::clamp(int(p * v.size() + 0.5) - 1, 0, int(v.size()) - 1);
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+void appendEscaped(QByteArray& out, const QString& text)
+{
+    for (const QChar c : text) {
+        if (c == QLatin1Char('"') || c == QLatin1Char('\\'))
+            out.append('\\');
+        if (c.unicode() < 0x20)
+            continue;
+        out.append(QString(c).toUtf8());
+    }
+}
+}
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    profilerClock();   // time base starts no later than the profiler
+    return profiler;
+}
+
+qint64 Profiler::now()
+{
+    return profilerClock().nsecsElapsed();
+}
+
+void Profiler::setStatisticsEnabled(bool on)
+{
+    if (on)
+        m_flags.fetchAndOrRelaxed(Statistics);
+    else
+        m_flags.fetchAndAndRelaxed(~Statistics);
+}
+
+void Profiler::setTracing(bool on)
+{
+    if (on) {
+        QMutexLocker lock(&m_mutex);
+        m_trace.clear();
+        m_droppedEvents = 0;
+        m_flags.fetchAndOrRelaxed(Tracing);
+    } else {
+        m_flags.fetchAndAndRelaxed(~Tracing);
+    }
+}
+
+int Profiler::stageIndex(const char* stage)
+{
+    const auto it = m_stageByPointer.constFind(stage);
+    if (it != m_stageByPointer.constEnd())
+        return it.value();
+    const QString name = QString::fromLatin1(stage);
+    int index = m_stageByName.value(name, -1);
+    if (index < 0) {
+        index = m_stages.size();
+        Stage s;
+        s.name = name;
+        s.samples.reserve(kHistory);
+        m_stages.append(s);
+        m_stageByName.insert(name, index);
+    }
+    m_stageByPointer.insert(stage, index);
+    return index;
+}
+
+int Profiler::threadIndex()
+{
+    const Qt::HANDLE handle = QThread::currentThreadId();
+    const auto it = m_threadByHandle.constFind(handle);
+    if (it != m_threadByHandle.constEnd())
+        return it.value();
+    QThread* thread = QThread::currentThread();
+    QString name = thread ? thread->objectName() : QString();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+        name = QStringLiteral("GUI");
+    else if (name.isEmpty())
+        name = QStringLiteral("thread %1").arg(m_threadNames.size());
+    const int index = m_threadNames.size();
+    m_threadNames.append(name);
+    m_threadByHandle.insert(handle, index);
+    return index;
+}
+
+void Profiler::record(const char* stage, qint64 startNs, qint64 endNs)
+{
+    const int flags = m_flags.loadRelaxed();
+    if (!flags)
+        return;
+    const qint64 duration = std::max<qint64>(0, endNs - startNs);
+    QMutexLocker lock(&m_mutex);
+    const int index = stageIndex(stage);
+    Stage& s = m_stages[index];
+    s.last = float(duration * 1e-6);
+    ++s.count;
+    if (flags & Statistics) {
+        if (s.samples.size() < kHistory)
+            s.samples.append(s.last);
+        else
+            s.samples[s.next] = s.last;
+        s.next = (s.next + 1) % kHistory;
+    }
+    if (flags & Tracing) {
+        if (m_trace.size() < kMaxTraceEvents)
+            m_trace.append({ index, threadIndex(), startNs, duration });
+        else
+            ++m_droppedEvents;
+    }
+}
+
+QVector<Profiler::StageStats> Profiler::statistics() const
+{
+    QVector<StageStats> result;
+    QMutexLocker lock(&m_mutex);
+    result.reserve(m_stages.size());
+    for (const Stage& s : m_stages) {
+        if (s.samples.isEmpty())
+            continue;
+        StageStats st;
+        st.name = s.name;
+        st.count = s.count;
+        st.lastMs = s.last;
+        QVector<float> window = s.samples;
+        st.maxMs = *std::max_element(window.cbegin(), window.cend());
+        st.p50Ms = percentile(window, 0.50);
+        st.p95Ms = percentile(window, 0.95);
+        st.p99Ms = percentile(window, 0.99);
+        result.append(st);
+    }
+    return result;
+}
+
+void Profiler::resetStatistics()
+{
+    QMutexLocker lock(&m_mutex);
+    for (Stage& s : m_stages) {
+        s.samples.clear();
+        s.next = 0;
+        s.count = 0;
+        s.last = 0.0f;
+    }
+}
+
+int Profiler::traceEventCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_trace.size();
+}
+
+bool Profiler::writeChromeTrace(const QString& filePath, QString* error) const
+{
+    QVector<TraceEvent> events;
+    QVector<QString> stages, threads;
+    qint64 dropped = 0;
+    {
+        QMutexLocker lock(&m_mutex);
+        events = m_trace;
+        for (const Stage& s : m_stages)
+            stages.append(s.name);
+        threads = m_threadNames;
+        dropped = m_droppedEvents;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    // Timestamps in microseconds (the trace-event unit), relative to the profiler start.
+    QByteArray out;
+    out.reserve(1 << 20);
+    out.append("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":");
+    out.append(QByteArray::number(dropped));
+    out.append("},\"traceEvents\":[");
+    const char* separator = "\n";
+    for (int t = 0; t < threads.size(); ++t) {
+        out.append(separator);
+        separator = ",\n";
+        out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        out.append(QByteArray::number(t));
+        out.append(",\"args\":{\"name\":\"");
+        appendEscaped(out, threads[t]);
+        out.append("\"}}");
+    }
+    for (const TraceEvent& e : events) {
+        out.append(separator);
+        separator = ",\n";
+        out.append("{\"name\":\"");
+        appendEscaped(out, stages[e.stage]);
+        out.append("\",\"cat\":\"qurcuma\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+        out.append(QByteArray::number(e.thread));
+        out.append(",\"ts\":");
+        out.append(QByteArray::number(e.startNs * 1e-3, 'f', 3));
+        out.append(",\"dur\":");
+        out.append(QByteArray::number(e.durationNs * 1e-3, 'f', 3));
+        out.append("}");
+        if (out.size() > (1 << 20)) {
+            file.write(out);
+            out.clear();
+        }
+    }
+    out.append("\n]}\n");
+    file.write(out);
+    if (!file.flush()) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+// profiler.h - Per-stage frame-time instrumentation (HUD statistics + Chrome trace)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - where did a slow frame go?
+//
+// Stages are named by string literals ("scene.rebuildGeometry", "md.step", ...) and timed
+// with a ProfileScope on whatever thread runs them (GUI, Quick render thread, simulation
+// worker). Two independent consumers:
+//
+//   statistics  each stage keeps its last kHistory durations in a ring; statistics()
+//               returns p50/p95/p99/max over that window (the viewer HUD polls it)
+//   tracing     every scope becomes a complete ("X") event; writeChromeTrace() emits the
+//               JSON loaded by chrome://tracing / Perfetto, one track per thread
+//
+// While both are off a ProfileScope costs one relaxed atomic load.
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+class Profiler
+{
+public:
+    static constexpr int kHistory = 512;               // samples per stage for the percentiles
+    static constexpr int kMaxTraceEvents = 1 << 21;    // ~64 MB; later events are counted, not kept
+
+    struct StageStats {
+        QString name;
+        qint64 count = 0;   // samples since reset (the percentiles cover the last kHistory)
+        double lastMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    static Profiler& instance();
+
+    /// True while statistics or tracing is on; ProfileScope checks this before timing.
+    bool active() const { return m_flags.loadRelaxed() != 0; }
+    void setStatisticsEnabled(bool on);
+    bool statisticsEnabled() const { return m_flags.loadRelaxed() & Statistics; }
+    /// Starting a trace drops the previous one.
+    void setTracing(bool on);
+    bool tracing() const { return m_flags.loadRelaxed() & Tracing; }
+
+    /// Monotonic nanoseconds since the profiler was created.
+    static qint64 now();
+    /// Record one interval of @p stage (a string literal) on the calling thread.
+    void record(const char* stage, qint64 startNs, qint64 endNs);
+
+    /// Stages in order of first appearance.
+    QVector<StageStats> statistics() const;
+    void resetStatistics();
+
+    int traceEventCount() const;
+    /// Write the recorded trace as Chrome trace-event JSON.
+    bool writeChromeTrace(const QString& filePath, QString* error = nullptr) const;
+
+private:
+    Profiler() = default;
+
+    enum Flag { Statistics = 1, Tracing = 2 };
+
+    struct Stage {
+        QString name;
+        QVector<float> samples;   // ring of durations (ms)
+        int next = 0;
+        qint64 count = 0;
+        float last = 0.0f;
+    };
+    struct TraceEvent {
+        int stage;
+        int thread;
+        qint64 startNs;
+        qint64 durationNs;
+    };
+
+    int stageIndex(const char* stage);   // m_mutex held
+    int threadIndex();                   // m_mutex held
+
+    QAtomicInt m_flags;
+    mutable QMutex m_mutex;
+    QHash<const char*, int> m_stageByPointer;   // fast path: same literal
+    QHash<QString, int> m_stageByName;          // same name from another translation unit
+    QVector<Stage> m_stages;
+    QHash<Qt::HANDLE, int> m_threadByHandle;
+    QVector<QString> m_threadNames;
+    QVector<TraceEvent> m_trace;
+    qint64 m_droppedEvents = 0;
+};
+
+/// Times the enclosing block as @p stage (a string literal) when the profiler is active.
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* stage)
+        : m_stage(Profiler::instance().active() ? stage : nullptr)
+        , m_start(m_stage ? Profiler::now() : 0)
+    {
+    }
+    ~ProfileScope()
+    {
+        if (m_stage)
+            Profiler::instance().record(m_stage, m_start, Profiler::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_stage;
+    qint64 m_start;
+};
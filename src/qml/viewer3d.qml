@@ -15,7 +15,7 @@ Item {
     View3D {
         id: view3D
         anchors.fill: parent
-        camera: camera
+        camera: controller.tileProjectionActive ? tileCamera : camera
 
         environment: ExtendedSceneEnvironment {
             // Transparent clear for image export/compositing; otherwise the scene colour.
@@ -85,6 +85,13 @@ Item {
                 DirectionalLight { eulerRotation.x: 30;  eulerRotation.y: 30;  brightness: 0.7; visible: controller.cornerLight2; castsShadow: false }
                 DirectionalLight { eulerRotation.x: 30;  eulerRotation.y: -30; brightness: 0.7; visible: controller.cornerLight3; castsShadow: false }
             }
+            // Tiled image export: same pose, off-axis projection of one tile (the corner
+            // lights above stay parented to the main camera at the same position).
+            CustomCamera {
+                id: tileCamera
+                z: controller.cameraDistance
+                projection: controller.tileProjection
+            }
         }
 
         // World-fixed key light -> world-fixed cast shadows.
@@ -116,10 +123,12 @@ Item {
             pivot: controller.sceneCenter
             rotation: controller.rootRotation
 
+            // Primary atoms/bonds use the controller's LOD meshes (tessellation from
+            // PerformanceOptimizer); culled chunks are simply absent from the tables.
             Model {
                 id: atomModel
-                source: "#Sphere"
-                visible: controller.atomsVisible
+                geometry: controller.sphereGeometry
+                visible: controller.atomsVisible && controller.atomMeshActive
                 instancing: controller.atomInstancing
                 materials: PrincipledMaterial {
                     baseColor: "white"
@@ -134,8 +143,8 @@ Item {
 
             Model {
                 id: bondModel
-                source: "#Cylinder"
-                visible: controller.bondsVisible
+                geometry: controller.cylinderGeometry
+                visible: controller.bondsVisible && !controller.bondImpostorsActive
                 instancing: controller.bondInstancing
                 materials: PrincipledMaterial {
                     baseColor: "white"
@@ -146,6 +155,46 @@ Item {
                 }
             }
 
+            // Ray-cast impostors (far chunks / large systems): a camera-facing quad per
+            // atom and the cylinder's bounding box per half-bond, both shaded in the
+            // fragment shader with true depth. Unshaded materials: the screen-fixed
+            // corner lights are evaluated in the shader, scene lights/SSAO do not apply.
+            Model {
+                id: atomImpostorModel
+                source: "#Rectangle"
+                visible: controller.atomsVisible && controller.atomImpostorsActive
+                instancing: controller.atomImpostorInstancing
+                materials: CustomMaterial {
+                    shadingMode: CustomMaterial.Unshaded
+                    cullMode: Material.NoCulling
+                    vertexShader: "qrc:/shaders/src/shaders/atom_impostor.vert"
+                    fragmentShader: "qrc:/shaders/src/shaders/atom_impostor.frag"
+                    sourceBlend: controller.blendEnabled ? CustomMaterial.SrcAlpha : CustomMaterial.NoBlend
+                    destinationBlend: controller.blendEnabled ? CustomMaterial.OneMinusSrcAlpha : CustomMaterial.NoBlend
+                    property vector4d cornerLights: Qt.vector4d(controller.cornerLight0 ? 1 : 0,
+                                                                controller.cornerLight1 ? 1 : 0,
+                                                                controller.cornerLight2 ? 1 : 0,
+                                                                controller.cornerLight3 ? 1 : 0)
+                }
+            }
+            Model {
+                id: bondImpostorModel
+                source: "#Cube"
+                visible: controller.bondsVisible && controller.bondImpostorsActive
+                instancing: controller.bondInstancing
+                materials: CustomMaterial {
+                    shadingMode: CustomMaterial.Unshaded
+                    vertexShader: "qrc:/shaders/src/shaders/bond_impostor.vert"
+                    fragmentShader: "qrc:/shaders/src/shaders/bond_impostor.frag"
+                    sourceBlend: controller.blendEnabled ? CustomMaterial.SrcAlpha : CustomMaterial.NoBlend
+                    destinationBlend: controller.blendEnabled ? CustomMaterial.OneMinusSrcAlpha : CustomMaterial.NoBlend
+                    property vector4d cornerLights: Qt.vector4d(controller.cornerLight0 ? 1 : 0,
+                                                                controller.cornerLight1 ? 1 : 0,
+                                                                controller.cornerLight2 ? 1 : 0,
+                                                                controller.cornerLight3 ? 1 : 0)
+                }
+            }
+
             // RMSD overlay: second structure, opaque, with HSV-shifted element
             // colours (set per-instance) so it reads as the "other" molecule while
             // staying element-coded. Shares the molecule's rotation.
@@ -289,6 +338,25 @@ Item {
         }
     }
 
+    // Frame-time HUD (2D overlay, top-left): per-stage percentiles from the profiler.
+    Rectangle {
+        visible: controller.profilerVisible
+        anchors { left: parent.left; top: parent.top; margins: 8 }
+        width: profilerHudText.implicitWidth + 16
+        height: profilerHudText.implicitHeight + 10
+        radius: 5
+        color: "#cc101418"
+        border.color: "#5affffff"
+        Text {
+            id: profilerHudText
+            anchors.centerIn: parent
+            color: "#d8e6ff"
+            font.pixelSize: 11
+            font.family: "monospace"
+            text: controller.profilerText
+        }
+    }
+
     // Measurement result label (2D overlay).
     Rectangle {
         visible: controller.measurementActive
@@ -7,6 +7,7 @@
 // overlays. Per structure the table shows the plain + permutation RMSD and offers a
 // colour tint, a size and a visibility toggle, plus removal. Backed by curcuma's
 // RMSDDriver; decoupled from the viewer via signals (MainWindow drives it).
+// Conformer clustering (ConformerClustering) shares the job pool and progress row.
 #include "rmsdwidget.h"
 
 #include "moleculebridge.h"
@@ -36,15 +37,20 @@ using json = nlohmann::json;
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
+#include <QMenu>
 #include <QMessageBox>
 #include <QPlainTextEdit>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QRadioButton>
 #include <QSpinBox>
 #include <QTableWidget>
 #include <QTableWidgetItem>
+#include <QThread>
+#include <QThreadPool>
 #include <QVBoxLayout>
 
+#include <algorithm>
 #include <vector>
 
 namespace {
@@ -60,15 +66,29 @@ enum Column {
     ColRemove,     // remove button
     ColCount
 };
+
+// A file ensemble can split into thousands of clusters at a tight threshold; beyond this
+// many representatives the overlay workspace stops being readable.
+constexpr int kMaxClusterOverlays = 50;
 }
 
 RMSDWidget::RMSDWidget(QWidget* parent)
     : QWidget(parent)
+    , m_pool(new QThreadPool(this))
 {
     setupUI();
     updateButtons();
 }
 
+RMSDWidget::~RMSDWidget()
+{
+    // Jobs post their results to this widget; let the running ones finish first.
+    if (m_cancelFlag)
+        m_cancelFlag->storeRelaxed(1);
+    m_pool->clear();
+    m_pool->waitForDone();
+}
+
 void RMSDWidget::setupUI()
 {
     auto* mainLayout = new QVBoxLayout(this);
@@ -102,6 +122,16 @@ void RMSDWidget::setupUI()
     m_threadsSpin->setRange(1, 64);
     m_threadsSpin->setValue(1);
     optLayout->addRow(tr("Threads:"), m_threadsSpin);
+
+    m_clusterThresholdSpin = new QDoubleSpinBox(this);
+    m_clusterThresholdSpin->setRange(0.05, 5.0);
+    m_clusterThresholdSpin->setSingleStep(0.05);
+    m_clusterThresholdSpin->setDecimals(2);
+    m_clusterThresholdSpin->setValue(0.5);
+    m_clusterThresholdSpin->setSuffix(QStringLiteral(" Å"));
+    m_clusterThresholdSpin->setToolTip(
+        tr("Conformers closer than this plain RMSD (given atom order) share a cluster."));
+    optLayout->addRow(tr("Cluster threshold:"), m_clusterThresholdSpin);
     mainLayout->addWidget(optBox);
 
     // --- Structures table ---
@@ -152,10 +182,35 @@ void RMSDWidget::setupUI()
     actionRow->addWidget(m_addButton);
     actionRow->addWidget(m_useReferenceButton);
     actionRow->addStretch();
+    m_clusterButton = new QPushButton(tr("Cluster…"), this);
+    m_clusterButton->setToolTip(
+        tr("Cluster conformers by pairwise RMSD and keep one representative per cluster."));
+    auto* clusterMenu = new QMenu(m_clusterButton);
+    m_clusterWorkspaceAction = clusterMenu->addAction(tr("Workspace structures"));
+    QAction* clusterFileAction = clusterMenu->addAction(tr("Conformers from XYZ file…"));
+    m_clusterButton->setMenu(clusterMenu);
     actionRow->addWidget(m_reorderCheck);
     actionRow->addWidget(m_realignButton);
+    actionRow->addWidget(m_clusterButton);
     mainLayout->addLayout(actionRow);
 
+    m_clusterLabel = new QLabel(this);
+    m_clusterLabel->setWordWrap(true);
+    m_clusterLabel->hide();
+    mainLayout->addWidget(m_clusterLabel);
+
+    // --- Re-align / clustering progress (visible while a job runs) ---
+    auto* progressRow = new QHBoxLayout();
+    m_progress = new QProgressBar(this);
+    m_cancelButton = new QPushButton(QIcon::fromTheme(QStringLiteral("process-stop")),
+        tr("Cancel"), this);
+    m_cancelButton->setToolTip(tr("Stop the running job; structures not aligned yet stay unaligned."));
+    progressRow->addWidget(m_progress, 1);
+    progressRow->addWidget(m_cancelButton);
+    mainLayout->addLayout(progressRow);
+    m_progress->hide();
+    m_cancelButton->hide();
+
     // --- Reorder mapping for the selected structure ---
     m_reorderLabel = new QLabel(tr("Reorder mapping (selected structure):"), this);
     mainLayout->addWidget(m_reorderLabel);
@@ -167,6 +222,13 @@ void RMSDWidget::setupUI()
     connect(m_useReferenceButton, &QPushButton::clicked, this, &RMSDWidget::onUseCurrentAsReference);
     connect(m_addButton, &QPushButton::clicked, this, &RMSDWidget::onAddStructure);
     connect(m_realignButton, &QPushButton::clicked, this, &RMSDWidget::onRealignAll);
+    connect(m_clusterWorkspaceAction, &QAction::triggered, this, &RMSDWidget::onClusterWorkspace);
+    connect(clusterFileAction, &QAction::triggered, this, &RMSDWidget::onClusterFile);
+    connect(m_cancelButton, &QPushButton::clicked, this, [this] {
+        cancelBatch();
+        rebuildTable();
+        pushWorkspace(/*referenceChanged=*/false);
+    });
     connect(m_methodCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
         this, &RMSDWidget::onMethodChanged);
     connect(m_table, &QTableWidget::itemSelectionChanged, this, &RMSDWidget::onSelectionChanged);
@@ -285,20 +347,15 @@ void RMSDWidget::rebuildTable()
         connect(show, &QCheckBox::toggled, this, [this, id](bool on) { onVisibilityToggled(id, on); });
         m_table->setCellWidget(row, ColShow, centerCell(show));
 
-        // Name
-        m_table->setItem(row, ColName, new QTableWidgetItem(
-            s.isReference ? tr("%1  (reference)").arg(s.name) : s.name));
-
-        // RMSD columns: plain for any aligned structure; perm. only when reordering ran.
-        const bool aligned = !s.isReference && s.hasResult;
-        auto* r1 = new QTableWidgetItem(
-            aligned ? QString::number(s.rmsdPlain, 'f', 3) : QStringLiteral("–"));
-        r1->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_table->setItem(row, ColRmsd, r1);
-        auto* r2 = new QTableWidgetItem(
-            (aligned && s.reordered) ? QString::number(s.rmsdPerm, 'f', 3) : QStringLiteral("–"));
-        r2->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_table->setItem(row, ColRmsdPerm, r2);
+        // Name (+ cluster of the last clustering run)
+        QString name = s.isReference ? tr("%1  (reference)").arg(s.name) : s.name;
+        if (s.clusterSize > 0)
+            name += tr("  [cluster %1 · %n member(s)]", nullptr, s.clusterSize).arg(s.cluster + 1);
+        else if (s.cluster >= 0)
+            name += tr("  [cluster %1]").arg(s.cluster + 1);
+        m_table->setItem(row, ColName, new QTableWidgetItem(name));
+
+        updateRmsdCells(row);
 
         // Colour-tint swatch (overlays only)
         auto* swatch = new QPushButton;
@@ -342,43 +399,79 @@ void RMSDWidget::rebuildTable()
     onSelectionChanged();
 }
 
+void RMSDWidget::updateRmsdCells(int row)
+{
+    // RMSD columns: plain for any aligned structure; perm. only when reordering ran.
+    const Structure& s = m_structures[row];
+    const bool aligned = !s.isReference && s.hasResult;
+    const QString none = s.pending ? QStringLiteral("…") : QStringLiteral("–");
+    auto* r1 = new QTableWidgetItem(aligned ? QString::number(s.rmsdPlain, 'f', 3) : none);
+    r1->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    m_table->setItem(row, ColRmsd, r1);
+    auto* r2 = new QTableWidgetItem(
+        (aligned && s.reordered) ? QString::number(s.rmsdPerm, 'f', 3) : none);
+    r2->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    m_table->setItem(row, ColRmsdPerm, r2);
+}
+
 void RMSDWidget::updateButtons()
 {
     m_realignButton->setEnabled(referenceIndex() >= 0 && m_structures.size() >= 2);
+    m_clusterWorkspaceAction->setEnabled(m_structures.size() >= 2);
 }
 
 // ---- alignment ----
 
-bool RMSDWidget::alignToReference(Structure& s)
+struct RMSDWidget::AlignContext {
+    json controller;
+    bool reorder = false;
+    bool includeH = true;
+    curcuma::Molecule reference;  // handed to every RMSDDriver of the batch
+    Geometry plainReference;      // centred (H-filtered) reference for the plain RMSD
+};
+
+namespace {
+// Atoms that enter the plain RMSD (all, or heavy atoms only), centred.
+curcuma::Molecule plainRmsdMolecule(const curcuma::Molecule& m, bool includeH)
 {
-    const int refIdx = referenceIndex();
-    if (refIdx < 0)
-        return false;
-    if (m_structures[refIdx].id == s.id) {
-        s.aligned = s.original;  // the reference itself
-        s.hasResult = false;
-        return true;
-    }
+    curcuma::Molecule out;
+    for (std::size_t i = 0; i < m.AtomCount(); ++i)
+        if (includeH || m.Atom(i).first != 1)
+            out.addPair(m.Atom(i));
+    out.Center();
+    return out;
+}
+}
 
-    json controller;
-    controller["method"] = currentMethod().toStdString();
-    controller["protons"] = m_protonsCheck->isChecked();
+QSharedPointer<const RMSDWidget::AlignContext> RMSDWidget::makeAlignContext() const
+{
+    auto ctx = QSharedPointer<AlignContext>::create();
+    ctx->controller["method"] = currentMethod().toStdString();
+    ctx->controller["protons"] = m_protonsCheck->isChecked();
     // Reorder ON => force the chosen method's permutation (curcuma only reorders when the
     // atom order differs OR force_reorder is set, so picking a method alone would not
     // reorder conformers in matching order). OFF => disable reordering entirely.
-    const bool reorder = m_reorderCheck->isChecked();
-    controller["force_reorder"] = reorder;
-    controller["no_reorder"] = !reorder;
-    controller["threads"] = m_threadsSpin->value();
-    s.reordered = reorder;
+    ctx->reorder = m_reorderCheck->isChecked();
+    ctx->controller["force_reorder"] = ctx->reorder;
+    ctx->controller["no_reorder"] = !ctx->reorder;
+    ctx->controller["threads"] = m_threadsSpin->value();
     if (m_elementEdit->isEnabled()) {
         const QString el = m_elementEdit->text().trimmed();
         if (!el.isEmpty())
-            controller["element"] = el.toStdString();
+            ctx->controller["element"] = el.toStdString();
     }
+    ctx->includeH = m_protonsCheck->isChecked();
+    ctx->reference = atomsToMolecule(m_structures[referenceIndex()].original);
+    ctx->plainReference = plainRmsdMolecule(ctx->reference, ctx->includeH).getGeometry();
+    return ctx;
+}
 
-    curcuma::Molecule ref = atomsToMolecule(m_structures[refIdx].original);
-    curcuma::Molecule tgt = atomsToMolecule(s.original);
+RMSDWidget::AlignResult RMSDWidget::alignStructure(const AlignContext& ctx,
+    const QVector<MoleculeViewer::Atom>& target)
+{
+    AlignResult r;
+    r.reordered = ctx.reorder;
+    curcuma::Molecule tgt = atomsToMolecule(target);
 
     // Plain RMSD = best-fit (Kabsch) in the original atom order. Computed locally so the
     // column is always available and independent of whether curcuma populated its internal
@@ -386,67 +479,311 @@ bool RMSDWidget::alignToReference(Structure& s)
     // "Include hydrogens" so it stays consistent with the permutation RMSD, which depletes
     // protons when disabled. Returns 0 on an atom-count mismatch (no meaningful same-order
     // RMSD). Claude Generated.
-    const bool includeH = m_protonsCheck->isChecked();
-    auto plainRmsd = [&ref, &tgt, includeH]() -> double {
-        auto prep = [includeH](const curcuma::Molecule& m) {
-            curcuma::Molecule out;
-            for (std::size_t i = 0; i < m.AtomCount(); ++i)
-                if (includeH || m.Atom(i).first != 1)
-                    out.addPair(m.Atom(i));
-            out.Center();
-            return out;
-        };
-        curcuma::Molecule a = prep(ref), b = prep(tgt);
-        if (a.AtomCount() == 0 || a.AtomCount() != b.AtomCount())
+    auto plainRmsd = [&ctx, &tgt]() -> double {
+        const Geometry b = plainRmsdMolecule(tgt, ctx.includeH).getGeometry();
+        if (ctx.plainReference.rows() == 0 || ctx.plainReference.rows() != b.rows())
             return 0.0;
-        const Eigen::Matrix3d R = RMSDFunctions::BestFitRotation(a.getGeometry(), b.getGeometry());
-        const Geometry aligned = RMSDFunctions::applyRotation(b.getGeometry(), R);
-        return RMSDFunctions::getRMSD(a.getGeometry(), aligned);
+        const Eigen::Matrix3d R = RMSDFunctions::BestFitRotation(ctx.plainReference, b);
+        const Geometry aligned = RMSDFunctions::applyRotation(b, R);
+        return RMSDFunctions::getRMSD(ctx.plainReference, aligned);
     };
 
-    bool ok = true;
     try {
-        RMSDDriver driver(controller, true);
-        driver.setReference(ref);
+        RMSDDriver driver(ctx.controller, true);
+        driver.setReference(ctx.reference);
         driver.setTarget(tgt);
         driver.start();
-        s.rules = driver.ReorderRules();
+        r.rules = driver.ReorderRules();
         // Overlay geometry = the target whose deviation equals the reported RMSD. curcuma's
         // TargetForRMSD() returns the reordered + aligned target when reordering ran, else the
         // plain best-fit. Using TargetAligned() directly here drew the un-reordered (rmsd_raw)
         // structure while the table showed the permutation RMSD — the original overlay bug.
-        s.aligned = moleculeToAtoms(driver.TargetForRMSD());
+        r.aligned = moleculeToAtoms(driver.TargetForRMSD());
         // RMSD columns: plain (best-fit in the original order, local Kabsch above) is always
         // shown; perm. is curcuma's reordered best-fit, only meaningful when reordering ran.
-        s.rmsdPlain = plainRmsd();
-        s.rmsdPerm = reorder ? driver.RMSD() : s.rmsdPlain;
-        s.hasResult = true;
+        r.rmsdPlain = plainRmsd();
+        r.rmsdPerm = ctx.reorder ? driver.RMSD() : r.rmsdPlain;
+        r.ok = !r.aligned.isEmpty();
     } catch (const std::exception& e) {
-        ok = false;
         qWarning("RMSDDriver failed: %s", e.what());
     } catch (...) {
-        ok = false;
     }
-    if (!ok || s.aligned.isEmpty()) {
+    return r;
+}
+
+bool RMSDWidget::applyAlignResult(Structure& s, const AlignResult& result)
+{
+    s.reordered = result.reordered;
+    if (!result.ok) {
         s.aligned = s.original;
         s.hasResult = false;
         return false;
     }
+    s.aligned = result.aligned;
+    s.rules = result.rules;
+    s.rmsdPlain = result.rmsdPlain;
+    s.rmsdPerm = result.rmsdPerm;
+    s.hasResult = true;
     return true;
 }
 
+bool RMSDWidget::alignToReference(Structure& s)
+{
+    const int refIdx = referenceIndex();
+    if (refIdx < 0)
+        return false;
+    if (m_structures[refIdx].id == s.id) {
+        s.aligned = s.original;  // the reference itself
+        s.hasResult = false;
+        return true;
+    }
+    return applyAlignResult(s, alignStructure(*makeAlignContext(), s.original));
+}
+
 void RMSDWidget::realignAll()
 {
+    cancelBatch();
     if (referenceIndex() < 0)
         return;
-    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    // Each RMSDDriver already runs "Threads" threads; size the pool so the jobs together
+    // roughly fill the machine.
+    m_pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / m_threadsSpin->value()));
+    const QSharedPointer<const AlignContext> ctx = makeAlignContext();
+    const QSharedPointer<QAtomicInt> cancel = QSharedPointer<QAtomicInt>::create(0);
+    const int batch = ++m_batch;
+    m_cancelFlag = cancel;
+    m_batchTotal = 0;
+    m_batchDone = 0;
     for (Structure& s : m_structures) {
-        if (s.isReference)
+        if (s.isReference) {
             s.aligned = s.original;
-        else
-            alignToReference(s);
+            continue;
+        }
+        s.pending = true;
+        s.hasResult = false;
+        ++m_batchTotal;
+        const int id = s.id;
+        const QVector<MoleculeViewer::Atom> target = s.original;  // shared, never written by the job
+        m_pool->start([this, ctx, cancel, batch, id, target] {
+            if (cancel->loadRelaxed())
+                return;
+            const AlignResult r = alignStructure(*ctx, target);
+            if (cancel->loadRelaxed())
+                return;
+            QMetaObject::invokeMethod(this,
+                [this, batch, id, r] { onAlignmentFinished(batch, id, r); }, Qt::QueuedConnection);
+        });
     }
-    QApplication::restoreOverrideCursor();
+    if (m_batchTotal == 0)
+        return;
+    m_progress->setFormat(tr("Aligned %v / %m"));
+    m_progress->setRange(0, m_batchTotal);
+    m_progress->setValue(0);
+    m_progress->show();
+    m_cancelButton->show();
+}
+
+void RMSDWidget::onAlignmentFinished(int batch, int id, const AlignResult& result)
+{
+    if (batch != m_batch)
+        return;  // cancelled or superseded
+    m_progress->setValue(++m_batchDone);
+    const int i = indexOfId(id);  // -1 if removed meanwhile
+    if (i >= 0 && m_structures[i].pending) {
+        m_structures[i].pending = false;
+        applyAlignResult(m_structures[i], result);
+        updateRmsdCells(i);
+        if (m_table->currentRow() == i)
+            onSelectionChanged();
+    }
+    if (m_batchDone == m_batchTotal)
+        finishRealign();
+}
+
+void RMSDWidget::finishRealign()
+{
+    m_progress->hide();
+    m_cancelButton->hide();
+    m_cancelFlag.reset();
+    pushWorkspace(/*referenceChanged=*/false);  // overlays now carry the aligned geometry
+}
+
+void RMSDWidget::cancelBatch()
+{
+    if (!m_cancelFlag)
+        return;
+    m_cancelFlag->storeRelaxed(1);
+    m_cancelFlag.reset();
+    m_pool->clear();  // jobs not started yet; running ones finish and are dropped
+    ++m_batch;
+    for (Structure& s : m_structures) {
+        if (!s.pending)
+            continue;
+        s.pending = false;
+        s.aligned = s.original;
+        s.hasResult = false;
+    }
+    m_progress->hide();
+    m_cancelButton->hide();
+}
+
+// ---- clustering ----
+
+void RMSDWidget::startClustering(const QString& path,
+    const QVector<QVector<MoleculeViewer::Atom>>& conformers, const QVector<int>& ids)
+{
+    cancelBatch();
+    ConformerClustering::Options options;
+    options.threshold = m_clusterThresholdSpin->value();
+    options.includeHydrogens = m_protonsCheck->isChecked();
+    const QSharedPointer<QAtomicInt> cancel = QSharedPointer<QAtomicInt>::create(0);
+    const QSharedPointer<QAtomicInt> lastPermille = QSharedPointer<QAtomicInt>::create(-1);
+    const int batch = ++m_batch;
+    m_cancelFlag = cancel;
+
+    m_pool->start([this, path, conformers, ids, options, cancel, lastPermille, batch] {
+        ClusterOutcome out;
+        out.ids = ids;
+        QVector<QVector<MoleculeViewer::Atom>> frames = conformers;
+        if (!path.isEmpty()) {
+            XYZParser parser;
+            out.fileName = QFileInfo(path).fileName();
+            if (!parser.parseTrajectory(path) || parser.getFrameCount() < 2) {
+                out.error = tr("%1 holds fewer than two readable frames.").arg(out.fileName);
+            } else {
+                frames.resize(parser.getFrameCount());
+                XYZParser::XYZFrame frame;
+                QVector<MoleculeViewer::Bond> noBonds;  // XYZ carries none
+                for (int f = 0; f < frames.size() && !cancel->loadRelaxed(); ++f)
+                    if (parser.getFrame(f, frame))
+                        XYZParser::convertToMoleculeViewer(frame, frames[f], noBonds);
+                parser.releaseFrames();
+            }
+        }
+        if (out.error.isEmpty() && !cancel->loadRelaxed()) {
+            // Called per tile from the OpenMP threads; post only when the permille moves.
+            out.result = ConformerClustering::run(frames, options, cancel.data(),
+                [this, lastPermille, batch](qint64 done, qint64 total) {
+                    const int permille = total > 0 ? int(done * 1000 / total) : 1000;
+                    const int previous = lastPermille->loadRelaxed();
+                    if (permille <= previous || !lastPermille->testAndSetRelaxed(previous, permille))
+                        return;
+                    QMetaObject::invokeMethod(this, [this, batch, permille] {
+                        if (batch == m_batch)
+                            m_progress->setValue(permille);
+                    }, Qt::QueuedConnection);
+                });
+            if (!path.isEmpty() && !out.result.cancelled) {
+                for (int rep : out.result.representatives) {
+                    if (out.repAtoms.size() == kMaxClusterOverlays)
+                        break;
+                    out.repAtoms.append(frames[rep]);
+                }
+            }
+        }
+        if (cancel->loadRelaxed())
+            return;
+        QMetaObject::invokeMethod(this,
+            [this, batch, out] { onClusteringFinished(batch, out); }, Qt::QueuedConnection);
+    });
+
+    m_progress->setFormat(tr("Clustering %p%"));
+    m_progress->setRange(0, 1000);
+    m_progress->setValue(0);
+    m_progress->show();
+    m_cancelButton->show();
+}
+
+void RMSDWidget::onClusteringFinished(int batch, const ClusterOutcome& outcome)
+{
+    if (batch != m_batch)
+        return;  // cancelled or superseded
+    m_progress->hide();
+    m_cancelButton->hide();
+    m_cancelFlag.reset();
+    if (!outcome.error.isEmpty()) {
+        QMessageBox::warning(this, tr("Cluster Conformers"), outcome.error);
+        return;
+    }
+
+    const ConformerClustering::Result& r = outcome.result;
+    const int skipped = std::count(r.assignment.begin(), r.assignment.end(), -1);
+    QString summary = tr("%1 conformers → %2 clusters (largest %3) at %4 Å · %5 of %6 pairs "
+                         "decided by a lower bound")
+                          .arg(r.conformerCount)
+                          .arg(r.representatives.size())
+                          .arg(r.clusterSizes.isEmpty() ? 0 : r.clusterSizes.first())
+                          .arg(m_clusterThresholdSpin->value(), 0, 'f', 2)
+                          .arg(r.pruned)
+                          .arg(r.pairs);
+    if (skipped > 0)
+        summary += tr(" · %1 with different atoms skipped").arg(skipped);
+    if (outcome.repAtoms.size() < r.representatives.size() && !outcome.fileName.isEmpty())
+        summary += tr(" · the %1 largest clusters loaded").arg(outcome.repAtoms.size());
+    m_clusterLabel->setText(summary);
+    m_clusterLabel->show();
+
+    if (outcome.fileName.isEmpty())
+        applyWorkspaceClusters(outcome);
+    else
+        loadFileClusters(outcome);
+}
+
+void RMSDWidget::applyWorkspaceClusters(const ClusterOutcome& outcome)
+{
+    // Keep every structure, show the representatives only; the largest cluster's
+    // representative becomes the reference.
+    const ConformerClustering::Result& r = outcome.result;
+    int newReference = -1;
+    for (int c = 0; c < outcome.ids.size(); ++c) {
+        const int i = indexOfId(outcome.ids[c]);  // -1 if removed meanwhile
+        if (i < 0)
+            continue;
+        Structure& s = m_structures[i];
+        s.cluster = r.assignment[c];
+        s.clusterSize = 0;
+        if (s.cluster < 0)
+            continue;  // not comparable: left as it was
+        const bool representative = r.representatives[s.cluster] == c;
+        if (representative)
+            s.clusterSize = r.clusterSizes[s.cluster];
+        if (representative && s.cluster == 0)
+            newReference = i;
+        s.visible = representative;
+    }
+    if (newReference >= 0 && !m_structures[newReference].isReference) {
+        setReferenceByIndex(newReference);
+        return;
+    }
+    rebuildTable();
+    pushWorkspace(/*referenceChanged=*/false);  // carries the reference visibility too
+}
+
+void RMSDWidget::loadFileClusters(const ClusterOutcome& outcome)
+{
+    // Fresh workspace of the representatives, largest cluster first (= reference).
+    const ConformerClustering::Result& r = outcome.result;
+    m_structures.clear();
+    for (int c = 0; c < outcome.repAtoms.size(); ++c) {
+        if (outcome.repAtoms[c].isEmpty())
+            continue;
+        Structure s;
+        s.id = m_nextId++;
+        s.name = tr("%1 #%2").arg(outcome.fileName).arg(r.representatives[c] + 1);
+        s.original = outcome.repAtoms[c];
+        s.aligned = s.original;
+        s.cluster = c;
+        s.clusterSize = r.clusterSizes[c];
+        s.isReference = m_structures.isEmpty();
+        if (!s.isReference)
+            s.tint = nextDefaultTint();
+        m_structures.append(s);
+    }
+    realignAll();
+    rebuildTable();
+    updateButtons();
+    pushWorkspace(/*referenceChanged=*/true);
 }
 
 // ---- workspace mutations ----
@@ -587,6 +924,7 @@ void RMSDWidget::clearWorkspace()
 {
     if (m_structures.isEmpty())
         return;
+    cancelBatch();
     m_structures.clear();
     rebuildTable();
     updateButtons();
@@ -610,7 +948,7 @@ void RMSDWidget::pushWorkspace(bool referenceChanged)
         spec.atoms = s.aligned;
         spec.tint = s.tint;
         spec.sizeScale = s.sizeScale;
-        spec.visible = s.visible;
+        spec.visible = s.visible && !s.pending;  // shown once aligned to this reference
         overlays.append(spec);
     }
     emit overlayWorkspaceChanged(ref.original, ref.bonds, ref.visible, overlays, referenceChanged);
@@ -651,7 +989,7 @@ void RMSDWidget::onVisibilityToggled(int id, bool on)
     m_structures[i].visible = on;
     if (m_structures[i].isReference)
         emit referenceVisibilityChanged(on);
-    else
+    else if (!m_structures[i].pending)
         emit overlayVisibilityChanged(overlayIndexOf(i), on);
 }
 
@@ -706,13 +1044,36 @@ void RMSDWidget::onAddStructure()
     addStructureFromFile(path);
 }
 
+void RMSDWidget::onClusterWorkspace()
+{
+    if (m_structures.size() < 2)
+        return;
+    QVector<QVector<MoleculeViewer::Atom>> conformers;
+    QVector<int> ids;
+    conformers.reserve(m_structures.size());
+    for (const Structure& s : m_structures) {
+        conformers.append(s.original);
+        ids.append(s.id);
+    }
+    startClustering(QString(), conformers, ids);
+}
+
+void RMSDWidget::onClusterFile()
+{
+    const QString path = QFileDialog::getOpenFileName(this, tr("Cluster Conformers"),
+        QString(), tr("Multi-frame XYZ (*.xyz *.trj)"));
+    if (path.isEmpty())
+        return;
+    startClustering(path, {}, {});
+}
+
 void RMSDWidget::onRealignAll()
 {
     if (referenceIndex() < 0)
         return;
     realignAll();
     rebuildTable();
-    pushWorkspace(/*referenceChanged=*/false);  // overlay geometry changed; primary unchanged
+    pushWorkspace(/*referenceChanged=*/false);  // pending overlays hidden until their result arrives
 }
 
 // ---- file loading ----
@@ -14,17 +14,30 @@
 // (full rebuild) plus cheap per-overlay live-edit signals, and MainWindow drives
 // the MoleculeViewer. seedReferenceRequested() asks MainWindow to (re-)seed the
 // reference from the current viewer frame.
+//
+// Re-aligning the workspace (new reference, "Re-align all") runs one independent job per
+// structure on a private thread pool. The options and the reference geometry are
+// snapshotted once per batch (AlignContext) and shared read-only by all jobs; results are
+// applied on the GUI thread as they arrive, with a progress bar and a cancel button.
+//
+// "Cluster" runs ConformerClustering on the same pool (workspace structures, or every frame
+// of a multi-frame XYZ) and keeps only the cluster representatives: visible in the workspace,
+// or loaded into a fresh workspace, the largest cluster's representative as the reference.
 #ifndef RMSDWIDGET_H
 #define RMSDWIDGET_H
 
+#include <QAtomicInt>
 #include <QColor>
+#include <QSharedPointer>
 #include <QVector>
 #include <QWidget>
 
 #include <vector>
 
+#include "conformerclustering.h"
 #include "view.h"  // MoleculeViewer::Atom / Bond / OverlaySpec
 
+class QAction;
 class QButtonGroup;
 class QCheckBox;
 class QComboBox;
@@ -32,15 +45,18 @@ class QDoubleSpinBox;
 class QLabel;
 class QLineEdit;
 class QPlainTextEdit;
+class QProgressBar;
 class QPushButton;
 class QSpinBox;
 class QTableWidget;
+class QThreadPool;
 
 class RMSDWidget : public QWidget {
     Q_OBJECT
 
 public:
     explicit RMSDWidget(QWidget* parent = nullptr);
+    ~RMSDWidget() override;
 
     /** Seed (or refresh) the reference structure from the currently displayed molecule. */
     void setReferenceStructure(const QVector<MoleculeViewer::Atom>& atoms,
@@ -92,6 +108,8 @@ private slots:
     void onRealignAll();
     void onMethodChanged(int index);
     void onSelectionChanged();
+    void onClusterWorkspace();
+    void onClusterFile();
 
 private:
     // One structure in the workspace (the reference or an aligned target).
@@ -110,6 +128,33 @@ private:
         double rmsdPlain = 0.0;   // RMSDRaw (before reorder)
         double rmsdPerm = 0.0;    // RMSD (after reorder)
         std::vector<int> rules;   // reorder mapping (target index -> reference index)
+        bool pending = false;     // queued in the running re-align batch
+        int cluster = -1;         // conformer cluster of the last clustering run (-1: none)
+        int clusterSize = 0;      // members of that cluster (set on its representative only)
+    };
+
+    // Options + prepared reference of one alignment batch (defined in the .cpp, where the
+    // curcuma types are visible). Immutable once built, so jobs share it across threads.
+    struct AlignContext;
+
+    // Outcome of one alignment job, applied to its Structure on the GUI thread.
+    struct AlignResult {
+        bool ok = false;
+        bool reordered = false;
+        QVector<MoleculeViewer::Atom> aligned;
+        double rmsdPlain = 0.0;
+        double rmsdPerm = 0.0;
+        std::vector<int> rules;
+    };
+
+    // Outcome of one clustering job. For a file source the representatives' atoms come
+    // along (the other frames never reach the GUI thread).
+    struct ClusterOutcome {
+        ConformerClustering::Result result;
+        QString error;
+        QString fileName;                               // empty: workspace source
+        QVector<int> ids;                               // workspace source: structure per conformer
+        QVector<QVector<MoleculeViewer::Atom>> repAtoms; // file source, largest cluster first
     };
 
     void setupUI();
@@ -118,7 +163,22 @@ private:
     void pushWorkspace(bool referenceChanged);
 
     bool alignToReference(Structure& s);          // run RMSDDriver, fill aligned/rmsd/rules
-    void realignAll();                            // re-align every non-reference structure
+    void realignAll();                            // queue every non-reference structure on the pool
+    void cancelBatch();                           // drop the running re-align / clustering job
+    void onAlignmentFinished(int batch, int id, const AlignResult& result);
+    void finishRealign();
+    QSharedPointer<const AlignContext> makeAlignContext() const;
+    // Thread-safe: touches nothing but its arguments.
+    static AlignResult alignStructure(const AlignContext& context,
+        const QVector<MoleculeViewer::Atom>& target);
+    static bool applyAlignResult(Structure& s, const AlignResult& result);
+    void updateRmsdCells(int row);
+    // Queue one clustering job; @p path empty = cluster @p conformers (workspace ids @p ids).
+    void startClustering(const QString& path, const QVector<QVector<MoleculeViewer::Atom>>& conformers,
+        const QVector<int>& ids);
+    void onClusteringFinished(int batch, const ClusterOutcome& outcome);
+    void applyWorkspaceClusters(const ClusterOutcome& outcome);
+    void loadFileClusters(const ClusterOutcome& outcome);
     bool addStructure(const QVector<MoleculeViewer::Atom>& atoms,
         const QVector<MoleculeViewer::Bond>& bonds, const QString& name);
     void setReferenceByIndex(int index);          // promote a structure to reference
@@ -145,6 +205,13 @@ private:
     int m_nextId = 1;
     int m_nextTint = 0;
 
+    // --- re-align batch ---
+    QThreadPool* m_pool = nullptr;
+    QSharedPointer<QAtomicInt> m_cancelFlag;  // set to abandon the current batch
+    int m_batch = 0;                          // results of older batches are dropped
+    int m_batchTotal = 0;
+    int m_batchDone = 0;
+
     // --- UI ---
     QPushButton* m_useReferenceButton = nullptr;
     QPushButton* m_addButton = nullptr;
@@ -158,6 +225,12 @@ private:
     QButtonGroup* m_refGroup = nullptr;
     QLabel* m_reorderLabel = nullptr;
     QPlainTextEdit* m_reorderText = nullptr;
+    QProgressBar* m_progress = nullptr;
+    QPushButton* m_cancelButton = nullptr;
+    QDoubleSpinBox* m_clusterThresholdSpin = nullptr;
+    QPushButton* m_clusterButton = nullptr;
+    QAction* m_clusterWorkspaceAction = nullptr;
+    QLabel* m_clusterLabel = nullptr;
 };
 
 #endif // RMSDWIDGET_H
@@ -5,11 +5,14 @@
 #include "atominstancing.h"
 #include "bondinstancing.h"
 #include "elementdata.h"
+#include "lodgeometry.h"
+#include "profiler.h"
 
 #include "src/core/elements.h"
 
 #include <QPair>
 #include <QtMath>
+#include <algorithm>
 #include <limits>
 
 namespace {
@@ -58,6 +61,23 @@ QQuaternion bondRotation(const QVector3D& normDir)
     const float angle = qAcos(QVector3D::dotProduct(localUp, normDir)) * 180.0f / float(M_PI);
     return QQuaternion::fromAxisAndAngle(rotAxis.normalized(), angle);
 }
+
+/// Transform of the two half-cylinders drawn for bond A-B (each coloured after its atom).
+/// Returns false for coincident endpoints, which are not drawn.
+bool halfBondTransforms(const QVector3D& posA, const QVector3D& posB, float sxz,
+    QVector3D& centerA, QVector3D& centerB, QVector3D& scale, QQuaternion& rot)
+{
+    const QVector3D dir = posB - posA;
+    const float length = dir.length();
+    if (length < 1e-4f)
+        return false;
+    rot = bondRotation(dir / length);
+    const QVector3D mid = 0.5f * (posA + posB);
+    scale = QVector3D(sxz, length * 0.25f / kCylBaseHalfHeight, sxz);
+    centerA = 0.5f * (posA + mid);
+    centerB = 0.5f * (mid + posB);
+    return true;
+}
 }
 
 SceneController::SceneController(QObject* parent)
@@ -85,6 +105,19 @@ SceneController::SceneController(QObject* parent)
     m_overlayAtoms->setParent(this);
     m_overlayBonds = new BondInstancing(nullptr);
     m_overlayBonds->setParent(this);
+    m_sphereMesh = new SphereGeometry(nullptr);
+    m_sphereMesh->setParent(this);
+    m_cylinderMesh = new CylinderGeometry(nullptr);
+    m_cylinderMesh->setParent(this);
+    m_atomImpostors = new AtomInstancing(nullptr);
+    m_atomImpostors->setParent(this);
+
+    // Culling and distance tiers follow the camera: re-classify the chunks on every view
+    // change; the instance tables are only rewritten when a chunk changes tier.
+    connect(this, &SceneController::transformChanged, this, [this]() {
+        if (lodActive() && !m_atomItems.isEmpty() && classifyChunks())
+            uploadAtomInstances();
+    });
 }
 
 QQuick3DInstancing* SceneController::measureLineInstancing() const { return m_measureLines; }
@@ -193,8 +226,7 @@ void SceneController::rebuildOverlays()
     }
 
     const float radiusFactor = (m_renderingMode == SpaceFilling) ? 1.0f : 0.30f;
-    const float bondRadius = (m_renderingMode == Wireframe) ? qMin(m_bondRadius, 0.06f) : m_bondRadius;
-    const float sxz = bondRadius / kCylBaseRadius;
+    const float sxz = bondInstanceRadius() / kCylBaseRadius;
 
     QVector<AtomInstancing::Item> items;
     QVector<BondInstancing::Segment> segs;
@@ -205,8 +237,8 @@ void SceneController::rebuildOverlays()
             continue;
         anyVisible = true;
 
-        auto tinted = [&](const QString& element, float charge) {
-            QColor c = shiftOverlayColor(schemeColor(element, charge), ov.tint);
+        auto tinted = [&](int atomicNumber, float charge) {
+            QColor c = shiftOverlayColor(schemeColor(atomicNumber, charge), ov.tint);
             c.setAlphaF(m_transparency);
             return c;
         };
@@ -216,28 +248,23 @@ void SceneController::rebuildOverlays()
             for (const AtomDatum& a : ov.atoms) {
                 AtomInstancing::Item it;
                 it.position = a.position;
-                it.scale = radiusFactor * ov.sizeScale * m_atomScaleFactor * elem::vdwRadius(a.element);
-                it.color = tinted(a.element, a.charge);
+                it.scale = radiusFactor * ov.sizeScale * m_atomScaleFactor * elem::vdwRadius(a.atomicNumber);
+                it.color = tinted(a.atomicNumber, a.charge);
                 items.append(it);
             }
         }
 
         if (m_bondsVisible) {
+            QVector3D centerA, centerB, scale;
+            QQuaternion rot;
             for (const BondDatum& b : ov.bonds) {
                 if (b.a < 0 || b.b < 0 || b.a >= ov.atoms.size() || b.b >= ov.atoms.size())
                     continue;
-                const QVector3D posA = ov.atoms[b.a].position;
-                const QVector3D posB = ov.atoms[b.b].position;
-                const QVector3D dir = posB - posA;
-                const float length = dir.length();
-                if (length < 1e-4f)
+                if (!halfBondTransforms(ov.atoms[b.a].position, ov.atoms[b.b].position, sxz,
+                        centerA, centerB, scale, rot))
                     continue;
-                const QQuaternion rot = bondRotation(dir / length);
-                const QVector3D mid = 0.5f * (posA + posB);
-                const float halfLength = length * 0.25f;
-                const QVector3D scale(sxz, halfLength / kCylBaseHalfHeight, sxz);
-                segs.append({ 0.5f * (posA + mid), scale, rot, tinted(ov.atoms[b.a].element, ov.atoms[b.a].charge) });
-                segs.append({ 0.5f * (mid + posB), scale, rot, tinted(ov.atoms[b.b].element, ov.atoms[b.b].charge) });
+                segs.append({ centerA, scale, rot, tinted(ov.atoms[b.a].atomicNumber, ov.atoms[b.a].charge) });
+                segs.append({ centerB, scale, rot, tinted(ov.atoms[b.b].atomicNumber, ov.atoms[b.b].charge) });
             }
         }
     }
@@ -604,6 +631,9 @@ QQuick3DInstancing* SceneController::atomInstancing() const { return m_atomInsta
 QQuick3DInstancing* SceneController::bondInstancing() const { return m_bondInstancing; }
 QQuick3DInstancing* SceneController::arrowShaftInstancing() const { return m_arrowShaft; }
 QQuick3DInstancing* SceneController::arrowTipInstancing() const { return m_arrowTip; }
+QQuick3DGeometry* SceneController::sphereGeometry() const { return m_sphereMesh; }
+QQuick3DGeometry* SceneController::cylinderGeometry() const { return m_cylinderMesh; }
+QQuick3DInstancing* SceneController::atomImpostorInstancing() const { return m_atomImpostors; }
 
 void SceneController::setForceVectorsVisible(bool on)
 {
@@ -656,6 +686,8 @@ void SceneController::setStructure(const QVector<AtomDatum>& atoms, const QVecto
 {
     m_atoms = atoms;
     m_bonds = bonds;
+    m_bvhState = BvhState::Rebuild;
+    m_chunksDirty = true;
     if (keepView) {
         // Structure editing: atom count changed but keep the current view. Don't
         // recompute bounds (that would shift a rotated molecule) or reset the camera;
@@ -673,13 +705,67 @@ void SceneController::setStructure(const QVector<AtomDatum>& atoms, const QVecto
     emit structureChanged();
 }
 
-void SceneController::updatePositions(const QVector<QVector3D>& positions)
+const QVector3D* SceneController::packPositions() const
 {
-    // Fast path for live simulation: same atom count, reuse colours/bonds.
-    const int n = qMin(positions.size(), m_atoms.size());
-    for (int i = 0; i < n; ++i)
-        m_atoms[i].position = positions[i];
-    rebuildGeometry();
+    m_positionScratch.resize(m_atoms.size());
+    for (int i = 0; i < m_atoms.size(); ++i)
+        m_positionScratch[i] = m_atoms[i].position;
+    return m_positionScratch.constData();
+}
+
+void SceneController::updatePositions(PositionSpan positions)
+{
+    ProfileScope profile("scene.updatePositions");
+    // Fast path for live simulation / trajectory playback: same atom count, so colours,
+    // scales and the bond list are unchanged. The existing instance tables are patched in
+    // place: sphere translations for every atom, cylinder transforms (batched kernel) only
+    // for bonds with a moved endpoint. Reads straight from the caller's block (e.g. a
+    // TrajectoryStore frame).
+    const int n = qMin(positions.size, int(m_atoms.size()));
+    m_moved.fill(0, m_atoms.size());
+    bool anyMoved = false;
+    for (int i = 0; i < n; ++i) {
+        if (m_atoms[i].position != positions[i]) {
+            m_atoms[i].position = positions[i];
+            m_moved[i] = 1;
+            anyMoved = true;
+        }
+    }
+    if (!anyMoved)
+        return;
+    if (m_bvhState == BvhState::Valid)
+        m_bvhState = BvhState::Refit;
+
+    if (m_atomsVisible && m_primaryVisible) {
+        const PositionSpan moved(positions.data, n);
+        if (!lodActive()) {
+            m_atomInstancing->updatePositions(moved);
+        } else {
+            // Chunk spheres follow the atoms; the tables are split anew only when a chunk
+            // crossed the frustum or the impostor distance, otherwise patched in place.
+            refitChunks();
+            if (classifyChunks()) {
+                uploadAtomInstances();
+            } else {
+                m_atomInstancing->updatePositions(moved);
+                m_atomImpostors->updatePositions(moved);
+            }
+        }
+    }
+
+    if (!m_bondsVisible || !m_primaryVisible || m_bondA.isEmpty())
+        return;
+    // Bond kernel input: the caller's block when it covers every atom, else a packed copy.
+    const QVector3D* packed = positions.data;
+    if (n < m_atoms.size())
+        packed = packPositions();
+    m_dirtyBonds.clear();
+    for (int k = 0; k < m_bondA.size(); ++k)
+        if (m_moved[m_bondA[k]] || m_moved[m_bondB[k]])
+            m_dirtyBonds.append(k);
+    const bool all = m_dirtyBonds.size() == m_bondA.size();
+    m_bondInstancing->updateHalfBonds(packed, m_bondA.constData(), m_bondB.constData(),
+        all ? nullptr : m_dirtyBonds.constData(), m_dirtyBonds.size(), bondInstanceRadius());
 }
 
 // Claude Generated 2026 - replace the bond list and rebuild geometry only. No bounds recompute or
@@ -695,6 +781,8 @@ void SceneController::clear()
     m_atoms.clear();
     m_bonds.clear();
     m_selection.clear();
+    m_bvhState = BvhState::Rebuild;
+    m_chunksDirty = true;
     rebuildGeometry();
     emit structureChanged();
 }
@@ -723,7 +811,7 @@ void SceneController::recomputeBounds()
 
 // Base colour for an element/charge under the current scheme, ignoring the transient
 // selection/hover/collision state. Shared by atomColor() and the overlay tint path.
-QColor SceneController::schemeColor(const QString& element, float charge) const
+QColor SceneController::schemeColor(int atomicNumber, float charge) const
 {
     switch (m_colorScheme) {
     case Monochrome:
@@ -736,7 +824,7 @@ QColor SceneController::schemeColor(const QString& element, float charge) const
     case CPK:
     case Custom:
     default:
-        return elem::cpkColor(element);
+        return elem::cpkColor(atomicNumber);
     }
 }
 
@@ -757,12 +845,12 @@ QColor SceneController::atomColor(int index) const
     const AtomDatum& a = m_atoms[index];
     // Hover feedback: brighten the atom under the cursor (below selection).
     if (index == m_hoverAtom) {
-        QColor base = (m_colorScheme == Monochrome) ? m_monochrome : elem::cpkColor(a.element);
+        QColor base = (m_colorScheme == Monochrome) ? m_monochrome : elem::cpkColor(a.atomicNumber);
         QColor hl = base.lighter(170);
         hl.setAlphaF(m_transparency);
         return hl;
     }
-    QColor c = schemeColor(a.element, a.charge);
+    QColor c = schemeColor(a.atomicNumber, a.charge);
     c.setAlphaF(m_transparency);
     return c;
 }
@@ -778,12 +866,191 @@ void SceneController::rebuildAtoms()
         for (int i = 0; i < m_atoms.size(); ++i) {
             AtomInstancing::Item it;
             it.position = m_atoms[i].position;
-            it.scale = radiusFactor * m_atomScaleFactor * elem::vdwRadius(m_atoms[i].element);
+            it.scale = radiusFactor * m_atomScaleFactor * elem::vdwRadius(m_atoms[i].atomicNumber);
             it.color = atomColor(i);
             items.append(it);
         }
     }
-    m_atomInstancing->setItems(items);
+    m_atomItems = items;
+    if (lodActive() && !m_atomItems.isEmpty()) {
+        if (m_chunksDirty)
+            rebuildChunks();
+        else
+            refitChunks();   // display radii may have changed (mode / scale factor)
+        classifyChunks();
+    }
+    uploadAtomInstances();
+}
+
+// ---- level of detail (Claude Generated 2026) ----
+void SceneController::setLevelOfDetail(const LevelOfDetail& lod)
+{
+    m_sphereMesh->setDetail(lod.sphereRings, lod.sphereSlices);
+    m_cylinderMesh->setSlices(lod.bondSlices);
+    const bool bondsChanged = lod.impostors != m_lod.impostors;
+    m_lod = lod;
+    m_chunkTier.clear();   // tiers depend on the new thresholds
+    rebuildAtoms();
+    if (bondsChanged)
+        emit lodChanged();
+}
+
+void SceneController::setViewportSize(float width, float height)
+{
+    if (width <= 0.0f || height <= 0.0f)
+        return;
+    const float aspect = width / height;
+    if (qFuzzyCompare(aspect, m_viewAspect))
+        return;
+    m_viewAspect = aspect;
+    if (lodActive() && !m_atomItems.isEmpty() && classifyChunks())
+        uploadAtomInstances();
+}
+
+void SceneController::rebuildChunks()
+{
+    // Atoms sorted along a Morton (Z-order) curve over the bounding box and cut into
+    // fixed-size blocks: each chunk is a compact region, so its bounding sphere is tight
+    // enough to cull and to pick a distance tier for all its atoms at once. Membership is
+    // kept while positions change (MD / playback); refitChunks() only grows the spheres.
+    constexpr int kChunkAtoms = 512;
+    m_chunksDirty = false;
+    m_chunks.clear();
+    m_chunkTier.clear();
+    const int n = m_atoms.size();
+    m_chunkAtoms.resize(n);
+    if (n == 0)
+        return;
+
+    QVector3D lo = m_atoms[0].position, hi = lo;
+    for (const AtomDatum& a : m_atoms) {
+        lo = QVector3D(qMin(lo.x(), a.position.x()), qMin(lo.y(), a.position.y()), qMin(lo.z(), a.position.z()));
+        hi = QVector3D(qMax(hi.x(), a.position.x()), qMax(hi.y(), a.position.y()), qMax(hi.z(), a.position.z()));
+    }
+    const QVector3D extent = hi - lo;
+    const float scale = 1023.0f / qMax(1e-3f, qMax(extent.x(), qMax(extent.y(), extent.z())));
+    auto spread = [](quint32 v) {   // 10 bits -> every third bit
+        v &= 0x3ff;
+        v = (v | (v << 16)) & 0x030000ff;
+        v = (v | (v << 8)) & 0x0300f00f;
+        v = (v | (v << 4)) & 0x030c30c3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    };
+    QVector<QPair<quint32, int>> keyed(n);
+    for (int i = 0; i < n; ++i) {
+        const QVector3D q = (m_atoms[i].position - lo) * scale;
+        keyed[i] = { spread(quint32(q.x())) | (spread(quint32(q.y())) << 1) | (spread(quint32(q.z())) << 2), i };
+    }
+    std::sort(keyed.begin(), keyed.end());
+    for (int i = 0; i < n; ++i)
+        m_chunkAtoms[i] = keyed[i].second;
+    for (int begin = 0; begin < n; begin += kChunkAtoms) {
+        AtomChunk chunk;
+        chunk.begin = begin;
+        chunk.end = qMin(n, begin + kChunkAtoms);
+        m_chunks.append(chunk);
+    }
+    refitChunks();
+}
+
+void SceneController::refitChunks()
+{
+    if (m_chunksDirty) {
+        rebuildChunks();
+        return;
+    }
+    const bool radii = m_atomItems.size() == m_atoms.size();
+    for (AtomChunk& chunk : m_chunks) {
+        QVector3D lo = m_atoms[m_chunkAtoms[chunk.begin]].position, hi = lo;
+        float atomRadius = 0.0f;
+        for (int k = chunk.begin; k < chunk.end; ++k) {
+            const int i = m_chunkAtoms[k];
+            const QVector3D& p = m_atoms[i].position;
+            lo = QVector3D(qMin(lo.x(), p.x()), qMin(lo.y(), p.y()), qMin(lo.z(), p.z()));
+            hi = QVector3D(qMax(hi.x(), p.x()), qMax(hi.y(), p.y()), qMax(hi.z(), p.z()));
+            if (radii)
+                atomRadius = qMax(atomRadius, m_atomItems[i].scale);
+        }
+        chunk.center = 0.5f * (lo + hi);
+        chunk.atomRadius = atomRadius;
+        chunk.radius = 0.5f * (hi - lo).length() + atomRadius;
+    }
+}
+
+bool SceneController::classifyChunks()
+{
+    // Same axis-aligned camera as pickAtom(): at cameraWorldPos() looking down -Z, the
+    // molecule rotated about sceneCenter. A chunk sphere is culled when it lies entirely
+    // behind the near plane or outside one of the four side planes.
+    constexpr float kClipNear = 0.5f;   // == PerspectiveCamera.clipNear in viewer3d.qml
+    const QVector3D cam = cameraWorldPos();
+    const float halfH = std::tan(m_fov * float(M_PI) / 360.0f);
+    const float halfW = halfH * m_viewAspect;
+    const float slackH = std::sqrt(1.0f + halfH * halfH);
+    const float slackW = std::sqrt(1.0f + halfW * halfW);
+
+    bool changed = m_chunkTier.size() != m_chunks.size();
+    m_chunkTier.resize(m_chunks.size());
+    for (int c = 0; c < m_chunks.size(); ++c) {
+        const AtomChunk& chunk = m_chunks[c];
+        const QVector3D v = modelToWorld(chunk.center) - cam;
+        const float depth = -v.z();
+        quint8 tier = m_lod.impostors ? ChunkImpostor : ChunkMesh;
+        if (m_lod.frustumCulling
+            && (depth < kClipNear - chunk.radius
+                || std::abs(v.x()) - depth * halfW > chunk.radius * slackW
+                || std::abs(v.y()) - depth * halfH > chunk.radius * slackH)) {
+            tier = ChunkCulled;
+        } else if (tier == ChunkMesh && m_lod.impostorBelow > 0.0f) {
+            // Largest atom of the chunk at the chunk's nearest depth, as a fraction of the
+            // view height: below the threshold the mesh's silhouette is no longer visible.
+            const float nearest = depth - chunk.radius;
+            if (nearest > kClipNear && chunk.atomRadius < m_lod.impostorBelow * nearest * halfH)
+                tier = ChunkImpostor;
+        }
+        if (m_chunkTier[c] != tier) {
+            m_chunkTier[c] = tier;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void SceneController::uploadAtomInstances()
+{
+    QVector<AtomInstancing::Item> mesh, impostors;
+    QVector<int> meshIndex, impostorIndex;
+    if (!lodActive() || m_atomItems.isEmpty()) {
+        mesh = m_atomItems;   // identity order: the updatePositions() fast path
+    } else {
+        mesh.reserve(m_atomItems.size());
+        meshIndex.reserve(m_atomItems.size());
+        for (int c = 0; c < m_chunks.size(); ++c) {
+            if (m_chunkTier[c] == ChunkCulled)
+                continue;
+            const bool impostor = m_chunkTier[c] == ChunkImpostor;
+            QVector<AtomInstancing::Item>& items = impostor ? impostors : mesh;
+            QVector<int>& index = impostor ? impostorIndex : meshIndex;
+            for (int k = m_chunks[c].begin; k < m_chunks[c].end; ++k) {
+                const int i = m_chunkAtoms[k];
+                AtomInstancing::Item it = m_atomItems[i];
+                it.position = m_atoms[i].position;
+                items.append(it);
+                index.append(i);
+            }
+        }
+    }
+    m_atomInstancing->setItems(mesh, meshIndex);
+    m_atomImpostors->setItems(impostors, impostorIndex);
+
+    const bool meshActive = !mesh.isEmpty();
+    const bool impostorsActive = !impostors.isEmpty();
+    if (meshActive != m_atomMeshActive || impostorsActive != m_atomImpostorsActive) {
+        m_atomMeshActive = meshActive;
+        m_atomImpostorsActive = impostorsActive;
+        emit lodChanged();
+    }
 }
 
 void SceneController::setHoverAtom(int index)
@@ -798,40 +1065,49 @@ void SceneController::setHoverAtom(int index)
 
 void SceneController::rebuildGeometry()
 {
+    ProfileScope profile("scene.rebuildGeometry");
     rebuildAtoms();
 
     // --- bonds (two half-cylinders, coloured per atom) ---
-    QVector<BondInstancing::Segment> segs;
+    // Valid bonds are packed into m_bondA/m_bondB and handed to the batched kernel, which
+    // writes the instance table directly; updatePositions() re-runs it on the same arrays.
+    m_bondA.clear();
+    m_bondB.clear();
     if (m_bondsVisible && m_primaryVisible) {
-        const float bondRadius = (m_renderingMode == Wireframe)
-            ? qMin(m_bondRadius, 0.06f)
-            : m_bondRadius;
-        const float sxz = bondRadius / kCylBaseRadius;
-        segs.reserve(m_bonds.size() * 2);
+        m_bondA.reserve(m_bonds.size());
+        m_bondB.reserve(m_bonds.size());
         for (const BondDatum& b : m_bonds) {
             if (b.a < 0 || b.b < 0 || b.a >= m_atoms.size() || b.b >= m_atoms.size())
                 continue;
-            const QVector3D posA = m_atoms[b.a].position;
-            const QVector3D posB = m_atoms[b.b].position;
-            const QVector3D dir = posB - posA;
-            const float length = dir.length();
-            if (length < 1e-4f)
+            m_bondA.append(b.a);
+            m_bondB.append(b.b);
+        }
+
+        // Bond halves take the atom's base colour (no selection/hover); one table colour per
+        // element rather than per atom.
+        QVector4D byElement[elem::kMaxAtomicNumber + 1];
+        bool known[elem::kMaxAtomicNumber + 1] = {};
+        QColor mono = m_monochrome;
+        mono.setAlphaF(m_transparency);
+        const QVector4D monoColor = BondInstancing::tableColor(mono);
+        m_bondColors.resize(m_atoms.size());
+        for (int i = 0; i < m_atoms.size(); ++i) {
+            if (m_colorScheme == Monochrome) {
+                m_bondColors[i] = monoColor;
                 continue;
-            const QQuaternion rot = bondRotation(dir / length);
-            const QVector3D mid = 0.5f * (posA + posB);
-            const float halfLength = length * 0.25f;
-            const QVector3D scale(sxz, halfLength / kCylBaseHalfHeight, sxz);
-
-            QColor cA = (m_colorScheme == Monochrome) ? m_monochrome : elem::cpkColor(m_atoms[b.a].element);
-            QColor cB = (m_colorScheme == Monochrome) ? m_monochrome : elem::cpkColor(m_atoms[b.b].element);
-            cA.setAlphaF(m_transparency);
-            cB.setAlphaF(m_transparency);
-
-            segs.append({ 0.5f * (posA + mid), scale, rot, cA });
-            segs.append({ 0.5f * (mid + posB), scale, rot, cB });
+            }
+            const int z = m_atoms[i].atomicNumber <= elem::kMaxAtomicNumber ? m_atoms[i].atomicNumber : 0;
+            if (!known[z]) {
+                QColor c = elem::cpkColor(z);
+                c.setAlphaF(m_transparency);
+                byElement[z] = BondInstancing::tableColor(c);
+                known[z] = true;
+            }
+            m_bondColors[i] = byElement[z];
         }
     }
-    m_bondInstancing->setSegments(segs);
+    m_bondInstancing->setHalfBonds(m_bondA.isEmpty() ? nullptr : packPositions(), m_bondA.constData(),
+        m_bondB.constData(), m_bondA.size(), bondInstanceRadius(), m_bondColors.constData());
 
     // Overlays inherit the global styles just touched here; repack them too (cheap
     // early-return when there are none, so the MD updatePositions path stays fast).
@@ -886,6 +1162,8 @@ void SceneController::cloneStateFrom(const SceneController* src)
     // vectors — is intentionally NOT copied, for a clean export image).
     m_atoms = src->m_atoms;
     m_bonds = src->m_bonds;
+    m_bvhState = BvhState::Rebuild;
+    m_chunksDirty = true;   // m_lod stays at full detail: exports are never culled or impostored
     m_overlays = src->m_overlays;
 
     // Appearance
@@ -948,6 +1226,31 @@ void SceneController::cloneStateFrom(const SceneController* src)
     emit wallChanged();
 }
 
+void SceneController::setExportTile(const QSize& imageSize, const QRect& tile)
+{
+    if (tile.isEmpty() || imageSize.isEmpty()) {
+        if (!m_tileActive)
+            return;
+        m_tileActive = false;
+        emit tileChanged();
+        return;
+    }
+    // Symmetric frustum of the full image (vertical fov, like PerspectiveCamera), cut to
+    // the tile's pixel range. Near/far match viewer3d.qml's camera.
+    const float clipNear = 0.5f;
+    const float clipFar = m_cameraDistance * 8.0f + m_sceneExtent * 8.0f + 1000.0f;
+    const float top = clipNear * std::tan(m_fov * float(M_PI) / 360.0f);
+    const float right = top * float(imageSize.width()) / float(imageSize.height());
+    const auto x = [&](int px) { return -right + 2.0f * right * px / imageSize.width(); };
+    const auto y = [&](int px) { return top - 2.0f * top * px / imageSize.height(); };
+    QMatrix4x4 projection;
+    projection.frustum(x(tile.left()), x(tile.left() + tile.width()),
+        y(tile.top() + tile.height()), y(tile.top()), clipNear, clipFar);
+    m_tileProjection = projection;
+    m_tileActive = true;
+    emit tileChanged();
+}
+
 void SceneController::setRenderingMode(int mode)
 {
     m_renderingMode = mode;
@@ -1017,6 +1320,22 @@ void SceneController::setEditHint(const QString& text)
     emit editHintChanged();
 }
 
+void SceneController::setProfilerVisible(bool visible)
+{
+    if (m_profilerVisible == visible)
+        return;
+    m_profilerVisible = visible;
+    emit profilerChanged();
+}
+
+void SceneController::setProfilerText(const QString& text)
+{
+    if (m_profilerText == text)
+        return;
+    m_profilerText = text;
+    emit profilerChanged();
+}
+
 // ---- effects setters ----
 void SceneController::setSsao(bool on, float strength)
 {
@@ -1102,14 +1421,14 @@ void SceneController::resetView()
 }
 // Claude Generated 2026 - shift the currently displayed atoms so the mass-weighted
 // centre-of-mass lands at the origin, then reset the camera to a clean framing.
-// Uses curcuma Elements::AtomicMass / Elements::String2Element for consistent masses.
+// Uses curcuma Elements::AtomicMass (indexed by the atoms' interned atomic number).
 void SceneController::centerAtOrigin()
 {
     if (m_atoms.isEmpty()) return;
     QVector3D com;
     float totalMass = 0.0f;
     for (const AtomDatum& a : m_atoms) {
-        const int z = Elements::String2Element(a.element.toLower().toStdString());
+        const int z = a.atomicNumber;
         const float mass = (z > 0 && z < static_cast<int>(Elements::AtomicMass.size()))
             ? static_cast<float>(Elements::AtomicMass[z]) : 12.011f;
         com += a.position * mass;
@@ -1118,6 +1437,8 @@ void SceneController::centerAtOrigin()
     if (totalMass > 0.0f) com /= totalMass;
     for (AtomDatum& a : m_atoms)
         a.position -= com;
+    m_bvhState = BvhState::Rebuild;
+    m_chunksDirty = true;
     recomputeBounds();
     rebuildGeometry();
     resetView();
@@ -1173,46 +1494,65 @@ int SceneController::pickAtom(float sx, float sy, float viewW, float viewH) cons
     // Ray in world space: camera looks down -Z, right=+X, up=+Y.
     const QVector3D rayDir = QVector3D(ndcX * halfW, ndcY * halfH, -1.0f).normalized();
 
-    int best = -1;
-    float bestT = 1e20f;
-    for (int i = 0; i < m_atoms.size(); ++i) {
-        const QVector3D center = modelToWorld(m_atoms[i].position);
-        const float radius = elem::vdwRadius(m_atoms[i].element) * 1.5f; // generous hit
-        const QVector3D oc = camPos - center;
-        const float b = 2.0f * QVector3D::dotProduct(oc, rayDir);
-        const float c = QVector3D::dotProduct(oc, oc) - radius * radius;
-        const float disc = b * b - 4.0f * c;
-        if (disc < 0.0f)
-            continue;
-        const float sq = std::sqrt(disc);
-        float t = (-b - sq) * 0.5f;
-        if (t < 0.0f)
-            t = (-b + sq) * 0.5f;
-        if (t > 0.0f && t < bestT) {
-            bestT = t;
-            best = i;
-        }
-    }
-    return best;
+    // The BVH lives in model space: undo the root rotation about the scene centre instead
+    // of rotating every atom. Rotation keeps lengths, so the nearest hit is the same.
+    const QQuaternion toModel = m_rootRotation.inverted();
+    const QVector3D origin = m_sceneCenter + toModel.rotatedVector(camPos - m_sceneCenter);
+    return atomBvh().raycast(origin, toModel.rotatedVector(rayDir));
 }
 
 // Claude Generated 2026 - atoms whose projected centres fall inside a pixel rectangle
-// (rubber-band/box selection). Atoms behind the camera are skipped.
+// (rubber-band/box selection). Atoms behind the camera are skipped. Sorted by index.
 QVector<int> SceneController::atomsInScreenRect(const QRectF& rectPx, float viewW, float viewH) const
 {
     QVector<int> result;
     if (m_atoms.isEmpty() || viewW <= 0 || viewH <= 0 || !rectPx.isValid())
         return result;
+    // The rectangle seen from the camera is a pyramid: four side planes through the camera
+    // plus a near plane, written as n.(p - camPos) + d >= 0 in world space and then carried
+    // into model space for the BVH query.
+    const float halfH = std::tan(m_fov * float(M_PI) / 360.0f);
+    const float halfW = halfH * (viewW / viewH);
+    const float left = halfW * (2.0f * float(rectPx.left()) / viewW - 1.0f);
+    const float right = halfW * (2.0f * float(rectPx.right()) / viewW - 1.0f);
+    const float top = halfH * (1.0f - 2.0f * float(rectPx.top()) / viewH);
+    const float bottom = halfH * (1.0f - 2.0f * float(rectPx.bottom()) / viewH);
+    const QVector4D world[5] = {
+        { 1.0f, 0.0f, left, 0.0f },
+        { -1.0f, 0.0f, -right, 0.0f },
+        { 0.0f, -1.0f, -top, 0.0f },
+        { 0.0f, 1.0f, bottom, 0.0f },
+        { 0.0f, 0.0f, -1.0f, -1e-4f },  // in front of the camera
+    };
     const QVector3D camPos = cameraWorldPos();
-    for (int i = 0; i < m_atoms.size(); ++i) {
-        float sx = 0, sy = 0;
-        if (projectToScreen(modelToWorld(m_atoms[i].position), camPos, m_fov, viewW, viewH, sx, sy)
-            && rectPx.contains(sx, sy))
-            result.append(i);
+    const QQuaternion toModel = m_rootRotation.inverted();
+    QVector4D planes[5];
+    for (int p = 0; p < 5; ++p) {
+        const QVector3D n = world[p].toVector3D();
+        const QVector3D nModel = toModel.rotatedVector(n);
+        planes[p] = QVector4D(nModel, QVector3D::dotProduct(n, m_sceneCenter - camPos)
+                + world[p].w() - QVector3D::dotProduct(nModel, m_sceneCenter));
     }
+    atomBvh().centersInside(planes, 5, result);
+    std::sort(result.begin(), result.end());
     return result;
 }
 
+// Claude Generated 2026 - bring the picking BVH up to date with m_atoms (see m_bvhState).
+const AtomBvh& SceneController::atomBvh() const
+{
+    if (m_bvhState == BvhState::Refit) {
+        m_bvh.refit(packPositions());
+    } else if (m_bvhState == BvhState::Rebuild) {
+        QVector<float> radii(m_atoms.size());
+        for (int i = 0; i < m_atoms.size(); ++i)
+            radii[i] = elem::vdwRadius(m_atoms[i].atomicNumber) * 1.5f; // generous hit
+        m_bvh.build(packPositions(), radii.constData(), m_atoms.size());
+    }
+    m_bvhState = BvhState::Valid;
+    return m_bvh;
+}
+
 QVector3D SceneController::computeGrabForce(float mx, float my, int atomIndex,
     float viewW, float viewH, double grabStrength) const
 {
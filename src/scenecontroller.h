@@ -8,15 +8,24 @@
 #pragma once
 
 #include <QColor>
+#include <QMatrix4x4>
 #include <QObject>
+#include <QQuick3DGeometry>
 #include <QQuaternion>
+#include <QRect>
 #include <QRectF>
 #include <QVector3D>
+#include <QVector4D>
 #include <QVector>
 
-class AtomInstancing;
+#include "atombvh.h"
+#include "atominstancing.h"
+#include "positionspan.h"
+
 class BondInstancing;
+class CylinderGeometry;
 class QQuick3DInstancing;
+class SphereGeometry;
 
 class SceneController : public QObject
 {
@@ -55,6 +64,9 @@ class SceneController : public QObject
     Q_PROPERTY(QRectF rubberBandRect READ rubberBandRect NOTIFY rubberBandChanged)
     // Edit-mode key/mouse hint (2D overlay); empty string = hidden.
     Q_PROPERTY(QString editHint READ editHint NOTIFY editHintChanged)
+    // Claude Generated 2026 - frame-time HUD (Profiler statistics, formatted by the viewer).
+    Q_PROPERTY(bool profilerVisible READ profilerVisible NOTIFY profilerChanged)
+    Q_PROPERTY(QString profilerText READ profilerText NOTIFY profilerChanged)
 
     // Visibility per rendering mode.
     Q_PROPERTY(bool atomsVisible READ atomsVisible NOTIFY appearanceChanged)
@@ -89,6 +101,21 @@ class SceneController : public QObject
     Q_PROPERTY(float sceneExtent READ sceneExtent NOTIFY structureChanged)
     Q_PROPERTY(float fieldOfView READ fieldOfView CONSTANT)
 
+    // Claude Generated 2026 - level of detail. The primary structure is drawn with the
+    // tessellation-selectable meshes below; atoms in far (or, in the impostor tier, all)
+    // chunks go to the ray-cast sphere impostors, bonds switch to cylinder impostors as a
+    // whole. Chunks outside the view frustum are not uploaded at all.
+    Q_PROPERTY(QQuick3DGeometry* sphereGeometry READ sphereGeometry CONSTANT)
+    Q_PROPERTY(QQuick3DGeometry* cylinderGeometry READ cylinderGeometry CONSTANT)
+    Q_PROPERTY(QQuick3DInstancing* atomImpostorInstancing READ atomImpostorInstancing CONSTANT)
+    Q_PROPERTY(bool atomMeshActive READ atomMeshActive NOTIFY lodChanged)
+    Q_PROPERTY(bool atomImpostorsActive READ atomImpostorsActive NOTIFY lodChanged)
+    Q_PROPERTY(bool bondImpostorsActive READ bondImpostorsActive NOTIFY lodChanged)
+    // Claude Generated 2026 - tiled export: the View3D switches to a CustomCamera with an
+    // off-axis projection covering one tile of the full image (setExportTile()).
+    Q_PROPERTY(bool tileProjectionActive READ tileProjectionActive NOTIFY tileChanged)
+    Q_PROPERTY(QMatrix4x4 tileProjection READ tileProjection NOTIFY tileChanged)
+
 public:
     explicit SceneController(QObject* parent = nullptr);
 
@@ -97,6 +124,7 @@ public:
         QVector3D position;
         QString element;
         float charge = 0.0f;
+        quint8 atomicNumber = 0;  // index into the elem:: tables (0 = unknown)
     };
     struct BondDatum {
         int a = 0;
@@ -115,6 +143,18 @@ public:
         bool visible = true;
     };
 
+    // Claude Generated 2026 - rendering detail, chosen by PerformanceOptimizer (view.cpp).
+    // The defaults are full detail without culling (offscreen export controllers keep them).
+    struct LevelOfDetail {
+        int sphereRings = 32;
+        int sphereSlices = 32;
+        int bondSlices = 16;
+        bool impostors = false;       // every atom/bond as a ray-cast impostor
+        bool frustumCulling = false;  // skip atom chunks outside the view frustum
+        float impostorBelow = 0.0f;   // chunks whose atoms cover less than this fraction of
+                                      // the view height are drawn as impostors (0 = never)
+    };
+
     enum ColorScheme { CPK = 0, Monochrome = 1, ByCharge = 2, Custom = 3 };
     enum RenderingMode { BallAndStick = 0, Wireframe = 1, SpaceFilling = 2, SticksOnly = 3 };
 
@@ -214,12 +254,23 @@ public:
     float sceneExtent() const { return m_sceneExtent; }
     float fieldOfView() const { return m_fov; }
 
+    QQuick3DGeometry* sphereGeometry() const;
+    QQuick3DGeometry* cylinderGeometry() const;
+    QQuick3DInstancing* atomImpostorInstancing() const;
+    bool atomMeshActive() const { return m_atomMeshActive; }
+    bool atomImpostorsActive() const { return m_atomImpostorsActive; }
+    bool bondImpostorsActive() const { return m_lod.impostors; }
+    const LevelOfDetail& levelOfDetail() const { return m_lod; }
+    void setLevelOfDetail(const LevelOfDetail& lod);
+    /// Viewport size in pixels; the culling frustum needs its aspect ratio.
+    void setViewportSize(float width, float height);
+
     // --- structure / animation (called by the viewer) ---
     // keepView=true (structure editing: append/delete atoms) skips bounds recompute +
     // camera reset + selection clear, so the molecule stays put under the current view.
     void setStructure(const QVector<AtomDatum>& atoms, const QVector<BondDatum>& bonds,
         bool keepView = false);
-    void updatePositions(const QVector<QVector3D>& positions); // sim fast path (same count)
+    void updatePositions(PositionSpan positions); // sim / playback fast path (same count, no copy)
     void updateBonds(const QVector<BondDatum>& bonds);         // Claude Generated 2026 - swap bonds only (no bounds/camera change)
     void clear();
     int atomCount() const { return m_atoms.size(); }
@@ -235,6 +286,12 @@ public:
     /// camera, walls) into a fresh controller — used to render an offscreen export view
     /// without sharing scene-graph nodes with the live viewer. Claude Generated 2026.
     void cloneStateFrom(const SceneController* src);
+    /// Render only @p tile (pixels, y down, may extend past the image) of an @p imageSize
+    /// view: same camera, sub-frustum of its projection. An empty tile restores the
+    /// normal camera. Claude Generated 2026.
+    void setExportTile(const QSize& imageSize, const QRect& tile);
+    bool tileProjectionActive() const { return m_tileActive; }
+    QMatrix4x4 tileProjection() const { return m_tileProjection; }
     void setRenderingMode(int mode);
     void setAtomScaleFactor(float s);
     void setBondThickness(float r);
@@ -257,6 +314,11 @@ public:
     // Edit-mode hint overlay (empty = hidden).
     QString editHint() const { return m_editHint; }
     void setEditHint(const QString& text);
+    // Frame-time HUD overlay (top-left, monospace table).
+    bool profilerVisible() const { return m_profilerVisible; }
+    void setProfilerVisible(bool visible);
+    QString profilerText() const { return m_profilerText; }
+    void setProfilerText(const QString& text);
 
     // --- effects ---
     void setSsao(bool on, float strength);
@@ -310,16 +372,30 @@ signals:
     void wallChanged();
     void rubberBandChanged();
     void editHintChanged();
+    void profilerChanged();
+    void lodChanged();
+    void tileChanged();
 
 private:
     void rebuildGeometry();        // recompute atom items + bond segments
     void rebuildAtoms();           // recompute only atom items (selection/hover)
+    const QVector3D* packPositions() const;  // m_atoms positions as one contiguous block
+    const AtomBvh& atomBvh() const;    // picking BVH, brought up to date on demand
+    float bondInstanceRadius() const { return (m_renderingMode == Wireframe) ? qMin(m_bondRadius, 0.06f) : m_bondRadius; }
     void rebuildOverlays();        // repack the overlay list into the overlay buffers
+    // Claude Generated 2026 - LOD chunks: spatially sorted blocks of atoms with a bounding
+    // sphere (model space). Tier per chunk: culled / mesh / impostor.
+    enum ChunkTier : quint8 { ChunkCulled = 0, ChunkMesh = 1, ChunkImpostor = 2 };
+    bool lodActive() const { return m_lod.impostors || m_lod.frustumCulling || m_lod.impostorBelow > 0.0f; }
+    void rebuildChunks();          // regroup atoms (structure changes)
+    void refitChunks();            // recompute chunk spheres (positions changed)
+    bool classifyChunks();         // true if any chunk changed tier
+    void uploadAtomInstances();    // split m_atomItems into mesh / impostor tables
     void recomputeBounds();
     QColor atomColor(int index) const;
     // Base scheme colour for an element/charge (CPK/Monochrome/ByCharge), ignoring the
     // transient selection/hover/collision state — used as the tint base for overlays.
-    QColor schemeColor(const QString& element, float charge) const;
+    QColor schemeColor(int atomicNumber, float charge) const;
 
     AtomInstancing* m_atomInstancing = nullptr;
     BondInstancing* m_bondInstancing = nullptr;
@@ -349,16 +425,53 @@ private:
     AtomInstancing* m_overlayAtoms = nullptr; // combined overlay spheres (all structures)
     BondInstancing* m_overlayBonds = nullptr; // combined overlay cylinders (all structures)
     bool m_overlayVisible = false;            // true if any overlay structure is visible
+    SphereGeometry* m_sphereMesh = nullptr;   // primary atoms (rings/slices from the LOD)
+    CylinderGeometry* m_cylinderMesh = nullptr; // primary bonds
+    AtomInstancing* m_atomImpostors = nullptr;  // ray-cast sphere impostors (far/all chunks)
     QVector<OverlayStructure> m_overlays;     // aligned RMSD targets (per-structure tint/size)
 
     QVector<AtomDatum> m_atoms;
     QVector<BondDatum> m_bonds;
+    // Claude Generated 2026 - packed input of the batched bond kernel (drawn bonds only; bond
+    // k owns instances 2k/2k+1) plus per-frame scratch for updatePositions().
+    QVector<int> m_bondA, m_bondB;
+    QVector<QVector4D> m_bondColors;      // instance-table colour per atom
+    mutable QVector<QVector3D> m_positionScratch; // packed m_atoms positions
+    QVector<int> m_dirtyBonds;            // bonds with a moved endpoint this frame
+    QVector<quint8> m_moved;              // atom moved this frame
+    // Claude Generated 2026 - level of detail state (see LevelOfDetail / ChunkTier).
+    struct AtomChunk {
+        int begin = 0;             // range in m_chunkAtoms
+        int end = 0;
+        QVector3D center;          // model space
+        float radius = 0.0f;       // encloses every atom sphere of the chunk
+        float atomRadius = 0.0f;   // largest display radius in the chunk
+    };
+    LevelOfDetail m_lod;
+    QVector<AtomInstancing::Item> m_atomItems; // every primary atom (scale/colour), by index
+    QVector<AtomChunk> m_chunks;
+    QVector<int> m_chunkAtoms;                 // atom indices grouped by chunk
+    QVector<quint8> m_chunkTier;
+    bool m_chunksDirty = true;
+    bool m_atomMeshActive = true;
+    bool m_atomImpostorsActive = false;
+    float m_viewAspect = 1.0f;
+    bool m_tileActive = false;       // Claude Generated 2026 - tiled export sub-frustum
+    QMatrix4x4 m_tileProjection;
+    // Claude Generated 2026 - picking BVH over m_atoms (model space). Structure changes mark
+    // it for a rebuild, position updates for a refit; both happen on the next pick, so MD
+    // and playback frames without mouse interaction pay nothing.
+    enum class BvhState { Rebuild, Refit, Valid };
+    mutable AtomBvh m_bvh;
+    mutable BvhState m_bvhState = BvhState::Rebuild;
     QVector<int> m_selection;
     QVector<int> m_collisionAtoms;  // Claude Generated 2026 - clashing atoms (drawn red)
     int m_hoverAtom = -1;
     bool m_rubberBandActive = false;        // Claude Generated 2026 - box-select overlay
     QRectF m_rubberBandRect;                // viewport pixels
     QString m_editHint;                     // Claude Generated 2026 - edit-mode hint HUD
+    QString m_profilerText;                 // Claude Generated 2026 - frame-time HUD
+    bool m_profilerVisible = false;
 
     // appearance state
     int m_colorScheme = CPK;
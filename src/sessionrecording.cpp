@@ -0,0 +1,415 @@
+// sessionrecording.cpp - Binary recording of interactive MD sessions (.qrec)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "sessionrecording.h"
+
+#include "trajectorystore.h"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace {
+constexpr char kFileMagic[8] = { 'Q', 'R', 'C', 'R', 'E', 'C', '0', '1' };
+constexpr char kFooterMagic[8] = { 'Q', 'R', 'C', 'E', 'V', 'T', '0', '1' };
+constexpr quint32 kVersion = 1;
+constexpr quint32 kByteOrderMark = 0x01020304;
+
+struct FileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 byteOrderMark;
+    quint32 atomCount;
+    quint32 frameStride;
+    quint64 framesOffset;
+    double timestep;  // fs
+    quint8 reserved[24];
+};
+
+struct TopologyEntry {
+    quint8 atomicNumber;
+    char symbol[3];  // element symbol, NUL-padded
+};
+
+struct FrameHeader {
+    qint64 step;
+    double energy;
+    double ekin;
+    double temperature;
+    double targetTemperature;
+};
+
+struct Footer {
+    char magic[8];
+    quint64 eventOffset;
+    quint64 eventCount;
+    quint64 frameCount;
+};
+
+static_assert(sizeof(FileHeader) == 64, "qrec header layout");
+static_assert(sizeof(TopologyEntry) == 4, "qrec topology layout");
+static_assert(sizeof(FrameHeader) == 40, "qrec frame header layout");
+static_assert(sizeof(Footer) == 32, "qrec footer layout");
+static_assert(sizeof(SessionEvent) == 56, "qrec event layout");
+static_assert(sizeof(QVector3D) == 3 * sizeof(float), "positions are stored as packed QVector3D");
+
+constexpr qint64 align8(qint64 bytes)
+{
+    return (bytes + 7) & ~qint64(7);
+}
+
+qint64 framesOffsetFor(int atomCount)
+{
+    return align8(qint64(sizeof(FileHeader)) + qint64(atomCount) * qint64(sizeof(TopologyEntry)));
+}
+
+qint64 frameStrideFor(int atomCount)
+{
+    return align8(qint64(sizeof(FrameHeader)) + qint64(atomCount) * qint64(sizeof(QVector3D)));
+}
+
+// Recovered recordings only: whether a record is a frame the recorder wrote. Steps grow
+// strictly (one record per MD step / optimisation iteration), energies are finite and the
+// stride padding is zero; the event bytes of an interrupted close() fail this.
+bool plausibleFrame(const uchar* record, qint64 stride, int atomCount, qint64 previousStep)
+{
+    FrameHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    if (header.step <= previousStep || !std::isfinite(header.energy) || !std::isfinite(header.ekin)
+        || !(header.ekin >= 0.0) || !(header.temperature >= 0.0) || !std::isfinite(header.temperature)
+        || !(header.targetTemperature >= 0.0) || !std::isfinite(header.targetTemperature))
+        return false;
+    const qint64 used = qint64(sizeof(FrameHeader)) + qint64(atomCount) * qint64(sizeof(QVector3D));
+    for (qint64 b = used; b < stride; ++b)
+        if (record[b] != 0)
+            return false;
+    return true;
+}
+}
+
+QString SessionEvent::describe() const
+{
+    switch (type) {
+    case InjectForce: {
+        const double f = std::sqrt(value[0] * value[0] + value[1] * value[1] + value[2] * value[2]);
+        return QCoreApplication::translate("SessionEvent", "grab atom %1, |F| = %2 Eh/Bohr")
+            .arg(atom + 1)
+            .arg(f, 0, 'f', 4);
+    }
+    case ClearForce:
+        return QCoreApplication::translate("SessionEvent", "grab released");
+    case TargetTemperature:
+        return QCoreApplication::translate("SessionEvent", "T target %1 K").arg(value[0], 0, 'f', 1);
+    case WallTemp:
+        return QCoreApplication::translate("SessionEvent", "wall T %1 K").arg(value[0], 0, 'f', 1);
+    case WallBeta:
+        return QCoreApplication::translate("SessionEvent", "wall beta %1").arg(value[0], 0, 'f', 2);
+    }
+    return QString();
+}
+
+// ---------------------------------------------------------------------------
+// SessionRecorder
+// ---------------------------------------------------------------------------
+SessionRecorder::SessionRecorder(const QString& filePath)
+    : m_filePath(filePath)
+{
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+QString SessionRecorder::lastError() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_error;
+}
+
+qint64 SessionRecorder::frameCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_framesAppended;
+}
+
+bool SessionRecorder::open(const QVector<MoleculeViewer::Atom>& topology, double timestep)
+{
+    if (m_thread || topology.isEmpty())
+        return false;
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_error = QString("Cannot write %1: %2").arg(m_filePath, m_file.errorString());
+        return false;
+    }
+
+    m_atomCount = topology.size();
+    m_frameStride = frameStrideFor(m_atomCount);
+    const qint64 framesOffset = framesOffsetFor(m_atomCount);
+
+    QByteArray head(framesOffset, '\0');
+    FileHeader header = {};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kVersion;
+    header.byteOrderMark = kByteOrderMark;
+    header.atomCount = quint32(m_atomCount);
+    header.frameStride = quint32(m_frameStride);
+    header.framesOffset = quint64(framesOffset);
+    header.timestep = timestep;
+    std::memcpy(head.data(), &header, sizeof(header));
+    for (int i = 0; i < m_atomCount; ++i) {
+        TopologyEntry entry = {};
+        entry.atomicNumber = topology[i].atomicNumber;
+        const QByteArray symbol = topology[i].element.toLatin1().left(int(sizeof(entry.symbol)));
+        std::memcpy(entry.symbol, symbol.constData(), symbol.size());
+        std::memcpy(head.data() + sizeof(FileHeader) + i * sizeof(TopologyEntry), &entry, sizeof(entry));
+    }
+    if (m_file.write(head) != head.size()) {
+        m_error = QString("Cannot write %1: %2").arg(m_filePath, m_file.errorString());
+        m_file.close();
+        return false;
+    }
+
+    m_pending.clear();
+    m_writing.clear();
+    m_events.clear();
+    m_framesAppended = 0;
+    m_closing = false;
+    m_thread = QThread::create([this]() { writeLoop(); });
+    m_thread->start(QThread::LowPriority);
+    return true;
+}
+
+void SessionRecorder::appendFrame(const SimulationFrame& frame)
+{
+    if (int(frame.positions.size()) != m_atomCount)
+        return;
+
+    QMutexLocker lock(&m_mutex);
+    if (!m_thread || m_closing)
+        return;
+    // Backpressure: never drop a frame, wait for the writer instead.
+    while (m_pending.size() >= kMaxPendingBytes && m_error.isEmpty())
+        m_pendingDrained.wait(&m_mutex);
+
+    const qint64 at = m_pending.size();
+    if (m_pending.capacity() < at + m_frameStride)
+        m_pending.reserve(std::max(2 * m_pending.capacity(), at + m_frameStride));
+    m_pending.resize(at + m_frameStride);
+    char* record = m_pending.data() + at;
+
+    const FrameHeader header = { frame.step, frame.energy, frame.ekin, frame.temperature,
+        frame.targetTemperature };
+    std::memcpy(record, &header, sizeof(header));
+    const qint64 positionBytes = qint64(m_atomCount) * qint64(sizeof(QVector3D));
+    std::memcpy(record + sizeof(header), frame.positions.data(), positionBytes);
+    std::memset(record + sizeof(header) + positionBytes, 0, m_frameStride - sizeof(header) - positionBytes);
+    ++m_framesAppended;
+    m_pendingReady.wakeOne();
+}
+
+void SessionRecorder::appendEvent(SessionEvent event)
+{
+    QMutexLocker lock(&m_mutex);
+    if (!m_thread || m_closing)
+        return;
+    event.frame = m_framesAppended;
+    m_events.append(event);
+}
+
+void SessionRecorder::writeLoop()
+{
+    QMutexLocker lock(&m_mutex);
+    for (;;) {
+        while (m_pending.isEmpty() && !m_closing)
+            m_pendingReady.wait(&m_mutex);
+        if (m_pending.isEmpty())
+            return;  // closing and drained
+        m_pending.swap(m_writing);  // both keep their capacity
+        m_pendingDrained.wakeAll();
+        // After a failed (possibly short) write nothing more goes to the file: later records
+        // would land at misaligned offsets. Keep draining and discarding so the producer
+        // never blocks on a dead disk.
+        const bool failed = !m_error.isEmpty();
+        lock.unlock();
+
+        const bool written = failed || m_file.write(m_writing) == m_writing.size();
+        m_writing.resize(0);
+
+        lock.relock();
+        if (!written && m_error.isEmpty()) {
+            m_error = QString("Cannot write %1: %2").arg(m_filePath, m_file.errorString());
+            m_pendingDrained.wakeAll();
+        }
+    }
+}
+
+void SessionRecorder::close()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_thread)
+            return;
+        m_closing = true;
+        m_pendingReady.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+
+    Footer footer = {};
+    std::memcpy(footer.magic, kFooterMagic, sizeof(kFooterMagic));
+    footer.eventOffset = quint64(framesOffsetFor(m_atomCount) + m_framesAppended * m_frameStride);
+    footer.eventCount = quint64(m_events.size());
+    footer.frameCount = quint64(m_framesAppended);
+    if (m_error.isEmpty()) {
+        const qint64 eventBytes = qint64(m_events.size()) * qint64(sizeof(SessionEvent));
+        if (m_file.write(reinterpret_cast<const char*>(m_events.constData()), eventBytes) != eventBytes
+            || m_file.write(reinterpret_cast<const char*>(&footer), sizeof(footer)) != qint64(sizeof(footer)))
+            m_error = QString("Cannot write %1: %2").arg(m_filePath, m_file.errorString());
+    }
+    m_file.close();
+    m_pending.clear();
+    m_writing.clear();
+}
+
+// ---------------------------------------------------------------------------
+// SessionRecording
+// ---------------------------------------------------------------------------
+SessionRecording::~SessionRecording()
+{
+    if (m_map)
+        m_file.unmap(m_map);
+}
+
+bool SessionRecording::open(const QString& filePath)
+{
+    auto failed = [this, &filePath](const QString& reason) {
+        m_error = QString("%1: %2").arg(filePath, reason);
+        return false;
+    };
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return failed(m_file.errorString());
+    m_size = m_file.size();
+    if (m_size < qint64(sizeof(FileHeader)))
+        return failed(QStringLiteral("not a session recording"));
+    m_map = m_file.map(0, m_size);
+    if (!m_map)
+        return failed(QStringLiteral("cannot map file"));
+
+    FileHeader header;
+    std::memcpy(&header, m_map, sizeof(header));
+    if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0)
+        return failed(QStringLiteral("not a session recording"));
+    if (header.byteOrderMark != kByteOrderMark)
+        return failed(QStringLiteral("recorded on a machine with another byte order"));
+    if (header.version != kVersion)
+        return failed(QString("unsupported version %1").arg(header.version));
+    const int atomCount = int(header.atomCount);
+    m_framesOffset = framesOffsetFor(atomCount);
+    m_frameStride = frameStrideFor(atomCount);
+    if (atomCount <= 0 || qint64(header.framesOffset) != m_framesOffset
+        || qint64(header.frameStride) != m_frameStride || m_size < m_framesOffset)
+        return failed(QStringLiteral("corrupt header"));
+    m_timestep = header.timestep;
+
+    m_elements.resize(atomCount);
+    m_atomicNumbers.resize(atomCount);
+    for (int i = 0; i < atomCount; ++i) {
+        TopologyEntry entry;
+        std::memcpy(&entry, m_map + sizeof(FileHeader) + i * sizeof(TopologyEntry), sizeof(entry));
+        m_atomicNumbers[i] = entry.atomicNumber;
+        const char* end = std::find(entry.symbol, entry.symbol + sizeof(entry.symbol), '\0');
+        m_elements[i] = QString::fromLatin1(entry.symbol, int(end - entry.symbol));
+    }
+
+    // A closed session ends in a footer whose offsets agree with the file size; anything
+    // else is an interrupted recording: keep the whole frames, drop the (unwritten) events.
+    qint64 frames = -1;
+    if (m_size >= m_framesOffset + qint64(sizeof(Footer))) {
+        Footer footer;
+        std::memcpy(&footer, m_map + m_size - sizeof(Footer), sizeof(footer));
+        const qint64 eventOffset = m_framesOffset + qint64(footer.frameCount) * m_frameStride;
+        if (std::memcmp(footer.magic, kFooterMagic, sizeof(kFooterMagic)) == 0
+            && qint64(footer.eventOffset) == eventOffset
+            && eventOffset + qint64(footer.eventCount) * qint64(sizeof(SessionEvent)) + qint64(sizeof(Footer)) == m_size) {
+            frames = qint64(footer.frameCount);
+            m_events.resize(qsizetype(footer.eventCount));
+            std::memcpy(m_events.data(), m_map + eventOffset, footer.eventCount * sizeof(SessionEvent));
+        }
+    }
+    m_recovered = frames < 0;
+    if (m_recovered) {
+        // Whole strides after the topology, up to the first record that is no frame (the
+        // event track of a close() that died before its footer, or a torn write).
+        const qint64 strides = (m_size - m_framesOffset) / m_frameStride;
+        qint64 previousStep = std::numeric_limits<qint64>::min();
+        frames = 0;
+        while (frames < strides) {
+            const uchar* record = m_map + m_framesOffset + frames * m_frameStride;
+            if (!plausibleFrame(record, m_frameStride, atomCount, previousStep))
+                break;
+            std::memcpy(&previousStep, record, sizeof(previousStep));  // FrameHeader::step
+            ++frames;
+        }
+    }
+    m_frameCount = int(std::min<qint64>(frames, std::numeric_limits<int>::max()));
+    if (m_frameCount == 0)
+        return failed(QStringLiteral("no frames recorded"));
+    return true;
+}
+
+const uchar* SessionRecording::frameRecord(int frame) const
+{
+    if (frame < 0 || frame >= m_frameCount)
+        return nullptr;
+    return m_map + m_framesOffset + qint64(frame) * m_frameStride;
+}
+
+SessionRecording::FrameInfo SessionRecording::frameInfo(int frame) const
+{
+    FrameInfo info;
+    const uchar* record = frameRecord(frame);
+    if (!record)
+        return info;
+    FrameHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    info.step = header.step;
+    info.energy = header.energy;
+    info.ekin = header.ekin;
+    info.temperature = header.temperature;
+    info.targetTemperature = header.targetTemperature;
+    return info;
+}
+
+const QVector3D* SessionRecording::positions(int frame) const
+{
+    const uchar* record = frameRecord(frame);
+    return record ? reinterpret_cast<const QVector3D*>(record + sizeof(FrameHeader)) : nullptr;
+}
+
+int SessionRecording::lastEventAt(int frame) const
+{
+    const auto it = std::upper_bound(m_events.cbegin(), m_events.cend(), qint64(frame),
+        [](qint64 f, const SessionEvent& e) { return f < e.frame; });
+    return int(it - m_events.cbegin()) - 1;
+}
+
+QSharedPointer<TrajectoryStore> SessionRecording::trajectoryStore(
+    const QSharedPointer<const SessionRecording>& recording)
+{
+    if (!recording || recording->frameCount() == 0)
+        return {};
+    auto store = QSharedPointer<TrajectoryStore>::create();
+    store->adoptMapped(recording->elements(), recording->atomicNumbers(), recording->frameCount(),
+        recording->frameRecord(0) + sizeof(FrameHeader), recording->m_frameStride,
+        std::shared_ptr<const void>(recording.data(), [recording](const void*) {}));
+    return store;
+}
@@ -0,0 +1,182 @@
+// sessionrecording.h - Binary recording of interactive MD sessions (.qrec)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - replayable interactive sessions.
+//
+// curcuma's write_xyz produces a text .trj.xyz and knows nothing about what the user did
+// during the run. A .qrec file keeps every frame the worker produced plus the interactive
+// events (grab forces, thermostat setpoint, wall parameters) in a fixed-stride binary
+// layout that is scrubbed straight from a memory mapping:
+//
+//   FileHeader (64 B)      magic "QRCREC01", version, byte-order mark, atom count,
+//                          frame stride, offset of frame 0, MD time step
+//   topology               atomCount x { uint8 Z; char symbol[3] }, padded to 8 bytes
+//   frames                 fixed stride: FrameHeader (step, Epot, Ekin, T, T_target)
+//                          followed by atomCount x 3 float32 (Angstrom)
+//   events                 eventCount x SessionEvent            } written by
+//   Footer (32 B)          magic "QRCEVT01", event offset/count,  } SessionRecorder::close()
+//                          frame count
+//
+// Frame i lives at framesOffset + i * frameStride, so opening is O(1) in the frame count.
+// A session that ended without close() (crash, kill) has no footer; its frames are still
+// readable (count = whole strides after the topology, cut at the first record that is not
+// a plausible frame), only the event track is lost.
+// Host byte order; the byte-order mark rejects files written on the other endianness.
+
+#pragma once
+
+#include "simulationframe.h"
+#include "view.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector3D>
+#include <QVector>
+#include <QWaitCondition>
+
+class QThread;
+class TrajectoryStore;
+
+/// One interactive change, applied before frame @c frame was produced.
+struct SessionEvent {
+    enum Type : quint32 {
+        InjectForce = 1,        // atom, aux = maxShells, value = { fx, fy, fz, alpha } (Eh/Bohr)
+        ClearForce = 2,         // grab released
+        TargetTemperature = 3,  // value[0] = K
+        WallTemp = 4,           // value[0] = K
+        WallBeta = 5            // value[0] = beta
+    };
+
+    qint64 frame = 0;
+    quint32 type = 0;
+    qint32 atom = -1;
+    qint32 aux = 0;
+    qint32 reserved = 0;
+    double value[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    /// Short human-readable form for the status bar ("grab atom 12, |F| = 0.020 Eh/Bohr").
+    QString describe() const;
+};
+
+/**
+ * @brief Appends frames and events to a .qrec file from a background writer thread.
+ *
+ * appendFrame() / appendEvent() are called on the simulation worker thread. A frame is
+ * encoded into a pending buffer (no per-frame allocation once the buffers have grown); the
+ * writer thread swaps that buffer out and writes it, so disk latency never stalls an MD
+ * step. If the disk falls more than kMaxPendingBytes behind, appendFrame() blocks until
+ * the writer catches up instead of dropping frames. Events are kept in memory (they are
+ * few) and written with the footer by close(); the destructor closes as well.
+ */
+class SessionRecorder
+{
+public:
+    static constexpr qint64 kMaxPendingBytes = 64LL * 1024 * 1024;
+
+    explicit SessionRecorder(const QString& filePath);
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /** Create the file, write header + topology and start the writer thread. */
+    bool open(const QVector<MoleculeViewer::Atom>& topology, double timestep);
+    bool isOpen() const { return m_thread != nullptr; }
+
+    /** Queue one frame. Frames with another atom count than the topology are skipped. */
+    void appendFrame(const SimulationFrame& frame);
+    /** Record an event; it is stamped with the index of the next frame. */
+    void appendEvent(SessionEvent event);
+
+    /** Flush the pending frames, write event track + footer and stop the writer. */
+    void close();
+
+    QString filePath() const { return m_filePath; }
+    QString lastError() const;
+    qint64 frameCount() const;
+
+private:
+    void writeLoop();
+
+    QString m_filePath;
+    QFile m_file;
+    QThread* m_thread = nullptr;
+    int m_atomCount = 0;
+    qint64 m_frameStride = 0;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_pendingReady;   // writer: frames queued or closing
+    QWaitCondition m_pendingDrained; // producer: backlog below kMaxPendingBytes
+    QByteArray m_pending;            // encoded frames not yet handed to the writer
+    QByteArray m_writing;            // buffer the writer currently drains (ping-pong)
+    QVector<SessionEvent> m_events;
+    qint64 m_framesAppended = 0;
+    bool m_closing = false;
+    QString m_error;
+};
+
+/**
+ * @brief Read-only, memory-mapped view of a .qrec file.
+ *
+ * Positions and per-frame metadata are read from the mapping on demand; nothing is copied
+ * at open() besides the topology and the event track. Thread-safe for concurrent reads.
+ */
+class SessionRecording
+{
+public:
+    struct FrameInfo {
+        qint64 step = 0;
+        double energy = 0.0;             // Hartree
+        double ekin = 0.0;               // Hartree
+        double temperature = 0.0;        // K
+        double targetTemperature = 0.0;  // K
+    };
+
+    SessionRecording() = default;
+    ~SessionRecording();
+
+    SessionRecording(const SessionRecording&) = delete;
+    SessionRecording& operator=(const SessionRecording&) = delete;
+
+    bool open(const QString& filePath);
+    QString filePath() const { return m_file.fileName(); }
+    QString lastError() const { return m_error; }
+
+    int frameCount() const { return m_frameCount; }
+    int atomCount() const { return m_elements.size(); }
+    double timestep() const { return m_timestep; }
+    /// True when the footer was missing (session not closed) and only frames were recovered.
+    bool recovered() const { return m_recovered; }
+
+    const QVector<QString>& elements() const { return m_elements; }
+    const QVector<quint8>& atomicNumbers() const { return m_atomicNumbers; }
+    const QVector<SessionEvent>& events() const { return m_events; }
+
+    FrameInfo frameInfo(int frame) const;
+    /// Coordinates of @p frame inside the mapping (atomCount() entries), nullptr if out of range.
+    const QVector3D* positions(int frame) const;
+    /// Index into events() of the last event applied at or before @p frame, -1 if none.
+    int lastEventAt(int frame) const;
+
+    /** Frames of @p recording as a mapped TrajectoryStore (keeps the recording alive). */
+    static QSharedPointer<TrajectoryStore> trajectoryStore(
+        const QSharedPointer<const SessionRecording>& recording);
+
+private:
+    const uchar* frameRecord(int frame) const;
+
+    QFile m_file;
+    uchar* m_map = nullptr;
+    qint64 m_size = 0;
+    qint64 m_framesOffset = 0;
+    qint64 m_frameStride = 0;
+    int m_frameCount = 0;
+    double m_timestep = 0.0;
+    bool m_recovered = false;
+    QVector<QString> m_elements;
+    QVector<quint8> m_atomicNumbers;
+    QVector<SessionEvent> m_events;
+    QString m_error;
+};
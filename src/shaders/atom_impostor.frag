@@ -0,0 +1,47 @@
+// Claude Generated 2026 - ray-cast sphere impostor, fragment stage (Quick3D CustomMaterial,
+// unshaded). Intersects the view ray with the sphere, discards misses, writes the true
+// sphere depth (so impostors intersect correctly with meshes and with each other) and
+// lights the hit with the screen-fixed corner lights of atom_instanced.frag.
+
+VARYING vec3 vViewPos;
+VARYING vec3 vCenter;
+VARYING float vRadius;
+VARYING vec4 vColor;
+
+vec3 cornerLighting(vec3 base, vec3 n)
+{
+    // View-space directions toward each screen corner, tilted toward the camera (+z).
+    vec3 cornerDir[4] = vec3[4](
+        normalize(vec3(-0.6,  0.6, 0.5)),  // top-left
+        normalize(vec3( 0.6,  0.6, 0.5)),  // top-right
+        normalize(vec3(-0.6, -0.6, 0.5)),  // bottom-left
+        normalize(vec3( 0.6, -0.6, 0.5))   // bottom-right
+    );
+    float diff = 0.0;
+    float spec = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        float w = cornerLights[i];
+        if (w <= 0.0)
+            continue;
+        vec3 h = normalize(cornerDir[i] + vec3(0.0, 0.0, 1.0));
+        diff += w * max(dot(n, cornerDir[i]), 0.0);
+        spec += w * pow(max(dot(n, h), 0.0), 64.0);
+    }
+    return base * 0.22 + base * diff * 0.55 + vec3(0.3) * spec;
+}
+
+void MAIN()
+{
+    // Camera at the view-space origin: |t*d - c|^2 = r^2.
+    vec3 d = normalize(vViewPos);
+    float b = dot(d, vCenter);
+    float h = b * b - dot(vCenter, vCenter) + vRadius * vRadius;
+    if (h < 0.0)
+        discard;
+    vec3 hit = (b - sqrt(h)) * d;
+    vec3 n = (hit - vCenter) / vRadius;
+
+    vec4 clip = PROJECTION_MATRIX * vec4(hit, 1.0);
+    gl_FragDepth = (clip.z / clip.w - NEAR_CLIP_VALUE) / (1.0 - NEAR_CLIP_VALUE);
+    FRAGCOLOR = vec4(cornerLighting(vColor.rgb, n), vColor.a);
+}
@@ -0,0 +1,24 @@
+// Claude Generated 2026 - ray-cast sphere impostor, vertex stage (Quick3D CustomMaterial).
+// Drawn on the instanced "#Rectangle" (100 x 100 in XY) with the unchanged atom instance
+// table: the quad is re-oriented towards the camera in view space, sized to the sphere
+// radius encoded in the instance scale (base radius 50, like "#Sphere") and pulled
+// forward by one radius so the ray-cast surface is never clipped by the quad itself.
+
+VARYING vec3 vViewPos;   // view-space position on the billboard
+VARYING vec3 vCenter;    // view-space sphere centre
+VARYING float vRadius;
+VARYING vec4 vColor;
+
+void MAIN()
+{
+    vec4 center = VIEW_MATRIX * INSTANCE_MODEL_MATRIX * vec4(0.0, 0.0, 0.0, 1.0);
+    float radius = length(INSTANCE_MODEL_MATRIX[0].xyz) * 50.0;
+
+    // 1.25: perspective widens the silhouette of spheres away from the view axis.
+    vec3 corner = center.xyz + vec3(VERTEX.xy / 50.0 * radius * 1.25, radius);
+    vViewPos = corner;
+    vCenter = center.xyz;
+    vRadius = radius;
+    vColor = INSTANCE_COLOR;
+    POSITION = PROJECTION_MATRIX * vec4(corner, 1.0);
+}
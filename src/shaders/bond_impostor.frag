@@ -0,0 +1,68 @@
+// Claude Generated 2026 - ray-cast cylinder impostor, fragment stage (Quick3D CustomMaterial,
+// unshaded). Local frame: x^2 + z^2 <= 50^2, |y| <= 50. Side hit first, flat caps for rays
+// entering through an end (visible in sticks-only mode); writes the true surface depth.
+
+VARYING vec3 vLocal;
+VARYING vec3 vCamLocal;
+VARYING vec3 vAxisX;
+VARYING vec3 vAxisY;
+VARYING vec3 vAxisZ;
+VARYING vec3 vOrigin;
+VARYING vec4 vColor;
+
+vec3 cornerLighting(vec3 base, vec3 n)
+{
+    vec3 cornerDir[4] = vec3[4](
+        normalize(vec3(-0.6,  0.6, 0.5)),  // top-left
+        normalize(vec3( 0.6,  0.6, 0.5)),  // top-right
+        normalize(vec3(-0.6, -0.6, 0.5)),  // bottom-left
+        normalize(vec3( 0.6, -0.6, 0.5))   // bottom-right
+    );
+    float diff = 0.0;
+    float spec = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        float w = cornerLights[i];
+        if (w <= 0.0)
+            continue;
+        vec3 h = normalize(cornerDir[i] + vec3(0.0, 0.0, 1.0));
+        diff += w * max(dot(n, cornerDir[i]), 0.0);
+        spec += w * pow(max(dot(n, h), 0.0), 64.0);
+    }
+    return base * 0.22 + base * diff * 0.55 + vec3(0.3) * spec;
+}
+
+void MAIN()
+{
+    const float R = 50.0;
+    vec3 ro = vCamLocal;
+    vec3 rd = vLocal - vCamLocal;   // not normalised: t is in the same units on both paths
+
+    vec3 hit;
+    vec3 n;
+    float a = dot(rd.xz, rd.xz);
+    float b = dot(ro.xz, rd.xz);
+    float c = dot(ro.xz, ro.xz) - R * R;
+    float h = b * b - a * c;
+    bool side = false;
+    if (a > 1e-8 && h >= 0.0) {
+        hit = ro + ((-b - sqrt(h)) / a) * rd;
+        side = abs(hit.y) <= 50.0;
+        n = vec3(hit.x, 0.0, hit.z);
+    }
+    if (!side) {
+        if (abs(rd.y) < 1e-8)
+            discard;
+        float capY = ro.y > 0.0 ? 50.0 : -50.0;
+        hit = ro + ((capY - ro.y) / rd.y) * rd;
+        if (dot(hit.xz, hit.xz) > R * R)
+            discard;
+        n = vec3(0.0, capY, 0.0);
+    }
+
+    mat3 m = mat3(vAxisX, vAxisY, vAxisZ);
+    vec3 worldNormal = normalize(transpose(inverse(m)) * n);
+    vec3 viewNormal = normalize(mat3(VIEW_MATRIX) * worldNormal);
+    vec4 clip = VIEWPROJECTION_MATRIX * vec4(m * hit + vOrigin, 1.0);
+    gl_FragDepth = (clip.z / clip.w - NEAR_CLIP_VALUE) / (1.0 - NEAR_CLIP_VALUE);
+    FRAGCOLOR = vec4(cornerLighting(vColor.rgb, viewNormal), vColor.a);
+}
@@ -0,0 +1,26 @@
+// Claude Generated 2026 - ray-cast cylinder impostor, vertex stage (Quick3D CustomMaterial).
+// Drawn on the instanced "#Cube" (100 units, centred) with the unchanged bond instance
+// table: the cube is exactly the bounding box of the instance's "#Cylinder" (radius 50,
+// height 100 along +Y), so the ray can be cast in the instance's local frame where the
+// cylinder is axis-aligned. 12 triangles per bond instead of the cylinder mesh.
+
+VARYING vec3 vLocal;     // local-space position on the box
+VARYING vec3 vCamLocal;  // camera position in the instance's local frame
+VARYING vec3 vAxisX;     // instance model matrix columns (normal + depth reconstruction)
+VARYING vec3 vAxisY;
+VARYING vec3 vAxisZ;
+VARYING vec3 vOrigin;
+VARYING vec4 vColor;
+
+void MAIN()
+{
+    mat4 m = INSTANCE_MODEL_MATRIX;
+    vLocal = VERTEX;
+    vCamLocal = (inverse(m) * vec4(CAMERA_POSITION, 1.0)).xyz;
+    vAxisX = m[0].xyz;
+    vAxisY = m[1].xyz;
+    vAxisZ = m[2].xyz;
+    vOrigin = m[3].xyz;
+    vColor = INSTANCE_COLOR;
+    POSITION = INSTANCE_MODELVIEWPROJECTION_MATRIX * vec4(VERTEX, 1.0);
+}
@@ -139,12 +139,17 @@ void SimulationControlWidget::setupUI()
     // every 1/fpsLimit seconds so "max XXX FPS" is honoured on click-driven
     // single-step optimisation).
     auto* speedForm = new QFormLayout;
+    // 0 = "Unlimited" (Claude Generated 2026): MD integrates back to back and the viewer
+    // shows the newest step per rendered frame (SimulationFrameRing).
     m_fpsLimitSpin = new QSpinBox(this);
-    m_fpsLimitSpin->setRange(1, 240);
+    m_fpsLimitSpin->setRange(0, 240);
     m_fpsLimitSpin->setValue(30);
     m_fpsLimitSpin->setSuffix(tr(" fps"));
+    m_fpsLimitSpin->setSpecialValueText(tr("Unlimited"));
     m_fpsLimitSpin->setToolTip(tr("Maximum steps/iterations emitted per second "
-                                  "(throttles the auto-run cadence and the Step button rate)"));
+                                  "(throttles the auto-run cadence and the Step button rate).\n"
+                                  "Unlimited: MD runs as fast as possible, the viewer shows "
+                                  "the latest step at display rate."));
     speedForm->addRow(tr("Speed:"), m_fpsLimitSpin);
     innerLayout->addLayout(speedForm);
 
@@ -768,6 +773,12 @@ void SimulationControlWidget::setupUI()
     m_writeTrjCheck = new QCheckBox(tr("Write .trj.xyz"), this);
     outputLayout->addWidget(m_writeTrjCheck);
 
+    m_recordSessionCheck = new QCheckBox(tr("Record session (.qrec)"), this);
+    m_recordSessionCheck->setToolTip(tr("Record every frame plus grab forces, temperature and wall "
+                                        "changes to a binary .qrec file in the working directory. "
+                                        "Open it like a trajectory to replay the session."));
+    outputLayout->addWidget(m_recordSessionCheck);
+
     m_perfCheck = new QCheckBox(tr("Performance analysis"), this);
     outputLayout->addWidget(m_perfCheck);
 
@@ -874,6 +885,7 @@ void SimulationControlWidget::setupUI()
     connect(m_hmassSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, notifyConfig);
     connect(m_gpuCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, notifyConfig);
     connect(m_writeTrjCheck, &QCheckBox::toggled, this, notifyConfig);
+    connect(m_recordSessionCheck, &QCheckBox::toggled, this, notifyConfig);
     connect(m_perfCheck, &QCheckBox::toggled, this, notifyConfig);
     connect(m_convergenceSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, notifyConfig);
     connect(m_optKeepParamsCheck, &QCheckBox::toggled, this, notifyConfig);
@@ -1014,6 +1026,7 @@ SimulationConfig SimulationControlWidget::buildConfig() const
     cfg.noseChainLength     = m_noseChainSpin->value();
     cfg.gpu = m_gpuCombo->currentData().toString();
     cfg.writeTrajectory = m_writeTrjCheck->isChecked();
+    cfg.recordSession = m_recordSessionCheck->isChecked();
     cfg.performanceAnalysis = m_perfCheck->isChecked();
     cfg.convergence = m_convergenceSpin->value();
     cfg.optKeepParameters = m_optKeepParamsCheck->isChecked();
@@ -1108,7 +1121,7 @@ void SimulationControlWidget::applyConfig(const SimulationConfig& cfg)
     const QList<QWidget*> guarded = {
         m_modeCombo, m_methodCombo, m_optimizerCombo, m_tempSlider, m_timestepSpin,
         m_stepsSpin, m_fpsLimitSpin, m_hmassSpin, m_thermostatCombo, m_couplingSpin,
-        m_andersenProbSpin, m_noseChainSpin, m_gpuCombo, m_writeTrjCheck, m_perfCheck,
+        m_andersenProbSpin, m_noseChainSpin, m_gpuCombo, m_writeTrjCheck, m_recordSessionCheck, m_perfCheck,
         m_convergenceSpin, m_optKeepParamsCheck, m_rattleCombo, m_rattle12Check,
         m_rattle13Check, m_rattleTol12Spin, m_rattleTol13Spin, m_rattleMaxIterSpin,
         m_topologyModeCombo, m_rmsdMtdEnableCheck, m_rmsdMtdKSpin, m_rmsdMtdAlphaSpin,
@@ -1136,6 +1149,7 @@ void SimulationControlWidget::applyConfig(const SimulationConfig& cfg)
     m_noseChainSpin->setValue(cfg.noseChainLength);
     selectData(m_gpuCombo, cfg.gpu);
     m_writeTrjCheck->setChecked(cfg.writeTrajectory);
+    m_recordSessionCheck->setChecked(cfg.recordSession);
     m_perfCheck->setChecked(cfg.performanceAnalysis);
     m_convergenceSpin->setValue(cfg.convergence);
     m_optKeepParamsCheck->setChecked(cfg.optKeepParameters);
@@ -1256,6 +1270,7 @@ void SimulationControlWidget::onStartClicked()
     m_worker->setConfig(buildConfig());
 
     m_thread = new QThread(this);
+    m_thread->setObjectName(QStringLiteral("Simulation"));   // trace track name
     m_worker->moveToThread(m_thread);
 
     connect(m_thread, &QThread::started, m_worker, &SimulationWorker::run);
@@ -1321,6 +1336,7 @@ void SimulationControlWidget::onStepClicked()
     m_worker->setConfig(buildConfig());
 
     m_thread = new QThread(this);
+    m_thread->setObjectName(QStringLiteral("Simulation"));   // trace track name
     m_worker->moveToThread(m_thread);
 
     // Single-shot step: QThread::started → stepOnce() (NOT run()).
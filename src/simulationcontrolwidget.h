@@ -152,6 +152,7 @@ private:
     QDoubleSpinBox* m_hmassSpin = nullptr;  // Hydrogen mass scaling
     QComboBox* m_gpuCombo = nullptr;
     QCheckBox* m_writeTrjCheck = nullptr;
+    QCheckBox* m_recordSessionCheck = nullptr;  // Claude Generated 2026 - .qrec session recording
     QCheckBox* m_perfCheck = nullptr;
 
     // --- GFN-FF topology mode ---
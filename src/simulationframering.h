@@ -0,0 +1,78 @@
+// simulationframering.h - Lock-free latest-frame exchange between MD worker and viewer
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - uncapped MD (fpsLimit 0).
+//
+// Single producer (the worker thread) and single consumer (the GUI thread) share three
+// preallocated SimulationFrames. The producer owns one slot ("back") and fills it in
+// place every step; publish() swaps it with the shared "middle" slot. The consumer owns
+// another slot ("front") and takeLatest() swaps it with the middle when that holds a
+// fresh frame. Both swaps are one atomic exchange, so neither side ever waits and the
+// consumer always sees the newest step; older unconsumed steps are simply overwritten.
+// Slots keep their position storage, so after the first three steps nothing allocates.
+//
+// The consumer pulls once per rendered frame. To restart an idle render loop, publish()
+// reports when the consumer found nothing new on its last pull; the worker then sends a
+// single queued notification instead of one signal per step.
+
+#pragma once
+
+#include "simulationframe.h"
+
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QSharedPointer>
+
+class SimulationFrameRing
+{
+public:
+    SimulationFrameRing()
+    {
+        for (QSharedPointer<SimulationFrame>& slot : m_slots)
+            slot = QSharedPointer<SimulationFrame>::create();
+    }
+
+    // --- producer (worker thread) ---
+
+    /// Slot to fill for the next step; owned by the producer until publish().
+    SimulationFrame& writeSlot() { return *m_slots[m_back]; }
+
+    /** Make the filled slot the latest frame.
+     *  @return true if the consumer is idle and must be notified to pull again. */
+    bool publish()
+    {
+        m_back = m_middle.fetchAndStoreOrdered(m_back | kFresh) & kIndexMask;
+        m_published.fetchAndAddRelaxed(1);
+        return m_consumerIdle.fetchAndStoreOrdered(0) != 0;
+    }
+
+    // --- consumer (GUI thread) ---
+
+    /** Newest frame published since the last call, or null if there is none. The frame
+     *  belongs to the consumer until the next takeLatest(); do not keep it beyond that. */
+    SimulationFramePtr takeLatest()
+    {
+        if (!(m_middle.loadAcquire() & kFresh)) {
+            // Announce idleness first, then re-check: a frame published in between
+            // either is seen here or makes publish() request a notification.
+            m_consumerIdle.storeRelease(1);
+            if (!(m_middle.loadAcquire() & kFresh) || !m_consumerIdle.testAndSetOrdered(1, 0))
+                return {};
+        }
+        m_front = m_middle.fetchAndStoreOrdered(m_front) & kIndexMask;
+        return m_slots[m_front];
+    }
+
+    /// Steps published so far (frames the consumer skipped included).
+    qint64 publishedCount() const { return m_published.loadRelaxed(); }
+
+private:
+    static constexpr int kFresh = 0x4;      // set on m_middle by publish(), cleared by takeLatest()
+    static constexpr int kIndexMask = 0x3;
+
+    QSharedPointer<SimulationFrame> m_slots[3];
+    int m_back = 0;                  // producer only
+    int m_front = 1;                 // consumer only
+    QAtomicInt m_middle{ 2 };        // slot index | kFresh
+    QAtomicInt m_consumerIdle{ 1 };  // consumer's last pull came back empty
+    QAtomicInteger<qint64> m_published{ 0 };
+};
@@ -3,6 +3,7 @@
 // Claude Generated - Interactive Simulation Integration (stepwise API)
 
 #include "simulationworker.h"
+#include "profiler.h"
 
 #include "external/json.hpp"
 using json = nlohmann::json;
@@ -107,6 +108,7 @@ void applyTempRampParams(const SimulationConfig& cfg, json& simplemd_params)
 
 SimulationWorker::SimulationWorker(QObject* parent)
     : QObject(parent)
+    , m_frameRing(QSharedPointer<SimulationFrameRing>::create())
 {
     static const int kPtrTypeId = qRegisterMetaType<SimulationFramePtr>("SimulationFramePtr");
     Q_UNUSED(kPtrTypeId);
@@ -121,6 +123,8 @@ static Molecule atomsToMolecule(const QVector<MoleculeViewer::Atom>& atoms);
 static SimulationFramePtr moleculeToFrame(
     const Molecule& mol, int referenceSize, double energy, double ekin, int step,
     double temperature = 0.0, double targetTemperature = 0.0);
+static void fillFrame(SimulationFrame& frame, const Molecule& mol, int referenceSize,
+    double energy, double ekin, int step, double temperature, double targetTemperature);
 static Vector pendingForcesToFlatVector(const Eigen::MatrixXd& pending);
 
 void SimulationWorker::setMolecule(const QVector<MoleculeViewer::Atom>& atoms)
@@ -152,6 +156,19 @@ void SimulationWorker::injectForce(int atomIndex, QVector3D force, double alpha,
     QMutexLocker lock(&m_forceMutex);
     m_pendingForces = distributed;
     m_pendingForcesValid = true;
+    lock.unlock();
+
+    if (m_recorder) {
+        SessionEvent event;
+        event.type = SessionEvent::InjectForce;
+        event.atom = atomIndex;
+        event.aux = maxShells;
+        event.value[0] = force.x();
+        event.value[1] = force.y();
+        event.value[2] = force.z();
+        event.value[3] = alpha;
+        m_recorder->appendEvent(event);
+    }
 }
 
 void SimulationWorker::clearInjectedForce()
@@ -160,6 +177,13 @@ void SimulationWorker::clearInjectedForce()
     QMutexLocker lock(&m_forceMutex);
     m_pendingForcesValid = false;
     m_pendingForces.resize(0, 0);
+    lock.unlock();
+
+    if (m_recorder) {
+        SessionEvent event;
+        event.type = SessionEvent::ClearForce;
+        m_recorder->appendEvent(event);
+    }
 }
 
 // Claude Generated 2026 - Live global temperature setpoint. Stored under a mutex; the value is
@@ -170,6 +194,8 @@ void SimulationWorker::setTargetTemperature(double temperature)
     QMutexLocker lock(&m_tempMutex);
     m_pendingTemperature = temperature;
     m_pendingTemperatureValid = true;
+    lock.unlock();
+    recordParameterEvent(SessionEvent::TargetTemperature, temperature);
 }
 
 // Claude Generated 2026 - Live wall potential parameters. Same mutex-buffered pattern as
@@ -179,6 +205,8 @@ void SimulationWorker::setWallTemp(double T)
     QMutexLocker lock(&m_wallParamMutex);
     m_pendingWallTemp = T;
     m_pendingWallTempValid = true;
+    lock.unlock();
+    recordParameterEvent(SessionEvent::WallTemp, T);
 }
 
 void SimulationWorker::setWallBeta(double beta)
@@ -186,6 +214,30 @@ void SimulationWorker::setWallBeta(double beta)
     QMutexLocker lock(&m_wallParamMutex);
     m_pendingWallBeta = beta;
     m_pendingWallBetaValid = true;
+    lock.unlock();
+    recordParameterEvent(SessionEvent::WallBeta, beta);
+}
+
+// Claude Generated 2026 - Session recording: one-value events (setpoint / wall changes).
+void SimulationWorker::recordParameterEvent(quint32 type, double value)
+{
+    if (!m_recorder)
+        return;
+    SessionEvent event;
+    event.type = type;
+    event.value[0] = value;
+    m_recorder->appendEvent(event);
+}
+
+// Claude Generated 2026 - Flush and finalise the session recording before finished().
+void SimulationWorker::closeRecorder()
+{
+    if (!m_recorder)
+        return;
+    m_recorder->close();
+    if (!m_recorder->lastError().isEmpty())
+        qWarning() << "Session recording:" << m_recorder->lastError();
+    m_recorder.reset();
 }
 
 // Claude Generated 2026 - One-shot step from the dock's Step button.
@@ -382,6 +434,12 @@ void SimulationWorker::run()
     QFile::remove(QDir::currentPath() + QStringLiteral("/stop"));
     m_lastEmitTimer.start();
 
+    // Claude Generated 2026 - .qrec session recording (SimulationConfig::recordSession).
+    if (m_recorder && !m_recorder->open(m_initialAtoms, m_config.timestep)) {
+        qWarning() << "Session recording disabled:" << m_recorder->lastError();
+        m_recorder.reset();
+    }
+
     switch (m_config.mode) {
     case SimulationConfig::Mode::MolecularDynamics:
         // Async: startMD() creates the QTimer and returns. The worker thread's event loop
@@ -392,6 +450,7 @@ void SimulationWorker::run()
     case SimulationConfig::Mode::GeometryOptimization:
         // Synchronous: Optimizer::Optimize() runs its own step loop via the callback.
         runOptimization();
+        closeRecorder();
         emit finished();
         break;
     }
@@ -401,7 +460,8 @@ static Molecule atomsToMolecule(const QVector<MoleculeViewer::Atom>& atoms)
 {
     Molecule mol;
     for (const auto& atom : atoms) {
-        int Z = Elements::String2Element(atom.element.toStdString());
+        const int Z = atom.atomicNumber > 0 ? int(atom.atomicNumber)
+                                            : Elements::String2Element(atom.element.toStdString());
         Position pos(atom.position.x(), atom.position.y(), atom.position.z());
         mol.addPair({ Z, pos });
     }
@@ -413,22 +473,30 @@ static SimulationFramePtr moleculeToFrame(
     double temperature, double targetTemperature)
 {
     auto frame = QSharedPointer<SimulationFrame>::create();
-    frame->energy = energy;
-    frame->ekin = ekin;
-    frame->step = step;
-    frame->temperature = temperature;
-    frame->targetTemperature = targetTemperature;
-
-    Geometry geo = mol.getGeometry();
-    const int n = std::min(static_cast<int>(geo.rows()), referenceSize);
-    frame->positions.reserve(n);
+    fillFrame(*frame, mol, referenceSize, energy, ekin, step, temperature, targetTemperature);
+    return frame;
+}
+
+// Claude Generated 2026 - Overwrite @p frame in place. Reuses the positions storage, so
+// the uncapped MD path (ring slots) does not allocate per step.
+static void fillFrame(SimulationFrame& frame, const Molecule& mol, int referenceSize,
+    double energy, double ekin, int step, double temperature, double targetTemperature)
+{
+    frame.energy = energy;
+    frame.ekin = ekin;
+    frame.step = step;
+    frame.temperature = temperature;
+    frame.targetTemperature = targetTemperature;
+
+    const int n = std::min(mol.AtomCount(), referenceSize);
+    frame.positions.resize(n);
     for (int i = 0; i < n; ++i) {
-        frame->positions.emplace_back(
-            static_cast<float>(geo(i, 0)),
-            static_cast<float>(geo(i, 1)),
-            static_cast<float>(geo(i, 2)));
+        const auto atom = mol.Atom(i);  // (Z, position) by value; no Geometry copy
+        frame.positions[i] = QVector3D(
+            static_cast<float>(atom.second(0)),
+            static_cast<float>(atom.second(1)),
+            static_cast<float>(atom.second(2)));
     }
-    return frame;
 }
 
 void SimulationWorker::startMD()
@@ -502,26 +570,49 @@ void SimulationWorker::startMD()
 
     // QTimer lives in this (worker) thread because 'this' is moveToThread'd before run().
     // PreciseTimer gives ms-level accuracy on Linux (default is 1 ms coarse).
-    int effectiveFps = m_config.fpsLimit > 0 ? m_config.fpsLimit : 60;
+    // fpsLimit 0 = uncapped: zero interval, performMDStep() integrates a whole time slice.
     m_mdTimer = new QTimer(this);
     m_mdTimer->setTimerType(Qt::PreciseTimer);
-    m_mdTimer->setInterval(1000 / effectiveFps);
+    // Batch runs ignore fpsLimit: nobody is watching, so integrate as fast as possible.
+    m_mdTimer->setInterval(m_config.fpsLimit > 0 && m_batchInterval == 0 ? 1000 / m_config.fpsLimit : 0);
     connect(m_mdTimer, &QTimer::timeout, this, &SimulationWorker::performMDStep);
     m_mdTimer->start();
 }
 
 void SimulationWorker::performMDStep()
 {
-    if (!m_md) return;
+    if (m_config.fpsLimit > 0 && m_batchInterval == 0) {
+        advanceMD();
+        return;
+    }
+
+    // Claude Generated 2026 - Uncapped: integrate back to back for one slice, then return
+    // to the event loop so queued grab forces, temperature changes and stop/pause requests
+    // are picked up. The viewer pulls the newest step from m_frameRing at its own rate.
+    static constexpr qint64 kSliceMs = 8;
+    static constexpr int kPausedPollMs = 50;
+    QElapsedTimer slice;
+    slice.start();
+    while (advanceMD() && slice.elapsed() < kSliceMs) {
+    }
+    // A zero-interval timer would spin while paused.
+    if (m_mdTimer)
+        m_mdTimer->setInterval(m_pauseRequested.loadRelaxed() ? kPausedPollMs : 0);
+}
+
+bool SimulationWorker::advanceMD()
+{
+    if (!m_md) return false;
 
     if (m_stopRequested.loadRelaxed()) {
         finalizeMDRun();
-        return;
+        return false;
     }
     if (m_pauseRequested.loadRelaxed()) {
-        return;  // skip this tick; timer keeps firing, observes resume automatically
+        return false;  // skip this tick; timer keeps firing, observes resume automatically
     }
 
+    ProfileScope profile("md.step");
     QElapsedTimer stepClock;
     stepClock.start();
 
@@ -557,17 +648,44 @@ void SimulationWorker::performMDStep()
         }
     }
 
-    if (!m_md->step()) {
+    // Force evaluation happens inside SimpleMD::step(), so "md.integrate" covers both.
+    bool stepped;
+    {
+        ProfileScope integrate("md.integrate");
+        stepped = m_md->step();
+    }
+    if (!stepped) {
         finalizeMDRun();
-        return;
+        return false;
     }
 
-    SimulationFramePtr frame = moleculeToFrame(
-        m_md->currentMolecule(), m_initialAtoms.size(),
-        m_md->potentialEnergy(), m_md->kineticEnergy(), m_md->stepCount(),
-        m_md->currentTemperature(), m_md->targetTemperature());
-
-    emit frameReady(frame);
+    const qint64 emitStart = Profiler::now();
+    if (m_batchInterval > 0) {
+        // Headless: every Nth step goes to the batch writer; no ring, nobody renders.
+        if (m_md->stepCount() % m_batchInterval == 0)
+            emit frameReady(moleculeToFrame(
+                m_md->currentMolecule(), m_initialAtoms.size(),
+                m_md->potentialEnergy(), m_md->kineticEnergy(), m_md->stepCount(),
+                m_md->currentTemperature(), m_md->targetTemperature()));
+    } else if (m_config.fpsLimit > 0) {
+        const SimulationFramePtr frame = moleculeToFrame(
+            m_md->currentMolecule(), m_initialAtoms.size(),
+            m_md->potentialEnergy(), m_md->kineticEnergy(), m_md->stepCount(),
+            m_md->currentTemperature(), m_md->targetTemperature());
+        if (m_recorder)
+            m_recorder->appendFrame(*frame);
+        emit frameReady(frame);
+    } else {
+        fillFrame(m_frameRing->writeSlot(), m_md->currentMolecule(), m_initialAtoms.size(),
+            m_md->potentialEnergy(), m_md->kineticEnergy(), m_md->stepCount(),
+            m_md->currentTemperature(), m_md->targetTemperature());
+        // Every step is recorded, also those the viewer skips when it pulls the newest.
+        if (m_recorder)
+            m_recorder->appendFrame(m_frameRing->writeSlot());
+        if (m_frameRing->publish())
+            emit framesAvailable();
+    }
+    Profiler::instance().record("md.emit", emitStart, Profiler::now());
 
     if (m_config.performanceAnalysis) {
         qint64 stepTime = stepClock.elapsed();
@@ -580,7 +698,7 @@ void SimulationWorker::performMDStep()
             qint64 avgStep = m_mdTotalStepTime / m_mdFrameCount;
             double fps = 1000.0 * m_mdFrameCount / std::max<qint64>(1, m_mdPerfTimer.elapsed());
             qDebug() << "=== Performance [last" << m_mdFrameCount << "frames @ step" << m_md->stepCount() << "] ==="
-                     << "atoms:" << static_cast<int>(frame->positions.size())
+                     << "atoms:" << static_cast<int>(m_initialAtoms.size())
                      << "avg_step:" << avgStep << "ms"
                      << "min:" << m_mdMinStepTime << "max:" << m_mdMaxStepTime
                      << "fps:" << fps;
@@ -591,6 +709,7 @@ void SimulationWorker::performMDStep()
             m_mdPerfTimer.restart();
         }
     }
+    return true;
 }
 
 void SimulationWorker::finalizeMDRun()
@@ -604,6 +723,7 @@ void SimulationWorker::finalizeMDRun()
         m_md->finalizeRun();
         m_md.reset();
     }
+    closeRecorder();
     emit finished();
 }
 
@@ -695,6 +815,13 @@ void SimulationWorker::runOptimization()
                         return false;
                     QThread::msleep(50);
                 }
+                if (m_batchInterval > 0) {
+                    // Headless batch run: no throttle, no grab forces to pick up.
+                    if (iter % m_batchInterval == 0)
+                        Q_EMIT frameReady(moleculeToFrame(mol, m_initialAtoms.size(), energy, 0.0, iter));
+                    lastSeen = mol;
+                    return true;
+                }
                 int effectiveFps = m_config.fpsLimit > 0 ? m_config.fpsLimit : 60;
                 qint64 targetMs = 1000 / effectiveFps;
                 qint64 remaining = targetMs - m_lastEmitTimer.elapsed();
@@ -702,7 +829,10 @@ void SimulationWorker::runOptimization()
                     QThread::msleep(static_cast<unsigned long>(std::min(remaining, qint64(50))));
                     remaining = targetMs - m_lastEmitTimer.elapsed();
                 }
-                Q_EMIT frameReady(moleculeToFrame(mol, m_initialAtoms.size(), energy, 0.0, iter));
+                const SimulationFramePtr frame = moleculeToFrame(mol, m_initialAtoms.size(), energy, 0.0, iter);
+                if (m_recorder)
+                    m_recorder->appendFrame(*frame);
+                Q_EMIT frameReady(frame);
                 m_lastEmitTimer.restart();
                 lastSeen = mol;  // remember the latest geometry for robust carry-forward
 
@@ -798,6 +928,8 @@ void SimulationWorker::runOptimization()
 
             emit frameReady(moleculeToFrame(current, m_initialAtoms.size(),
                 result.final_energy, 0.0, result.iterations_performed));
+            if (m_batchInterval > 0)
+                break;  // batch: one optimisation, no keep-alive
 
             // Anti-spin: when it converged in ~0 iterations (idle at the minimum,
             // no grab), throttle the restart to the FPS budget so we don't busy
@@ -5,7 +5,9 @@
 #pragma once
 
 #include "forceinjector.h"
+#include "sessionrecording.h"
 #include "simulationframe.h"
+#include "simulationframering.h"
 #include "view.h"
 
 #include <Eigen/Dense>
@@ -17,6 +19,7 @@
 #include <QVector>
 #include <QVector3D>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 
@@ -53,7 +56,8 @@ struct SimulationConfig {
     // rebuilding GFN-FF from a heavily distorted geometry is slow and can crash.
     bool optKeepParameters = true;
     bool writeTrajectory = false; // Also write .trj.xyz file to disk
-    int fpsLimit = 30;            // Simulation speed in steps/sec (0 = unlimited)
+    bool recordSession = false;   // Also record frames + interactive events to a binary .qrec (SessionRecorder). Claude Generated 2026
+    int fpsLimit = 30;            // Simulation speed in steps/sec (0 = unlimited: MD runs back to back, viewer pulls the latest frame)
     bool performanceAnalysis = false; // Per-frame timing stats every N steps
     int performanceInterval = 100;   // Output summary every N frames
     QString gpu = "none";         // GPU acceleration: "none", "cuda", "rocm", "vulkan", "auto"
@@ -170,6 +174,20 @@ public:
     /** @brief Resume from pause. Thread-safe. */
     void requestResume() { m_pauseRequested.storeRelaxed(0); }
 
+    /** @brief Headless batch run (qurcuma --batch): no frame-rate throttling and no
+     *  interactive Opt keep-alive (one optimisation, then finished()); frameReady() only every
+     *  @p frameInterval MD steps / Opt iterations. 0 (default) = interactive. Claude Generated 2026. */
+    void setBatchMode(int frameInterval) { m_batchInterval = std::max(0, frameInterval); }
+
+    /** @brief Record every produced frame and the interactive events (grab, temperature,
+     *  wall changes) of the next run() into @p recorder (not yet opened; run() opens it with
+     *  the worker's topology and closes it before finished()). Claude Generated 2026. */
+    void setRecorder(QSharedPointer<SessionRecorder> recorder) { m_recorder = recorder; }
+
+    /** @brief Latest-frame exchange used by uncapped MD (fpsLimit 0) instead of frameReady().
+     *  Claude Generated 2026 - the viewer pulls from it once per rendered frame. */
+    QSharedPointer<SimulationFrameRing> frameRing() const { return m_frameRing; }
+
 public slots:
     /** @brief Start the simulation. Connect to QThread::started. */
     void run();
@@ -214,6 +232,12 @@ signals:
      */
     void frameReady(SimulationFramePtr frame);
 
+    /**
+     * @brief Uncapped MD: a frame was published to frameRing() while the consumer was idle.
+     * Claude Generated 2026 - at most one notification per idle period, not one per step.
+     */
+    void framesAvailable();
+
     /** @brief Emitted when the simulation completes normally or is stopped. */
     void finished();
 
@@ -227,12 +251,16 @@ private slots:
     // Timer-driven MD: fires every 1000/fpsLimit ms. One fire = one md.step() + one emit.
     // If md.step() runs longer than the interval, Qt fires the timer again immediately and
     // the visible rate drops to the actual compute rate — no frames skipped, no accumulation.
+    // Uncapped (fpsLimit 0): zero-interval timer, each fire integrates for one time slice.
     void performMDStep();
 
 private:
     void startMD();             // build SimpleMD, start m_mdTimer; returns so the thread's event loop can drive it
+    bool advanceMD();           // one MD step + frame output; false when the run ended or is paused
     void finalizeMDRun();       // stop timer, finalizeRun, emit finished
     void runOptimization();     // synchronous — drives its own step callback inside Optimizer::Optimize()
+    void recordParameterEvent(quint32 type, double value);  // SessionEvent with value[0] only
+    void closeRecorder();       // finalise the .qrec file (run end)
 
     // moleculeToAtoms() is defined in simulationworker.cpp only (uses curcuma Molecule type,
     // which must not be exposed in this header to avoid include pollution).
@@ -247,6 +275,7 @@ private:
     QVector<MoleculeViewer::Bond> m_bonds;
     forceinjector::Adjacency m_adjacency;
     SimulationConfig m_config;
+    int m_batchInterval = 0;  // > 0: headless batch run, see setBatchMode()
     QAtomicInt m_stopRequested{ 0 };
     QAtomicInt m_pauseRequested{ 0 };
     QElapsedTimer m_lastEmitTimer;  // FPS throttle for OPT step callback
@@ -254,6 +283,8 @@ private:
     // MD state persisted across QTimer fires (lives in the worker thread)
     std::unique_ptr<SimpleMD> m_md;
     QTimer* m_mdTimer = nullptr;    // parent = this, auto-cleaned
+    QSharedPointer<SimulationFrameRing> m_frameRing;  // uncapped MD output (Claude Generated 2026)
+    QSharedPointer<SessionRecorder> m_recorder;       // .qrec session recording (Claude Generated 2026)
 
     // Performance-analysis accumulators for MD (timer-driven, so counters must persist)
     QElapsedTimer m_mdPerfTimer;
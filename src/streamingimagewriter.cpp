@@ -0,0 +1,352 @@
+// streamingimagewriter.cpp - Row-streamed PNG / TIFF output for tiled image export
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+
+#include "streamingimagewriter.h"
+
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#ifdef QURCUMA_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+constexpr int kIdatChunk = 1 << 20;   // flush compressed PNG data in ~1 MB IDAT chunks
+constexpr int kTiffRowsPerStrip = 16;
+
+quint32 crc32(const char* data, int size, quint32 crc = 0xffffffffu)
+{
+    static const auto table = [] {
+        std::array<quint32, 256> t {};
+        for (quint32 n = 0; n < 256; ++n) {
+            quint32 c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    for (int i = 0; i < size; ++i)
+        crc = table[(crc ^ quint8(data[i])) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+quint32 adler32(quint32 adler, const char* data, int size)
+{
+    quint32 a = adler & 0xffff, b = adler >> 16;
+    while (size > 0) {
+        const int n = std::min(size, 5552);   // largest block without 32-bit overflow
+        for (int i = 0; i < n; ++i) {
+            a += quint8(data[i]);
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += n;
+        size -= n;
+    }
+    return (b << 16) | a;
+}
+
+void appendBE32(QByteArray& out, quint32 v)
+{
+    const quint32 be = qToBigEndian(v);
+    out.append(reinterpret_cast<const char*>(&be), 4);
+}
+
+template <typename T>
+void appendLE(QByteArray& out, T v)
+{
+    const T le = qToLittleEndian(v);
+    out.append(reinterpret_cast<const char*>(&le), sizeof(T));
+}
+}
+
+struct StreamingImageWriter::Deflater {
+#ifdef QURCUMA_HAVE_ZLIB
+    z_stream stream {};
+    ~Deflater() { deflateEnd(&stream); }
+#endif
+};
+
+StreamingImageWriter::StreamingImageWriter() = default;
+StreamingImageWriter::~StreamingImageWriter() = default;
+
+bool StreamingImageWriter::formatForPath(const QString& path, Format* format)
+{
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == QLatin1String("png"))
+        *format = Format::Png;
+    else if (suffix == QLatin1String("tif") || suffix == QLatin1String("tiff"))
+        *format = Format::Tiff;
+    else
+        return false;
+    return true;
+}
+
+bool StreamingImageWriter::fail(const QString& message)
+{
+    if (!m_failed)
+        m_error = message;
+    m_failed = true;
+    return false;
+}
+
+bool StreamingImageWriter::open(const QString& path, int width, int height, bool alpha,
+    const QVector<QPair<QString, QString>>& text)
+{
+    if (!formatForPath(path, &m_format))
+        return fail(QStringLiteral("Tiled export writes PNG or TIFF only"));
+    if (width < 1 || height < 1)
+        return fail(QStringLiteral("Empty image"));
+    m_width = width;
+    m_height = height;
+    m_channels = alpha ? 4 : 3;
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return fail(m_file.errorString());
+
+    if (m_format == Format::Tiff) {
+        QByteArray header("II");
+        appendLE<quint16>(header, 42);
+        appendLE<quint32>(header, 0);   // first IFD offset, patched by close()
+        if (m_file.write(header) != header.size())
+            return fail(m_file.errorString());
+        m_strip.reserve(kTiffRowsPerStrip * m_width * m_channels);
+        return true;
+    }
+
+    m_previousRow = QByteArray(m_width * m_channels, '\0');
+    m_deflater = std::make_unique<Deflater>();
+#ifdef QURCUMA_HAVE_ZLIB
+    if (deflateInit(&m_deflater->stream, 6) != Z_OK)
+        return fail(QStringLiteral("zlib initialisation failed"));
+#else
+    m_pending.append("\x78\x01", 2);   // zlib header: deflate, 32K window, no dictionary
+#endif
+    return writePngHeader(text);
+}
+
+bool StreamingImageWriter::writeChunk(const char type[4], const QByteArray& data)
+{
+    QByteArray chunk;
+    chunk.reserve(data.size() + 12);
+    appendBE32(chunk, quint32(data.size()));
+    chunk.append(type, 4);
+    chunk.append(data);
+    appendBE32(chunk, crc32(chunk.constData() + 4, data.size() + 4) ^ 0xffffffffu);
+    if (m_file.write(chunk) != chunk.size())
+        return fail(m_file.errorString());
+    return true;
+}
+
+bool StreamingImageWriter::writePngHeader(const QVector<QPair<QString, QString>>& text)
+{
+    if (m_file.write("\x89PNG\r\n\x1a\n", 8) != 8)
+        return fail(m_file.errorString());
+    QByteArray ihdr;
+    appendBE32(ihdr, quint32(m_width));
+    appendBE32(ihdr, quint32(m_height));
+    ihdr.append(char(8));                       // bit depth
+    ihdr.append(char(m_channels == 4 ? 6 : 2)); // RGBA / RGB
+    ihdr.append(3, '\0');                       // deflate, adaptive filtering, no interlace
+    if (!writeChunk("IHDR", ihdr))
+        return false;
+    for (const auto& [key, value] : text) {
+        // iTXt: keyword, NUL, uncompressed, method, empty language + translated keyword, UTF-8
+        QByteArray itxt = key.toLatin1().left(79);
+        itxt.append('\0').append('\0').append('\0').append('\0').append('\0');
+        itxt.append(value.toUtf8());
+        if (!writeChunk("iTXt", itxt))
+            return false;
+    }
+    return true;
+}
+
+bool StreamingImageWriter::deflateRow(const QByteArray& filtered, bool last)
+{
+#ifdef QURCUMA_HAVE_ZLIB
+    z_stream& z = m_deflater->stream;
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(filtered.constData()));
+    z.avail_in = uInt(filtered.size());
+    char out[1 << 16];
+    int status;
+    do {
+        z.next_out = reinterpret_cast<Bytef*>(out);
+        z.avail_out = sizeof(out);
+        status = deflate(&z, last ? Z_FINISH : Z_NO_FLUSH);
+        if (status == Z_STREAM_ERROR)
+            return fail(QStringLiteral("zlib deflate failed"));
+        m_pending.append(out, int(sizeof(out) - z.avail_out));
+    } while (z.avail_out == 0 || (last && status != Z_STREAM_END));
+#else
+    // Stored blocks (BTYPE 00), at most 65535 bytes each; BFINAL on the very last one.
+    m_adler = adler32(m_adler, filtered.constData(), filtered.size());
+    for (int pos = 0; pos < filtered.size(); pos += 65535) {
+        const quint16 len = quint16(std::min(65535, int(filtered.size()) - pos));
+        const bool final = last && pos + len == filtered.size();
+        m_pending.append(char(final ? 1 : 0));
+        appendLE<quint16>(m_pending, len);
+        appendLE<quint16>(m_pending, quint16(~len));
+        m_pending.append(filtered.constData() + pos, len);
+    }
+    if (last)
+        appendBE32(m_pending, m_adler);
+#endif
+    if (m_pending.size() >= kIdatChunk || last) {
+        if (!writeChunk("IDAT", m_pending))
+            return false;
+        m_pending.clear();
+    }
+    return true;
+}
+
+bool StreamingImageWriter::writeRow(const uchar* row)
+{
+    const int bytes = m_width * m_channels;
+    const bool last = m_rowsWritten + 1 == m_height;
+    ++m_rowsWritten;
+    if (m_format == Format::Tiff) {
+        m_strip.append(reinterpret_cast<const char*>(row), bytes);
+        if (m_rowsWritten % kTiffRowsPerStrip == 0 || last)
+            return flushStrip();
+        return true;
+    }
+    // Filter type 2 (Up): difference to the row above, good for flat backgrounds.
+    QByteArray filtered(bytes + 1, Qt::Uninitialized);
+    filtered[0] = 2;
+    char* previous = m_previousRow.data();
+    for (int i = 0; i < bytes; ++i) {
+        filtered[i + 1] = char(row[i] - quint8(previous[i]));
+        previous[i] = char(row[i]);
+    }
+    return deflateRow(filtered, last);
+}
+
+bool StreamingImageWriter::writeRows(const QImage& band)
+{
+    if (m_failed || !m_file.isOpen())
+        return false;
+    if (band.width() != m_width)
+        return fail(QStringLiteral("Band width does not match the image"));
+    const QImage rows = band.convertToFormat(m_channels == 4 ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+    for (int y = 0; y < rows.height() && m_rowsWritten < m_height; ++y)
+        if (!writeRow(rows.constScanLine(y)))
+            return false;
+    return true;
+}
+
+bool StreamingImageWriter::flushStrip()
+{
+    const QByteArray compressed = qCompress(m_strip, 6).mid(4);   // drop Qt's length prefix
+    m_strip.clear();
+    const qint64 offset = m_file.pos();
+    if (offset + compressed.size() > std::numeric_limits<quint32>::max())
+        return fail(QStringLiteral("TIFF output exceeds 4 GiB; export as PNG instead"));
+    m_stripOffsets.append(quint32(offset));
+    m_stripSizes.append(quint32(compressed.size()));
+    if (m_file.write(compressed) != compressed.size())
+        return fail(m_file.errorString());
+    return true;
+}
+
+bool StreamingImageWriter::writeTiffDirectory()
+{
+    struct Entry {
+        quint16 tag;
+        quint16 type;   // 2 ASCII, 3 SHORT, 4 LONG, 5 RATIONAL
+        quint32 count;
+        QByteArray data;
+    };
+    auto shorts = [](std::initializer_list<quint16> v) {
+        QByteArray b;
+        for (quint16 x : v)
+            appendLE(b, x);
+        return b;
+    };
+    auto longs = [](const QVector<quint32>& v) {
+        QByteArray b;
+        for (quint32 x : v)
+            appendLE(b, x);
+        return b;
+    };
+    const quint32 strips = quint32(m_stripOffsets.size());
+    const QByteArray resolution = longs({ 300, 1 });
+    QByteArray bits;
+    for (int c = 0; c < m_channels; ++c)
+        appendLE<quint16>(bits, 8);
+
+    QVector<Entry> entries = {
+        { 256, 4, 1, longs({ quint32(m_width) }) },
+        { 257, 4, 1, longs({ quint32(m_height) }) },
+        { 258, 3, quint32(m_channels), bits },
+        { 259, 3, 1, shorts({ 8 }) },   // Adobe Deflate
+        { 262, 3, 1, shorts({ 2 }) },   // RGB
+        { 273, 4, strips, longs(m_stripOffsets) },
+        { 277, 3, 1, shorts({ quint16(m_channels) }) },
+        { 278, 4, 1, longs({ quint32(kTiffRowsPerStrip) }) },
+        { 279, 4, strips, longs(m_stripSizes) },
+        { 282, 5, 1, resolution },
+        { 283, 5, 1, resolution },
+        { 284, 3, 1, shorts({ 1 }) },   // chunky
+        { 296, 3, 1, shorts({ 2 }) },   // inch
+        { 305, 2, 8, QByteArray("qurcuma", 8) },
+    };
+    if (m_channels == 4)
+        entries.append({ 338, 3, 1, shorts({ 2 }) });   // unassociated alpha
+
+    qint64 directory = m_file.pos();
+    if (directory % 2) {
+        m_file.write("\0", 1);
+        ++directory;
+    }
+    qint64 extra = directory + 2 + 12 * entries.size() + 4;
+    QByteArray ifd, payload;
+    appendLE<quint16>(ifd, quint16(entries.size()));
+    for (const Entry& e : entries) {
+        appendLE(ifd, e.tag);
+        appendLE(ifd, e.type);
+        appendLE(ifd, e.count);
+        if (e.data.size() <= 4) {
+            ifd.append(e.data);
+            ifd.append(4 - e.data.size(), '\0');
+        } else {
+            appendLE<quint32>(ifd, quint32(extra + payload.size()));
+            payload.append(e.data);
+            if (payload.size() % 2)
+                payload.append('\0');
+        }
+    }
+    appendLE<quint32>(ifd, 0);   // no further IFD
+    if (extra + payload.size() > std::numeric_limits<quint32>::max())
+        return fail(QStringLiteral("TIFF output exceeds 4 GiB; export as PNG instead"));
+    if (m_file.write(ifd) != ifd.size() || m_file.write(payload) != payload.size())
+        return fail(m_file.errorString());
+    QByteArray offset;
+    appendLE<quint32>(offset, quint32(directory));
+    if (!m_file.seek(4) || m_file.write(offset) != 4)
+        return fail(m_file.errorString());
+    return true;
+}
+
+bool StreamingImageWriter::close()
+{
+    if (!m_file.isOpen())
+        return false;
+    bool ok = !m_failed;
+    if (ok && m_rowsWritten < m_height)
+        ok = fail(QStringLiteral("Image incomplete: %1 of %2 rows written").arg(m_rowsWritten).arg(m_height));
+    if (ok)
+        ok = m_format == Format::Tiff ? writeTiffDirectory() : writeChunk("IEND", QByteArray());
+    if (ok && !m_file.flush())
+        ok = fail(m_file.errorString());
+    m_file.close();
+    if (!ok)
+        m_file.remove();
+    return ok;
+}
@@ -0,0 +1,74 @@
+// streamingimagewriter.h - Row-streamed PNG / TIFF output for tiled image export
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - poster-size exports in bounded memory.
+//
+// QImageWriter needs the whole image in memory (16k x 16k RGBA = 1 GiB). This writer takes
+// horizontal bands top to bottom and only ever holds one row (PNG) or one strip (TIFF):
+//
+//   PNG   8-bit RGB/RGBA, "Up" filter, one zlib stream over all rows split into IDAT
+//         chunks. Compressed through zlib when the build found it (QURCUMA_HAVE_ZLIB),
+//         otherwise written as stored (uncompressed) deflate blocks, which every PNG reader
+//         accepts. Text pairs become iTXt chunks (UTF-8).
+//   TIFF  baseline RGB/RGBA (unassociated alpha), 16-row strips, each an Adobe-Deflate
+//         (qCompress) zlib stream; classic 32-bit offsets, so the file must stay < 4 GiB.
+
+#pragma once
+
+#include <QFile>
+#include <QImage>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+class StreamingImageWriter
+{
+public:
+    enum class Format { Png, Tiff };
+
+    StreamingImageWriter();
+    ~StreamingImageWriter();
+
+    /// Png / Tiff from the suffix of @p path; false for anything else.
+    static bool formatForPath(const QString& path, Format* format);
+
+    bool open(const QString& path, int width, int height, bool alpha,
+        const QVector<QPair<QString, QString>>& text = {});
+    /// Append the rows of @p band (any format, width() == image width) below the previous ones.
+    bool writeRows(const QImage& band);
+    /// Finish the file; fails if fewer rows than the image height were written.
+    bool close();
+
+    QString errorString() const { return m_error; }
+
+private:
+    bool fail(const QString& message);
+    bool writeRow(const uchar* row);
+    // PNG
+    bool writePngHeader(const QVector<QPair<QString, QString>>& text);
+    bool writeChunk(const char type[4], const QByteArray& data);
+    bool deflateRow(const QByteArray& filtered, bool last);
+    // TIFF
+    bool flushStrip();
+    bool writeTiffDirectory();
+
+    Format m_format = Format::Png;
+    QFile m_file;
+    QString m_error;
+    int m_width = 0;
+    int m_height = 0;
+    int m_channels = 3;
+    int m_rowsWritten = 0;
+    bool m_failed = false;
+
+    QByteArray m_previousRow;    // PNG Up filter
+    QByteArray m_pending;        // compressed bytes not yet in an IDAT chunk
+    quint32 m_adler = 1;         // stored-block fallback
+    struct Deflater;
+    std::unique_ptr<Deflater> m_deflater;
+
+    QByteArray m_strip;          // TIFF rows of the current strip
+    QVector<quint32> m_stripOffsets;
+    QVector<quint32> m_stripSizes;
+};
@@ -0,0 +1,229 @@
+// structurecache.cpp - Persistent cache of decoded structures / trajectories
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "structurecache.h"
+#include "profiler.h"
+#include "trajectorystore.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <memory>
+
+namespace {
+constexpr quint32 kEntryMagic = 0x51534331;  // "QSC1"
+constexpr quint32 kEntryVersion = 2;
+constexpr quint32 kFlagExplicitBonds = 1u;
+constexpr quint32 kFlagCentred = 2u;
+// magic, version, byte order, frames, atoms, flags (6 x 32 bit) + meta size, positions
+// offset (2 x 64 bit)
+constexpr qint64 kHeaderBytes = 6 * 4 + 2 * 8;
+constexpr qint64 kPositionsAlignment = 64;
+
+quint32 hostByteOrder()
+{
+    return Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? 1u : 0u;
+}
+
+bool sameBonds(const QVector<MoleculeViewer::Bond>& a, const QVector<MoleculeViewer::Bond>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (int i = 0; i < a.size(); ++i)
+        if (a[i].atom1 != b[i].atom1 || a[i].atom2 != b[i].atom2 || a[i].bondOrder != b[i].bondOrder)
+            return false;
+    return true;
+}
+}
+
+bool StructureCache::isCacheable(const QString& filePath)
+{
+    return QFileInfo(filePath).size() >= kMinSourceBytes;
+}
+
+QString StructureCache::cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/structures/");
+}
+
+QString StructureCache::entryPath(const QString& filePath)
+{
+    const QFileInfo info(filePath);
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    // Path + size + mtime identify the file; the content sample catches rewrites that
+    // keep both (copied-in results, coarse mtime resolution on network shares).
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    hash.addData(file.read(kSampleBytes));
+    if (info.size() > 2 * kSampleBytes && file.seek(info.size() - kSampleBytes))
+        hash.addData(file.read(kSampleBytes));
+    return cacheDirectory() + QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".qsc");
+}
+
+bool StructureCache::load(const QString& filePath, Entry& entry)
+{
+    ProfileScope profile("parse.structureCache");
+    const QString path = entryPath(filePath);
+    if (path.isEmpty() || !QFile::exists(path))
+        return false;
+
+    auto file = std::make_shared<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly))
+        return false;
+    const qint64 size = file->size();
+    if (size < kHeaderBytes)
+        return false;
+    const uchar* map = file->map(0, size);
+    if (!map)
+        return false;
+
+    QDataStream header(QByteArray::fromRawData(reinterpret_cast<const char*>(map), kHeaderBytes));
+    quint32 magic = 0, version = 0, byteOrder = 0, flags = 0;
+    qint32 frames = 0, atoms = 0;
+    qint64 metaBytes = 0, positionsOffset = 0;
+    header >> magic >> version >> byteOrder >> frames >> atoms >> flags >> metaBytes >> positionsOffset;
+    if (header.status() != QDataStream::Ok || magic != kEntryMagic || version != kEntryVersion
+        || byteOrder != hostByteOrder() || frames <= 0 || atoms <= 0 || metaBytes <= 0
+        || kHeaderBytes + metaBytes > positionsOffset || positionsOffset % kPositionsAlignment != 0
+        || positionsOffset + qint64(frames) * atoms * 3 * qint64(sizeof(float)) != size)
+        return false;
+
+    QDataStream meta(QByteArray::fromRawData(reinterpret_cast<const char*>(map) + kHeaderBytes, metaBytes));
+    QVector<QString> elements;
+    QVector<quint8> atomicNumbers;
+    QVector<float> charges;
+    QVector<QVector<qint32>> bondLists;
+    QVector<qint32> bondIndex;
+    meta >> elements >> atomicNumbers >> charges >> bondLists >> bondIndex;
+    if (meta.status() != QDataStream::Ok || elements.size() != atoms || atomicNumbers.size() != atoms
+        || bondIndex.size() > frames)
+        return false;
+
+    QVector<QVector<MoleculeViewer::Bond>> lists;
+    lists.reserve(bondLists.size());
+    for (const QVector<qint32>& flat : bondLists) {
+        if (flat.size() % 3 != 0)
+            return false;
+        QVector<MoleculeViewer::Bond> bonds(flat.size() / 3);
+        for (int i = 0; i < bonds.size(); ++i)
+            bonds[i] = { flat[3 * i], flat[3 * i + 1], flat[3 * i + 2] };
+        lists.append(bonds);
+    }
+    entry.bonds.clear();
+    entry.bonds.reserve(bondIndex.size());
+    for (qint32 index : bondIndex)
+        entry.bonds.append(index >= 0 && index < lists.size() ? lists[index] : QVector<MoleculeViewer::Bond>());
+    entry.explicitBonds = flags & kFlagExplicitBonds;
+    entry.centred = flags & kFlagCentred;
+
+    entry.store = QSharedPointer<TrajectoryStore>::create();
+    entry.store->adoptMapped(elements, atomicNumbers, frames, map + positionsOffset,
+        qint64(atoms) * 3 * qint64(sizeof(float)), file, charges);
+    if (entry.store->isEmpty())
+        return false;
+
+    // LRU: a hit counts as a use.
+    file->setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+bool StructureCache::save(const QString& filePath, const TrajectoryStore& frames,
+    const QVector<QVector<MoleculeViewer::Bond>>& bonds, bool explicitBonds, bool centred,
+    const std::atomic<bool>* cancel)
+{
+    if (frames.isEmpty() || frames.atomCount() == 0)
+        return false;
+    const QString path = entryPath(filePath);
+    if (path.isEmpty())
+        return false;
+    QDir().mkpath(cacheDirectory());
+
+    const qint32 atoms = frames.atomCount();
+    // Identical bond lists (one file topology repeated per frame) are stored once.
+    QVector<QVector<qint32>> bondLists;
+    QVector<qint32> bondIndex;
+    QVector<int> listFrame;   // frame each stored list came from
+    for (int f = 0; f < qMin(bonds.size(), frames.frameCount()); ++f) {
+        if (bonds[f].isEmpty()) {
+            bondIndex.append(-1);
+            continue;
+        }
+        // Compared with the first and the latest list only, so per-frame topologies stay linear.
+        int index = -1;
+        if (!listFrame.isEmpty() && sameBonds(bonds[listFrame.first()], bonds[f]))
+            index = 0;
+        else if (!listFrame.isEmpty() && sameBonds(bonds[listFrame.last()], bonds[f]))
+            index = listFrame.size() - 1;
+        if (index < 0) {
+            QVector<qint32> flat;
+            flat.reserve(3 * bonds[f].size());
+            for (const MoleculeViewer::Bond& b : bonds[f])
+                flat << b.atom1 << b.atom2 << b.bondOrder;
+            index = bondLists.size();
+            bondLists.append(flat);
+            listFrame.append(f);
+        }
+        bondIndex.append(index);
+    }
+
+    QByteArray meta;
+    {
+        QDataStream out(&meta, QIODevice::WriteOnly);
+        out << frames.elements() << frames.atomicNumbers() << frames.charges() << bondLists << bondIndex;
+    }
+    const qint64 unaligned = kHeaderBytes + meta.size();
+    const qint64 positionsOffset = (unaligned + kPositionsAlignment - 1) / kPositionsAlignment * kPositionsAlignment;
+
+    QByteArray header;
+    {
+        QDataStream out(&header, QIODevice::WriteOnly);
+        const quint32 flags = (explicitBonds ? kFlagExplicitBonds : 0u) | (centred ? kFlagCentred : 0u);
+        out << kEntryMagic << kEntryVersion << hostByteOrder() << qint32(frames.frameCount()) << atoms
+            << flags << qint64(meta.size()) << positionsOffset;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(header);
+    file.write(meta);
+    file.write(QByteArray(positionsOffset - unaligned, '\0'));
+    // QVector3D is three packed floats, the layout of a Mapped frame.
+    QVector<QVector3D> scratch;
+    for (int f = 0; f < frames.frameCount(); ++f) {
+        if (cancel && cancel->load(std::memory_order_relaxed))
+            return false;   // not committed: QSaveFile drops the temporary file
+        const PositionSpan frame = frames.positions(f, scratch);
+        file.write(reinterpret_cast<const char*>(frame.begin()), qint64(frame.size) * qint64(sizeof(QVector3D)));
+    }
+    if (!file.commit()) {
+        qWarning() << "StructureCache: could not write" << path << file.errorString();
+        return false;
+    }
+    evict();
+    return true;
+}
+
+void StructureCache::evict(qint64 maxBytes)
+{
+    // Newest first; everything past the budget goes.
+    const QFileInfoList entries = QDir(cacheDirectory()).entryInfoList(
+        { QStringLiteral("*.qsc") }, QDir::Files, QDir::Time);
+    qint64 total = 0;
+    for (const QFileInfo& info : entries) {
+        total += info.size();
+        if (total > maxBytes)
+            QFile::remove(info.absoluteFilePath());
+    }
+}
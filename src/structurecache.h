@@ -0,0 +1,61 @@
+// structurecache.h - Persistent cache of decoded structures / trajectories
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - lets StructureLoader skip parsing and bond perception when the
+// same XYZ/VTF file is opened again.
+//
+// An entry holds what the viewer needs after parsing: the topology (elements, atomic
+// numbers, charges), the coordinates of every frame as one float32 block (the same layout
+// as TrajectoryStore::Compression::Mapped), and the bonds - all frames of explicit
+// topologies (VTF), the perceived bonds of frame 0 otherwise. Entries are named after a
+// hash of the file's absolute path, size, mtime and a content sample (first and last
+// 64 KB), so a rewritten file simply misses and its old entry ages out. A hit maps the
+// entry and serves the frames from the mapping; nothing is copied. The entry records
+// whether its frames were centred on load, so a hit never has to rewrite them.
+//
+// Entries live under CacheLocation/structures. Every hit refreshes the entry's mtime;
+// after a write the directory is trimmed to kMaxCacheBytes, least recently used first.
+
+#pragma once
+
+#include "view.h"
+
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+
+class TrajectoryStore;
+
+class StructureCache
+{
+public:
+    static constexpr qint64 kMinSourceBytes = 512LL * 1024;            // smaller files parse faster than a lookup
+    static constexpr qint64 kMaxCacheBytes = 2LL * 1024 * 1024 * 1024;  // LRU bound of the directory
+    static constexpr qint64 kSampleBytes = 64 * 1024;
+
+    struct Entry {
+        QSharedPointer<TrajectoryStore> store;          // Compression::Mapped over the entry
+        QVector<QVector<MoleculeViewer::Bond>> bonds;   // per frame, may be shorter / empty
+        bool explicitBonds = false;                     // bonds come from the file
+        bool centred = false;                           // frames were stored centred
+    };
+
+    /// Whether @p filePath is worth caching (size threshold).
+    static bool isCacheable(const QString& filePath);
+
+    /// Look up @p filePath. @return false on a miss or an unreadable / stale entry.
+    static bool load(const QString& filePath, Entry& entry);
+
+    /// Store the decoded @p frames of @p filePath. Thread-safe; intended to run on a worker
+    /// thread after the file is on screen. Setting @p cancel drops the partial entry.
+    static bool save(const QString& filePath, const TrajectoryStore& frames,
+        const QVector<QVector<MoleculeViewer::Bond>>& bonds, bool explicitBonds, bool centred,
+        const std::atomic<bool>* cancel = nullptr);
+
+    static QString cacheDirectory();
+    /// Entry file for the current state of @p filePath; empty if it cannot be read.
+    static QString entryPath(const QString& filePath);
+    /// Delete least recently used entries until the directory holds at most @p maxBytes.
+    static void evict(qint64 maxBytes = kMaxCacheBytes);
+};
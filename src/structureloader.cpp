@@ -0,0 +1,315 @@
+// structureloader.cpp - Background, cancellable loading of XYZ/VTF structure files
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "structureloader.h"
+#include "bondperception.h"
+#include "profiler.h"
+#include "structurecache.h"
+#include "trajectorystore.h"
+#include "vtfparser.h"
+#include "xyzparser.h"
+#include "xyztrajectoryreader.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+
+#include <functional>
+
+namespace {
+using AtomSink = std::function<bool(QVector<MoleculeViewer::Atom>&& atoms,
+    QVector<MoleculeViewer::Bond>&& bonds, qint64 bytesRead, qint64 totalBytes)>;
+
+// Parse @p filePath frame by frame into viewer atoms; @p sink returns false to stop.
+bool parseFrames(const QString& filePath, bool vtf, const AtomSink& sink)
+{
+    if (vtf) {
+        // The parser hands every frame the same (implicitly shared) bond list; converting
+        // it once keeps one copy for the whole trajectory.
+        QVector<VTFParser::VTFBond> lastVtfBonds;
+        QVector<MoleculeViewer::Bond> lastBonds;
+        VTFParser parser;
+        return parser.parseTrajectory(filePath, [&](VTFParser::VTFFrame&& frame, qint64 done, qint64 total) {
+            QVector<MoleculeViewer::Atom> atoms;
+            QVector<MoleculeViewer::Bond> bonds;
+            VTFParser::convertToMoleculeViewer(frame, atoms, bonds);
+            if (!lastBonds.isEmpty() && frame.bonds.constData() == lastVtfBonds.constData()) {
+                bonds = lastBonds;
+            } else {
+                lastVtfBonds = frame.bonds;
+                lastBonds = bonds;
+            }
+            return sink(std::move(atoms), std::move(bonds), done, total);
+        });
+    }
+    XYZParser parser;
+    return parser.parseTrajectory(filePath, [&](XYZParser::XYZFrame&& frame, qint64 done, qint64 total) {
+        QVector<MoleculeViewer::Atom> atoms;
+        QVector<MoleculeViewer::Bond> bonds;
+        XYZParser::convertToMoleculeViewer(frame, atoms, bonds);
+        return sink(std::move(atoms), std::move(bonds), done, total);
+    });
+}
+
+// Structure editor text: the whole file, or its first @p firstFrameBytes for large files.
+QString editorText(const QString& filePath, qint64 fileSize, qint64 firstFrameBytes)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    const qint64 bytes = fileSize <= StructureLoader::kEditorTextBytes ? fileSize : firstFrameBytes;
+    QString text = QString::fromUtf8(file.read(bytes));
+    text.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+    return text;
+}
+}
+
+StructureLoader::StructureLoader(QObject* parent)
+    : QObject(parent)
+{
+}
+
+StructureLoader::~StructureLoader()
+{
+    for (const Worker& worker : m_workers) {
+        worker.job->cancel = true;
+        worker.thread->wait();
+        delete worker.thread;
+    }
+}
+
+bool StructureLoader::canLoad(const QString& filePath)
+{
+    const QString suffix = QFileInfo(filePath).suffix().toLower();
+    return suffix == QLatin1String("xyz") || suffix == QLatin1String("vtf");
+}
+
+QString StructureLoader::filePath() const
+{
+    return m_job ? m_job->filePath : QString();
+}
+
+void StructureLoader::start(const QString& filePath, const Options& options)
+{
+    cancel();
+    auto job = std::make_shared<Job>();
+    job->filePath = filePath;
+    job->options = options;
+    m_job = job;
+
+    QThread* thread = QThread::create([this, job]() { run(job); });
+    m_workers.append({ thread, job });
+    connect(thread, &QThread::finished, this, [this, thread]() {
+        for (int i = 0; i < m_workers.size(); ++i) {
+            if (m_workers[i].thread == thread) {
+                m_workers.removeAt(i);
+                break;
+            }
+        }
+        thread->deleteLater();
+    });
+    thread->start();
+}
+
+void StructureLoader::cancel()
+{
+    if (!m_job)
+        return;
+    // The worker notices at its next frame; whatever it still delivers is dropped.
+    m_job->cancel = true;
+    const QString path = m_job->filePath;
+    m_job.reset();
+    emit cancelled(path);
+}
+
+template <typename Fn>
+void StructureLoader::deliver(const std::shared_ptr<Job>& job, Fn fn)
+{
+    QMetaObject::invokeMethod(this, [this, job, fn]() {
+        if (job == m_job && !job->cancel)
+            fn();
+    }, Qt::QueuedConnection);
+}
+
+void StructureLoader::complete(const std::shared_ptr<Job>& job, const Result& result)
+{
+    deliver(job, [this, result]() {
+        m_job.reset();
+        emit finished(result);
+    });
+}
+
+void StructureLoader::fail(const std::shared_ptr<Job>& job, const QString& error)
+{
+    deliver(job, [this, job, error]() {
+        m_job.reset();
+        emit failed(job->filePath, error);
+    });
+}
+
+void StructureLoader::run(const std::shared_ptr<Job>& job)
+{
+    ProfileScope profile("load.pipeline");
+    const QString filePath = job->filePath;
+    const QFileInfo info(filePath);
+    const qint64 fileSize = info.size();
+    const bool vtf = info.suffix().toLower() == QLatin1String("vtf");
+    const bool streamed = !vtf && fileSize >= kStreamingThresholdBytes;
+    const bool center = job->options.center;
+    auto aborted = [&job]() { return job->cancel.load(std::memory_order_relaxed); };
+
+    Result result;
+    result.filePath = filePath;
+    int frames = 0;
+    QElapsedTimer clock;
+    clock.start();
+    qint64 nextReportMs = kProgressIntervalMs;   // quick loads never show a progress bar
+    auto report = [&](Stage stage, qint64 done, qint64 total) {
+        if (clock.elapsed() < nextReportMs)
+            return;
+        nextReportMs = clock.elapsed() + kProgressIntervalMs;
+        const int count = frames;
+        deliver(job, [this, stage, done, total, count]() { emit progress(stage, done, total, count); });
+    };
+    auto publishFirstFrame = [&](QVector<MoleculeViewer::Atom> atoms, QVector<MoleculeViewer::Bond> bonds,
+                                 qint64 firstFrameBytes) {
+        if (bonds.isEmpty())
+            bonds = bondperception::detect(atoms);
+        const QString text = editorText(filePath, fileSize, firstFrameBytes);
+        deliver(job, [this, job, atoms, bonds, text]() {
+            emit firstFrameReady(job->filePath, atoms, bonds, text);
+        });
+        return bonds;
+    };
+    // Frame 0 only (cache hits, streamed files): atoms and the bytes it spans.
+    QVector<MoleculeViewer::Atom> firstAtoms;
+    QVector<MoleculeViewer::Bond> firstBonds;
+    qint64 firstFrameBytes = fileSize;
+    auto readFirstFrame = [&]() {
+        return parseFrames(filePath, vtf, [&](QVector<MoleculeViewer::Atom>&& atoms,
+                                              QVector<MoleculeViewer::Bond>&& bonds, qint64 done, qint64) {
+            firstAtoms = std::move(atoms);
+            firstBonds = std::move(bonds);
+            firstFrameBytes = done;
+            return false;
+        });
+    };
+
+    // read: decoded before? Streamed files are never cached (the index is their cache).
+    StructureCache::Entry entry;
+    if (!streamed && StructureCache::isCacheable(filePath) && StructureCache::load(filePath, entry)
+        && entry.centred == center) {
+        if (fileSize > kEditorTextBytes)
+            readFirstFrame();   // only for the extent of the editor text
+        QVector<MoleculeViewer::Atom> atoms;
+        entry.store->frameAtoms(0, atoms);
+        entry.bonds.resize(qMax<int>(entry.bonds.size(), 1));
+        entry.bonds[0] = publishFirstFrame(atoms, entry.bonds[0], firstFrameBytes);
+        result.frameCount = entry.store->frameCount();
+        result.store = entry.store;
+        result.bonds = entry.bonds;
+        result.explicitBonds = entry.explicitBonds;
+        result.fromCache = true;
+        complete(job, result);
+        return;
+    }
+
+    if (streamed) {
+        // Frame 0 straight from the top of the file, then the frame index for the viewer's
+        // own reader (which re-opens the file and only loads the sidecar index).
+        if (!readFirstFrame()) {
+            fail(job, tr("No complete XYZ frame found in %1").arg(filePath));
+            return;
+        }
+        if (center)
+            MoleculeViewer::centerFrameAtOrigin(firstAtoms);
+        publishFirstFrame(firstAtoms, firstBonds, firstFrameBytes);
+        XYZTrajectoryReader reader;
+        reader.setProgressCallback([&](qint64 done, qint64 total) {
+            report(Stage::Indexing, done, total);
+            return !aborted();
+        });
+        if (!reader.open(filePath)) {
+            if (!aborted())
+                fail(job, reader.lastError());
+            return;
+        }
+        result.frameCount = reader.frameCount();
+        result.streamed = true;
+        complete(job, result);
+        return;
+    }
+
+    // parse: frames are packed as they arrive; a frame with another topology unpacks the
+    // store and the rest is kept frame by frame.
+    QSharedPointer<TrajectoryStore> store;
+    QVector<QVector<MoleculeViewer::Atom>> mixed;
+    QVector<QVector<MoleculeViewer::Bond>> bonds;
+    bool explicitBonds = false;
+    const bool parsed = parseFrames(filePath, vtf, [&](QVector<MoleculeViewer::Atom>&& atoms,
+                                                       QVector<MoleculeViewer::Bond>&& frameBonds,
+                                                       qint64 done, qint64 total) {
+        if (aborted())
+            return false;
+        if (center)
+            MoleculeViewer::centerFrameAtOrigin(atoms);
+        if (frames == 0) {
+            explicitBonds = !frameBonds.isEmpty();
+            frameBonds = publishFirstFrame(atoms, frameBonds, done);
+            // Compression is chosen up front from the size of frame 0 in the file.
+            const qint64 estimatedAtomFrames = qint64(atoms.size()) * (total / qMax<qint64>(done, 1));
+            store = QSharedPointer<TrajectoryStore>::create();
+            store->beginFrames(atoms, estimatedAtomFrames > TrajectoryStore::kDeltaCompressionAtomFrames
+                    ? TrajectoryStore::Compression::Delta : TrajectoryStore::Compression::None);
+        }
+        if (!store || !store->appendFrame(atoms)) {
+            if (store) {
+                mixed.resize(store->frameCount());
+                for (int f = 0; f < mixed.size(); ++f)
+                    store->frameAtoms(f, mixed[f]);
+                store.reset();
+            }
+            mixed.append(std::move(atoms));
+        }
+        // Perceived bonds: frame 0 only, the viewer perceives the others when shown.
+        if (explicitBonds || frames == 0)
+            bonds.append(std::move(frameBonds));
+        ++frames;
+        report(Stage::Parsing, done, total);
+        return true;
+    });
+    if (aborted())
+        return;
+    if (!parsed || frames == 0) {
+        fail(job, tr("No structure found in %1").arg(filePath));
+        return;
+    }
+
+    // bonds: without a shared topology the viewer keeps frames as they are, so every frame
+    // needs its bonds now.
+    if (!mixed.isEmpty() && !explicitBonds) {
+        bonds.resize(mixed.size());
+        for (int f = 1; f < mixed.size(); ++f) {
+            if (aborted())
+                return;
+            bonds[f] = bondperception::detect(mixed[f]);
+            report(Stage::Bonds, f, mixed.size());
+        }
+    }
+
+    result.frameCount = frames;
+    result.store = store;
+    result.frames = mixed;
+    result.bonds = bonds;
+    result.explicitBonds = explicitBonds;
+    if (!store || !StructureCache::isCacheable(filePath)) {
+        complete(job, result);
+        return;
+    }
+    // The GUI edits and centres its store in place; the cache is written from a copy
+    // (implicitly shared frames, so nothing is duplicated until the GUI writes).
+    const TrajectoryStore snapshot = *store;
+    complete(job, result);
+    StructureCache::save(filePath, snapshot, bonds, explicitBonds, center, &job->cancel);
+}
@@ -0,0 +1,116 @@
+// structureloader.h - Background, cancellable loading of XYZ/VTF structure files
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - takes reading, parsing and bond perception out of
+// MainWindow::loadMoleculeFile, which ran them (and setPlainText(readAll())) on the GUI thread.
+//
+// Every start() runs one worker thread through the pipeline
+//
+//   read    StructureCache lookup; the text for the structure editor (the whole file up to
+//           kEditorTextBytes, otherwise only the first frame)
+//   parse   XYZParser / VTFParser frame by frame from the mapped file; each frame is
+//           converted to viewer atoms, centred if requested and packed into a
+//           TrajectoryStore as soon as it is read (nothing else is kept per frame)
+//   bonds   frame 0 right away; the other frames of a packed trajectory are perceived by
+//           the viewer when shown, frames of mixed topologies here
+//   upload  on the GUI thread by the receiver of finished() (setTrajectoryStore)
+//
+// Frame 0 is published through firstFrameReady() as soon as it is decoded, so the structure
+// is on screen while the rest of a long trajectory is still being read. XYZ files from
+// kStreamingThresholdBytes on are not packed at all: the worker builds the frame index
+// (XYZTrajectoryReader sidecar) and the viewer decodes frames on demand.
+//
+// All signals are emitted on the GUI thread. cancel() - or the next start() - makes the
+// running job stop at its next frame and drops whatever it would still deliver.
+
+#pragma once
+
+#include "view.h"
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
+class QThread;
+class TrajectoryStore;
+
+class StructureLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// XYZ files from this size on are streamed (frame index + on-demand decoding).
+    static constexpr qint64 kStreamingThresholdBytes = 64LL * 1024 * 1024;
+    /// Larger files show only their first frame in the structure editor.
+    static constexpr qint64 kEditorTextBytes = 16LL * 1024 * 1024;
+    /// Minimum interval between two progress() signals.
+    static constexpr int kProgressIntervalMs = 100;
+
+    enum class Stage { Parsing, Indexing, Bonds };
+
+    struct Options {
+        bool center = true;   // shift every frame's centre of mass to the origin
+    };
+
+    /// A loaded file, ready to be handed to the viewer. Exactly one of store, frames and
+    /// streamed describes the frames.
+    struct Result {
+        QString filePath;
+        int frameCount = 0;
+        QSharedPointer<TrajectoryStore> store;              // one topology (also cache hits)
+        QVector<QVector<MoleculeViewer::Atom>> frames;      // mixed topologies
+        bool streamed = false;                              // open an XYZTrajectoryReader
+        QVector<QVector<MoleculeViewer::Bond>> bonds;       // per frame, may be shorter
+        bool explicitBonds = false;                         // bonds come from the file
+        bool fromCache = false;
+    };
+
+    explicit StructureLoader(QObject* parent = nullptr);
+    ~StructureLoader() override;   // cancels every job and waits for the workers
+
+    /// Formats handled by the pipeline (xyz, vtf).
+    static bool canLoad(const QString& filePath);
+
+    /// Load @p filePath in the background; a running load is cancelled first.
+    void start(const QString& filePath, const Options& options = Options());
+    bool isLoading() const { return m_job != nullptr; }
+    QString filePath() const;
+
+public slots:
+    /// Abort the running load (emits cancelled()); no-op when idle.
+    void cancel();
+
+signals:
+    /// Frame 0 with its bonds and the editor text, before the rest of the file is read.
+    void firstFrameReady(const QString& filePath, const QVector<MoleculeViewer::Atom>& atoms,
+        const QVector<MoleculeViewer::Bond>& bonds, const QString& text);
+    /// @p done of @p total bytes (frames in the Bonds stage); @p frames parsed so far.
+    void progress(StructureLoader::Stage stage, qint64 done, qint64 total, int frames);
+    void finished(const StructureLoader::Result& result);
+    void failed(const QString& filePath, const QString& error);
+    void cancelled(const QString& filePath);
+
+private:
+    struct Job {
+        QString filePath;
+        Options options;
+        std::atomic<bool> cancel{ false };
+    };
+    struct Worker {
+        QThread* thread = nullptr;
+        std::shared_ptr<Job> job;   // still cancellable while it writes the cache entry
+    };
+
+    void run(const std::shared_ptr<Job>& job);
+    /// Run @p fn on the GUI thread unless @p job was cancelled or superseded meanwhile.
+    template <typename Fn>
+    void deliver(const std::shared_ptr<Job>& job, Fn fn);
+    void complete(const std::shared_ptr<Job>& job, const Result& result);
+    void fail(const std::shared_ptr<Job>& job, const QString& error);
+
+    std::shared_ptr<Job> m_job;   // null when idle
+    QVector<Worker> m_workers;
+};
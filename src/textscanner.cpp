@@ -0,0 +1,228 @@
+// textscanner.cpp - Memory-mapped, allocation-free line/field scanner for parsers
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "textscanner.h"
+
+#include "elementdata.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+// Normalise a numeric field for std::from_chars: drop a leading '+', and map a
+// Fortran 'D'/'d' exponent to 'e'. Only copies when a rewrite is needed.
+inline QByteArrayView normaliseNumber(QByteArrayView s, char* scratch, qsizetype scratchSize)
+{
+    if (!s.isEmpty() && s.front() == '+')
+        s = s.sliced(1);
+    const char* d = static_cast<const char*>(std::memchr(s.data(), 'D', s.size()));
+    if (!d)
+        d = static_cast<const char*>(std::memchr(s.data(), 'd', s.size()));
+    if (!d || s.size() > scratchSize)
+        return s;
+    std::memcpy(scratch, s.data(), s.size());
+    scratch[d - s.data()] = 'e';
+    return QByteArrayView(scratch, s.size());
+}
+}
+
+TextScanner::~TextScanner()
+{
+    close();
+}
+
+bool TextScanner::open(const QString& filePath)
+{
+    close();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    const qint64 size = m_file.size();
+    if (size > 0) {
+        m_map = m_file.map(0, size);
+        if (m_map) {
+            m_data = QByteArrayView(reinterpret_cast<const char*>(m_map), size);
+        } else {
+            // Unmappable (pipes, some network filesystems): one bulk read.
+            m_buffer = m_file.readAll();
+            m_data = m_buffer;
+        }
+    }
+    m_pos = 0;
+    return true;
+}
+
+void TextScanner::setData(QByteArrayView data)
+{
+    close();
+    m_data = data;
+}
+
+void TextScanner::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+    m_buffer.clear();
+    m_data = {};
+    m_pos = 0;
+}
+
+QByteArrayView TextScanner::readLine()
+{
+    if (atEnd())
+        return {};
+    const char* begin = m_data.data() + m_pos;
+    const qsizetype left = m_data.size() - m_pos;
+    const char* nl = static_cast<const char*>(std::memchr(begin, '\n', left));
+    qsizetype len = nl ? nl - begin : left;
+    m_pos += nl ? len + 1 : len;
+    if (len > 0 && begin[len - 1] == '\r')
+        --len;
+    return QByteArrayView(begin, len);
+}
+
+int TextScanner::skipLines(int count)
+{
+    int skipped = 0;
+    while (skipped < count && !atEnd()) {
+        const char* begin = m_data.data() + m_pos;
+        const char* nl = static_cast<const char*>(std::memchr(begin, '\n', m_data.size() - m_pos));
+        m_pos = nl ? (nl - m_data.data()) + 1 : m_data.size();
+        ++skipped;
+    }
+    return skipped;
+}
+
+QByteArrayView TextScanner::trimmed(QByteArrayView s)
+{
+    qsizetype b = 0, e = s.size();
+    while (b < e && isSpace(s[b]))
+        ++b;
+    while (e > b && isSpace(s[e - 1]))
+        --e;
+    return s.sliced(b, e - b);
+}
+
+int TextScanner::splitFields(QByteArrayView line, QByteArrayView* fields, int maxFields)
+{
+    int n = 0;
+    qsizetype i = 0;
+    const qsizetype len = line.size();
+    while (n < maxFields) {
+        while (i < len && isSpace(line[i]))
+            ++i;
+        if (i >= len)
+            break;
+        const qsizetype start = i;
+        while (i < len && !isSpace(line[i]))
+            ++i;
+        fields[n++] = line.sliced(start, i - start);
+    }
+    return n;
+}
+
+QByteArrayView TextScanner::column(QByteArrayView line, qsizetype start, qsizetype width)
+{
+    if (start >= line.size())
+        return {};
+    return trimmed(line.sliced(start, qMin(width, line.size() - start)));
+}
+
+namespace {
+template <typename Real>
+bool parseReal(QByteArrayView s, Real& value)
+{
+    s = TextScanner::trimmed(s);
+    if (s.isEmpty())
+        return false;
+    char scratch[64];
+    s = normaliseNumber(s, scratch, sizeof(scratch));
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto res = std::from_chars(s.data(), s.data() + s.size(), value);
+    return res.ec == std::errc() && res.ptr == s.data() + s.size();
+#else
+    // Toolchains without floating-point from_chars (older libc++): Qt's parser is
+    // locale-independent too, it just allocates a little.
+    bool ok = false;
+    value = Real(QByteArray::fromRawData(s.data(), s.size()).toDouble(&ok));
+    return ok;
+#endif
+}
+}
+
+bool TextScanner::parseFloat(QByteArrayView s, float& value)
+{
+    return parseReal(s, value);
+}
+
+bool TextScanner::parseFloat(QByteArrayView s, double& value)
+{
+    return parseReal(s, value);
+}
+
+bool TextScanner::parseInt(QByteArrayView s, int& value)
+{
+    s = trimmed(s);
+    if (!s.isEmpty() && s.front() == '+')
+        s = s.sliced(1);
+    if (s.isEmpty())
+        return false;
+    const auto res = std::from_chars(s.data(), s.data() + s.size(), value);
+    return res.ec == std::errc() && res.ptr == s.data() + s.size();
+}
+
+float TextScanner::toFloat(QByteArrayView s, float fallback, bool* ok)
+{
+    float v = fallback;
+    const bool good = parseFloat(s, v);
+    if (ok)
+        *ok = good;
+    return good ? v : fallback;
+}
+
+int TextScanner::toInt(QByteArrayView s, int fallback, bool* ok)
+{
+    int v = fallback;
+    const bool good = parseInt(s, v);
+    if (ok)
+        *ok = good;
+    return good ? v : fallback;
+}
+
+int SymbolCache::find(QByteArrayView token)
+{
+    // fromRawData: the lookup key borrows the token, only a miss copies it.
+    const auto it = m_index.constFind(QByteArray::fromRawData(token.data(), token.size()));
+    if (it != m_index.constEnd())
+        return it.value();
+    const int i = m_values.size();
+    m_index.insert(token.toByteArray(), i);
+    m_values.append(QString::fromLatin1(token.data(), token.size()));
+    m_atomicNumbers.append(-1);
+    return i;
+}
+
+QString SymbolCache::intern(QByteArrayView token)
+{
+    return m_values[find(token)];
+}
+
+QString SymbolCache::intern(QByteArrayView token, quint8& atomicNumber)
+{
+    const int i = find(token);
+    if (m_atomicNumbers[i] < 0)
+        m_atomicNumbers[i] = qint16(elem::atomicNumber(m_values[i]));
+    atomicNumber = quint8(m_atomicNumbers[i]);
+    return m_values[i];
+}
@@ -0,0 +1,96 @@
+// textscanner.h - Memory-mapped, allocation-free line/field scanner for parsers
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - shared tokenizer under the XYZ/VTF/PDB/MOL2 parsers.
+//
+// Replaces the QTextStream::readLine() + QString::trimmed() + split(QRegularExpression)
+// pattern, which allocated several QStrings per atom line. The file is mapped once
+// (QFile::map; read into one buffer if mapping is not possible) and every line/field
+// is a QByteArrayView into that mapping. Numbers are parsed with std::from_chars
+// (locale-independent, no allocation). The API deliberately mirrors QTextStream
+// (atEnd/readLine/pos/seek) so parser control flow ports one-to-one.
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class TextScanner
+{
+public:
+    TextScanner() = default;
+    ~TextScanner();
+
+    TextScanner(const TextScanner&) = delete;
+    TextScanner& operator=(const TextScanner&) = delete;
+
+    /** Map @p filePath read-only. @return false if it cannot be opened. */
+    bool open(const QString& filePath);
+    /** Scan an in-memory buffer (not copied; must outlive the scanner). */
+    void setData(QByteArrayView data);
+    void close();
+
+    QString errorString() const { return m_error; }
+    QByteArrayView data() const { return m_data; }
+    qsizetype size() const { return m_data.size(); }
+
+    bool atEnd() const { return m_pos >= m_data.size(); }
+    qsizetype pos() const { return m_pos; }
+    void seek(qsizetype pos) { m_pos = qBound<qsizetype>(0, pos, m_data.size()); }
+
+    /** Next line without its terminator ("\n" or "\r\n"); advances past it. */
+    QByteArrayView readLine();
+    /** Skip @p count lines. @return number of lines actually skipped. */
+    int skipLines(int count);
+
+    // ----- Field helpers (all operate on views, nothing is allocated) -----
+
+    /** Strip leading/trailing ASCII whitespace. */
+    static QByteArrayView trimmed(QByteArrayView s);
+    /** Split @p line at runs of whitespace into at most @p maxFields views.
+     *  @return the number of fields written to @p fields. */
+    static int splitFields(QByteArrayView line, QByteArrayView* fields, int maxFields);
+    /** Fixed-width column [start, start + width), clamped to the line and trimmed (PDB). */
+    static QByteArrayView column(QByteArrayView line, qsizetype start, qsizetype width);
+
+    /** Locale-independent float/int parsing of a whole (trimmed) field.
+     *  Accepts a leading '+' and Fortran-style 'D' exponents. */
+    static bool parseFloat(QByteArrayView s, float& value);
+    static bool parseFloat(QByteArrayView s, double& value);
+    static bool parseInt(QByteArrayView s, int& value);
+    /// Convenience forms: @p fallback if the field is empty or not a number.
+    static float toFloat(QByteArrayView s, float fallback = 0.0f, bool* ok = nullptr);
+    static int toInt(QByteArrayView s, int fallback = 0, bool* ok = nullptr);
+
+private:
+    QFile m_file;
+    uchar* m_map = nullptr;
+    QByteArray m_buffer;  // fallback when mapping fails
+    QByteArrayView m_data;
+    qsizetype m_pos = 0;
+    QString m_error;
+};
+
+/**
+ * Interns short, highly repetitive tokens (element symbols, Sybyl types, residue
+ * names) so that every atom line shares one implicitly shared QString instead of
+ * allocating its own. Hashed, so a file with many distinct tokens still interns in O(1);
+ * per-atom unique names are better built directly than interned.
+ * For element tokens the atomic number is resolved once per distinct symbol as well.
+ */
+class SymbolCache
+{
+public:
+    QString intern(QByteArrayView token);  // implicitly shared copy, no allocation on hit
+    QString intern(QByteArrayView token, quint8& atomicNumber);
+
+private:
+    int find(QByteArrayView token);
+
+    QHash<QByteArray, int> m_index;  // token -> slot in m_values
+    QVector<QString> m_values;
+    QVector<qint16> m_atomicNumbers;  // -1 = not resolved yet
+};
@@ -0,0 +1,303 @@
+// trajectoryanalysis.cpp - Trajectory-wide RMSD / RMSF over all frames
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "trajectoryanalysis.h"
+
+#include <QThreadPool>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr int kBlockFrames = 256;    // RMSD values per rmsdBlock() update
+constexpr int kRangesPerThread = 4;  // frame ranges per pool thread (load balance)
+}
+
+// Fit atoms of the reference frame, centred on their centroid (SoA for the SIMD loops).
+struct TrajectoryAnalysis::Reference {
+    int atomCount = 0;
+    QVector<int> fit;
+    QVector<double> x, y, z;
+};
+
+// Per-range RMSF accumulators, merged on the GUI thread.
+struct TrajectoryAnalysis::RangeSums {
+    QVector<double> sum;    // 3 per atom
+    QVector<double> sumSq;  // 1 per atom
+    int fitted = 0;
+    int failed = 0;
+};
+
+namespace {
+struct FitScratch {
+    QVector<double> x, y, z;
+};
+
+// Kabsch superposition of @p coords onto @p ref: @p rot and @p centroid map a frame atom p
+// to rot * (p - centroid) in the reference frame. Returns the RMSD over the fit atoms.
+template <typename Reference>
+double fitFrame(const Reference& ref, const QVector<QVector3D>& coords, FitScratch& s,
+    Eigen::Matrix3d& rot, Eigen::Vector3d& centroid)
+{
+    const int m = ref.fit.size();
+    s.x.resize(m);
+    s.y.resize(m);
+    s.z.resize(m);
+    for (int k = 0; k < m; ++k) {
+        const QVector3D& p = coords[ref.fit[k]];
+        s.x[k] = p.x();
+        s.y[k] = p.y();
+        s.z[k] = p.z();
+    }
+    const double* x = s.x.constData();
+    const double* y = s.y.constData();
+    const double* z = s.z.constData();
+    const double* rx = ref.x.constData();
+    const double* ry = ref.y.constData();
+    const double* rz = ref.z.constData();
+
+    double cx = 0.0, cy = 0.0, cz = 0.0;
+#pragma omp simd reduction(+ : cx, cy, cz)
+    for (int k = 0; k < m; ++k) {
+        cx += x[k];
+        cy += y[k];
+        cz += z[k];
+    }
+    cx /= m;
+    cy /= m;
+    cz /= m;
+
+    // The reference is centred, so sum (p - c) r^T == sum p r^T: one pass, no centring.
+    double hxx = 0.0, hxy = 0.0, hxz = 0.0, hyx = 0.0, hyy = 0.0, hyz = 0.0,
+           hzx = 0.0, hzy = 0.0, hzz = 0.0;
+#pragma omp simd reduction(+ : hxx, hxy, hxz, hyx, hyy, hyz, hzx, hzy, hzz)
+    for (int k = 0; k < m; ++k) {
+        hxx += x[k] * rx[k];
+        hxy += x[k] * ry[k];
+        hxz += x[k] * rz[k];
+        hyx += y[k] * rx[k];
+        hyy += y[k] * ry[k];
+        hyz += y[k] * rz[k];
+        hzx += z[k] * rx[k];
+        hzy += z[k] * ry[k];
+        hzz += z[k] * rz[k];
+    }
+    Eigen::Matrix3d h;
+    h << hxx, hxy, hxz, hyx, hyy, hyz, hzx, hzy, hzz;
+    const Eigen::JacobiSVD<Eigen::Matrix3d> svd(h, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix3d d = Eigen::Matrix3d::Identity();
+    if ((svd.matrixV() * svd.matrixU().transpose()).determinant() < 0.0)
+        d(2, 2) = -1.0;  // reflection -> proper rotation
+    rot = svd.matrixV() * d * svd.matrixU().transpose();
+    centroid = Eigen::Vector3d(cx, cy, cz);
+
+    const double r00 = rot(0, 0), r01 = rot(0, 1), r02 = rot(0, 2);
+    const double r10 = rot(1, 0), r11 = rot(1, 1), r12 = rot(1, 2);
+    const double r20 = rot(2, 0), r21 = rot(2, 1), r22 = rot(2, 2);
+    double e = 0.0;
+#pragma omp simd reduction(+ : e)
+    for (int k = 0; k < m; ++k) {
+        const double px = x[k] - cx, py = y[k] - cy, pz = z[k] - cz;
+        const double dx = r00 * px + r01 * py + r02 * pz - rx[k];
+        const double dy = r10 * px + r11 * py + r12 * pz - ry[k];
+        const double dz = r20 * px + r21 * py + r22 * pz - rz[k];
+        e += dx * dx + dy * dy + dz * dz;
+    }
+    return std::sqrt(e / m);
+}
+
+// Add the fitted coordinates of all atoms to the RMSF sums.
+void accumulateFitted(const QVector<QVector3D>& coords, const Eigen::Matrix3d& rot,
+    const Eigen::Vector3d& centroid, double* sum, double* sumSq)
+{
+    const int n = coords.size();
+    const float* p = reinterpret_cast<const float*>(coords.constData());  // x, y, z packed
+    const double r00 = rot(0, 0), r01 = rot(0, 1), r02 = rot(0, 2);
+    const double r10 = rot(1, 0), r11 = rot(1, 1), r12 = rot(1, 2);
+    const double r20 = rot(2, 0), r21 = rot(2, 1), r22 = rot(2, 2);
+    const double cx = centroid.x(), cy = centroid.y(), cz = centroid.z();
+#pragma omp simd
+    for (int i = 0; i < n; ++i) {
+        const double px = p[3 * i] - cx, py = p[3 * i + 1] - cy, pz = p[3 * i + 2] - cz;
+        const double fx = r00 * px + r01 * py + r02 * pz;
+        const double fy = r10 * px + r11 * py + r12 * pz;
+        const double fz = r20 * px + r21 * py + r22 * pz;
+        sum[3 * i] += fx;
+        sum[3 * i + 1] += fy;
+        sum[3 * i + 2] += fz;
+        sumSq[i] += fx * fx + fy * fy + fz * fz;
+    }
+}
+}
+
+TrajectoryAnalysis::TrajectoryAnalysis(QObject* parent)
+    : QObject(parent)
+    , m_pool(new QThreadPool(this))
+{
+}
+
+TrajectoryAnalysis::~TrajectoryAnalysis()
+{
+    // No finished() here: the receivers may already be half destroyed.
+    if (m_cancelFlag)
+        m_cancelFlag->storeRelaxed(1);
+    m_pool->clear();
+    m_pool->waitForDone();
+}
+
+void TrajectoryAnalysis::stop()
+{
+    if (!m_running)
+        return;
+    m_cancelFlag->storeRelaxed(1);
+    m_cancelFlag.reset();
+    m_pool->clear();
+    m_pool->waitForDone();  // workers check the flag once per frame
+    ++m_run;
+    m_running = false;
+    emit finished(false);
+}
+
+bool TrajectoryAnalysis::start(const TrajectoryFrameSource& source, const Options& options)
+{
+    stop();
+    if (!source.isValid() || options.referenceFrame < 0
+        || options.referenceFrame >= source.frameCount)
+        return false;
+
+    const int n = source.atomicNumbers.size();
+    QVector<QVector3D> coords;
+    const TrajectoryFrameReader read = source.openReader();
+    if (!read || !read(options.referenceFrame, coords) || coords.size() != n)
+        return false;
+
+    auto ref = QSharedPointer<Reference>::create();
+    ref->atomCount = n;
+    for (int i = 0; i < n; ++i)
+        if (options.fitAtoms == FitAtoms::All || source.atomicNumbers[i] != 1)
+            ref->fit.append(i);
+    if (ref->fit.size() < 3) {  // e.g. H2: fit on all atoms instead
+        ref->fit.resize(n);
+        for (int i = 0; i < n; ++i)
+            ref->fit[i] = i;
+    }
+    const int m = ref->fit.size();
+    double cx = 0.0, cy = 0.0, cz = 0.0;
+    for (int i : ref->fit) {
+        cx += coords[i].x();
+        cy += coords[i].y();
+        cz += coords[i].z();
+    }
+    cx /= m;
+    cy /= m;
+    cz /= m;
+    ref->x.resize(m);
+    ref->y.resize(m);
+    ref->z.resize(m);
+    for (int k = 0; k < m; ++k) {
+        ref->x[k] = coords[ref->fit[k]].x() - cx;
+        ref->y[k] = coords[ref->fit[k]].y() - cy;
+        ref->z[k] = coords[ref->fit[k]].z() - cz;
+    }
+
+    const int frames = source.frameCount;
+    m_rmsd.fill(std::numeric_limits<float>::quiet_NaN(), frames);
+    m_rmsf.clear();
+    m_sum.fill(0.0, 3 * n);
+    m_sumSq.fill(0.0, n);
+    m_framesDone = 0;
+    m_framesFailed = 0;
+
+    const int ranges = std::min(frames, std::max(1, m_pool->maxThreadCount()) * kRangesPerThread);
+    const QSharedPointer<QAtomicInt> cancel = QSharedPointer<QAtomicInt>::create(0);
+    const int run = ++m_run;
+    m_cancelFlag = cancel;
+    m_rangesLeft = ranges;
+    m_running = true;
+
+    const std::function<TrajectoryFrameReader()> openReader = source.openReader;
+    for (int r = 0; r < ranges; ++r) {
+        const int first = int(qint64(frames) * r / ranges);
+        const int last = int(qint64(frames) * (r + 1) / ranges);
+        m_pool->start([this, openReader, ref, cancel, run, first, last] {
+            const int n = ref->atomCount;
+            const TrajectoryFrameReader read = openReader();
+            auto sums = QSharedPointer<RangeSums>::create();
+            sums->sum.fill(0.0, 3 * n);
+            sums->sumSq.fill(0.0, n);
+            QVector<QVector3D> coords;
+            FitScratch scratch;
+            Eigen::Matrix3d rot;
+            Eigen::Vector3d centroid;
+            QVector<float> block;
+            block.reserve(kBlockFrames);
+            int blockStart = first;
+            for (int f = first; f < last; ++f) {
+                if (cancel->loadRelaxed())
+                    return;
+                float value = std::numeric_limits<float>::quiet_NaN();
+                if (read && read(f, coords) && coords.size() == n) {
+                    value = float(fitFrame(*ref, coords, scratch, rot, centroid));
+                    accumulateFitted(coords, rot, centroid, sums->sum.data(), sums->sumSq.data());
+                    ++sums->fitted;
+                } else {
+                    ++sums->failed;
+                }
+                block.append(value);
+                if (block.size() == kBlockFrames || f + 1 == last) {
+                    QMetaObject::invokeMethod(this,
+                        [this, run, blockStart, block] { onBlock(run, blockStart, block); },
+                        Qt::QueuedConnection);
+                    block.clear();
+                    blockStart = f + 1;
+                }
+            }
+            QMetaObject::invokeMethod(this, [this, run, sums] { onRangeDone(run, sums); },
+                Qt::QueuedConnection);
+        });
+    }
+    return true;
+}
+
+void TrajectoryAnalysis::onBlock(int run, int firstFrame, const QVector<float>& values)
+{
+    if (run != m_run)
+        return;
+    std::copy(values.cbegin(), values.cend(), m_rmsd.begin() + firstFrame);
+    m_framesDone += values.size();
+    emit rmsdBlock(firstFrame, values.size());
+    emit progress(m_framesDone, m_rmsd.size());
+}
+
+void TrajectoryAnalysis::onRangeDone(int run, const QSharedPointer<RangeSums>& sums)
+{
+    if (run != m_run)
+        return;
+    for (int i = 0; i < m_sum.size(); ++i)
+        m_sum[i] += sums->sum[i];
+    for (int i = 0; i < m_sumSq.size(); ++i)
+        m_sumSq[i] += sums->sumSq[i];
+    m_framesFailed += sums->failed;
+    if (--m_rangesLeft > 0)
+        return;
+
+    // RMSF^2 = <|r|^2> - |<r>|^2 over the fitted frames.
+    const int fitted = m_framesDone - m_framesFailed;
+    const int n = m_sumSq.size();
+    m_rmsf.fill(0.0f, n);
+    if (fitted > 0) {
+        for (int i = 0; i < n; ++i) {
+            const double mx = m_sum[3 * i] / fitted;
+            const double my = m_sum[3 * i + 1] / fitted;
+            const double mz = m_sum[3 * i + 2] / fitted;
+            const double var = m_sumSq[i] / fitted - (mx * mx + my * my + mz * mz);
+            m_rmsf[i] = float(std::sqrt(std::max(0.0, var)));
+        }
+    }
+    m_cancelFlag.reset();
+    m_running = false;
+    emit finished(true);
+}
@@ -0,0 +1,96 @@
+// trajectoryanalysis.h - Trajectory-wide RMSD / RMSF over all frames
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - batch analysis of loaded or streamed trajectories.
+//
+// Every frame is superimposed onto a reference frame (Kabsch: 3x3 covariance of the fit
+// atoms, SVD, proper rotation) and its RMSD over the fit atoms recorded. The fitted
+// coordinates of all atoms feed running sums for the per-atom RMSF about the mean
+// structure, so no frame has to be kept after it was processed.
+//
+// Frames come from a TrajectoryFrameSource: openReader() hands every worker its own
+// reader (TrajectoryStore with a private decode buffer, or a separate XYZTrajectoryReader
+// over the sidecar index), so the engine never needs more than one frame per thread in
+// memory. The frame range is split into contiguous ranges processed on a thread pool;
+// RMSD values are published in blocks as they are computed (rmsdBlock), the RMSF once all
+// ranges are merged (finished).
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector3D>
+#include <QVector>
+
+#include <functional>
+
+class QThreadPool;
+
+/// Decode the coordinates of frame @p frame into @p coords; false if it cannot be read
+/// (or does not match the topology). One reader is used by one thread only.
+using TrajectoryFrameReader = std::function<bool(int frame, QVector<QVector3D>& coords)>;
+
+/// Read-only access to every frame of a trajectory from any thread.
+struct TrajectoryFrameSource {
+    int frameCount = 0;
+    QVector<quint8> atomicNumbers;                   // topology (atom count = size)
+    std::function<TrajectoryFrameReader()> openReader;  // null reader on failure
+
+    bool isValid() const { return frameCount > 0 && !atomicNumbers.isEmpty() && openReader; }
+};
+
+class TrajectoryAnalysis : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class FitAtoms { All, Heavy };
+
+    struct Options {
+        int referenceFrame = 0;
+        FitAtoms fitAtoms = FitAtoms::All;
+    };
+
+    explicit TrajectoryAnalysis(QObject* parent = nullptr);
+    ~TrajectoryAnalysis() override;
+
+    /** Start analysing @p source (cancels a running analysis first).
+     *  @return false if the source or the reference frame cannot be read. */
+    bool start(const TrajectoryFrameSource& source, const Options& options);
+    /** Abandon the running analysis; returns once no worker touches the source anymore. */
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    int frameCount() const { return m_rmsd.size(); }
+    int framesDone() const { return m_framesDone; }
+    /// RMSD [A] per frame over the fit atoms; NaN for frames not (yet) analysed.
+    const QVector<float>& rmsd() const { return m_rmsd; }
+    /// RMSF [A] per atom about the mean fitted structure; filled when finished(true).
+    const QVector<float>& rmsf() const { return m_rmsf; }
+
+signals:
+    /** rmsd()[firstFrame, firstFrame + count) has been filled. */
+    void rmsdBlock(int firstFrame, int count);
+    void progress(int framesDone, int frameCount);
+    /** @p completed false: stopped or failed; rmsd() keeps what was computed. */
+    void finished(bool completed);
+
+private:
+    struct Reference;
+    struct RangeSums;
+
+    void onBlock(int run, int firstFrame, const QVector<float>& values);
+    void onRangeDone(int run, const QSharedPointer<RangeSums>& sums);
+
+    QThreadPool* m_pool = nullptr;
+    QSharedPointer<QAtomicInt> m_cancelFlag;
+    int m_run = 0;  // results of older runs are dropped
+    bool m_running = false;
+    int m_rangesLeft = 0;
+    int m_framesDone = 0;
+    int m_framesFailed = 0;
+    QVector<float> m_rmsd;
+    QVector<float> m_rmsf;
+    QVector<double> m_sum;    // merged per-atom sums of fitted x, y, z
+    QVector<double> m_sumSq;  // merged per-atom sums of |fitted|^2
+};
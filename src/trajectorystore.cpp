@@ -0,0 +1,289 @@
+// trajectorystore.cpp - Structure-of-arrays trajectory container
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "trajectorystore.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+// Quantised offset of @p value from @p reference; false if it does not fit int16.
+inline bool quantise(float value, float reference, qint16& out)
+{
+    const float steps = std::round((value - reference) / TrajectoryStore::kDeltaQuantum);
+    if (!(std::abs(steps) <= float(std::numeric_limits<qint16>::max())))
+        return false;
+    out = qint16(steps);
+    return true;
+}
+}
+
+void TrajectoryStore::clear()
+{
+    m_frameCount = 0;
+    m_elements.clear();
+    m_atomicNumbers.clear();
+    m_charges.clear();
+    m_frames.clear();
+    m_scratch.clear();
+    m_mappedFirst = nullptr;
+    m_mappedStride = 0;
+    m_mappedOwner.reset();
+    m_mappedEdits.clear();
+}
+
+void TrajectoryStore::adoptMapped(const QVector<QString>& elements,
+    const QVector<quint8>& atomicNumbers, int frameCount, const uchar* firstFrame, qint64 stride,
+    std::shared_ptr<const void> owner, const QVector<float>& charges)
+{
+    clear();
+    if (frameCount <= 0 || !firstFrame || elements.size() != atomicNumbers.size())
+        return;
+    m_compression = Compression::Mapped;
+    m_elements = elements;
+    m_atomicNumbers = atomicNumbers;
+    m_charges = charges.size() == elements.size() ? charges : QVector<float>(elements.size(), 0.0f);
+    m_frameCount = frameCount;
+    m_mappedFirst = firstFrame;
+    m_mappedStride = stride;
+    m_mappedOwner = std::move(owner);
+}
+
+bool TrajectoryStore::setFrames(const QVector<QVector<MoleculeViewer::Atom>>& frames,
+    Compression compression)
+{
+    clear();
+    if (frames.isEmpty())
+        return false;
+
+    const QVector<MoleculeViewer::Atom>& first = frames[0];
+    const int n = first.size();
+    for (const QVector<MoleculeViewer::Atom>& frame : frames) {
+        if (frame.size() != n)
+            return false;
+        for (int i = 0; i < n; ++i)
+            if (frame[i].element != first[i].element)
+                return false;
+    }
+
+    beginFrames(first, compression);
+    m_frames.reserve(frames.size());
+    for (const QVector<MoleculeViewer::Atom>& frame : frames)
+        appendPositions(frame);
+    return true;
+}
+
+void TrajectoryStore::beginFrames(const QVector<MoleculeViewer::Atom>& first, Compression compression)
+{
+    clear();
+    m_compression = compression;
+    const int n = first.size();
+    m_elements.reserve(n);
+    m_atomicNumbers.reserve(n);
+    m_charges.reserve(n);
+    for (const MoleculeViewer::Atom& a : first) {
+        m_elements.append(a.element);
+        m_atomicNumbers.append(a.atomicNumber);
+        m_charges.append(a.charge);
+    }
+}
+
+bool TrajectoryStore::appendFrame(const QVector<MoleculeViewer::Atom>& frame)
+{
+    if (frame.size() != atomCount())
+        return false;
+    for (int i = 0; i < frame.size(); ++i)
+        if (frame[i].element != m_elements[i])
+            return false;
+    appendPositions(frame);
+    return true;
+}
+
+void TrajectoryStore::appendPositions(const QVector<MoleculeViewer::Atom>& frame)
+{
+    const int n = atomCount();
+    m_scratch.resize(n);
+    for (int i = 0; i < n; ++i)
+        m_scratch[i] = frame[i].position;
+    m_frames.append(Frame());
+    encode(m_frameCount++, m_scratch.constData());
+}
+
+void TrajectoryStore::encode(int f, const QVector3D* coords)
+{
+    const int n = atomCount();
+    if (m_compression == Compression::Mapped) {
+        m_mappedEdits.insert(f, QVector<QVector3D>(coords, coords + n));
+        return;
+    }
+    Frame& frame = m_frames[f];
+    frame.full.clear();
+    frame.half.clear();
+    frame.delta.clear();
+    frame.keyframe = -1;
+
+    switch (m_compression) {
+    case Compression::None:
+        frame.full = QVector<QVector3D>(coords, coords + n);
+        return;
+    case Compression::Float16:
+        frame.half.resize(3 * n);
+        for (int i = 0; i < n; ++i) {
+            frame.half[3 * i] = qfloat16(coords[i].x());
+            frame.half[3 * i + 1] = qfloat16(coords[i].y());
+            frame.half[3 * i + 2] = qfloat16(coords[i].z());
+        }
+        return;
+    case Compression::Delta:
+    case Compression::Mapped:
+        break;
+    }
+
+    // Reference = the most recent keyframe within the interval; frames are encoded in
+    // order by setFrames(), and later edits re-use the keyframe they were assigned.
+    int key = -1;
+    if (f % kKeyframeInterval != 0) {
+        for (int k = f - 1; k >= 0 && f - k < kKeyframeInterval; --k) {
+            if (m_frames[k].keyframe == k) {
+                key = k;
+                break;
+            }
+        }
+    }
+    if (key >= 0) {
+        const QVector<QVector3D>& ref = m_frames[key].full;
+        QVector<qint16> delta(3 * n);
+        bool fits = true;
+        for (int i = 0; i < n && fits; ++i) {
+            fits = quantise(coords[i].x(), ref[i].x(), delta[3 * i])
+                && quantise(coords[i].y(), ref[i].y(), delta[3 * i + 1])
+                && quantise(coords[i].z(), ref[i].z(), delta[3 * i + 2]);
+        }
+        if (fits) {
+            frame.delta = delta;
+            frame.keyframe = key;
+            return;
+        }
+    }
+    // Keyframe (interval boundary, or atoms moved too far for int16 offsets).
+    frame.full = QVector<QVector3D>(coords, coords + n);
+    frame.keyframe = f;
+}
+
+PositionSpan TrajectoryStore::positions(int f) const
+{
+    return positions(f, m_scratch);
+}
+
+PositionSpan TrajectoryStore::positions(int f, QVector<QVector3D>& scratch) const
+{
+    if (f < 0 || f >= m_frameCount)
+        return {};
+    const int n = atomCount();
+    if (m_compression == Compression::Mapped) {
+        const auto edit = m_mappedEdits.constFind(f);
+        if (edit != m_mappedEdits.cend())
+            return { edit->constData(), n };
+        return { reinterpret_cast<const QVector3D*>(m_mappedFirst + qint64(f) * m_mappedStride), n };
+    }
+    const Frame& frame = m_frames[f];
+    if (!frame.full.isEmpty())
+        return { frame.full.constData(), n };
+
+    scratch.resize(n);
+    if (!frame.half.isEmpty()) {
+        for (int i = 0; i < n; ++i)
+            scratch[i] = QVector3D(frame.half[3 * i], frame.half[3 * i + 1], frame.half[3 * i + 2]);
+    } else {
+        const QVector<QVector3D>& ref = m_frames[frame.keyframe].full;
+        for (int i = 0; i < n; ++i)
+            scratch[i] = ref[i] + QVector3D(frame.delta[3 * i], frame.delta[3 * i + 1], frame.delta[3 * i + 2]) * kDeltaQuantum;
+    }
+    return { scratch.constData(), n };
+}
+
+void TrajectoryStore::setPositions(int f, const QVector3D* coords, int count)
+{
+    if (f < 0 || f >= m_frameCount || count != atomCount())
+        return;
+    if (m_compression != Compression::Delta) {
+        encode(f, coords);
+        return;
+    }
+
+    // A group is a keyframe plus the delta frames up to the next keyframe, all referencing
+    // it (transformFrames() relies on that). The rest of @p f's group is re-encoded when the
+    // edit changes its reference: decoded before a rewritten keyframe is lost, or after a
+    // delta frame turned keyframe (its old reference is untouched).
+    QVector<QVector<QVector3D>> rest;
+    auto decodeRest = [&]() {
+        for (int g = f + 1; g < m_frameCount && m_frames[g].keyframe != g; ++g) {
+            const PositionSpan span = positions(g);
+            rest.append(QVector<QVector3D>(span.begin(), span.end()));
+        }
+    };
+    const bool wasKeyframe = m_frames[f].keyframe == f;
+    if (wasKeyframe)
+        decodeRest();
+    encode(f, coords);
+    if (!wasKeyframe && m_frames[f].keyframe == f)
+        decodeRest();
+    for (int d = 0; d < rest.size(); ++d)
+        encode(f + 1 + d, rest[d].constData());
+}
+
+void TrajectoryStore::transformFrames(const std::function<void(int, QVector<QVector3D>&)>& fn)
+{
+    // A group is a keyframe plus the delta frames that reference it; all of them are decoded
+    // before the keyframe is rewritten. Without delta compression every group is one frame.
+    QVector<QVector<QVector3D>> group;
+    int f = 0;
+    while (f < m_frameCount) {
+        int end = f + 1;
+        if (m_compression == Compression::Delta)
+            while (end < m_frameCount && m_frames[end].keyframe != end)
+                ++end;
+        group.resize(end - f);
+        for (int g = f; g < end; ++g) {
+            const PositionSpan span = positions(g);
+            group[g - f] = QVector<QVector3D>(span.begin(), span.end());
+            fn(g, group[g - f]);
+        }
+        for (int g = f; g < end; ++g)
+            encode(g, group[g - f].constData());
+        f = end;
+    }
+}
+
+void TrajectoryStore::frameAtoms(int f, QVector<MoleculeViewer::Atom>& atoms) const
+{
+    const PositionSpan pos = positions(f);
+    const int n = pos.size;
+    bool sameTopology = atoms.size() == n;
+    for (int i = 0; i < n && sameTopology; ++i)
+        sameTopology = atoms[i].element == m_elements[i] && atoms[i].charge == m_charges[i];
+
+    if (!sameTopology) {
+        atoms.resize(n);
+        for (int i = 0; i < n; ++i) {
+            atoms[i].element = m_elements[i];  // implicitly shared, no string copy
+            atoms[i].atomicNumber = m_atomicNumbers[i];
+            atoms[i].charge = m_charges[i];
+        }
+    }
+    for (int i = 0; i < n; ++i)
+        atoms[i].position = pos[i];
+}
+
+qint64 TrajectoryStore::memoryBytes() const
+{
+    qint64 bytes = qint64(m_elements.size()) * (sizeof(QString) + sizeof(quint8) + sizeof(float));
+    for (const Frame& frame : m_frames) {
+        bytes += qint64(frame.full.size()) * sizeof(QVector3D);
+        bytes += qint64(frame.half.size()) * sizeof(qfloat16);
+        bytes += qint64(frame.delta.size()) * sizeof(qint16);
+    }
+    for (const QVector<QVector3D>& edit : m_mappedEdits)
+        bytes += qint64(edit.size()) * sizeof(QVector3D);
+    return bytes;
+}
@@ -0,0 +1,124 @@
+// trajectorystore.h - Structure-of-arrays trajectory container
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - compact in-memory trajectories.
+//
+// QVector<QVector<MoleculeViewer::Atom>> repeats the element string and charge of every
+// atom in every frame although only positions change along an MD trajectory. The store
+// keeps the topology (element, atomic number, charge) once and one contiguous position block per
+// frame, optionally compressed:
+//
+//   None     3 x float32 per atom; positions() is a zero-copy span into the frame.
+//   Float16  3 x qfloat16 per atom (~1e-2 A error at 50 A; display-grade only).
+//   Delta    every kKeyframeInterval-th frame as float32, the others as int16 offsets
+//            from that keyframe quantised to kDeltaQuantum (<= 5e-4 A error). A frame
+//            whose offsets do not fit int16 becomes a keyframe itself, so access stays
+//            O(atoms) for any frame.
+//   Mapped   frames are float32 blocks inside an external memory mapping (a .qrec session
+//            recording, see sessionrecording.h); positions() is a zero-copy span into the
+//            mapping. Edited frames are kept as overrides in memory; the file is read-only.
+//
+// Compressed frames are decoded into one scratch buffer owned by the store; a span
+// returned by positions() stays valid until the next positions() call.
+
+#pragma once
+
+#include "positionspan.h"
+#include "view.h"
+
+#include <QFloat16>
+#include <QString>
+#include <QVector3D>
+#include <QVector>
+
+#include <QHash>
+
+#include <functional>
+#include <memory>
+
+class TrajectoryStore
+{
+public:
+    enum class Compression { None, Float16, Delta, Mapped };
+
+    static constexpr int kKeyframeInterval = 32;
+    static constexpr float kDeltaQuantum = 1.0e-3f;  // Angstrom per int16 step
+    // Trajectories above this many atom-frames (~190 MB as float32) are delta-compressed
+    // (<= 5e-4 A quantisation, well below display resolution).
+    static constexpr qint64 kDeltaCompressionAtomFrames = 16 * 1000 * 1000;
+
+    TrajectoryStore() = default;
+
+    /** Pack @p frames. Topology is taken from frame 0.
+     *  @return false (store left empty) if the frames differ in atom count or element
+     *  order, i.e. the trajectory has no single topology. */
+    bool setFrames(const QVector<QVector<MoleculeViewer::Atom>>& frames,
+        Compression compression = Compression::None);
+    /** Pack frames one at a time as they are parsed (StructureLoader): beginFrames() takes
+     *  the topology from @p first without adding it, appendFrame() encodes the next frame.
+     *  appendFrame() @return false (nothing added) if @p frame has another topology.
+     *  @p compression: None, Float16 or Delta. */
+    void beginFrames(const QVector<MoleculeViewer::Atom>& first, Compression compression);
+    bool appendFrame(const QVector<MoleculeViewer::Atom>& frame);
+    /** Serve @p frameCount frames from external memory (Compression::Mapped): frame f's
+     *  atomCount x 3 float32 start at @p firstFrame + f * @p stride. @p owner keeps the
+     *  mapping alive for as long as the store uses it. @p charges defaults to all zero. */
+    void adoptMapped(const QVector<QString>& elements, const QVector<quint8>& atomicNumbers,
+        int frameCount, const uchar* firstFrame, qint64 stride, std::shared_ptr<const void> owner,
+        const QVector<float>& charges = {});
+    void clear();
+
+    bool isEmpty() const { return m_frameCount == 0; }
+    int frameCount() const { return m_frameCount; }
+    int atomCount() const { return m_elements.size(); }
+    Compression compression() const { return m_compression; }
+
+    const QVector<QString>& elements() const { return m_elements; }
+    const QVector<float>& charges() const { return m_charges; }
+    const QVector<quint8>& atomicNumbers() const { return m_atomicNumbers; }
+
+    /** Coordinates of frame @p frame. Zero-copy for Compression::None; compressed frames
+     *  are decoded into an internal buffer (valid until the next call). */
+    PositionSpan positions(int frame) const;
+    /** Same, decoding into the caller's @p scratch instead of the shared buffer; safe to
+     *  call from several threads at once as long as nothing modifies the store. */
+    PositionSpan positions(int frame, QVector<QVector3D>& scratch) const;
+
+    /** Overwrite the coordinates of @p frame (edits, centring); re-encodes as needed. */
+    void setPositions(int frame, const QVector3D* coords, int count);
+
+    /** Apply @p fn to the coordinates of every frame (e.g. centring) and re-encode. Delta
+     *  frames are processed one keyframe group at a time, so each frame is decoded once. */
+    void transformFrames(const std::function<void(int frame, QVector<QVector3D>& coords)>& fn);
+
+    /** Materialise frame @p frame as viewer atoms. Reuses @p atoms' storage when it already
+     *  holds this topology (only positions are rewritten, no allocation). */
+    void frameAtoms(int frame, QVector<MoleculeViewer::Atom>& atoms) const;
+
+    /// Approximate heap footprint (topology + all position blocks; mapped frames: edits only).
+    qint64 memoryBytes() const;
+
+private:
+    struct Frame {
+        QVector<QVector3D> full;        // None / Delta keyframes
+        QVector<qfloat16> half;         // Float16 (x, y, z interleaved)
+        QVector<qint16> delta;          // Delta non-keyframes (x, y, z interleaved)
+        int keyframe = -1;              // Delta: frame holding the reference coordinates
+    };
+
+    void encode(int frame, const QVector3D* coords);
+    void appendPositions(const QVector<MoleculeViewer::Atom>& frame);
+
+    int m_frameCount = 0;
+    Compression m_compression = Compression::None;
+    QVector<QString> m_elements;
+    QVector<quint8> m_atomicNumbers;
+    QVector<float> m_charges;
+    QVector<Frame> m_frames;
+    mutable QVector<QVector3D> m_scratch;
+
+    // Compression::Mapped
+    const uchar* m_mappedFirst = nullptr;
+    qint64 m_mappedStride = 0;
+    std::shared_ptr<const void> m_mappedOwner;
+    QHash<int, QVector<QVector3D>> m_mappedEdits;  // edited frames override the mapping
+};
@@ -0,0 +1,257 @@
+// videoencoder.cpp - Background encoding of rendered frame sequences (PNG files / ffmpeg)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026
+
+#include "videoencoder.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <algorithm>
+
+namespace {
+// Qt maps PNG "quality" to the zlib level ((100 - q) / 11); 80 -> level 1-2, which encodes
+// several times faster than the default for ~10-20 % larger files of mostly flat frames.
+constexpr int kPngQuality = 80;
+constexpr int kFfmpegQueue = 8;
+}
+
+VideoEncoder::~VideoEncoder()
+{
+    if (!m_threads.isEmpty())
+        abort();
+}
+
+QString VideoEncoder::findFfmpeg()
+{
+    return QStandardPaths::findExecutable(QStringLiteral("ffmpeg"));
+}
+
+QString VideoEncoder::sequenceFileName(const QString& path, int index)
+{
+    const QFileInfo info(path);
+    const QString suffix = info.suffix().isEmpty() ? QStringLiteral("png") : info.suffix();
+    return info.dir().filePath(QStringLiteral("%1_%2.%3")
+                                   .arg(info.completeBaseName())
+                                   .arg(index, 5, 10, QLatin1Char('0'))
+                                   .arg(suffix));
+}
+
+bool VideoEncoder::open(const Options& options, const QSize& frameSize, bool alpha)
+{
+    if (!m_threads.isEmpty() || frameSize.isEmpty())
+        return false;
+    m_options = options;
+    m_size = frameSize;
+    m_alpha = alpha && options.output == Output::PngSequence;
+    m_queue.clear();
+    m_submitted = 0;
+    m_written = 0;
+    m_closing = false;
+    m_aborted = false;
+    m_error.clear();
+
+    if (options.output == Output::Ffmpeg) {
+        if (m_options.ffmpegPath.isEmpty())
+            m_options.ffmpegPath = findFfmpeg();
+        if (m_options.ffmpegPath.isEmpty()) {
+            m_error = QStringLiteral("ffmpeg was not found on PATH");
+            return false;
+        }
+        m_maxQueued = kFfmpegQueue;
+        m_threads.append(QThread::create([this]() { ffmpegLoop(); }));
+    } else {
+        // Leave one core to the render (GUI) thread.
+        const int workers = std::max(1, QThread::idealThreadCount() - 1);
+        m_maxQueued = 2 * workers;
+        for (int i = 0; i < workers; ++i)
+            m_threads.append(QThread::create([this]() { pngLoop(); }));
+    }
+    for (QThread* thread : m_threads)
+        thread->start();
+    return true;
+}
+
+bool VideoEncoder::submit(const QImage& frame)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_threads.isEmpty() || m_closing || m_aborted || !m_error.isEmpty())
+        return false;
+    if (frame.size() != m_size) {
+        m_error = QStringLiteral("Frame size changed during export");
+        return false;
+    }
+    // Backpressure: wait for a worker instead of buffering the whole movie.
+    while (m_queue.size() >= m_maxQueued && m_error.isEmpty() && !m_aborted)
+        m_frameTaken.wait(&m_mutex);
+    if (!m_error.isEmpty() || m_aborted)
+        return false;
+    m_queue.enqueue({ m_submitted++, frame });
+    m_frameQueued.wakeOne();
+    return true;
+}
+
+bool VideoEncoder::takeFrame(int* index, QImage* frame)
+{
+    QMutexLocker lock(&m_mutex);
+    while (m_queue.isEmpty() && !m_closing && !m_aborted)
+        m_frameQueued.wait(&m_mutex);
+    if (m_aborted || m_queue.isEmpty())
+        return false;   // aborted, or closing and drained
+    auto next = m_queue.dequeue();
+    m_frameTaken.wakeOne();
+    *index = next.first;
+    *frame = std::move(next.second);
+    return true;
+}
+
+void VideoEncoder::setError(const QString& message)
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_error.isEmpty())
+        m_error = message;
+    // Unblock submit(); the remaining frames are dropped.
+    m_queue.clear();
+    m_frameTaken.wakeAll();
+}
+
+void VideoEncoder::pngLoop()
+{
+    int index = 0;
+    QImage frame;
+    while (takeFrame(&index, &frame)) {
+        // Conversion (un-premultiply / drop alpha) runs here, not on the render thread.
+        const QImage image = frame.convertToFormat(m_alpha ? QImage::Format_ARGB32 : QImage::Format_RGB888);
+        const QString file = sequenceFileName(m_options.path, index);
+        if (!image.save(file, "PNG", kPngQuality)) {
+            setError(QStringLiteral("Cannot write %1").arg(file));
+            continue;
+        }
+        QMutexLocker lock(&m_mutex);
+        ++m_written;
+    }
+}
+
+void VideoEncoder::ffmpegLoop()
+{
+    // The QProcess lives (and is only touched) on this worker thread; the blocking
+    // waitFor* calls need no event loop.
+    const QString suffix = QFileInfo(m_options.path).suffix().toLower();
+    QStringList args = { QStringLiteral("-y"), QStringLiteral("-nostdin"), QStringLiteral("-loglevel"),
+        QStringLiteral("error"), QStringLiteral("-f"), QStringLiteral("rawvideo"), QStringLiteral("-pix_fmt"),
+        QStringLiteral("rgba"), QStringLiteral("-s"),
+        QStringLiteral("%1x%2").arg(m_size.width()).arg(m_size.height()), QStringLiteral("-r"),
+        QString::number(m_options.fps), QStringLiteral("-i"), QStringLiteral("-"),
+        // 4:2:0 chroma needs even dimensions.
+        QStringLiteral("-vf"), QStringLiteral("pad=ceil(iw/2)*2:ceil(ih/2)*2"), QStringLiteral("-pix_fmt"),
+        QStringLiteral("yuv420p") };
+    if (suffix == QLatin1String("webm"))
+        args << QStringLiteral("-c:v") << QStringLiteral("libvpx-vp9") << QStringLiteral("-b:v")
+             << QStringLiteral("0") << QStringLiteral("-row-mt") << QStringLiteral("1");
+    else
+        args << QStringLiteral("-c:v") << QStringLiteral("libx264") << QStringLiteral("-preset")
+             << QStringLiteral("medium") << QStringLiteral("-movflags") << QStringLiteral("+faststart");
+    args << QStringLiteral("-crf") << QString::number(m_options.quality) << m_options.path;
+
+    QProcess ffmpeg;
+    ffmpeg.setStandardOutputFile(QProcess::nullDevice());
+    ffmpeg.start(m_options.ffmpegPath, args);
+    if (!ffmpeg.waitForStarted()) {
+        setError(QStringLiteral("Cannot start %1: %2").arg(m_options.ffmpegPath, ffmpeg.errorString()));
+        return;
+    }
+
+    const qint64 frameBytes = qint64(m_size.width()) * m_size.height() * 4;
+    int index = 0;
+    QImage frame;
+    bool ok = true;
+    while (ok && takeFrame(&index, &frame)) {
+        // Frames are opaque here, so premultiplied RGBA == straight RGBA.
+        const QImage rgba = frame.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+        for (int y = 0; y < rgba.height(); ++y)
+            ffmpeg.write(reinterpret_cast<const char*>(rgba.constScanLine(y)), qint64(rgba.width()) * 4);
+        // Keep at most about one frame in QProcess' write buffer.
+        while (ok && ffmpeg.bytesToWrite() > frameBytes) {
+            if (!ffmpeg.waitForBytesWritten(60000) || ffmpeg.state() != QProcess::Running)
+                ok = false;
+        }
+        if (ok) {
+            QMutexLocker lock(&m_mutex);
+            ++m_written;
+        }
+    }
+
+    bool aborted;
+    {
+        QMutexLocker lock(&m_mutex);
+        aborted = m_aborted;
+    }
+    if (aborted) {
+        ffmpeg.kill();
+        ffmpeg.waitForFinished();
+        QFile::remove(m_options.path);
+        return;
+    }
+    while (ok && ffmpeg.bytesToWrite() > 0)
+        ok = ffmpeg.waitForBytesWritten(60000);
+    ffmpeg.closeWriteChannel();
+    ffmpeg.waitForFinished(-1);
+    if (!ok || ffmpeg.exitStatus() != QProcess::NormalExit || ffmpeg.exitCode() != 0) {
+        const QString log = QString::fromLocal8Bit(ffmpeg.readAllStandardError()).trimmed();
+        setError(QStringLiteral("ffmpeg failed (exit code %1)%2")
+                     .arg(ffmpeg.exitCode())
+                     .arg(log.isEmpty() ? QString() : QStringLiteral(": ") + log));
+    }
+}
+
+void VideoEncoder::stopWorkers()
+{
+    for (QThread* thread : m_threads) {
+        thread->wait();
+        delete thread;
+    }
+    m_threads.clear();
+}
+
+bool VideoEncoder::close()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_threads.isEmpty())
+            return false;
+        m_closing = true;
+        m_frameQueued.wakeAll();
+    }
+    stopWorkers();
+    return m_error.isEmpty();
+}
+
+void VideoEncoder::abort()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_threads.isEmpty())
+            return;
+        m_aborted = true;
+        m_queue.clear();
+        m_frameQueued.wakeAll();
+        m_frameTaken.wakeAll();
+    }
+    stopWorkers();
+}
+
+int VideoEncoder::framesWritten() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_written;
+}
+
+QString VideoEncoder::lastError() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_error;
+}
@@ -0,0 +1,89 @@
+// videoencoder.h - Background encoding of rendered frame sequences (PNG files / ffmpeg)
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - trajectory movie export.
+//
+// MoleculeViewer::exportVideo() renders frames on the GUI thread (QQuickRenderControl is
+// synchronous) and hands each read-back image to submit(). Encoding runs on worker threads
+// so it overlaps with rendering the next frames:
+//
+//   PngSequence  one worker per core (minus the render thread); each saves whole frames,
+//                movie.png -> movie_00000.png, movie_00001.png, ... in any order.
+//   Ffmpeg       one worker owns a local ffmpeg process and writes raw RGBA frames to its
+//                stdin in order; ffmpeg does the (multi-threaded) H.264 / VP9 encoding.
+//
+// submit() blocks while the queue holds maxQueued() frames, which bounds memory to a few
+// frames whatever the movie length.
+
+#pragma once
+
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+
+class QThread;
+
+class VideoEncoder
+{
+public:
+    enum class Output { PngSequence, Ffmpeg };
+
+    struct Options {
+        QString path;                 // PNG: name of the sequence ("movie.png"); ffmpeg: video file
+        Output output = Output::PngSequence;
+        int fps = 30;
+        int quality = 18;             // x264 / VP9 CRF (lower = better)
+        QString ffmpegPath;           // defaults to findFfmpeg()
+    };
+
+    VideoEncoder() = default;
+    ~VideoEncoder();   // aborts if still open
+
+    VideoEncoder(const VideoEncoder&) = delete;
+    VideoEncoder& operator=(const VideoEncoder&) = delete;
+
+    /// ffmpeg on PATH, or empty.
+    static QString findFfmpeg();
+    /// File name of frame @p index of a PNG sequence named @p path.
+    static QString sequenceFileName(const QString& path, int index);
+
+    /** Start the workers (and ffmpeg). Frames must be @p frameSize; alpha is kept only
+     *  for PNG sequences when @p alpha. */
+    bool open(const Options& options, const QSize& frameSize, bool alpha);
+    /** Queue the next frame; blocks while the queue is full. False after an error. */
+    bool submit(const QImage& frame);
+    /** Encode everything queued, stop the workers and (ffmpeg) wait for the file. */
+    bool close();
+    /** Drop queued frames, kill ffmpeg and remove its partial output. */
+    void abort();
+
+    int maxQueued() const { return m_maxQueued; }
+    int framesWritten() const;
+    QString lastError() const;
+
+private:
+    void pngLoop();
+    void ffmpegLoop();
+    bool takeFrame(int* index, QImage* frame);   // false when closing and drained, or aborted
+    void setError(const QString& message);
+    void stopWorkers();
+
+    Options m_options;
+    QSize m_size;
+    bool m_alpha = false;
+    int m_maxQueued = 4;
+    QVector<QThread*> m_threads;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_frameQueued;   // workers: a frame arrived, or closing
+    QWaitCondition m_frameTaken;    // submit(): room in the queue
+    QQueue<QPair<int, QImage>> m_queue;
+    int m_submitted = 0;
+    int m_written = 0;
+    bool m_closing = false;
+    bool m_aborted = false;
+    QString m_error;
+};
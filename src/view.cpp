@@ -8,15 +8,23 @@
 #include "view.h"
 
 #include "bondeditor.h"
+#include "bondperception.h"
 #include "elementdata.h"
 #include "settings.h"
 
 #include "src/core/elements.h"
+#include "clashdetector.h"
 #include "forceinjector.h"
+#include "neighborgrid.h"
 #include "performanceoptimizer.h"
+#include "profiler.h"
 #include "scenecontroller.h"
 #include "selectionmanager.h"
+#include "streamingimagewriter.h"
+#include "trajectoryanalysis.h"
 #include "xyzparser.h"
+#include "trajectorystore.h"
+#include "xyztrajectoryreader.h"
 
 #include <QApplication>
 #include <QCheckBox>
@@ -27,6 +35,8 @@
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
 #include <QFileDialog>
 #include <QFormLayout>
 #include <QGridLayout>
@@ -39,6 +49,7 @@
 #include <QMessageBox>
 #include <QSpinBox>
 #include <QMouseEvent>
+#include <QProgressDialog>
 // Offscreen high-resolution image export (QQuickRenderControl + QRhi).
 #include <QQmlComponent>
 #include <QQmlEngine>
@@ -60,6 +71,10 @@
 #include <QWheelEvent>
 #include <QtMath>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
 MoleculeViewer::MoleculeViewer(QWidget* parent)
     : QWidget(parent)
 {
@@ -108,6 +123,111 @@ void MoleculeViewer::setupViewer()
 
     // Mouse events arrive on the QQuickView (a QWindow), like the former Qt3DWindow.
     m_quickView->installEventFilter(this);
+
+    // Uncapped MD frames are pulled once per rendered frame, just before scene sync.
+    connect(m_quickView, &QQuickWindow::afterAnimating, this, &MoleculeViewer::pullSimulationFrame);
+
+    // Claude Generated 2026 - level of detail. The cost of every rendered frame (scene-graph
+    // sync + render + swap, measured on the render thread) feeds PerformanceOptimizer, whose
+    // mode changes are pushed into the controller; the culling frustum follows the view size.
+    auto frameClock = std::make_shared<QElapsedTimer>();
+    connect(m_quickView, &QQuickWindow::beforeSynchronizing, m_perfOpt,
+        [frameClock]() { frameClock->start(); }, Qt::DirectConnection);
+    connect(m_quickView, &QQuickWindow::frameSwapped, m_perfOpt, [this, frameClock]() {
+        if (!frameClock->isValid())
+            return;
+        const double ms = frameClock->nsecsElapsed() * 1e-6;
+        frameClock->invalidate();
+        QMetaObject::invokeMethod(m_perfOpt, [perf = m_perfOpt, ms]() { perf->recordFrameTime(ms); },
+            Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+    connect(m_perfOpt, &PerformanceOptimizer::qualityModeChanged, this, &MoleculeViewer::applyLevelOfDetail);
+    auto resized = [this]() { m_scene->setViewportSize(m_quickView->width(), m_quickView->height()); };
+    connect(m_quickView, &QWindow::widthChanged, this, resized);
+    connect(m_quickView, &QWindow::heightChanged, this, resized);
+    applyLevelOfDetail();
+
+    // Claude Generated 2026 - profiler stages on the render thread (see profiler.h). The
+    // pairs are emitted on the same thread in order, so plain shared timestamps suffice.
+    auto syncStart = std::make_shared<qint64>(0);
+    auto renderStart = std::make_shared<qint64>(0);
+    connect(m_quickView, &QQuickWindow::beforeSynchronizing, this,
+        [syncStart]() { *syncStart = Profiler::now(); }, Qt::DirectConnection);
+    connect(m_quickView, &QQuickWindow::afterSynchronizing, this, [syncStart]() {
+        Profiler::instance().record("quick3d.sync", *syncStart, Profiler::now());
+    }, Qt::DirectConnection);
+    connect(m_quickView, &QQuickWindow::beforeRendering, this,
+        [renderStart]() { *renderStart = Profiler::now(); }, Qt::DirectConnection);
+    connect(m_quickView, &QQuickWindow::afterRendering, this, [renderStart]() {
+        Profiler::instance().record("quick3d.render", *renderStart, Profiler::now());
+    }, Qt::DirectConnection);
+    connect(m_quickView, &QQuickWindow::frameSwapped, this, [syncStart]() {
+        if (*syncStart > 0)
+            Profiler::instance().record("quick3d.frame", *syncStart, Profiler::now());
+    }, Qt::DirectConnection);
+
+    m_profilerHudTimer = new QTimer(this);
+    m_profilerHudTimer->setInterval(500);
+    connect(m_profilerHudTimer, &QTimer::timeout, this, &MoleculeViewer::updateProfilerHud);
+}
+
+void MoleculeViewer::setProfilerHudVisible(bool visible)
+{
+    Profiler& profiler = Profiler::instance();
+    if (visible) {
+        profiler.resetStatistics();
+        profiler.setStatisticsEnabled(true);
+        m_profilerHudTimer->start();
+        updateProfilerHud();
+    } else {
+        profiler.setStatisticsEnabled(false);
+        m_profilerHudTimer->stop();
+    }
+    m_scene->setProfilerVisible(visible);
+}
+
+bool MoleculeViewer::isProfilerHudVisible() const
+{
+    return m_scene && m_scene->profilerVisible();
+}
+
+void MoleculeViewer::updateProfilerHud()
+{
+    // Fixed-width table for the monospace HUD; percentiles over each stage's last
+    // Profiler::kHistory samples.
+    QString text = QStringLiteral("%1 %2 %3 %4 %5 %6 %7")
+                       .arg(QStringLiteral("stage [ms]"), -22)
+                       .arg(QStringLiteral("n"), 7)
+                       .arg(QStringLiteral("last"), 7)
+                       .arg(QStringLiteral("p50"), 7)
+                       .arg(QStringLiteral("p95"), 7)
+                       .arg(QStringLiteral("p99"), 7)
+                       .arg(QStringLiteral("max"), 7);
+    for (const Profiler::StageStats& s : Profiler::instance().statistics()) {
+        text += QStringLiteral("\n%1 %2 %3 %4 %5 %6 %7")
+                    .arg(s.name, -22)
+                    .arg(s.count, 7)
+                    .arg(s.lastMs, 7, 'f', 2)
+                    .arg(s.p50Ms, 7, 'f', 2)
+                    .arg(s.p95Ms, 7, 'f', 2)
+                    .arg(s.p99Ms, 7, 'f', 2)
+                    .arg(s.maxMs, 7, 'f', 2);
+    }
+    m_scene->setProfilerText(text);
+}
+
+void MoleculeViewer::applyLevelOfDetail()
+{
+    if (!m_scene || !m_perfOpt)
+        return;
+    SceneController::LevelOfDetail lod;
+    lod.sphereRings = m_perfOpt->getSphereRings();
+    lod.sphereSlices = m_perfOpt->getSphereSlices();
+    lod.bondSlices = m_perfOpt->getBondSlices();
+    lod.impostors = m_perfOpt->getQualityMode() == PerformanceOptimizer::Impostor;
+    lod.frustumCulling = m_perfOpt->isFrustumCullingEnabled();
+    lod.impostorBelow = m_perfOpt->getImpostorThreshold();
+    m_scene->setLevelOfDetail(lod);
 }
 
 void MoleculeViewer::applyAppearanceToController()
@@ -156,6 +276,7 @@ bool MoleculeViewer::eventFilter(QObject* watched, QEvent* event)
                         if (!m_selectedAtoms.contains(picked))
                             selectAtom(picked, append);
                         m_movingSelection = true;
+                        computeCollisions();  // prime the clash detector for this drag
                         m_moveSnapshotTaken = false;  // snapshot lazily on first drag
                         m_moveRefLocal = selectionCentroidLocal();
                         m_dragAnchorGlobal = me->globalPosition().toPoint();  // cursor-lock pin
@@ -846,7 +967,7 @@ void MoleculeViewer::syncSceneToController(int frameIndex, bool resetCamera, boo
         QVector<SceneController::AtomDatum> sa;
         sa.reserve(atoms.size());
         for (const Atom& a : atoms)
-            sa.append({ a.position, a.element, a.charge });
+            sa.append({ a.position, a.element, a.charge, a.atomicNumber });
         QVector<SceneController::BondDatum> sb;
         if (frameIndex < m_trajectoryBonds.size()) {
             const QVector<Bond>& bonds = m_trajectoryBonds[frameIndex];
@@ -865,11 +986,7 @@ void MoleculeViewer::syncSceneToController(int frameIndex, bool resetCamera, boo
             m_modelRotation = QQuaternion();
         }
     } else {
-        QVector<QVector3D> pos;
-        pos.reserve(atoms.size());
-        for (const Atom& a : atoms)
-            pos.append(a.position);
-        m_scene->updatePositions(pos);
+        m_scene->updatePositions(framePositions(frameIndex));
     }
 }
 
@@ -905,6 +1022,7 @@ void MoleculeViewer::addMolecule(const QVector<Atom>& atoms, const QVector<Bond>
 
     const QVector<Bond> actualBonds = bonds.isEmpty() ? detectBonds(atoms) : bonds;
 
+    resetFrameSources();
     m_trajectoryAtoms.clear();
     m_trajectoryBonds.clear();
     m_trajectoryAtoms.append(atoms);
@@ -1012,7 +1130,7 @@ int MoleculeViewer::addOverlay(const QVector<Atom>& targetAtoms, const QColor& t
     QVector<SceneController::AtomDatum> ta;
     ta.reserve(targetAtoms.size());
     for (const Atom& a : targetAtoms)
-        ta.append({ a.position, a.element, a.charge });
+        ta.append({ a.position, a.element, a.charge, a.atomicNumber });
     QVector<SceneController::BondDatum> tb;
     tb.reserve(tBonds.size());
     for (const Bond& b : tBonds)
@@ -1055,21 +1173,253 @@ int MoleculeViewer::overlayCount() const
     return m_scene ? m_scene->overlayCount() : 0;
 }
 
+namespace {
+// Claude Generated 2026 - order-independent comparison of two bond sets (file-provided bonds may
+// not be in ascending (i,j) order, so compare as a set rather than element-wise).
+quint64 bondPairKey(int i, int j)
+{
+    return (static_cast<quint64>(qMin(i, j)) << 32) | static_cast<quint32>(qMax(i, j));
+}
+bool bondSetEqual(const QVector<MoleculeViewer::Bond>& a, const QVector<MoleculeViewer::Bond>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    QSet<quint64> sa;
+    sa.reserve(a.size());
+    for (const MoleculeViewer::Bond& x : a)
+        sa.insert(bondPairKey(x.atom1, x.atom2));
+    for (const MoleculeViewer::Bond& x : b)
+        if (!sa.contains(bondPairKey(x.atom1, x.atom2)))
+            return false;
+    return true;
+}
+// Exact (ordered, bond-order aware) comparison, used to share identical per-frame bond lists.
+bool sameBondList(const QVector<MoleculeViewer::Bond>& a, const QVector<MoleculeViewer::Bond>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (int i = 0; i < a.size(); ++i)
+        if (a[i].atom1 != b[i].atom1 || a[i].atom2 != b[i].atom2 || a[i].bondOrder != b[i].bondOrder)
+            return false;
+    return true;
+}
+}  // namespace
+
+// Claude Generated 2026 - Translate one frame so that its mass-weighted centre-of-mass sits at
+// the origin. Masses from curcuma's Elements tables (no duplicated mass table).
+void MoleculeViewer::centerFrameAtOrigin(QVector<Atom>& frame)
+{
+    if (frame.isEmpty()) return;
+    double totalMass = 0.0;
+    QVector3D com;
+    for (const MoleculeViewer::Atom& a : frame) {
+        const int z = Elements::String2Element(a.element.toLower().toStdString());
+        const double mass = (z > 0 && z < static_cast<int>(Elements::AtomicMass.size()))
+            ? Elements::AtomicMass[z] : 12.011;
+        com += a.position * static_cast<float>(mass);
+        totalMass += mass;
+    }
+    if (totalMass > 0.0) com /= static_cast<float>(totalMass);
+    for (MoleculeViewer::Atom& a : frame) a.position -= com;
+}
+
 void MoleculeViewer::setTrajectoryData(const QVector<QVector<Atom>>& atoms, const QVector<QVector<Bond>>& bonds)
 {
-    m_trajectoryAtoms = atoms;
+    resetFrameSources();
     m_frameCount = atoms.size();
     m_currentFrame = 0;
     m_moleculeDirty = false;
 
-    m_trajectoryBonds.clear();
-    if (bonds.isEmpty() || (bonds.size() == atoms.size() && bonds[0].isEmpty())) {
-        for (int i = 0; i < atoms.size(); ++i)
-            m_trajectoryBonds.append(detectBonds(atoms[i]));
+    const bool explicitBonds = !(bonds.isEmpty() || (bonds.size() == atoms.size() && bonds[0].isEmpty()));
+
+    // Multi-frame data with one topology: pack positions (topology once) and expand only
+    // the resident frame. Mixed topologies (rare: concatenated files) stay frame-by-frame.
+    QSharedPointer<TrajectoryStore> store;
+    if (atoms.size() > 1) {
+        const qint64 atomFrames = qint64(atoms.size()) * atoms[0].size();
+        store.reset(new TrajectoryStore);
+        if (!store->setFrames(atoms, atomFrames > TrajectoryStore::kDeltaCompressionAtomFrames
+                    ? TrajectoryStore::Compression::Delta : TrajectoryStore::Compression::None))
+            store.reset();
+    }
+
+    if (store) {
+        m_trajectoryStore = store;
+        m_trajectoryAtoms = QVector<QVector<Atom>>(m_frameCount);
+        // Explicit bonds (VTF/PDB) are usually the same list in every frame and then share
+        // one copy; perceived bonds are detected per frame when it becomes resident.
+        m_trajectoryBonds = explicitBonds ? bonds : QVector<QVector<Bond>>(m_frameCount);
+        m_perceiveBondsOnLoad = !explicitBonds;
+        for (int f = 1; explicitBonds && f < m_trajectoryBonds.size(); ++f)
+            if (sameBondList(m_trajectoryBonds[f], m_trajectoryBonds[0]))
+                m_trajectoryBonds[f] = m_trajectoryBonds[0];
     } else {
-        m_trajectoryBonds = bonds;
+        m_trajectoryAtoms = atoms;
+        m_trajectoryBonds.clear();
+        if (!explicitBonds) {
+            for (int i = 0; i < atoms.size(); ++i)
+                m_trajectoryBonds.append(detectBonds(atoms[i]));
+        } else {
+            m_trajectoryBonds = bonds;
+        }
+    }
+
+    updateFrameControls();
+
+    if (m_frameCount > 0)
+        showFrame(0);
+
+    buildForceAdjacency();
+    emit trajectoryLoaded(m_frameCount);
+    if (m_frameCount > 0)
+        emit moleculeUpdated(m_trajectoryAtoms[0], m_trajectoryBonds[0]);
+}
+
+void MoleculeViewer::setTrajectoryReader(QSharedPointer<XYZTrajectoryReader> reader)
+{
+    if (!reader || reader->frameCount() == 0)
+        return;
+    resetFrameSources();
+    m_trajectoryReader = reader;
+    m_perceiveBondsOnLoad = true;
+    m_frameCount = reader->frameCount();
+    m_currentFrame = 0;
+    m_moleculeDirty = false;
+    // One (empty) slot per frame keeps the index-based frame access unchanged.
+    m_trajectoryAtoms = QVector<QVector<Atom>>(m_frameCount);
+    m_trajectoryBonds = QVector<QVector<Bond>>(m_frameCount);
+
+    updateFrameControls();
+    showFrame(0);
+
+    buildForceAdjacency();
+    emit trajectoryLoaded(m_frameCount);
+    emit moleculeUpdated(m_trajectoryAtoms[0], m_trajectoryBonds[0]);
+}
+
+void MoleculeViewer::setTrajectoryStore(QSharedPointer<TrajectoryStore> store,
+    const QVector<QVector<Bond>>& bonds, bool explicitBonds)
+{
+    if (!store || store->isEmpty())
+        return;
+    resetFrameSources();
+    m_trajectoryStore = store;
+    m_perceiveBondsOnLoad = !explicitBonds;
+    m_frameCount = store->frameCount();
+    m_currentFrame = 0;
+    m_moleculeDirty = false;
+    m_trajectoryAtoms = QVector<QVector<Atom>>(m_frameCount);
+    m_trajectoryBonds = bonds;
+    m_trajectoryBonds.resize(m_frameCount);
+
+    updateFrameControls();
+    showFrame(0);
+
+    buildForceAdjacency();
+    emit trajectoryLoaded(m_frameCount);
+    emit moleculeUpdated(m_trajectoryAtoms[0], m_trajectoryBonds[0]);
+}
+
+void MoleculeViewer::resetFrameSources()
+{
+    m_trajectoryReader.reset();
+    m_trajectoryStore.reset();
+    m_perceiveBondsOnLoad = false;
+    m_pinnedFrames.clear();
+    m_residentFrame = -1;
+    m_centerStreamedFrames = false;
+}
+
+PositionSpan MoleculeViewer::framePositions(int frameIndex) const
+{
+    if (frameIndex < 0 || frameIndex >= m_trajectoryAtoms.size())
+        return {};
+    // Resident frames may carry unsaved edits, so they take precedence over the store.
+    if (m_trajectoryStore && m_trajectoryAtoms[frameIndex].isEmpty())
+        return m_trajectoryStore->positions(frameIndex);
+    const QVector<Atom>& atoms = m_trajectoryAtoms[frameIndex];
+    if (atoms.isEmpty())
+        return {};
+    // Atom is not a plain coordinate array; gather the resident frame into a buffer.
+    m_framePositionScratch.resize(atoms.size());
+    for (int i = 0; i < atoms.size(); ++i)
+        m_framePositionScratch[i] = atoms[i].position;
+    return m_framePositionScratch;
+}
+
+TrajectoryFrameSource MoleculeViewer::trajectoryFrameSource() const
+{
+    TrajectoryFrameSource source;
+    if (m_frameCount < 2)
+        return source;
+    source.frameCount = m_frameCount;
+
+    if (m_trajectoryStore) {
+        const QSharedPointer<const TrajectoryStore> store = m_trajectoryStore;
+        source.atomicNumbers = store->atomicNumbers();
+        source.openReader = [store]() -> TrajectoryFrameReader {
+            auto scratch = QSharedPointer<QVector<QVector3D>>::create();
+            return [store, scratch](int frame, QVector<QVector3D>& coords) {
+                const PositionSpan span = store->positions(frame, *scratch);
+                if (span.isEmpty())
+                    return false;
+                coords.resize(span.size);
+                std::copy(span.begin(), span.end(), coords.begin());
+                return true;
+            };
+        };
+        return source;
     }
 
+    auto atomsToCoords = [](const QVector<Atom>& atoms, QVector<QVector3D>& coords) {
+        coords.resize(atoms.size());
+        for (int i = 0; i < atoms.size(); ++i)
+            coords[i] = atoms[i].position;
+    };
+
+    if (m_trajectoryReader) {
+        // The viewer's reader (and its cache) stays on the GUI thread; workers re-open the
+        // file, which only reads the sidecar index.
+        QVector<Atom> first;
+        if (!m_trajectoryReader->frameAtoms(0, first) || first.isEmpty())
+            return {};
+        for (const Atom& a : first)
+            source.atomicNumbers.append(a.atomicNumber);
+        const QString path = m_trajectoryReader->filePath();
+        const int atomCount = first.size();
+        source.openReader = [path, atomCount, atomsToCoords]() -> TrajectoryFrameReader {
+            auto reader = QSharedPointer<XYZTrajectoryReader>::create(atomCount);
+            if (!reader->open(path))
+                return {};
+            auto atoms = QSharedPointer<QVector<Atom>>::create();
+            return [reader, atoms, atomsToCoords](int frame, QVector<QVector3D>& coords) {
+                if (!reader->frameAtoms(frame, *atoms))
+                    return false;
+                atomsToCoords(*atoms, coords);
+                return true;
+            };
+        };
+        return source;
+    }
+
+    // Mixed topologies are kept frame by frame; frames that differ from frame 0 in atom
+    // count are reported as unreadable by the analysis.
+    const QVector<QVector<Atom>> frames = m_trajectoryAtoms;  // implicitly shared snapshot
+    for (const Atom& a : frames[0])
+        source.atomicNumbers.append(a.atomicNumber);
+    source.openReader = [frames, atomsToCoords]() -> TrajectoryFrameReader {
+        return [frames, atomsToCoords](int frame, QVector<QVector3D>& coords) {
+            if (frame < 0 || frame >= frames.size())
+                return false;
+            atomsToCoords(frames[frame], coords);
+            return true;
+        };
+    };
+    return source;
+}
+
+void MoleculeViewer::updateFrameControls()
+{
     if (m_frameSlider && m_frameLabel && m_frameJumpBox && m_frameControlWidget) {
         m_frameSlider->setMaximum(m_frameCount - 1);
         m_frameJumpBox->setMaximum(m_frameCount - 1);
@@ -1078,20 +1428,71 @@ void MoleculeViewer::setTrajectoryData(const QVector<QVector<Atom>>& atoms, cons
     }
     if (m_playbackWidget)
         m_playbackWidget->setVisible(m_frameCount > 1);
+}
 
-    if (m_frameCount > 0)
-        showFrame(0);
+bool MoleculeViewer::ensureFrameResident(int frameIndex, bool withBonds)
+{
+    if (!m_trajectoryReader && !m_trajectoryStore)
+        return true;
+    if (frameIndex < 0 || frameIndex >= m_trajectoryAtoms.size())
+        return false;
 
-    buildForceAdjacency();
-    emit trajectoryLoaded(m_frameCount);
-    if (m_frameCount > 0)
-        emit moleculeUpdated(m_trajectoryAtoms[0], m_trajectoryBonds[0]);
+    // Retire the previously resident frame first so its Atom buffer can be recycled.
+    // An edited frame of a stored trajectory whose topology is unchanged is written back
+    // to the store instead of staying pinned; other edited frames stay resident.
+    QVector<Atom> recycled;
+    if (m_residentFrame >= 0 && m_residentFrame != frameIndex && m_residentFrame < m_trajectoryAtoms.size()) {
+        QVector<Atom>& old = m_trajectoryAtoms[m_residentFrame];
+        if (m_trajectoryStore && m_pinnedFrames.contains(m_residentFrame)
+            && old.size() == m_trajectoryStore->atomCount()) {
+            bool sameTopology = true;
+            for (int i = 0; i < old.size() && sameTopology; ++i)
+                sameTopology = old[i].element == m_trajectoryStore->elements()[i];
+            if (sameTopology) {
+                QVector<QVector3D> pos(old.size());
+                for (int i = 0; i < old.size(); ++i)
+                    pos[i] = old[i].position;
+                emit frameDataAboutToChange();
+                m_trajectoryStore->setPositions(m_residentFrame, pos.constData(), pos.size());
+                m_pinnedFrames.remove(m_residentFrame);
+            }
+        }
+        if (!m_pinnedFrames.contains(m_residentFrame)) {
+            recycled.swap(old);
+            if (m_perceiveBondsOnLoad)
+                m_trajectoryBonds[m_residentFrame] = {};
+        }
+    }
+    m_residentFrame = frameIndex;
+
+    if (m_trajectoryAtoms[frameIndex].isEmpty()) {
+        if (m_trajectoryStore) {
+            // Same topology in every frame: only positions are rewritten in the recycled buffer.
+            m_trajectoryStore->frameAtoms(frameIndex, recycled);
+            m_trajectoryAtoms[frameIndex].swap(recycled);
+        } else {
+            QVector<Atom> atoms;
+            if (!m_trajectoryReader->frameAtoms(frameIndex, atoms)) {
+                qWarning() << "Failed to decode trajectory frame" << frameIndex << ":"
+                           << m_trajectoryReader->lastError();
+                return false;
+            }
+            if (m_centerStreamedFrames)
+                centerFrameAtOrigin(atoms);
+            m_trajectoryAtoms[frameIndex] = atoms;
+        }
+    }
+    if (withBonds && m_trajectoryBonds[frameIndex].isEmpty())
+        m_trajectoryBonds[frameIndex] = detectBonds(m_trajectoryAtoms[frameIndex]);
+    return true;
 }
 
 void MoleculeViewer::showFrame(int frameIndex)
 {
     if (frameIndex < 0 || frameIndex >= m_trajectoryAtoms.size())
         return;
+    if (!ensureFrameResident(frameIndex))
+        return;
     m_currentFrame = frameIndex;
 
     const QVector<Atom>& atoms = m_trajectoryAtoms[frameIndex];
@@ -1127,8 +1528,14 @@ void MoleculeViewer::updateFramePositions(int frameIndex)
 {
     if (frameIndex < 0 || frameIndex >= m_trajectoryAtoms.size())
         return;
+    if (!ensureFrameResident(frameIndex, /*withBonds=*/false))
+        return;
     m_currentFrame = frameIndex;
-    syncSceneToController(frameIndex, /*resetCamera=*/false, /*fullRebuild=*/false);
+    // Unedited stored frames feed the scene straight from the packed position block.
+    if (m_scene && m_trajectoryStore && !m_pinnedFrames.contains(frameIndex))
+        m_scene->updatePositions(m_trajectoryStore->positions(frameIndex));
+    else
+        syncSceneToController(frameIndex, /*resetCamera=*/false, /*fullRebuild=*/false);
 
     if (m_frameSlider && m_frameLabel && m_frameJumpBox) {
         m_frameSlider->blockSignals(true);
@@ -1154,27 +1561,6 @@ void MoleculeViewer::previousFrame()
         showFrame(m_currentFrame - 1);
 }
 
-namespace {
-// Claude Generated 2026 - order-independent comparison of two bond sets (file-provided bonds may
-// not be in ascending (i,j) order, so compare as a set rather than element-wise).
-quint64 bondPairKey(int i, int j)
-{
-    return (static_cast<quint64>(qMin(i, j)) << 32) | static_cast<quint32>(qMax(i, j));
-}
-bool bondSetEqual(const QVector<MoleculeViewer::Bond>& a, const QVector<MoleculeViewer::Bond>& b)
-{
-    if (a.size() != b.size())
-        return false;
-    QSet<quint64> sa;
-    sa.reserve(a.size());
-    for (const MoleculeViewer::Bond& x : a)
-        sa.insert(bondPairKey(x.atom1, x.atom2));
-    for (const MoleculeViewer::Bond& x : b)
-        if (!sa.contains(bondPairKey(x.atom1, x.atom2)))
-            return false;
-    return true;
-}
-}  // namespace
 
 void MoleculeViewer::updateSimulationFrame(SimulationFramePtr frame)
 {
@@ -1183,6 +1569,13 @@ void MoleculeViewer::updateSimulationFrame(SimulationFramePtr frame)
     const auto& positions = frame->positions;
     const int n = static_cast<int>(positions.size());
 
+    // Stored trajectories expand frames lazily; the live simulation drives (and edits) frame 0.
+    if (m_trajectoryStore && !m_trajectoryAtoms.isEmpty()) {
+        if (m_trajectoryAtoms[0].isEmpty())
+            ensureFrameResident(0);
+        m_pinnedFrames.insert(0);
+    }
+
     // Topology change -> rebuild (carry element/charge where possible).
     if (m_trajectoryAtoms.isEmpty() || m_trajectoryAtoms[0].size() != n) {
         QVector<Atom> atoms;
@@ -1194,8 +1587,10 @@ void MoleculeViewer::updateSimulationFrame(SimulationFramePtr frame)
             if (haveCache && i < m_trajectoryAtoms[0].size()) {
                 a.element = m_trajectoryAtoms[0][i].element;
                 a.charge = m_trajectoryAtoms[0][i].charge;
+                a.atomicNumber = m_trajectoryAtoms[0][i].atomicNumber;
             } else {
                 a.element = QStringLiteral("C");
+                a.atomicNumber = 6;
             }
             atoms.append(a);
         }
@@ -1222,7 +1617,9 @@ void MoleculeViewer::updateSimulationFrame(SimulationFramePtr frame)
         }
     }
 
-    syncSceneToController(0, /*resetCamera=*/false, /*fullRebuild=*/false);
+    // Positions go to the scene straight from the worker's frame (no gather copy).
+    if (m_scene)
+        m_scene->updatePositions(PositionSpan(positions.data(), n));
     if (topologyChanged && m_scene) {
         QVector<SceneController::BondDatum> sb;
         sb.reserve(m_trajectoryBonds[0].size());
@@ -1246,6 +1643,33 @@ void MoleculeViewer::updateSimulationFrame(SimulationFramePtr frame)
     }
 }
 
+void MoleculeViewer::setSimulationFrameRing(QSharedPointer<SimulationFrameRing> ring)
+{
+    m_frameRing = ring;
+    if (m_frameRing)
+        requestSimulationFrame();
+}
+
+void MoleculeViewer::requestSimulationFrame()
+{
+    if (m_quickView)
+        m_quickView->update();
+}
+
+void MoleculeViewer::pullSimulationFrame()
+{
+    if (!m_frameRing)
+        return;
+    const SimulationFramePtr frame = m_frameRing->takeLatest();
+    if (!frame)
+        return;  // ring is idle now; the worker notifies on its next step
+    updateSimulationFrame(frame);
+    emit simulationFramePresented(frame);
+    // Keep the render loop polling while the worker produces: a frame without visible
+    // motion would otherwise not schedule the next pull.
+    m_quickView->update();
+}
+
 // ---------------------------------------------------------------------------
 // Camera / view commands
 // ---------------------------------------------------------------------------
@@ -1268,19 +1692,33 @@ void MoleculeViewer::resetViewToMolecule() { setDefaultView(); }
 void MoleculeViewer::centerAtOrigin()
 {
     if (m_trajectoryAtoms.isEmpty()) return;
-    for (QVector<Atom>& frame : m_trajectoryAtoms) {
-        if (frame.isEmpty()) continue;
-        double totalMass = 0.0;
-        QVector3D com;
-        for (const Atom& a : frame) {
-            const int z = Elements::String2Element(a.element.toLower().toStdString());
-            const double mass = (z > 0 && z < static_cast<int>(Elements::AtomicMass.size()))
-                ? Elements::AtomicMass[z] : 12.011;
-            com += a.position * static_cast<float>(mass);
-            totalMass += mass;
-        }
-        if (totalMass > 0.0) com /= static_cast<float>(totalMass);
-        for (Atom& a : frame) a.position -= com;
+    // Streamed trajectories: only resident frames exist here; frames decoded later are
+    // centred in ensureFrameResident().
+    if (m_trajectoryReader)
+        m_centerStreamedFrames = true;
+    for (QVector<Atom>& frame : m_trajectoryAtoms)
+        centerFrameAtOrigin(frame);
+    // Stored frames are centred in the store as well (resident, unedited frames just take
+    // their centred coordinates back). Edited frames are written back when evicted.
+    if (m_trajectoryStore) {
+        emit frameDataAboutToChange();
+        QVector<Atom> scratch;
+        m_trajectoryStore->transformFrames([&](int f, QVector<QVector3D>& coords) {
+            if (m_pinnedFrames.contains(f))
+                return;
+            if (!m_trajectoryAtoms[f].isEmpty()) {
+                for (int i = 0; i < coords.size(); ++i)
+                    coords[i] = m_trajectoryAtoms[f][i].position;
+                return;
+            }
+            if (scratch.isEmpty())
+                m_trajectoryStore->frameAtoms(f, scratch);  // topology (masses) once
+            for (int i = 0; i < coords.size(); ++i)
+                scratch[i].position = coords[i];
+            centerFrameAtOrigin(scratch);
+            for (int i = 0; i < coords.size(); ++i)
+                coords[i] = scratch[i].position;
+        });
     }
     showFrame(m_currentFrame);
 }
@@ -1659,7 +2097,12 @@ void MoleculeViewer::moveSelection(const QVector3D& modelDelta)
         if (idx >= 0 && idx < atoms.size())
             atoms[idx].position += modelDelta;
     syncSceneToController(m_currentFrame, /*resetCamera=*/false, /*fullRebuild=*/false);
-    computeCollisions();
+    // A drag primes the clash detector at press time; each move then only re-checks the
+    // selection's neighbourhood.
+    if (m_movingSelection)
+        updateCollisionsForMove(m_selectedAtoms);
+    else
+        computeCollisions();
 }
 
 // Claude Generated 2026 - Apply a single-atom edit coming from the atom table.
@@ -1674,6 +2117,7 @@ void MoleculeViewer::setAtomInCurrentFrame(int index, const QString& element, co
         return;
     const bool elementChanged = (atoms[index].element != element);
     atoms[index].element = element;
+    atoms[index].atomicNumber = quint8(elem::atomicNumber(element));
     atoms[index].position = position;
     syncSceneToController(m_currentFrame, /*resetCamera=*/false,
         /*fullRebuild=*/elementChanged, /*keepView=*/true);
@@ -1710,33 +2154,41 @@ bool MoleculeViewer::applyStructureFromAtoms(const QVector<Atom>& atoms)
 
 // Flag atoms that overlap (centre distance < kClashFactor * (vdw_i + vdw_j)). Bonded
 // pairs and pairs entirely inside the moving selection (a rigid body) never clash.
+// Full O(N) pass through the grid-backed ClashDetector; drags then update it incrementally
+// (moveSelection).
 void MoleculeViewer::computeCollisions()
 {
-    m_collisionAtoms.clear();
+    if (!m_clashDetector)
+        m_clashDetector = QSharedPointer<ClashDetector>::create(kClashFactor);
     if (m_currentFrame >= 0 && m_currentFrame < m_trajectoryAtoms.size()) {
-        const QVector<Atom>& atoms = m_trajectoryAtoms[m_currentFrame];
-        QSet<quint64> bonded;
-        if (m_currentFrame < m_trajectoryBonds.size())
-            for (const Bond& b : m_trajectoryBonds[m_currentFrame])
-                bonded.insert(bondPairKey(b.atom1, b.atom2));
-        const QSet<int> sel(m_selectedAtoms.begin(), m_selectedAtoms.end());
-        QSet<int> clash;
-        for (int i = 0; i < atoms.size(); ++i) {
-            for (int j = i + 1; j < atoms.size(); ++j) {
-                if (sel.contains(i) && sel.contains(j))
-                    continue;  // rigid body: intra-selection never self-clashes
-                if (bonded.contains(bondPairKey(i, j)))
-                    continue;
-                const float thr = (elem::vdwRadius(atoms[i].element)
-                                   + elem::vdwRadius(atoms[j].element)) * kClashFactor;
-                if ((atoms[i].position - atoms[j].position).length() < thr) {
-                    clash.insert(i);
-                    clash.insert(j);
-                }
-            }
-        }
-        m_collisionAtoms = QVector<int>(clash.begin(), clash.end());
+        m_clashDetector->setStructure(m_trajectoryAtoms[m_currentFrame],
+            m_currentFrame < m_trajectoryBonds.size() ? m_trajectoryBonds[m_currentFrame] : QVector<Bond>(),
+            m_selectedAtoms);
+    } else {
+        m_clashDetector->clear();
+    }
+    m_collisionAtoms = m_clashDetector->clashingAtoms();
+    std::sort(m_collisionAtoms.begin(), m_collisionAtoms.end());
+    if (m_scene)
+        m_scene->setCollisionAtoms(m_collisionAtoms);
+    emit collisionCountChanged(m_collisionAtoms.size());
+}
+
+// Claude Generated 2026 - Incremental clash update for moved atoms: only their
+// neighbourhoods are re-checked. The scene is recoloured only if the set changed.
+void MoleculeViewer::updateCollisionsForMove(const QVector<int>& moved)
+{
+    const QVector<Atom>& atoms = m_trajectoryAtoms[m_currentFrame];
+    if (!m_clashDetector || m_clashDetector->atomCount() != atoms.size()) {
+        computeCollisions();
+        return;
     }
+    m_clashDetector->moveAtoms(moved, atoms);
+    QVector<int> clashing = m_clashDetector->clashingAtoms();
+    std::sort(clashing.begin(), clashing.end());
+    if (clashing == m_collisionAtoms)
+        return;
+    m_collisionAtoms = clashing;
     if (m_scene)
         m_scene->setCollisionAtoms(m_collisionAtoms);
     emit collisionCountChanged(m_collisionAtoms.size());
@@ -1774,34 +2226,29 @@ void MoleculeViewer::resolveClashes()
 {
     if (m_selectedAtoms.isEmpty() || m_currentFrame < 0 || m_currentFrame >= m_trajectoryAtoms.size())
         return;
-    const QSet<int> sel(m_selectedAtoms.begin(), m_selectedAtoms.end());
-    QSet<quint64> bonded;
-    if (m_currentFrame < m_trajectoryBonds.size())
-        for (const Bond& b : m_trajectoryBonds[m_currentFrame])
-            bonded.insert(bondPairKey(b.atom1, b.atom2));
-
     QVector<Atom>& atoms = m_trajectoryAtoms[m_currentFrame];
+    QVector<int> sel;
+    for (int s : m_selectedAtoms)
+        if (s >= 0 && s < atoms.size())
+            sel.append(s);
+    // The selection is the detector's rigid group, so intra-selection pairs are skipped.
+    if (!m_clashDetector)
+        m_clashDetector = QSharedPointer<ClashDetector>::create(kClashFactor);
+    m_clashDetector->setStructure(atoms,
+        m_currentFrame < m_trajectoryBonds.size() ? m_trajectoryBonds[m_currentFrame] : QVector<Bond>(),
+        sel);
+
     constexpr int kMaxIter = 200;
     constexpr float kStep = 0.15f;  // Angstrom per iteration
     for (int iter = 0; iter < kMaxIter; ++iter) {
         QVector3D push;
         int clashes = 0;
         for (int s : sel) {
-            if (s < 0 || s >= atoms.size())
-                continue;
-            for (int j = 0; j < atoms.size(); ++j) {
-                if (sel.contains(j) || bonded.contains(bondPairKey(s, j)))
-                    continue;
-                const float thr = (elem::vdwRadius(atoms[s].element)
-                                   + elem::vdwRadius(atoms[j].element)) * kClashFactor;
-                QVector3D d = atoms[s].position - atoms[j].position;
-                const float dist = d.length();
-                if (dist < thr) {
-                    ++clashes;
-                    const QVector3D dir = (dist > 1e-4f) ? d / dist : QVector3D(1, 0, 0);
-                    push += dir * (thr - dist);  // overlap-weighted
-                }
-            }
+            m_clashDetector->forEachClash(s, [&](int, const QVector3D& d, float dist, float thr) {
+                ++clashes;
+                const QVector3D dir = (dist > 1e-4f) ? d / dist : QVector3D(1, 0, 0);
+                push += dir * (thr - dist);  // overlap-weighted
+            });
         }
         if (clashes == 0)
             break;
@@ -1809,8 +2256,8 @@ void MoleculeViewer::resolveClashes()
             push = QVector3D(1, 0, 0);  // degenerate (fully enclosed): escape arbitrarily
         push.normalize();
         for (int s : sel)
-            if (s >= 0 && s < atoms.size())
-                atoms[s].position += push * kStep;
+            atoms[s].position += push * kStep;
+        m_clashDetector->moveAtoms(sel, atoms);
     }
     syncSceneToController(m_currentFrame, /*resetCamera=*/false, /*fullRebuild=*/false);
     finalizeEdit();
@@ -1965,46 +2412,19 @@ float MoleculeViewer::getCovalentRadius(const QString& element)
     return elem::covalentRadius(element);
 }
 
+// Claude Generated 2026 - cell-list bond perception, O(N) (see bondperception.h).
 QVector<MoleculeViewer::Bond> MoleculeViewer::detectBonds(const QVector<Atom>& atoms)
 {
-    QVector<Bond> detectedBonds;
-    const float BOND_TOLERANCE = 1.25f;
-    for (int i = 0; i < atoms.size(); ++i) {
-        for (int j = i + 1; j < atoms.size(); ++j) {
-            const float distance = (atoms[i].position - atoms[j].position).length();
-            const float threshold = (getCovalentRadius(atoms[i].element) + getCovalentRadius(atoms[j].element)) * BOND_TOLERANCE;
-            if (distance <= threshold)
-                detectedBonds.append({ i, j, 1 });
-        }
-    }
-    return detectedBonds;
+    return bondperception::detect(atoms);
 }
 
-// Claude Generated 2026 - per-frame bond detection with hysteresis. A currently-bonded pair is
-// kept until it stretches past the looser BREAK threshold; an unbonded pair only forms a bond
-// within the tighter FORM threshold. The gap between the two suppresses on/off flicker for bonds
-// that vibrate near the cutoff at finite temperature.
+// Claude Generated 2026 - per-frame bond detection with hysteresis (see bondperception.h). The
+// neighbour grid persists across calls (m_bondGrid) and is re-binned incrementally, since live
+// MD frames move atoms only slightly.
 QVector<MoleculeViewer::Bond> MoleculeViewer::detectBondsHysteresis(
     const QVector<Atom>& atoms, const QVector<Bond>& previous)
 {
-    QSet<quint64> bonded;
-    bonded.reserve(previous.size());
-    for (const Bond& b : previous)
-        bonded.insert(bondPairKey(b.atom1, b.atom2));
-
-    QVector<Bond> result;
-    constexpr float FORM = 1.25f;   // matches detectBonds() used at load
-    constexpr float BREAK = 1.45f;  // ~16% looser before an existing bond is dropped
-    for (int i = 0; i < atoms.size(); ++i) {
-        for (int j = i + 1; j < atoms.size(); ++j) {
-            const float distance = (atoms[i].position - atoms[j].position).length();
-            const float r = getCovalentRadius(atoms[i].element) + getCovalentRadius(atoms[j].element);
-            const float tol = bonded.contains(bondPairKey(i, j)) ? BREAK : FORM;
-            if (distance <= r * tol)
-                result.append({ i, j, 1 });
-        }
-    }
-    return result;
+    return bondperception::detectHysteresis(atoms, previous, m_bondGrid);
 }
 
 // ---------------------------------------------------------------------------
@@ -2149,6 +2569,196 @@ void MoleculeViewer::saveScreenshotDialog()
     QMessageBox::information(this, tr("Screenshot Saved"), tr("Screenshot saved to:\n%1").arg(filename));
 }
 
+namespace {
+// Claude Generated 2026 - tiled export. Below kSinglePassPixels (and for JPEG) the image is
+// rendered in one pass; above it, or for TIFF, it is rendered as kExportTile-sized tiles
+// whose frusta overlap by kExportTileOverlap pixels on every side (SSAO / bloom sample
+// neighbours, so tile borders would otherwise show seams) and streamed to disk band by band.
+constexpr qint64 kSinglePassPixels = 4096LL * 4096;
+constexpr int kExportTile = 1024;
+constexpr int kExportTileOverlap = 64;
+
+// Offscreen render via QQuickRenderControl + QRhi. grabWindow() on a hidden window returns
+// blank with the threaded render loop; the render control drives rendering synchronously on
+// this thread into a texture that is read back. One instance renders any number of frames
+// (tiles) of the same scene.
+class OffscreenRenderer
+{
+public:
+    OffscreenRenderer(SceneController* ctrl, const QColor& clearColor, QQuickView* liveView)
+        : m_window(&m_renderControl)
+    {
+        m_window.setColor(clearColor);
+#if QT_CONFIG(vulkan) && __has_include(<vulkan/vulkan.h>)
+        // Vulkan needs a QVulkanInstance; reuse the live view's so we don't create a second.
+        if (QQuickWindow::graphicsApi() == QSGRendererInterface::Vulkan && liveView
+            && liveView->vulkanInstance())
+            m_window.setVulkanInstance(liveView->vulkanInstance());
+#else
+        Q_UNUSED(liveView);
+#endif
+        m_engine.rootContext()->setContextProperty(QStringLiteral("controller"), ctrl);
+    }
+
+    ~OffscreenRenderer()
+    {
+        delete m_root;   // release the QML scene before engine/ctrl go away
+        m_rt.reset();
+        m_rp.reset();
+        m_ds.reset();
+        m_tex.reset();
+        m_renderControl.invalidate();
+    }
+
+    bool initialize()
+    {
+        QQmlComponent component(&m_engine, QUrl(QStringLiteral("qrc:/qml/src/qml/viewer3d.qml")));
+        if (component.isError()) {
+            for (const QQmlError& e : component.errors())
+                qWarning() << "exportImage qml:" << e.toString();
+            return false;
+        }
+        m_root = component.create(m_engine.rootContext());
+        m_rootItem = qobject_cast<QQuickItem*>(m_root);
+        if (!m_rootItem)
+            return false;
+        m_rootItem->setParentItem(m_window.contentItem());
+        if (!m_renderControl.initialize()) {
+            qWarning() << "exportImage: QQuickRenderControl::initialize() failed";
+            return false;
+        }
+        return m_renderControl.rhi() != nullptr;
+    }
+
+    int maxTextureSize() const { return m_renderControl.rhi()->resourceLimit(QRhi::TextureSizeMax); }
+
+    /// (Re)create the colour + depth render target at @p size.
+    bool setTargetSize(const QSize& size)
+    {
+        QRhi* rhi = m_renderControl.rhi();
+        m_rt.reset();
+        m_rp.reset();
+        m_tex.reset(rhi->newTexture(QRhiTexture::RGBA8, size, 1,
+            QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+        m_ds.reset(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, size, 1));
+        if (!m_tex->create() || !m_ds->create())
+            return false;
+        QRhiTextureRenderTargetDescription rtDesc(QRhiColorAttachment(m_tex.data()));
+        rtDesc.setDepthStencilBuffer(m_ds.data());
+        m_rt.reset(rhi->newTextureRenderTarget(rtDesc));
+        m_rp.reset(m_rt->newCompatibleRenderPassDescriptor());
+        m_rt->setRenderPassDescriptor(m_rp.data());
+        if (!m_rt->create())
+            return false;
+        m_rootItem->setSize(QSizeF(size));
+        m_window.setGeometry(0, 0, size.width(), size.height());
+        m_window.setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(m_rt.data()));
+        return true;
+    }
+
+    /// One frame of the current scene state; premultiplied RGBA, top row first.
+    QImage render()
+    {
+        m_renderControl.polishItems();
+        m_renderControl.beginFrame();
+        m_renderControl.sync();
+        m_renderControl.render();
+
+        QImage result;
+        QRhiReadbackResult readback;
+        readback.completed = [&result, &readback]() {
+            const QImage img(reinterpret_cast<const uchar*>(readback.data.constData()),
+                readback.pixelSize.width(), readback.pixelSize.height(),
+                QImage::Format_RGBA8888_Premultiplied);
+            result = img.copy();  // deep copy: readback.data is freed after the callback
+        };
+        QRhiResourceUpdateBatch* batch = m_renderControl.rhi()->nextResourceUpdateBatch();
+        batch->readBackTexture(QRhiReadbackDescription(m_tex.data()), &readback);
+        m_renderControl.commandBuffer()->resourceUpdate(batch);
+        m_renderControl.endFrame();  // submits + runs the readback callback
+
+        if (m_renderControl.rhi()->isYUpInFramebuffer()) {  // OpenGL is bottom-up
+            // Claude Generated 2026 - QImage::flipped() is Qt 6.9+; CI pins 6.8.2, so
+            // fall back to the (now-deprecated) mirrored() there. mirrored(false, true)
+            // == flipped(Qt::Vertical).
+#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
+            result = result.flipped(Qt::Vertical);
+#else
+            result = result.mirrored(false, true);
+#endif
+        }
+        return result;
+    }
+
+private:
+    QQuickRenderControl m_renderControl;
+    QQuickWindow m_window;
+    QQmlEngine m_engine;
+    QObject* m_root = nullptr;
+    QQuickItem* m_rootItem = nullptr;
+    QScopedPointer<QRhiTexture> m_tex;
+    QScopedPointer<QRhiRenderBuffer> m_ds;
+    QScopedPointer<QRhiTextureRenderTarget> m_rt;
+    QScopedPointer<QRhiRenderPassDescriptor> m_rp;
+};
+
+// Claude Generated 2026 - embed reproducibility/authorship as PNG text chunks (QImage::setText
+// for single-pass exports, iTXt chunks from StreamingImageWriter for tiled ones).
+QVector<QPair<QString, QString>> imageTextPairs(const ImageMetadata& metadata)
+{
+    QVector<QPair<QString, QString>> text;
+    if (!metadata.embed)
+        return text;
+    auto set = [&text](const QString& key, const QString& value) { text.append({ key, value }); };
+    auto quat = metadata.cameraRotation;
+    set(QStringLiteral("Software"), QStringLiteral("Quranuma %1").arg(metadata.qurcumaVersion));
+    set(QStringLiteral("ExportTimestamp"), metadata.exportTimestamp);
+    set(QStringLiteral("ImageWidth"), QString::number(metadata.width));
+    set(QStringLiteral("ImageHeight"), QString::number(metadata.height));
+
+    for (int i = 0; i < metadata.sourceFiles.size(); ++i) {
+        const QString key = (i == 0) ? QStringLiteral("SourceFile")
+                                      : QStringLiteral("SourceFile%1").arg(i + 1);
+        set(key, metadata.sourceFiles[i]);
+    }
+
+    set(QStringLiteral("CameraRotation"),
+        QStringLiteral("%1,%2,%3,%4").arg(quat.scalar()).arg(quat.x()).arg(quat.y()).arg(quat.z()));
+    set(QStringLiteral("CameraDistance"), QString::number(metadata.cameraDistance));
+    set(QStringLiteral("CameraPan"),
+        QStringLiteral("%1,%2,%3").arg(metadata.cameraPan.x()).arg(metadata.cameraPan.y()).arg(metadata.cameraPan.z()));
+    set(QStringLiteral("ZoomMode"),
+        metadata.zoomMode == ZoomMode::Relative ? QStringLiteral("Relative")
+                                                : QStringLiteral("Absolute"));
+    set(QStringLiteral("ZoomFactor"), QString::number(metadata.zoomFactor));
+
+    set(QStringLiteral("RenderingMode"), QString::number(metadata.renderingMode));
+    set(QStringLiteral("ColorScheme"), QString::number(metadata.colorScheme));
+    set(QStringLiteral("AtomScale"), QString::number(metadata.atomScaleFactor));
+    set(QStringLiteral("BondThickness"), QString::number(metadata.bondThickness));
+    set(QStringLiteral("AtomTransparency"), QString::number(metadata.atomTransparency));
+    set(QStringLiteral("BackgroundColor"),
+        QStringLiteral("%1,%2,%3,%4")
+            .arg(metadata.backgroundColor.red()).arg(metadata.backgroundColor.green())
+            .arg(metadata.backgroundColor.blue()).arg(metadata.backgroundColor.alpha()));
+    if (!metadata.effects.isEmpty())
+        set(QStringLiteral("Effects"), metadata.effects);
+
+    if (!metadata.authorName.isEmpty())
+        set(QStringLiteral("Author"), metadata.authorName);
+    if (!metadata.authorOrcid.isEmpty())
+        set(QStringLiteral("AuthorORCID"), metadata.authorOrcid);
+    if (!metadata.authorInstitution.isEmpty())
+        set(QStringLiteral("AuthorInstitution"), metadata.authorInstitution);
+    if (!metadata.license.isEmpty())
+        set(QStringLiteral("License"), metadata.license);
+
+    if (!metadata.viewPresetName.isEmpty())
+        set(QStringLiteral("ViewPreset"), metadata.viewPresetName);
+    return text;
+}
+} // namespace
+
 bool MoleculeViewer::exportImage(const QString& path, int width, int height, int background,
     bool ssaa, const ImageMetadata& metadata)
 {
@@ -2160,6 +2770,7 @@ bool MoleculeViewer::exportImage(const QString& path, int width, int height, int
     SceneController ctrl;
     ctrl.cloneStateFrom(m_scene);
     ctrl.setHighQualityAA(ssaa);
+    ctrl.setViewportSize(width, height);   // frustum culling must use the export's aspect
     const bool transparent = (background == 2);
     if (background == 1) {
         ctrl.setTransparentBackground(false);
@@ -2168,155 +2779,70 @@ bool MoleculeViewer::exportImage(const QString& path, int width, int height, int
         ctrl.setTransparentBackground(transparent);
     }
 
-    // Offscreen render via QQuickRenderControl + QRhi. grabWindow() on a hidden window
-    // returns blank with the threaded render loop; the render control drives rendering
-    // synchronously on this thread into a texture we read back.
-    QQuickRenderControl renderControl;
-    QQuickWindow quickWindow(&renderControl);
-    quickWindow.setColor(transparent ? QColor(Qt::transparent) : ctrl.backgroundColor());
-#if QT_CONFIG(vulkan) && __has_include(<vulkan/vulkan.h>)
-    // Vulkan needs a QVulkanInstance; reuse the live view's so we don't create a second.
-    if (QQuickWindow::graphicsApi() == QSGRendererInterface::Vulkan && m_quickView
-        && m_quickView->vulkanInstance())
-        quickWindow.setVulkanInstance(m_quickView->vulkanInstance());
-#endif
-
-    QQmlEngine engine;
-    engine.rootContext()->setContextProperty(QStringLiteral("controller"), &ctrl);
-    QQmlComponent component(&engine, QUrl(QStringLiteral("qrc:/qml/src/qml/viewer3d.qml")));
-    if (component.isError()) {
-        for (const QQmlError& e : component.errors())
-            qWarning() << "exportImage qml:" << e.toString();
+    OffscreenRenderer renderer(&ctrl, transparent ? QColor(Qt::transparent) : ctrl.backgroundColor(),
+        m_quickView);
+    if (!renderer.initialize())
         return false;
-    }
-    QObject* rootObj = component.create(engine.rootContext());
-    auto* rootItem = qobject_cast<QQuickItem*>(rootObj);
-    if (!rootItem) {
-        delete rootObj;
-        return false;
-    }
-    rootItem->setParentItem(quickWindow.contentItem());
-    rootItem->setSize(QSizeF(width, height));
-    quickWindow.setGeometry(0, 0, width, height);
 
-    if (!renderControl.initialize()) {
-        qWarning() << "exportImage: QQuickRenderControl::initialize() failed";
-        delete rootObj;
-        return false;
-    }
-    QRhi* rhi = renderControl.rhi();
-    if (!rhi) {
-        delete rootObj;
-        return false;
+    const QSize imageSize(width, height);
+    const int maxTexture = renderer.maxTextureSize();
+    StreamingImageWriter::Format format;
+    const bool streamable = StreamingImageWriter::formatForPath(path, &format);
+    const bool tiled = streamable
+        && (format == StreamingImageWriter::Format::Tiff || width > maxTexture || height > maxTexture
+            || qint64(width) * height > kSinglePassPixels);
+
+    if (tiled) {
+        // SSAA renders internally at twice the target size; keep that within the limit too.
+        const int overlap = kExportTileOverlap;
+        const int tile = qMin(kExportTile, maxTexture / (ssaa ? 2 : 1) - 2 * overlap);
+        if (tile < 64 || !renderer.setTargetSize(QSize(tile + 2 * overlap, tile + 2 * overlap)))
+            return false;
+        StreamingImageWriter writer;
+        if (!writer.open(path, width, height, transparent, imageTextPairs(metadata))) {
+            qWarning() << "exportImage:" << writer.errorString();
+            return false;
+        }
+        for (int y0 = 0; y0 < height; y0 += tile) {
+            const int bandHeight = qMin(tile, height - y0);
+            QImage band(width, bandHeight, QImage::Format_RGBA8888_Premultiplied);
+            for (int x0 = 0; x0 < width; x0 += tile) {
+                const int w = qMin(tile, width - x0);
+                ctrl.setExportTile(imageSize,
+                    QRect(x0 - overlap, y0 - overlap, tile + 2 * overlap, tile + 2 * overlap));
+                const QImage frame = renderer.render();
+                if (frame.isNull()) {
+                    writer.close();
+                    return false;
+                }
+                for (int y = 0; y < bandHeight; ++y)
+                    std::memcpy(band.scanLine(y) + x0 * 4, frame.constScanLine(overlap + y) + overlap * 4,
+                        size_t(w) * 4);
+            }
+            if (!writer.writeRows(band))
+                break;
+        }
+        if (!writer.close()) {
+            qWarning() << "exportImage:" << writer.errorString();
+            return false;
+        }
+        return true;
     }
 
-    const QSize pixelSize(width, height);
-    QScopedPointer<QRhiTexture> tex(rhi->newTexture(QRhiTexture::RGBA8, pixelSize, 1,
-        QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
-    QScopedPointer<QRhiRenderBuffer> ds(
-        rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, pixelSize, 1));
-    if (!tex->create() || !ds->create()) {
-        delete rootObj;
+    if (width > maxTexture || height > maxTexture) {
+        qWarning() << "exportImage:" << imageSize << "exceeds the GPU texture limit" << maxTexture
+                   << "- export as PNG or TIFF for tiled rendering";
         return false;
     }
-    QRhiTextureRenderTargetDescription rtDesc(QRhiColorAttachment(tex.data()));
-    rtDesc.setDepthStencilBuffer(ds.data());
-    QScopedPointer<QRhiTextureRenderTarget> rt(rhi->newTextureRenderTarget(rtDesc));
-    QScopedPointer<QRhiRenderPassDescriptor> rp(rt->newCompatibleRenderPassDescriptor());
-    rt->setRenderPassDescriptor(rp.data());
-    if (!rt->create()) {
-        delete rootObj;
+    if (!renderer.setTargetSize(imageSize))
         return false;
-    }
-
-    quickWindow.setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(rt.data()));
-
-    renderControl.polishItems();
-    renderControl.beginFrame();
-    renderControl.sync();
-    renderControl.render();
-
-    QImage result;
-    QRhiReadbackResult readback;
-    readback.completed = [&result, &readback]() {
-        const QImage img(reinterpret_cast<const uchar*>(readback.data.constData()),
-            readback.pixelSize.width(), readback.pixelSize.height(),
-            QImage::Format_RGBA8888_Premultiplied);
-        result = img.copy();  // deep copy: readback.data is freed after the callback
-    };
-    QRhiResourceUpdateBatch* batch = rhi->nextResourceUpdateBatch();
-    batch->readBackTexture(QRhiReadbackDescription(tex.data()), &readback);
-    renderControl.commandBuffer()->resourceUpdate(batch);
-    renderControl.endFrame();  // submits + runs the readback callback
-
-    if (rhi->isYUpInFramebuffer()) {  // OpenGL is bottom-up
-        // Claude Generated 2026 - QImage::flipped() is Qt 6.9+; CI pins 6.8.2, so
-        // fall back to the (now-deprecated) mirrored() there. mirrored(false, true)
-        // == flipped(Qt::Vertical).
-#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
-        result = result.flipped(Qt::Vertical);
-#else
-        result = result.mirrored(false, true);
-#endif
-    }
-
-    delete rootObj;            // release the QML scene before engine/ctrl go away
-    renderControl.invalidate();
-
+    QImage result = renderer.render();
     if (result.isNull())
         return false;
     result = transparent ? result.convertToFormat(QImage::Format_ARGB32)
                          : result.convertToFormat(QImage::Format_RGB888);
-
-    // Claude Generated 2026 - embed reproducibility/authorship as PNG text chunks.
-    if (metadata.embed) {
-        auto quat = metadata.cameraRotation;
-        result.setText(QStringLiteral("Software"),
-                       QStringLiteral("Quranuma %1").arg(metadata.qurcumaVersion));
-        result.setText(QStringLiteral("ExportTimestamp"), metadata.exportTimestamp);
-        result.setText(QStringLiteral("ImageWidth"), QString::number(metadata.width));
-        result.setText(QStringLiteral("ImageHeight"), QString::number(metadata.height));
-
-        for (int i = 0; i < metadata.sourceFiles.size(); ++i) {
-            const QString key = (i == 0) ? QStringLiteral("SourceFile")
-                                          : QStringLiteral("SourceFile%1").arg(i + 1);
-            result.setText(key, metadata.sourceFiles[i]);
-        }
-
-        result.setText(QStringLiteral("CameraRotation"),
-                       QStringLiteral("%1,%2,%3,%4").arg(quat.scalar()).arg(quat.x()).arg(quat.y()).arg(quat.z()));
-        result.setText(QStringLiteral("CameraDistance"), QString::number(metadata.cameraDistance));
-        result.setText(QStringLiteral("CameraPan"),
-                       QStringLiteral("%1,%2,%3").arg(metadata.cameraPan.x()).arg(metadata.cameraPan.y()).arg(metadata.cameraPan.z()));
-        result.setText(QStringLiteral("ZoomMode"),
-                       metadata.zoomMode == ZoomMode::Relative ? QStringLiteral("Relative")
-                                                               : QStringLiteral("Absolute"));
-        result.setText(QStringLiteral("ZoomFactor"), QString::number(metadata.zoomFactor));
-
-        result.setText(QStringLiteral("RenderingMode"), QString::number(metadata.renderingMode));
-        result.setText(QStringLiteral("ColorScheme"), QString::number(metadata.colorScheme));
-        result.setText(QStringLiteral("AtomScale"), QString::number(metadata.atomScaleFactor));
-        result.setText(QStringLiteral("BondThickness"), QString::number(metadata.bondThickness));
-        result.setText(QStringLiteral("AtomTransparency"), QString::number(metadata.atomTransparency));
-        result.setText(QStringLiteral("BackgroundColor"),
-                       QStringLiteral("%1,%2,%3,%4")
-                           .arg(metadata.backgroundColor.red()).arg(metadata.backgroundColor.green())
-                           .arg(metadata.backgroundColor.blue()).arg(metadata.backgroundColor.alpha()));
-        if (!metadata.effects.isEmpty())
-            result.setText(QStringLiteral("Effects"), metadata.effects);
-
-        if (!metadata.authorName.isEmpty())
-            result.setText(QStringLiteral("Author"), metadata.authorName);
-        if (!metadata.authorOrcid.isEmpty())
-            result.setText(QStringLiteral("AuthorORCID"), metadata.authorOrcid);
-        if (!metadata.authorInstitution.isEmpty())
-            result.setText(QStringLiteral("AuthorInstitution"), metadata.authorInstitution);
-        if (!metadata.license.isEmpty())
-            result.setText(QStringLiteral("License"), metadata.license);
-
-        if (!metadata.viewPresetName.isEmpty())
-            result.setText(QStringLiteral("ViewPreset"), metadata.viewPresetName);
-    }
+    for (const auto& [key, value] : imageTextPairs(metadata))
+        result.setText(key, value);
 
     return result.save(path);
 }
@@ -2330,11 +2856,12 @@ void MoleculeViewer::exportImageDialog(const QString& startDir, Settings* settin
     // Default to 2x the current viewport size (true hi-res, keeps the on-screen aspect).
     const QSize cur = m_container ? m_container->size() : QSize(1280, 960);
     auto* wSpin = new QSpinBox(&dlg);
-    wSpin->setRange(64, 16384);
+    // Claude Generated 2026 - beyond the GPU texture limit PNG/TIFF are rendered in tiles.
+    wSpin->setRange(64, 65535);
     wSpin->setValue(qMax(64, cur.width() * 2));
     wSpin->setSuffix(tr(" px"));
     auto* hSpin = new QSpinBox(&dlg);
-    hSpin->setRange(64, 16384);
+    hSpin->setRange(64, 65535);
     hSpin->setValue(qMax(64, cur.height() * 2));
     hSpin->setSuffix(tr(" px"));
     form->addRow(tr("Width:"), wSpin);
@@ -2424,9 +2951,10 @@ void MoleculeViewer::exportImageDialog(const QString& startDir, Settings* settin
         meta.viewPresetName = presetName;
     }
 
-    const QString filter = (bg == 2)
-        ? tr("PNG Image (*.png)")  // alpha needs PNG
-        : tr("PNG Image (*.png);;JPEG Image (*.jpg *.jpeg)");
+    // Alpha needs PNG/TIFF; JPEG is rendered in a single pass, so only for moderate sizes.
+    QString filter = tr("PNG Image (*.png);;TIFF Image (*.tif *.tiff)");
+    if (bg != 2 && qint64(wSpin->value()) * hSpin->value() <= kSinglePassPixels)
+        filter += tr(";;JPEG Image (*.jpg *.jpeg)");
     // Default to the current workspace directory (suggest a file name there).
     const QString defaultPath = startDir.isEmpty()
         ? QString()
@@ -2450,6 +2978,200 @@ void MoleculeViewer::exportImageDialog(const QString& startDir, Settings* settin
             tr("Failed to export the image (the offscreen render returned no content)."));
 }
 
+bool MoleculeViewer::exportVideo(const VideoEncoder::Options& options, int width, int height,
+    int background, bool ssaa, int firstFrame, int lastFrame, int stride,
+    const std::function<bool(int, int)>& progress, QString* error)
+{
+    auto failed = [error](const QString& message) {
+        if (error)
+            *error = message;
+        return false;
+    };
+    if (!m_scene || width < 1 || height < 1 || stride < 1)
+        return failed(tr("Nothing to export"));
+    firstFrame = qBound(0, firstFrame, m_frameCount - 1);
+    lastFrame = qBound(firstFrame, lastFrame, m_frameCount - 1);
+
+    // Same offscreen setup as exportImage(): a cloned controller, so the live view keeps
+    // its own scene graph. Only positions change per frame (the animation fast path).
+    SceneController ctrl;
+    ctrl.cloneStateFrom(m_scene);
+    ctrl.setHighQualityAA(ssaa);
+    ctrl.setViewportSize(width, height);
+    const bool transparent = (background == 2 && options.output == VideoEncoder::Output::PngSequence);
+    if (background == 1) {
+        ctrl.setTransparentBackground(false);
+        ctrl.setBackgroundColor(Qt::white);
+    } else {
+        ctrl.setTransparentBackground(transparent);
+    }
+
+    OffscreenRenderer renderer(&ctrl, transparent ? QColor(Qt::transparent) : ctrl.backgroundColor(),
+        m_quickView);
+    if (!renderer.initialize())
+        return failed(tr("The offscreen renderer could not be initialised"));
+    const int maxTexture = renderer.maxTextureSize();
+    if (width > maxTexture || height > maxTexture)
+        return failed(tr("%1 x %2 exceeds the GPU texture limit (%3)").arg(width).arg(height).arg(maxTexture));
+    if (!renderer.setTargetSize(QSize(width, height)))
+        return failed(tr("The offscreen render target could not be created"));
+
+    VideoEncoder encoder;
+    if (!encoder.open(options, QSize(width, height), transparent))
+        return failed(encoder.lastError());
+
+    // QQuickRenderControl completes each offscreen frame (and its readback) in endFrame(),
+    // so the overlap is render + readback of frame N here vs. encoding of the frames before
+    // it on the encoder's workers.
+    const int restoreFrame = m_currentFrame;
+    const int total = (lastFrame - firstFrame) / stride + 1;
+    int done = 0;
+    bool cancelled = false;
+    for (int frame = firstFrame; frame <= lastFrame; frame += stride) {
+        updateFramePositions(frame);
+        ctrl.updatePositions(framePositions(frame));
+        const QImage image = renderer.render();
+        if (image.isNull() || !encoder.submit(image))
+            break;
+        ++done;
+        if (progress && !progress(done, total)) {
+            cancelled = true;
+            break;
+        }
+    }
+    updateFramePositions(restoreFrame);
+
+    if (cancelled) {
+        encoder.abort();
+        return failed(tr("Export cancelled"));
+    }
+    if (!encoder.close())
+        return failed(encoder.lastError());
+    if (done < total)
+        return failed(tr("Rendering stopped after %1 of %2 frames").arg(done).arg(total));
+    return true;
+}
+
+void MoleculeViewer::exportVideoDialog(const QString& startDir)
+{
+    if (m_frameCount <= 1) {
+        QMessageBox::information(this, tr("Export Video"), tr("Load a trajectory with more than one frame first."));
+        return;
+    }
+    QDialog dlg(this);
+    dlg.setWindowTitle(tr("Export Video"));
+    auto* form = new QFormLayout(&dlg);
+
+    // Default to the current viewport size, rounded to even pixels (4:2:0 video).
+    const QSize cur = m_container ? m_container->size() : QSize(1280, 720);
+    auto* wSpin = new QSpinBox(&dlg);
+    wSpin->setRange(64, 8192);
+    wSpin->setSingleStep(2);
+    wSpin->setValue(qMax(64, cur.width() & ~1));
+    wSpin->setSuffix(tr(" px"));
+    auto* hSpin = new QSpinBox(&dlg);
+    hSpin->setRange(64, 8192);
+    hSpin->setSingleStep(2);
+    hSpin->setValue(qMax(64, cur.height() & ~1));
+    hSpin->setSuffix(tr(" px"));
+    form->addRow(tr("Width:"), wSpin);
+    form->addRow(tr("Height:"), hSpin);
+
+    auto* firstSpin = new QSpinBox(&dlg);
+    firstSpin->setRange(1, m_frameCount);
+    firstSpin->setValue(1);
+    auto* lastSpin = new QSpinBox(&dlg);
+    lastSpin->setRange(1, m_frameCount);
+    lastSpin->setValue(m_frameCount);
+    auto* strideSpin = new QSpinBox(&dlg);
+    strideSpin->setRange(1, qMax(1, m_frameCount - 1));
+    strideSpin->setValue(1);
+    auto* fpsSpin = new QSpinBox(&dlg);
+    fpsSpin->setRange(1, 120);
+    fpsSpin->setValue(30);
+    fpsSpin->setSuffix(tr(" fps"));
+    form->addRow(tr("First frame:"), firstSpin);
+    form->addRow(tr("Last frame:"), lastSpin);
+    form->addRow(tr("Every n-th frame:"), strideSpin);
+    form->addRow(tr("Frame rate:"), fpsSpin);
+
+    const QString ffmpeg = VideoEncoder::findFfmpeg();
+    auto* outputCombo = new QComboBox(&dlg);
+    if (!ffmpeg.isEmpty()) {
+        outputCombo->addItem(tr("MP4 video (H.264, ffmpeg)"), QStringLiteral("mp4"));
+        outputCombo->addItem(tr("WebM video (VP9, ffmpeg)"), QStringLiteral("webm"));
+    }
+    outputCombo->addItem(tr("PNG image sequence"), QStringLiteral("png"));
+    outputCombo->setToolTip(ffmpeg.isEmpty() ? tr("Install ffmpeg (on PATH) to encode video files directly.")
+                                             : tr("Using %1").arg(ffmpeg));
+    form->addRow(tr("Output:"), outputCombo);
+
+    auto* bgCombo = new QComboBox(&dlg);
+    bgCombo->addItem(tr("Scene background"), 0);
+    bgCombo->addItem(tr("White"), 1);
+    bgCombo->addItem(tr("Transparent (PNG sequence)"), 2);
+    form->addRow(tr("Background:"), bgCombo);
+
+    auto* ssaaCheck = new QCheckBox(tr("High-quality antialiasing (SSAA, slower)"), &dlg);
+    form->addRow(QString(), ssaaCheck);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Save | QDialogButtonBox::Cancel, &dlg);
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    if (dlg.exec() != QDialog::Accepted)
+        return;
+
+    const QString suffix = outputCombo->currentData().toString();
+    const QString filter = suffix == QLatin1String("mp4") ? tr("MP4 Video (*.mp4)")
+        : suffix == QLatin1String("webm")                 ? tr("WebM Video (*.webm)")
+                                                          : tr("PNG Image Sequence (*.png)");
+    const QString defaultPath = QDir(startDir.isEmpty() ? QDir::currentPath() : startDir)
+                                    .filePath(QStringLiteral("trajectory.") + suffix);
+    QString path = QFileDialog::getSaveFileName(this, tr("Export Video"), defaultPath, filter);
+    if (path.isEmpty())
+        return;
+    if (QFileInfo(path).suffix().isEmpty())
+        path += QLatin1Char('.') + suffix;
+
+    VideoEncoder::Options options;
+    options.path = path;
+    options.output = suffix == QLatin1String("png") ? VideoEncoder::Output::PngSequence
+                                                    : VideoEncoder::Output::Ffmpeg;
+    options.fps = fpsSpin->value();
+    options.ffmpegPath = ffmpeg;
+
+    const int first = firstSpin->value() - 1;
+    const int last = qMax(first, lastSpin->value() - 1);
+    const int stride = strideSpin->value();
+    QProgressDialog progressDialog(tr("Rendering frames..."), tr("Cancel"), 0, (last - first) / stride + 1, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    const bool ok = exportVideo(options, wSpin->value() & ~1, hSpin->value() & ~1, bgCombo->currentData().toInt(),
+        ssaaCheck->isChecked(), first, last, stride,
+        [&progressDialog](int done, int total) {
+            progressDialog.setLabelText(tr("Rendering frame %1 of %2...").arg(done).arg(total));
+            progressDialog.setValue(done);   // modal: also processes events
+            return !progressDialog.wasCanceled();
+        },
+        &error);
+    const bool cancelled = progressDialog.wasCanceled();
+    progressDialog.hide();
+    if (ok) {
+        const QString where = options.output == VideoEncoder::Output::PngSequence
+            ? VideoEncoder::sequenceFileName(path, 0) + QStringLiteral(" ...")
+            : path;
+        QMessageBox::information(this, tr("Export Video"),
+            tr("Saved %1 frames in %2 s to:\n%3").arg((last - first) / stride + 1)
+                .arg(timer.elapsed() / 1000.0, 0, 'f', 1).arg(where));
+    } else if (!cancelled) {
+        QMessageBox::warning(this, tr("Export Video"), tr("Video export failed: %1").arg(error));
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Animation
 // ---------------------------------------------------------------------------
@@ -2506,6 +3228,10 @@ void MoleculeViewer::onAnimationTick()
 // ---------------------------------------------------------------------------
 void MoleculeViewer::onStructureChanged()
 {
+    // Streamed / stored trajectories: keep an edited frame resident instead of re-decoding
+    // it (stored frames are written back to the store when the user moves on).
+    if (m_trajectoryReader || m_trajectoryStore)
+        m_pinnedFrames.insert(m_currentFrame);
     if (m_autoSaveEnabled && !m_currentFilePath.isEmpty()) {
         m_hasUnsavedChanges = true;
         m_autoSaveTimer->stop();
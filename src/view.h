@@ -15,9 +15,16 @@
 #include <QQuaternion>
 #include <QVector3D>
 #include <QVector>
+#include <QSet>
 #include "simulationframe.h"  // Claude Generated - Zero-copy simulation payload
+#include "simulationframering.h"  // Claude Generated 2026 - uncapped MD frame exchange
 #include "viewpreset.h"  // Claude Generated 2026 - reproducible camera/display presets
 #include "imagemetadata.h"  // Claude Generated 2026 - export image provenance
+#include "neighborgrid.h"  // Claude Generated 2026 - cell-list bond perception
+#include "positionspan.h"  // Claude Generated 2026 - zero-copy frame coordinate access
+#include "videoencoder.h"  // Claude Generated 2026 - trajectory movie export
+
+#include <functional>
 
 class SelectionManager;  // Forward declaration
 class MeasurementOverlay;  // Claude Generated - Phase 2B (Quick3D port pending, M2)
@@ -25,6 +32,10 @@ class BondEditor;  // Claude Generated - Phase 4B - Forward declaration
 class PerformanceOptimizer;  // Claude Generated - LOD wire-up
 class SceneController;  // Claude Generated 2026 - Qt Quick 3D scene view-model
 class Settings;  // Claude Generated 2026 - operator metadata + view presets for export
+class XYZTrajectoryReader;  // Claude Generated 2026 - streamed, frame-indexed trajectories
+class TrajectoryStore;      // Claude Generated 2026 - compact (SoA) in-memory trajectories
+class ClashDetector;        // Claude Generated 2026 - grid-backed clash checks (editing)
+struct TrajectoryFrameSource;  // Claude Generated 2026 - thread-safe frame access (analysis)
 class QQuickView;
 
 class MoleculeViewer : public QWidget
@@ -58,6 +69,7 @@ public:
         QVector3D position;
         QString element;
         float charge = 0.0f;  // Claude Generated - for charge-based coloring
+        quint8 atomicNumber = 0;  // Claude Generated 2026 - elem::atomicNumber(element), 0 = unknown
     };
 
     struct Bond {
@@ -188,9 +200,57 @@ public:
     void setCurrentFrame(int frameIndex) { m_currentFrame = frameIndex; }
     int getCurrentFrame() const { return m_currentFrame; }
 
-    // Trajectory data (XYZ, VTF, etc.) — call with multiple frames
+    // Trajectory data (XYZ, VTF, etc.) — call with multiple frames. Multi-frame data with a
+    // single topology is packed into a TrajectoryStore (elements/charges once, one position
+    // block per frame); only the displayed and edited frames are expanded to Atom vectors.
     void setTrajectoryData(const QVector<QVector<Atom>>& atoms, const QVector<QVector<Bond>>& bonds);
 
+    /**
+     * @brief Coordinates of @p frameIndex without materialising Atom records: a span into
+     * the TrajectoryStore block (or the resident frame). Valid until the next call that
+     * changes frames. Empty for frames of a streamed trajectory that are not resident.
+     * Claude Generated 2026.
+     */
+    PositionSpan framePositions(int frameIndex) const;
+
+    /**
+     * @brief Show a streamed trajectory: frames are decoded on demand by @p reader
+     * (frame slider / animation) instead of being held in memory. Only the displayed
+     * frame plus edited (pinned) frames stay resident in the viewer; the reader's LRU
+     * cache bounds everything else. Bonds are perceived per frame when it is loaded.
+     * Claude Generated 2026.
+     */
+    void setTrajectoryReader(QSharedPointer<XYZTrajectoryReader> reader);
+    bool isStreamedTrajectory() const { return !m_trajectoryReader.isNull(); }
+
+    /**
+     * @brief Show an already packed trajectory, e.g. a memory-mapped session recording
+     * (SessionRecording::trajectoryStore). Frames are expanded only when displayed or
+     * edited; bonds are perceived per frame. Claude Generated 2026.
+     * @param bonds Optional per-frame bonds known in advance (StructureCache); frames left
+     *        empty are perceived when displayed. @p explicitBonds keeps them for good
+     *        (file topology), otherwise they are dropped with the frame like perceived ones.
+     */
+    void setTrajectoryStore(QSharedPointer<TrajectoryStore> store,
+        const QVector<QVector<Bond>>& bonds = {}, bool explicitBonds = false);
+
+    /**
+     * @brief Every frame's coordinates for analyses running off the GUI thread: each worker
+     * opens its own reader over the TrajectoryStore, the streamed file (separate
+     * XYZTrajectoryReader) or the resident frames. Unedited frame data only; invalid for
+     * fewer than two frames. Claude Generated 2026.
+     */
+    TrajectoryFrameSource trajectoryFrameSource() const;
+
+    /// Shift one frame so that its mass-weighted centre sits at the origin (what
+    /// centerAtOrigin() does to every frame); thread-safe. Claude Generated 2026.
+    static void centerFrameAtOrigin(QVector<Atom>& frame);
+
+    /// Frame-time HUD: per-stage p50/p95/p99 (Profiler statistics) over the 3D view.
+    /// Claude Generated 2026.
+    void setProfilerHudVisible(bool visible);
+    bool isProfilerHudVisible() const;
+
 public slots:
     void resetView();
     void resetViewToMolecule();  // Reset to molecule center (fallback to default if none loaded)
@@ -208,10 +268,20 @@ public slots:
     /// High-quality image export: render the scene offscreen at an arbitrary resolution
     /// (true supersampling, not upscaling) and save it. @p background: 0 = scene colour,
     /// 1 = white, 2 = transparent (alpha PNG). @p metadata is written as PNG text chunks.
+    /// Large PNG and all TIFF exports are rendered as overlapping tiles and streamed to disk,
+    /// so the size is not bounded by the GPU texture limit or by memory.
     /// Claude Generated 2026.
     bool exportImage(const QString& path, int width, int height, int background, bool ssaa,
                      const ImageMetadata& metadata);
     void exportImageDialog(const QString& startDir = QString(), Settings* settings = nullptr);
+    /// Render frames @p firstFrame..@p lastFrame (every @p stride-th) offscreen at
+    /// @p width x @p height and encode them on worker threads, as a PNG sequence or through a
+    /// local ffmpeg (VideoEncoder). @p progress(done, total) returning false cancels.
+    /// Claude Generated 2026.
+    bool exportVideo(const VideoEncoder::Options& options, int width, int height, int background,
+                     bool ssaa, int firstFrame, int lastFrame, int stride,
+                     const std::function<bool(int, int)>& progress = {}, QString* error = nullptr);
+    void exportVideoDialog(const QString& startDir = QString());
 
     // Claude Generated - Trajectory animation
     void startAnimation();
@@ -294,6 +364,14 @@ public slots:
      */
     void updateSimulationFrame(SimulationFramePtr frame);
 
+    /** @brief Uncapped MD (Claude Generated 2026): pull the newest frame from @p ring once per
+     *  rendered frame (QQuickWindow::afterAnimating) instead of applying every queued
+     *  frameReady. Each applied frame is re-emitted as simulationFramePresented(). A null
+     *  @p ring detaches. */
+    void setSimulationFrameRing(QSharedPointer<SimulationFrameRing> ring);
+    /** @brief The worker published into an idle ring: schedule a render so it is pulled. */
+    void requestSimulationFrame();
+
     /** @brief Enable/disable per-frame bond re-detection during live MD/Opt (default on).
      *  Claude Generated 2026 - shows bond breaking/formation in reactions. */
     void setDynamicBonds(bool on) { m_dynamicBonds = on; }
@@ -320,11 +398,19 @@ public slots:
 signals:
     void frameChanged(int frameIndex);
     void trajectoryLoaded(int frameCount);
+    // Claude Generated 2026 - emitted right before stored frame coordinates are rewritten
+    // in place (centring, edited frame written back); readers of trajectoryFrameSource() stop.
+    void frameDataAboutToChange();
     void selectionChanged(const QVector<int>& selectedAtoms);
 
     void moleculeUpdated(const QVector<MoleculeViewer::Atom>& atoms,
         const QVector<MoleculeViewer::Bond>& bonds);
 
+    /** @brief Claude Generated 2026 - uncapped MD frame just applied to the scene. Emitted
+     *  synchronously from the render-loop pull; @p frame is only valid during delivery, so
+     *  connect with a direct (same-thread) connection. */
+    void simulationFramePresented(SimulationFramePtr frame);
+
     void atomForceRequested(int atomIndex, QVector3D force, double alpha, int maxShells);
     void atomGrabReleased();
     void grabStatusChanged(QString message);
@@ -403,6 +489,7 @@ private slots:
     void onAutoSaveTimer();  // Claude Generated - Phase 4B - Auto-save XYZ with debouncing
     void onStructureChanged();  // Claude Generated - Phase 4B - Handle bond editor changes
     void onAnimationTick();  // Claude Generated - Timer callback for animation
+    void updateProfilerHud();  // Claude Generated 2026 - Profiler statistics -> HUD text
 
 private:
     void setupViewer();         // Build the QQuickView + SceneController + container
@@ -414,9 +501,15 @@ private:
     void syncSceneToController(int frameIndex, bool resetCamera, bool fullRebuild,
         bool keepView = false);
     void applyAppearanceToController();  // mirror appearance/effect state into the scene
+    void applyLevelOfDetail();  // Claude Generated 2026 - PerformanceOptimizer mode -> SceneController LOD
     void updateFramePositions(int frameIndex);  // fast position-only update (animation)
 
     void clearScene();          // Private implementation
+    void updateFrameControls(); // slider/label/playback visibility after a frame-count change
+    // Streamed / stored trajectories: decode frame @p frameIndex into m_trajectoryAtoms (and its
+    // bonds when @p withBonds) if not resident, and drop the previously resident, unedited frame.
+    bool ensureFrameResident(int frameIndex, bool withBonds = true);
+    void resetFrameSources();   // drop reader/store and residency bookkeeping
     void refreshVisualization();// Refresh without camera reset
 
     // Element data helpers (kept for getCurrentFrame* and bond detection).
@@ -427,6 +520,7 @@ private:
     // Claude Generated 2026 - per-frame bond re-detection with hysteresis (form tighter than break)
     // so thermally vibrating bonds near the cutoff don't flicker on/off every frame.
     QVector<Bond> detectBondsHysteresis(const QVector<Atom>& atoms, const QVector<Bond>& previous);
+    NeighborGrid m_bondGrid;  // persists across live frames; re-binned incrementally
 
     void setDefaultView();
     QVector3D modelToWorld(const QVector3D& localPos) const;
@@ -475,6 +569,14 @@ private:
     int m_currentFrame = 0;
     QVector<QVector<Atom>> m_trajectoryAtoms;
     QVector<QVector<Bond>> m_trajectoryBonds;
+    // Claude Generated 2026 - streamed trajectory state (empty slots = not resident).
+    QSharedPointer<XYZTrajectoryReader> m_trajectoryReader;
+    QSharedPointer<TrajectoryStore> m_trajectoryStore;  // Claude Generated 2026 - packed frames
+    bool m_perceiveBondsOnLoad = false;   // bonds are detected per resident frame, not kept
+    mutable QVector<QVector3D> m_framePositionScratch;  // framePositions() of resident frames
+    QSet<int> m_pinnedFrames;             // edited frames that must not be evicted
+    int m_residentFrame = -1;             // frame currently decoded into m_trajectoryAtoms
+    bool m_centerStreamedFrames = false;  // centerAtOrigin() applies to frames decoded later
 
     // Claude Generated - Visual settings state
     RenderingMode m_renderingMode = RenderingMode::BallAndStick;
@@ -522,10 +624,12 @@ private:
     QVector<Atom> m_clipboardAtoms;       // copy/paste buffer
     QVector<Bond> m_clipboardBonds;       // bonds internal to the clipboard (re-indexed)
     static constexpr float kClashFactor = 0.6f;  // clash if dist < factor * (vdw_i + vdw_j)
+    QSharedPointer<ClashDetector> m_clashDetector; // Claude Generated 2026 - created on first check
     static constexpr float kNudgeStep = 0.1f;    // arrow-key nudge (Angstrom)
     // Helpers
     QVector3D selectionCentroidLocal() const;     // mean position of selected atoms (current frame)
     void computeCollisions();                      // recolour clashes + emit collisionCountChanged
+    void updateCollisionsForMove(const QVector<int>& moved);  // incremental variant (drag)
     void moveSelection(const QVector3D& modelDelta); // translate selected atoms, redraw, recheck
     void finalizeEdit();                           // re-detect bonds + recompute collisions after a move/edit
 
@@ -534,6 +638,7 @@ private:
     BondEditor *m_bondEditor = nullptr;
     int m_bondEditMode = 0;
     PerformanceOptimizer *m_perfOpt = nullptr;
+    QTimer *m_profilerHudTimer = nullptr;  // Claude Generated 2026 - HUD refresh while visible
 
     // Claude Generated - Phase 4B: Auto-save system
     QString m_currentFilePath;
@@ -542,6 +647,8 @@ private:
     bool m_hasUnsavedChanges = false;
 
     bool m_moleculeDirty = false;
+    QSharedPointer<SimulationFrameRing> m_frameRing;  // Claude Generated 2026 - uncapped MD source
+    void pullSimulationFrame();                       // afterAnimating: apply the newest ring frame
     bool m_dynamicBonds = true;  // Claude Generated 2026 - re-detect bonds each live frame (reactions)
 
     // Instancing threshold kept for API compatibility (informational).
@@ -2,8 +2,9 @@
 // Parses VTF (Visualization Toolkit Format) files for molecular visualization
 
 #include "vtfparser.h"
-#include <QTextStream>
-#include <QRegularExpression>
+#include "elementdata.h"
+#include "profiler.h"
+#include "textscanner.h"
 
 bool VTFParser::parseFile(const QString& filePath, VTFFrame& frame)
 {
@@ -22,9 +23,19 @@ bool VTFParser::parseFile(const QString& filePath, VTFFrame& frame)
 
 bool VTFParser::parseTrajectory(const QString& filePath)
 {
+    ProfileScope profile("parse.vtf");
     // Clear previous frames
     m_frames.clear();
-    return parseAsciiFormat(filePath, m_frames);
+    return parseAsciiFormat(filePath, [this](VTFFrame&& frame, qint64, qint64) {
+        m_frames.append(std::move(frame));
+        return true;
+    });
+}
+
+bool VTFParser::parseTrajectory(const QString& filePath, const FrameSink& onFrame)
+{
+    ProfileScope profile("parse.vtf");
+    return parseAsciiFormat(filePath, onFrame);
 }
 
 bool VTFParser::getFrame(int frameIndex, VTFFrame& frame) const
@@ -45,42 +56,55 @@ QString VTFParser::trimQuotes(const QString& str)
     return trimmed;
 }
 
-bool VTFParser::parseAsciiFormat(const QString& filePath, QVector<VTFFrame>& frames)
+QByteArrayView VTFParser::trimQuotes(QByteArrayView str)
+{
+    QByteArrayView trimmed = TextScanner::trimmed(str);
+    if (trimmed.size() >= 2 && trimmed.startsWith('"') && trimmed.endsWith('"')) {
+        return trimmed.sliced(1, trimmed.size() - 2);
+    }
+    return trimmed;
+}
+
+bool VTFParser::parseAsciiFormat(const QString& filePath, const FrameSink& onFrame)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    TextScanner scanner;
+    if (!scanner.open(filePath)) {
         qWarning() << "Failed to open VTF file:" << filePath;
         return false;
     }
 
-    QTextStream stream(&file);
-    QString line;
+    QByteArrayView line;
+    QByteArrayView parts[8];
+    SymbolCache symbols;
 
     // Reset state for each parse
     QVector<VTFAtom> atomDefinitions;
     QVector<VTFBond> bonds;
     bool hasUnitCell = false;
     float cellA = 0, cellB = 0, cellC = 0;
+    int frameCount = 0;
+    float scaleFactor = 1.0f;  // decided on the first frame, applied to all of them
 
     qDebug() << "=== VTF PARSER START ===";
     qDebug() << "Starting to parse VTF file:" << filePath;
 
-    while (!stream.atEnd()) {
-        line = stream.readLine().trimmed();
+    while (!scanner.atEnd()) {
+        line = TextScanner::trimmed(scanner.readLine());
 
         if (line.startsWith("atom ")) {
             // Parse atom line: "atom     0 radius   0.20000E+01 type        ppo1 name 1"
-            QStringList parts = line.split(QRegularExpression("\\s+"));
+            const int count = TextScanner::splitFields(line, parts, 8);
 
             // Corrected: the actual structure is: atom, index, radius, radiusValue, type, typeValue, name, nameValue
             // So we need at least 8 parts
-            if (parts.size() >= 8) {
+            if (count >= 8) {
                 VTFAtom atom;
                 bool indexOk = false, radiusOk = false;
-                atom.index = parts[1].toInt(&indexOk);
-                atom.radius = parts[3].toDouble(&radiusOk);  // parts[3] = radius value
-                atom.type = trimQuotes(parts[5]);  // parts[5] = type value
-                atom.name = trimQuotes(parts[7]);   // parts[7] = name value
+                atom.index = TextScanner::toInt(parts[1], 0, &indexOk);
+                atom.radius = TextScanner::toFloat(parts[3], 0.0f, &radiusOk);  // parts[3] = radius value
+                atom.type = symbols.intern(trimQuotes(parts[5]));  // parts[5] = type value
+                const QByteArrayView name = trimQuotes(parts[7]);   // parts[7] = name value, unique per atom
+                atom.name = QString::fromLatin1(name.data(), name.size());
 
                 if (indexOk && radiusOk) {
 
@@ -92,24 +116,25 @@ bool VTFParser::parseAsciiFormat(const QString& filePath, QVector<VTFFrame>& fra
                     } else {
                         atom.element = "C"; // Default to carbon
                     }
+                    atom.atomicNumber = quint8(elem::atomicNumber(atom.element));
 
                     atomDefinitions.append(atom);
                 } else {
                     qWarning() << "Failed to parse atom values - skipping line:" << line;
                 }
             } else {
-                qWarning() << "Invalid atom line - not enough parts:" << parts.size() << "Expected: 8+";
+                qWarning() << "Invalid atom line - not enough parts:" << count << "Expected: 8+";
                 qWarning() << "Line was:" << line;
             }
         }
         else if (line.startsWith("bond ")) {
             // Parse bond line: "bond     0:1"
-            QStringList parts = line.split(":");
-            if (parts.size() == 2) {
+            const qsizetype colon = line.indexOf(':');
+            if (colon > 0 && line.indexOf(':', colon + 1) < 0) {
                 bool atom1Ok = false, atom2Ok = false;
                 VTFBond bond;
-                bond.atom1 = parts[0].mid(5).toInt(&atom1Ok); // Remove "bond " prefix
-                bond.atom2 = parts[1].toInt(&atom2Ok);
+                bond.atom1 = TextScanner::toInt(line.sliced(5, colon - 5), 0, &atom1Ok); // Remove "bond " prefix
+                bond.atom2 = TextScanner::toInt(line.sliced(colon + 1), 0, &atom2Ok);
                 if (atom1Ok && atom2Ok) {
                     bonds.append(bond);
                 } else {
@@ -121,12 +146,11 @@ bool VTFParser::parseAsciiFormat(const QString& filePath, QVector<VTFFrame>& fra
         }
         else if (line.startsWith("unitcell ")) {
             // Parse unit cell: "unitcell    10.00000    10.00000    10.00000"
-            QStringList parts = line.split(QRegularExpression("\\s+"));
-            if (parts.size() >= 4) {
+            if (TextScanner::splitFields(line, parts, 4) >= 4) {
                 bool cellAOk = false, cellBOk = false, cellCOk = false;
-                cellA = parts[1].toFloat(&cellAOk);
-                cellB = parts[2].toFloat(&cellBOk);
-                cellC = parts[3].toFloat(&cellCOk);
+                cellA = TextScanner::toFloat(parts[1], 0.0f, &cellAOk);
+                cellB = TextScanner::toFloat(parts[2], 0.0f, &cellBOk);
+                cellC = TextScanner::toFloat(parts[3], 0.0f, &cellCOk);
                 if (cellAOk && cellBOk && cellCOk) {
                     hasUnitCell = true;
                 } else {
@@ -148,45 +172,33 @@ bool VTFParser::parseAsciiFormat(const QString& filePath, QVector<VTFFrame>& fra
             
             
             // Skip "timestep ordered" line
-            if (!stream.atEnd()) {
-                QString timestepLine = stream.readLine().trimmed();
-            }
+            scanner.skipLines(1);
             
             // Parse coordinates - one line per atom with bounds checking
-            for (int i = 0; i < atomDefinitions.size() && !stream.atEnd(); ++i) {
-                line = stream.readLine().trimmed();
+            for (int i = 0; i < atomDefinitions.size() && !scanner.atEnd(); ++i) {
+                line = scanner.readLine();
                 
-                if (!line.isEmpty() && i < frame.atoms.size()) {
-                    QStringList coords = line.split(QRegularExpression("\\s+"));
-                    if (coords.size() >= 3) {
-                        bool xOk, yOk, zOk;
-                        
-                        // Parse scientific notation properly
-                        frame.atoms[i].x = coords[0].toDouble(&xOk);
-                        frame.atoms[i].y = coords[1].toDouble(&yOk);
-                        frame.atoms[i].z = coords[2].toDouble(&zOk);
-                        
-                        // Debug output for first few atoms to check parsing
-                        // REMOVED: Performance critical debug output in coordinate parsing loop
-                        
-                        // If parsing fails, set to reasonable default
-                        if (!xOk) {
-                            qWarning() << "Failed to parse X coordinate for atom" << i << ":" << coords[0];
-                            frame.atoms[i].x = 0.0f;
-                        }
-                        if (!yOk) {
-                            qWarning() << "Failed to parse Y coordinate for atom" << i << ":" << coords[1];
-                            frame.atoms[i].y = 0.0f;
-                        }
-                        if (!zOk) {
-                            qWarning() << "Failed to parse Z coordinate for atom" << i << ":" << coords[2];
-                            frame.atoms[i].z = 0.0f;
-                        }
-                    } else {
-                        qWarning() << "Invalid coordinate line at atom" << i << ":" << line;
+                if (TextScanner::splitFields(line, parts, 3) >= 3) {
+                    bool xOk, yOk, zOk;
+
+                    // from_chars handles the scientific notation VTF writers use
+                    VTFAtom& atom = frame.atoms[i];
+                    atom.x = TextScanner::toFloat(parts[0], 0.0f, &xOk);
+                    atom.y = TextScanner::toFloat(parts[1], 0.0f, &yOk);
+                    atom.z = TextScanner::toFloat(parts[2], 0.0f, &zOk);
+
+                    // If parsing fails, the coordinate stays at the 0.0 default
+                    if (!xOk) {
+                        qWarning() << "Failed to parse X coordinate for atom" << i << ":" << parts[0];
+                    }
+                    if (!yOk) {
+                        qWarning() << "Failed to parse Y coordinate for atom" << i << ":" << parts[1];
+                    }
+                    if (!zOk) {
+                        qWarning() << "Failed to parse Z coordinate for atom" << i << ":" << parts[2];
                     }
                 } else {
-                    qWarning() << "Out of bounds or empty line at atom" << i << ", frame.atoms.size() =" << frame.atoms.size();
+                    qWarning() << "Invalid coordinate line at atom" << i << ":" << line;
                 }
             }
             
@@ -194,65 +206,56 @@ bool VTFParser::parseAsciiFormat(const QString& filePath, QVector<VTFFrame>& fra
             frame.bonds = bonds;
             
 
-            // Only add frame if we have valid atom data
-            if (!frame.atoms.isEmpty()) {
-                frames.append(frame);
-            } else {
-                qWarning() << "Skipping frame - no atoms found";
+            // Skip "# End Image" line if present; otherwise rewind so the line is
+            // handled by the main loop (QTextStream could not put lines back).
+            if (!scanner.atEnd()) {
+                const qsizetype mark = scanner.pos();
+                if (TextScanner::trimmed(scanner.readLine()) != "# End Image")
+                    scanner.seek(mark);
             }
-            
-            // Skip "# End Image" line if present
-            if (!stream.atEnd()) {
-                line = stream.readLine().trimmed();
-                if (line == "# End Image") {
-                    continue;
-                } else {
-                    // If we didn't find "# End Image", put the line back by moving position back
-                    qDebug() << "Not an End Image line:" << line;
-                    // Note: Can't easily put back line with QTextStream, but that's ok
-                }
-            }
-        }
-    }
-    
-    file.close();
-    
-    qDebug() << "VTF parsing complete. Total frames:" << frames.size();
 
-    // Apply coordinate scaling for large VTF coordinates
-    if (!frames.isEmpty()) {
-        const QVector<VTFAtom>& firstFrameAtoms = frames.first().atoms;
-        if (!firstFrameAtoms.isEmpty()) {
-            // Check if coordinates are unusually large (typical for VTF files)
-            float maxCoord = 0.0f;
-            for (const VTFAtom& atom : firstFrameAtoms) {
-                maxCoord = qMax(maxCoord, qMax(qAbs(atom.x), qMax(qAbs(atom.y), qAbs(atom.z))));
+            // Only add frame if we have valid atom data
+            if (frame.atoms.isEmpty()) {
+                qWarning() << "Skipping frame - no atoms found";
+                continue;
             }
 
-            qDebug() << "Max VTF coordinate detected:" << maxCoord;
-
-            // If coordinates are large (typical VTF scaling issue), apply scaling factor
-            if (maxCoord > 50.0f) {
-                qDebug() << "Detected large VTF coordinates (" << maxCoord << "), applying scaling factor";
-                float scaleFactor = qMin(maxCoord / 50.0f, 200.0f); // Scale to max ~50 units, but not too aggressive
+            // Apply coordinate scaling for large VTF coordinates. The factor comes from
+            // the first frame, so frames can be handed on as soon as they are read.
+            if (frameCount == 0) {
+                // Check if coordinates are unusually large (typical for VTF files)
+                float maxCoord = 0.0f;
+                for (const VTFAtom& atom : frame.atoms) {
+                    maxCoord = qMax(maxCoord, qMax(qAbs(atom.x), qMax(qAbs(atom.y), qAbs(atom.z))));
+                }
 
-                qDebug() << "Applying scale factor:" << scaleFactor;
+                qDebug() << "Max VTF coordinate detected:" << maxCoord;
 
-                for (auto& frame : frames) {
-                    for (auto& atom : frame.atoms) {
-                        atom.x /= scaleFactor;
-                        atom.y /= scaleFactor;
-                        atom.z /= scaleFactor;
-                    }
+                // If coordinates are large (typical VTF scaling issue), apply scaling factor
+                if (maxCoord > 50.0f) {
+                    qDebug() << "Detected large VTF coordinates (" << maxCoord << "), applying scaling factor";
+                    scaleFactor = qMin(maxCoord / 50.0f, 200.0f); // Scale to max ~50 units, but not too aggressive
+                    qDebug() << "Applying scale factor:" << scaleFactor;
+                } else {
+                    qDebug() << "VTF coordinates are within normal range, no scaling applied";
+                }
+            }
+            if (scaleFactor != 1.0f) {
+                for (auto& atom : frame.atoms) {
+                    atom.x /= scaleFactor;
+                    atom.y /= scaleFactor;
+                    atom.z /= scaleFactor;
                 }
-            } else {
-                qDebug() << "VTF coordinates are within normal range, no scaling applied";
             }
+
+            ++frameCount;
+            if (!onFrame(std::move(frame), scanner.pos(), scanner.size()))
+                break;
         }
     }
 
-    qDebug() << "VTF parsing finished successfully. Frames:" << frames.size();
-    return !frames.isEmpty();
+    qDebug() << "VTF parsing finished. Frames:" << frameCount;
+    return frameCount > 0;
 }
 
 void VTFParser::convertToMoleculeViewer(const VTFFrame& vtfFrame, 
@@ -265,6 +268,7 @@ void VTFParser::convertToMoleculeViewer(const VTFFrame& vtfFrame,
     for (const auto& vtfAtom : vtfFrame.atoms) {
         MoleculeViewer::Atom atom;
         atom.element = vtfAtom.element;
+        atom.atomicNumber = vtfAtom.atomicNumber;
         atom.position = QVector3D(vtfAtom.x, vtfAtom.y, vtfAtom.z);
         atoms.append(atom);
     }
@@ -5,11 +5,14 @@
 #pragma once
 
 #include "view.h"
+#include <QByteArrayView>
 #include <QString>
 #include <QVector>
 #include <QFile>
 #include <QDebug>
 
+#include <functional>
+
 class VTFParser
 {
 public:
@@ -20,6 +23,7 @@ public:
         QString type;
         QString name;
         float x, y, z;
+        quint8 atomicNumber = 0;
     };
 
     struct VTFBond {
@@ -42,12 +46,22 @@ public:
     // Parse all frames from VTF file and store internally
     bool parseTrajectory(const QString& filePath);
 
+    // Claude Generated 2026 - Progressive parse (StructureLoader): every complete (already
+    // scaled) frame is handed to @p onFrame together with the bytes scanned so far and the
+    // file size, and is not stored. Returning false from @p onFrame stops the scan. False if
+    // the file cannot be read or holds no frame.
+    using FrameSink = std::function<bool(VTFFrame&& frame, qint64 bytesRead, qint64 totalBytes)>;
+    bool parseTrajectory(const QString& filePath, const FrameSink& onFrame);
+
     // Get frame count
     int getFrameCount() const { return m_frames.size(); }
 
     // Get frame by index
     bool getFrame(int frameIndex, VTFFrame& frame) const;
 
+    // Drop the parsed frames once they were handed to the viewer (Claude Generated 2026)
+    void releaseFrames() { m_frames = {}; }
+
     // Convert VTF data to MoleculeViewer format
     static void convertToMoleculeViewer(const VTFFrame& vtfFrame, 
                                       QVector<MoleculeViewer::Atom>& atoms,
@@ -60,8 +74,9 @@ public:
     static float getAtomRadius(float vtfRadius);
 
 private:
-    bool parseAsciiFormat(const QString& filePath, QVector<VTFFrame>& frames);
+    bool parseAsciiFormat(const QString& filePath, const FrameSink& onFrame);
     QString trimQuotes(const QString& str);
+    static QByteArrayView trimQuotes(QByteArrayView str);
 
     QVector<VTFFrame> m_frames;  // Store all parsed frames
 };
\ No newline at end of file
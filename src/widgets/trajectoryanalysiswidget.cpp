@@ -0,0 +1,206 @@
+// trajectoryanalysiswidget.cpp - RMSD-vs-frame and per-atom RMSF charts for a trajectory
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+
+#include "trajectoryanalysiswidget.h"
+
+#include <QtCharts>
+
+#include "CuteChart/src/charts.h"
+
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+TrajectoryAnalysisWidget::TrajectoryAnalysisWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_analysis(new TrajectoryAnalysis(this))
+{
+    auto* lay = new QVBoxLayout(this);
+    lay->setContentsMargins(0, 0, 0, 0);
+    lay->setSpacing(4);
+
+    // --- Controls: reference frame, fit atoms, run / stop, progress ---
+    auto* controls = new QHBoxLayout;
+    controls->addWidget(new QLabel(tr("Reference frame:"), this));
+    m_referenceSpin = new QSpinBox(this);
+    m_referenceSpin->setRange(1, 1);
+    controls->addWidget(m_referenceSpin);
+    controls->addWidget(new QLabel(tr("Fit on:"), this));
+    m_fitCombo = new QComboBox(this);
+    m_fitCombo->addItem(tr("All atoms"), int(TrajectoryAnalysis::FitAtoms::All));
+    m_fitCombo->addItem(tr("Heavy atoms"), int(TrajectoryAnalysis::FitAtoms::Heavy));
+    m_fitCombo->setToolTip(tr("Atoms used for the superposition and the RMSD. "
+                              "The RMSF is reported for all atoms."));
+    controls->addWidget(m_fitCombo);
+    m_runButton = new QPushButton(QIcon::fromTheme(QStringLiteral("media-playback-start")),
+        tr("Run"), this);
+    m_stopButton = new QPushButton(QIcon::fromTheme(QStringLiteral("process-stop")),
+        tr("Stop"), this);
+    m_stopButton->setEnabled(false);
+    controls->addWidget(m_runButton);
+    controls->addWidget(m_stopButton);
+    m_progress = new QProgressBar(this);
+    m_progress->setFormat(tr("%v / %m frames"));
+    m_progress->hide();
+    controls->addWidget(m_progress, 1);
+    lay->addLayout(controls);
+
+    m_status = new QLabel(this);
+    lay->addWidget(m_status);
+
+    // --- RMSD vs frame ---
+    m_rmsdChart = new ListChart;
+    m_rmsdChart->setTitle(tr("RMSD to reference"));
+    m_rmsdChart->setXAxis(tr("frame"));
+    m_rmsdChart->setYAxis(tr("RMSD [Å]"));
+    m_rmsdChart->setAnimationOptions(QChart::NoAnimation);
+    m_rmsdChart->chart()->setZoomStrategy(ZoomStrategy::Rectangular);
+    lay->addWidget(m_rmsdChart, 1);
+    m_rmsdSeries = new QLineSeries;
+    m_rmsdChart->addSeries(m_rmsdSeries, 0, QColor(40, 90, 220), tr("RMSD"), false);
+
+    // --- RMSF per atom ---
+    m_rmsfChart = new ListChart;
+    m_rmsfChart->setTitle(tr("RMSF"));
+    m_rmsfChart->setXAxis(tr("atom"));
+    m_rmsfChart->setYAxis(tr("RMSF [Å]"));
+    m_rmsfChart->setAnimationOptions(QChart::NoAnimation);
+    m_rmsfChart->chart()->setZoomStrategy(ZoomStrategy::Rectangular);
+    lay->addWidget(m_rmsfChart, 1);
+    m_rmsfSeries = new QLineSeries;
+    m_rmsfChart->addSeries(m_rmsfSeries, 0, QColor(220, 50, 40), tr("RMSF"), false);
+
+    // Blocks arrive far faster than the chart can redraw: coalesce them.
+    m_replotTimer.setSingleShot(true);
+    m_replotTimer.setInterval(kReplotMs);
+    connect(&m_replotTimer, &QTimer::timeout, this, &TrajectoryAnalysisWidget::replotRmsd);
+
+    connect(m_runButton, &QPushButton::clicked, this, &TrajectoryAnalysisWidget::run);
+    connect(m_stopButton, &QPushButton::clicked, this, &TrajectoryAnalysisWidget::stop);
+    connect(m_analysis, &TrajectoryAnalysis::rmsdBlock, this, [this] {
+        if (!m_replotTimer.isActive())
+            m_replotTimer.start();
+    });
+    connect(m_analysis, &TrajectoryAnalysis::progress, m_progress, &QProgressBar::setValue);
+    connect(m_analysis, &TrajectoryAnalysis::finished, this, &TrajectoryAnalysisWidget::onFinished);
+
+    trajectoryChanged(0);
+}
+
+void TrajectoryAnalysisWidget::setSourceProvider(std::function<TrajectoryFrameSource()> provider)
+{
+    m_sourceProvider = std::move(provider);
+}
+
+void TrajectoryAnalysisWidget::trajectoryChanged(int frameCount)
+{
+    stop();
+    m_referenceSpin->setRange(1, std::max(1, frameCount));
+    m_runButton->setEnabled(frameCount > 1);
+    m_status->setText(frameCount > 1 ? tr("%1 frames").arg(frameCount)
+                                     : tr("Load a trajectory with at least two frames."));
+}
+
+void TrajectoryAnalysisWidget::stop()
+{
+    m_analysis->stop();  // emits finished(false) when it was running
+}
+
+void TrajectoryAnalysisWidget::run()
+{
+    const TrajectoryFrameSource source = m_sourceProvider ? m_sourceProvider() : TrajectoryFrameSource();
+    TrajectoryAnalysis::Options options;
+    options.referenceFrame = m_referenceSpin->value() - 1;
+    options.fitAtoms = TrajectoryAnalysis::FitAtoms(m_fitCombo->currentData().toInt());
+
+    m_rmsdSeries->clear();
+    m_rmsfSeries->clear();
+    if (!m_analysis->start(source, options)) {
+        m_status->setText(tr("Could not read the reference frame."));
+        return;
+    }
+    m_progress->setRange(0, source.frameCount);
+    m_progress->setValue(0);
+    m_progress->show();
+    m_runButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+    m_status->setText(tr("Fitting %1 frames of %2 atoms…")
+                          .arg(source.frameCount)
+                          .arg(source.atomicNumbers.size()));
+}
+
+void TrajectoryAnalysisWidget::replotRmsd()
+{
+    // One point per bucket of frames (mean of the frames analysed so far), so a 100k-frame
+    // trajectory stays a few thousand points; frames not done yet are simply left out.
+    const QVector<float>& rmsd = m_analysis->rmsd();
+    const int frames = rmsd.size();
+    const int bucket = std::max(1, (frames + kMaxPlotPoints - 1) / kMaxPlotPoints);
+    QList<QPointF> points;
+    points.reserve(frames / bucket + 1);
+    for (int first = 0; first < frames; first += bucket) {
+        const int last = std::min(frames, first + bucket);
+        double sum = 0.0;
+        int count = 0;
+        for (int f = first; f < last; ++f) {
+            if (!std::isnan(rmsd[f])) {
+                sum += rmsd[f];
+                ++count;
+            }
+        }
+        if (count > 0)
+            points.append(QPointF(0.5 * (first + last - 1) + 1.0, sum / count));  // 1-based frames
+    }
+    m_rmsdSeries->replace(points);
+    m_rmsdChart->chart()->formatAxis();
+}
+
+void TrajectoryAnalysisWidget::onFinished(bool completed)
+{
+    m_replotTimer.stop();
+    replotRmsd();
+    m_progress->hide();
+    m_runButton->setEnabled(m_referenceSpin->maximum() > 1);
+    m_stopButton->setEnabled(false);
+    if (!completed) {
+        m_status->setText(tr("Stopped after %1 of %2 frames.")
+                              .arg(m_analysis->framesDone())
+                              .arg(m_analysis->frameCount()));
+        return;
+    }
+
+    const QVector<float>& rmsf = m_analysis->rmsf();
+    QList<QPointF> points;
+    points.reserve(rmsf.size());
+    for (int i = 0; i < rmsf.size(); ++i)
+        points.append(QPointF(i + 1, rmsf[i]));  // 1-based atoms, as in the atom list
+    m_rmsfSeries->replace(points);
+    m_rmsfChart->chart()->formatAxis();
+
+    double sum = 0.0;
+    double maxRmsd = 0.0;
+    int count = 0;
+    for (float v : m_analysis->rmsd()) {
+        if (std::isnan(v))
+            continue;
+        sum += v;
+        maxRmsd = std::max(maxRmsd, double(v));
+        ++count;
+    }
+    const int skipped = m_analysis->frameCount() - count;
+    QString text = tr("%1 frames: mean RMSD %2 Å, max %3 Å")
+                       .arg(count)
+                       .arg(count > 0 ? sum / count : 0.0, 0, 'f', 3)
+                       .arg(maxRmsd, 0, 'f', 3);
+    if (skipped > 0)
+        text += tr(" (%1 frames unreadable or with a different atom count skipped)").arg(skipped);
+    m_status->setText(text);
+}
@@ -0,0 +1,65 @@
+// trajectoryanalysiswidget.h - RMSD-vs-frame and per-atom RMSF charts for a trajectory
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - front end of TrajectoryAnalysis, laid out like
+// SimulationChartWidget (two stacked ListCharts).
+
+#pragma once
+
+#include "trajectoryanalysis.h"
+
+#include <QTimer>
+#include <QWidget>
+
+#include <functional>
+
+class ListChart;        // CuteChart composite chart + series legend
+class QComboBox;
+class QLabel;
+class QLineSeries;      // QtCharts (global namespace in Qt6)
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+
+/**
+ * @brief Runs TrajectoryAnalysis over the loaded trajectory and plots the results.
+ *
+ * The RMSD chart fills in while the analysis streams blocks (replotted at most every
+ * kReplotMs, down-sampled to kMaxPlotPoints); the RMSF chart appears when all frames are
+ * merged. Claude Generated 2026.
+ */
+class TrajectoryAnalysisWidget : public QWidget {
+    Q_OBJECT
+public:
+    static constexpr int kMaxPlotPoints = 4000;
+    static constexpr int kReplotMs = 150;
+
+    explicit TrajectoryAnalysisWidget(QWidget* parent = nullptr);
+
+    /** Called on Run to obtain the frames (MoleculeViewer::trajectoryFrameSource()). */
+    void setSourceProvider(std::function<TrajectoryFrameSource()> provider);
+
+public slots:
+    /** The trajectory was replaced or is about to be modified: stop, adopt @p frameCount. */
+    void trajectoryChanged(int frameCount);
+    void stop();
+
+private:
+    void run();
+    void replotRmsd();
+    void onFinished(bool completed);
+
+    std::function<TrajectoryFrameSource()> m_sourceProvider;
+    TrajectoryAnalysis* m_analysis = nullptr;
+    QTimer m_replotTimer;
+
+    QSpinBox* m_referenceSpin = nullptr;
+    QComboBox* m_fitCombo = nullptr;
+    QPushButton* m_runButton = nullptr;
+    QPushButton* m_stopButton = nullptr;
+    QProgressBar* m_progress = nullptr;
+    QLabel* m_status = nullptr;
+    ListChart* m_rmsdChart = nullptr;
+    ListChart* m_rmsfChart = nullptr;
+    QLineSeries* m_rmsdSeries = nullptr;
+    QLineSeries* m_rmsfSeries = nullptr;
+};
@@ -2,7 +2,8 @@
 // Parses XYZ files for molecular visualization with trajectory support
 
 #include "xyzparser.h"
-#include <QRegularExpression>
+#include "profiler.h"
+#include "textscanner.h"
 
 bool XYZParser::parseFile(const QString& filePath, XYZFrame& frame)
 {
@@ -21,9 +22,19 @@ bool XYZParser::parseFile(const QString& filePath, XYZFrame& frame)
 
 bool XYZParser::parseTrajectory(const QString& filePath)
 {
+    ProfileScope profile("parse.xyz");
     // Clear previous frames
     m_frames.clear();
-    return parseAsciiFormat(filePath, m_frames);
+    return parseAsciiFormat(filePath, [this](XYZFrame&& frame, qint64, qint64) {
+        m_frames.append(std::move(frame));
+        return true;
+    });
+}
+
+bool XYZParser::parseTrajectory(const QString& filePath, const FrameSink& onFrame)
+{
+    ProfileScope profile("parse.xyz");
+    return parseAsciiFormat(filePath, onFrame);
 }
 
 bool XYZParser::getFrame(int frameIndex, XYZFrame& frame) const
@@ -35,68 +46,70 @@ bool XYZParser::getFrame(int frameIndex, XYZFrame& frame) const
     return false;
 }
 
-bool XYZParser::parseAsciiFormat(const QString& filePath, QVector<XYZFrame>& frames)
+bool XYZParser::parseAsciiFormat(const QString& filePath, const FrameSink& onFrame)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    // Mapped, allocation-free scan (see textscanner.h); only the per-atom element
+    // QString is materialised, and that is shared through the symbol cache.
+    TextScanner scanner;
+    if (!scanner.open(filePath)) {
         qWarning() << "Failed to open XYZ file:" << filePath;
         return false;
     }
 
-    QTextStream stream(&file);
-    QString line;
-    
-    while (!stream.atEnd()) {
+    SymbolCache symbols;
+    QByteArrayView fields[4];
+    int frameCount = 0;
+
+    while (!scanner.atEnd()) {
         // Read atom count for this frame
-        line = stream.readLine().trimmed();
-        if (line.isEmpty()) {
+        const QByteArrayView countLine = TextScanner::trimmed(scanner.readLine());
+        if (countLine.isEmpty()) {
             continue; // Skip empty lines
         }
-        
-        bool ok;
-        int numAtoms = line.toInt(&ok);
-        if (!ok || numAtoms <= 0) {
-            qWarning() << "Invalid atom count in XYZ file:" << line;
+
+        int numAtoms = 0;
+        if (!TextScanner::parseInt(countLine, numAtoms) || numAtoms <= 0) {
+            qWarning() << "Invalid atom count in XYZ file:" << countLine;
             continue;
         }
-        
+
         // Read comment line
-        QString comment = stream.readLine().trimmed();
-        
+        const QByteArrayView comment = TextScanner::trimmed(scanner.readLine());
+
         // Create new frame
         XYZFrame frame;
-        frame.comment = comment;
+        frame.comment = QString::fromUtf8(comment.data(), comment.size());
         frame.atoms.reserve(numAtoms);
-        
+
         // Read atoms for this frame
-        for (int i = 0; i < numAtoms && !stream.atEnd(); ++i) {
-            line = stream.readLine().trimmed();
-            if (!line.isEmpty()) {
-                QStringList parts = line.split(QRegularExpression("\\s+"));
-                if (parts.size() >= 4) {
-                    XYZAtom atom;
-                    atom.element = parts[0];
-                    atom.x = parts[1].toFloat();
-                    atom.y = parts[2].toFloat();
-                    atom.z = parts[3].toFloat();
-                    frame.atoms.append(atom);
-                } else {
-                    qWarning() << "Invalid atom line in XYZ file:" << line;
-                }
+        for (int i = 0; i < numAtoms && !scanner.atEnd(); ++i) {
+            const QByteArrayView line = scanner.readLine();
+            const int n = TextScanner::splitFields(line, fields, 4);
+            if (n == 0)
+                continue;
+            if (n < 4) {
+                qWarning() << "Invalid atom line in XYZ file:" << line;
+                continue;
             }
+            XYZAtom atom;
+            atom.element = symbols.intern(fields[0], atom.atomicNumber);
+            atom.x = TextScanner::toFloat(fields[1]);
+            atom.y = TextScanner::toFloat(fields[2]);
+            atom.z = TextScanner::toFloat(fields[3]);
+            frame.atoms.append(atom);
         }
-        
+
         // Only add frame if we successfully read all atoms
         if (frame.atoms.size() == numAtoms) {
-            frames.append(frame);
+            ++frameCount;
+            if (!onFrame(std::move(frame), scanner.pos(), scanner.size()))
+                break;
         } else {
             qWarning() << "Incomplete frame in XYZ file. Expected" << numAtoms << "atoms, got" << frame.atoms.size();
         }
     }
 
-    file.close();
-
-    return !frames.isEmpty();
+    return frameCount > 0;
 }
 
 void XYZParser::convertToMoleculeViewer(const XYZFrame& xyzFrame,
@@ -109,6 +122,7 @@ void XYZParser::convertToMoleculeViewer(const XYZFrame& xyzFrame,
     for (const auto& xyzAtom : xyzFrame.atoms) {
         MoleculeViewer::Atom atom;
         atom.element = xyzAtom.element;
+        atom.atomicNumber = xyzAtom.atomicNumber;
         atom.position = QVector3D(xyzAtom.x, xyzAtom.y, xyzAtom.z);
         atoms.append(atom);
     }
@@ -199,6 +213,7 @@ bool XYZParser::convertFromMoleculeViewer(const QVector<MoleculeViewer::Atom>& a
     for (const auto& atom : atoms) {
         XYZAtom xyzAtom;
         xyzAtom.element = atom.element;
+        xyzAtom.atomicNumber = atom.atomicNumber;
         xyzAtom.x = atom.position.x();
         xyzAtom.y = atom.position.y();
         xyzAtom.z = atom.position.z();
@@ -10,12 +10,15 @@
 #include <QTextStream>
 #include <QDebug>
 
+#include <functional>
+
 class XYZParser
 {
 public:
     struct XYZAtom {
         QString element;
         float x, y, z;
+        quint8 atomicNumber = 0;
     };
 
     struct XYZFrame {
@@ -31,12 +34,22 @@ public:
     // Parse all frames from XYZ trajectory file
     bool parseTrajectory(const QString& filePath);
 
+    // Claude Generated 2026 - Progressive parse (StructureLoader): every complete frame is
+    // handed to @p onFrame together with the bytes scanned so far and the file size, and is
+    // not stored. Returning false from @p onFrame stops the scan. False if the file cannot
+    // be read or holds no complete frame.
+    using FrameSink = std::function<bool(XYZFrame&& frame, qint64 bytesRead, qint64 totalBytes)>;
+    bool parseTrajectory(const QString& filePath, const FrameSink& onFrame);
+
     // Get frame count
     int getFrameCount() const { return m_frames.size(); }
 
     // Get frame by index
     bool getFrame(int frameIndex, XYZFrame& frame) const;
 
+    // Drop the parsed frames once they were handed to the viewer (Claude Generated 2026)
+    void releaseFrames() { m_frames = {}; }
+
     // Convert XYZ data to MoleculeViewer format
     static void convertToMoleculeViewer(const XYZFrame& xyzFrame,
                                       QVector<MoleculeViewer::Atom>& atoms,
@@ -54,7 +67,7 @@ public:
                                          XYZFrame& xyzFrame);
 
 private:
-    bool parseAsciiFormat(const QString& filePath, QVector<XYZFrame>& frames);
+    bool parseAsciiFormat(const QString& filePath, const FrameSink& onFrame);
 
     QVector<XYZFrame> m_frames;  // Store all parsed frames
 };
\ No newline at end of file
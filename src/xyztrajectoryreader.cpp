@@ -0,0 +1,275 @@
+// xyztrajectoryreader.cpp - Frame-indexed, on-demand XYZ trajectory reader
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026.
+#include "xyztrajectoryreader.h"
+#include "profiler.h"
+#include "textscanner.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+constexpr quint32 kIndexMagic = 0x51584931;  // "QXI1"
+constexpr quint32 kIndexVersion = 1;
+
+// Parse a frame-header atom count ("  128  "); 0 if the line is not a count.
+int parseAtomCount(QByteArrayView line)
+{
+    int n = 0;
+    return TextScanner::parseInt(line, n) && n > 0 ? n : 0;
+}
+}
+
+XYZTrajectoryReader::XYZTrajectoryReader(int cacheAtoms)
+    : m_cache(cacheAtoms)
+{
+}
+
+XYZTrajectoryReader::~XYZTrajectoryReader() = default;
+
+QString XYZTrajectoryReader::sidecarPath(const QString& filePath)
+{
+    return filePath + QStringLiteral(".qidx");
+}
+
+QString XYZTrajectoryReader::cachePath(const QString& filePath)
+{
+    const QByteArray key = QCryptographicHash::hash(
+        QFileInfo(filePath).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QStringLiteral("/trajectory-index/") + QString::fromLatin1(key) + QStringLiteral(".qidx");
+}
+
+void XYZTrajectoryReader::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_file.close();
+    m_offsets.clear();
+    m_cache.clear();
+    m_filePath.clear();
+    m_indexFromSidecar = false;
+}
+
+bool XYZTrajectoryReader::open(const QString& filePath)
+{
+    ProfileScope profile("parse.xyzIndex");
+    close();
+    m_filePath = filePath;
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_lastError = QString("Cannot open file: %1").arg(filePath);
+        return false;
+    }
+    const QFileInfo info(filePath);
+    m_fileSize = info.size();
+    m_fileMTime = info.lastModified().toMSecsSinceEpoch();
+    // Keep the mapping for the reader's lifetime: frames are then decoded straight
+    // from the page cache. Unmappable files fall back to seek + read per frame.
+    if (m_fileSize > 0)
+        m_map = m_file.map(0, m_fileSize);
+
+    // Sidecar next to the trajectory first, then the per-user cache copy.
+    if (loadIndex(sidecarPath(filePath)) || loadIndex(cachePath(filePath))) {
+        m_indexFromSidecar = true;
+        return true;
+    }
+
+    if (!buildIndex())
+        return false;
+    if (!saveIndex(sidecarPath(filePath))) {
+        const QString fallback = cachePath(filePath);
+        QDir().mkpath(QFileInfo(fallback).absolutePath());
+        if (!saveIndex(fallback))
+            qWarning() << "XYZTrajectoryReader: could not persist frame index for" << filePath;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Index persistence. The header pins the trajectory's size + mtime; a stale
+// index (file appended to / rewritten) is rejected and rebuilt.
+// ---------------------------------------------------------------------------
+bool XYZTrajectoryReader::loadIndex(const QString& indexPath)
+{
+    QFile f(indexPath);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&f);
+    quint32 magic = 0, version = 0;
+    qint64 size = -1, mtime = -1;
+    in >> magic >> version >> size >> mtime;
+    if (magic != kIndexMagic || version != kIndexVersion || size != m_fileSize || mtime != m_fileMTime)
+        return false;
+    QVector<qint64> offsets;
+    in >> offsets;
+    if (in.status() != QDataStream::Ok || offsets.isEmpty())
+        return false;
+    m_offsets = offsets;
+    return true;
+}
+
+bool XYZTrajectoryReader::saveIndex(const QString& indexPath) const
+{
+    QSaveFile f(indexPath);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    QDataStream out(&f);
+    out << kIndexMagic << kIndexVersion << m_fileSize << m_fileMTime << m_offsets;
+    return out.status() == QDataStream::Ok && f.commit();
+}
+
+// ---------------------------------------------------------------------------
+// Index build: one pass, skipping whole frames by counting newlines. Frame
+// semantics match XYZParser::parseAsciiFormat (blank lines between frames and
+// non-numeric header lines are skipped, a truncated last frame is dropped).
+// ---------------------------------------------------------------------------
+bool XYZTrajectoryReader::buildIndex()
+{
+    m_offsets.clear();
+    if (m_fileSize > 0 && !(m_map ? buildIndexMapped(m_map, m_fileSize) : buildIndexSequential())) {
+        m_offsets.clear();
+        m_lastError = QString("Indexing %1 was cancelled").arg(m_filePath);
+        return false;
+    }
+    if (m_offsets.isEmpty()) {
+        m_lastError = QString("No complete XYZ frame found in %1").arg(m_filePath);
+        return false;
+    }
+    return true;
+}
+
+// False if the progress callback asks to stop.
+bool XYZTrajectoryReader::reportProgress(qint64 scanned, qint64& nextReport)
+{
+    if (!m_progress || scanned < nextReport)
+        return true;
+    nextReport = scanned + kProgressBytes;
+    return m_progress(scanned, m_fileSize);
+}
+
+bool XYZTrajectoryReader::buildIndexMapped(const uchar* data, qint64 size)
+{
+    TextScanner scanner;
+    scanner.setData(QByteArrayView(reinterpret_cast<const char*>(data), size));
+    qint64 nextReport = 0;
+    while (!scanner.atEnd()) {
+        if (!reportProgress(scanner.pos(), nextReport))
+            return false;
+        const qsizetype start = scanner.pos();
+        const int n = parseAtomCount(scanner.readLine());
+        if (n == 0)
+            continue;
+        // Skip the comment line + n atom lines.
+        if (scanner.skipLines(n + 1) < n + 1)
+            break;  // truncated last frame
+        m_offsets.append(start);
+    }
+    return true;
+}
+
+bool XYZTrajectoryReader::buildIndexSequential()
+{
+    // Fallback for files that cannot be mapped (e.g. some network filesystems).
+    m_file.seek(0);
+    qint64 nextReport = 0;
+    while (!m_file.atEnd()) {
+        if (!reportProgress(m_file.pos(), nextReport))
+            return false;
+        const qint64 start = m_file.pos();
+        const int n = parseAtomCount(m_file.readLine());
+        if (n == 0)
+            continue;
+        int linesLeft = n + 1;
+        while (linesLeft > 0 && !m_file.atEnd()) {
+            m_file.readLine();
+            --linesLeft;
+        }
+        if (linesLeft > 0)
+            break;
+        m_offsets.append(start);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Frame access
+// ---------------------------------------------------------------------------
+bool XYZTrajectoryReader::frameAtoms(int index, QVector<MoleculeViewer::Atom>& atoms)
+{
+    if (index < 0 || index >= m_offsets.size())
+        return false;
+    if (const QVector<MoleculeViewer::Atom>* cached = m_cache.object(index)) {
+        atoms = *cached;  // implicitly shared, no per-atom copy
+        return true;
+    }
+    if (!decodeFrame(index, atoms))
+        return false;
+    m_cache.insert(index, new QVector<MoleculeViewer::Atom>(atoms), qMax(1, int(atoms.size())));
+    return true;
+}
+
+QByteArray XYZTrajectoryReader::frameText(int index)
+{
+    if (index < 0 || index >= m_offsets.size())
+        return {};
+    const qint64 start = m_offsets[index];
+    const qint64 stop = index + 1 < m_offsets.size() ? m_offsets[index + 1] : m_fileSize;
+    if (m_map)
+        return QByteArray(reinterpret_cast<const char*>(m_map) + start, stop - start);
+    if (!m_file.seek(start))
+        return {};
+    return m_file.read(stop - start);
+}
+
+bool XYZTrajectoryReader::decodeFrame(int index, QVector<MoleculeViewer::Atom>& atoms)
+{
+    atoms.clear();
+    const qint64 start = m_offsets[index];
+    const qint64 stop = index + 1 < m_offsets.size() ? m_offsets[index + 1] : m_fileSize;
+
+    QByteArray buffer;  // only used when the file is not mapped
+    TextScanner scanner;
+    if (m_map) {
+        scanner.setData(QByteArrayView(reinterpret_cast<const char*>(m_map) + start, stop - start));
+    } else {
+        buffer = frameText(index);
+        scanner.setData(buffer);
+    }
+
+    const int n = parseAtomCount(scanner.readLine());
+    if (n == 0)
+        return false;
+    scanner.skipLines(1);  // comment
+    atoms.reserve(n);
+    QByteArrayView parts[4];
+    for (int i = 0; i < n && !scanner.atEnd(); ++i) {
+        const QByteArrayView line = scanner.readLine();
+        const int count = TextScanner::splitFields(line, parts, 4);
+        if (count == 0)
+            continue;
+        if (count < 4) {
+            qWarning() << "Invalid atom line in XYZ frame" << index << ":" << line;
+            continue;
+        }
+        MoleculeViewer::Atom atom;
+        atom.element = m_symbols.intern(parts[0], atom.atomicNumber);
+        atom.position = QVector3D(TextScanner::toFloat(parts[1]),
+                                  TextScanner::toFloat(parts[2]),
+                                  TextScanner::toFloat(parts[3]));
+        atoms.append(atom);
+    }
+    if (atoms.size() != n) {
+        qWarning() << "Incomplete XYZ frame" << index << ": expected" << n << "atoms, got" << atoms.size();
+        atoms.clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,98 @@
+// xyztrajectoryreader.h - Frame-indexed, on-demand XYZ trajectory reader
+// Copyright (C) 2015 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+// Claude Generated 2026 - streaming large MD trajectories.
+//
+// XYZParser::parseTrajectory materialises every frame; for multi-GB trajectories
+// that exhausts RAM. This reader makes one fast pass over the (memory-mapped) file
+// to record the byte offset of every frame header, persists that index in a sidecar
+// file (<trajectory>.qidx, or the user cache dir if the trajectory's directory is
+// read-only), and afterwards decodes only the frames that are actually requested.
+// Decoded frames live in a bounded LRU cache (QCache, cost = atom count), so memory
+// stays flat regardless of trajectory length.
+//
+// Not thread-safe: one reader per thread (re-opening is cheap once the sidecar
+// index exists).
+
+#pragma once
+
+#include "textscanner.h"
+#include "view.h"
+
+#include <QCache>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+class XYZTrajectoryReader
+{
+public:
+    /// Default LRU budget in atoms (~40 bytes per cached MoleculeViewer::Atom).
+    static constexpr int kDefaultCacheAtoms = 4000000;
+    /// Bytes scanned between two progress callbacks during an index build.
+    static constexpr qint64 kProgressBytes = 8LL * 1024 * 1024;
+
+    /// Called during an index build with the bytes scanned so far and the file size;
+    /// returning false aborts open().
+    using ProgressCallback = std::function<bool(qint64 bytesScanned, qint64 totalBytes)>;
+
+    explicit XYZTrajectoryReader(int cacheAtoms = kDefaultCacheAtoms);
+    ~XYZTrajectoryReader();
+
+    XYZTrajectoryReader(const XYZTrajectoryReader&) = delete;
+    XYZTrajectoryReader& operator=(const XYZTrajectoryReader&) = delete;
+
+    /** Open @p filePath and load (or build + persist) its frame index.
+     *  @return false if the file cannot be read or contains no complete frame. */
+    bool open(const QString& filePath);
+    void close();
+
+    /** Report (and allow cancelling) the first-time index build of open(); nothing is
+     *  reported when the sidecar index is reused. Claude Generated 2026 - StructureLoader. */
+    void setProgressCallback(ProgressCallback callback) { m_progress = std::move(callback); }
+
+    QString filePath() const { return m_filePath; }
+    QString lastError() const { return m_lastError; }
+    int frameCount() const { return m_offsets.size(); }
+    /// True when open() reused an up-to-date sidecar index instead of scanning.
+    bool indexWasCached() const { return m_indexFromSidecar; }
+
+    /** Decoded atoms of frame @p index (served from the LRU cache when possible).
+     *  @return false if the index is out of range or the frame is malformed. */
+    bool frameAtoms(int index, QVector<MoleculeViewer::Atom>& atoms);
+
+    /** Raw text of frame @p index (count line, comment and atom lines), e.g. to show
+     *  the first frame in the structure editor without reading the whole file. */
+    QByteArray frameText(int index);
+
+    /// Byte offset of each frame header in the file.
+    const QVector<qint64>& frameOffsets() const { return m_offsets; }
+
+    void setCacheAtoms(int cacheAtoms) { m_cache.setMaxCost(cacheAtoms); }
+
+    /// Sidecar index path next to the trajectory (<filePath>.qidx).
+    static QString sidecarPath(const QString& filePath);
+
+private:
+    bool loadIndex(const QString& indexPath);
+    bool saveIndex(const QString& indexPath) const;
+    bool buildIndex();
+    bool buildIndexMapped(const uchar* data, qint64 size);
+    bool buildIndexSequential();
+    bool decodeFrame(int index, QVector<MoleculeViewer::Atom>& atoms);
+    bool reportProgress(qint64 scanned, qint64& nextReport);
+    static QString cachePath(const QString& filePath);
+
+    QString m_filePath;
+    QString m_lastError;
+    QFile m_file;
+    uchar* m_map = nullptr;  // whole-file mapping, null if the file cannot be mapped
+    SymbolCache m_symbols;   // element strings shared across all decoded frames
+    qint64 m_fileSize = 0;
+    qint64 m_fileMTime = 0;
+    bool m_indexFromSidecar = false;
+    QVector<qint64> m_offsets;
+    QCache<int, QVector<MoleculeViewer::Atom>> m_cache;
+    ProgressCallback m_progress;
+};
@@ -0,0 +1,98 @@
+// TrajectoryStore Delta Test - Claude Generated 2026
+// Edits that turn a delta frame into a keyframe must keep the later frames of its
+// keyframe group consistent, so a following transformFrames() (centring) shifts every
+// frame exactly once.
+
+#include "trajectorystore.h"
+
+#include <QCoreApplication>
+#include <iostream>
+
+namespace {
+constexpr int kAtoms = 4;
+constexpr int kFrames = 20;
+// Delta quantisation (5e-4 A) plus float32 rounding of a ~100 A value.
+constexpr float kTolerance = 2.0e-3f;
+
+QVector<QVector3D> makeFrame(int f)
+{
+    QVector<QVector3D> coords(kAtoms);
+    for (int i = 0; i < kAtoms; ++i)
+        coords[i] = QVector3D(i * 1.5f + 0.01f * f, 0.02f * f, -0.5f * i);
+    return coords;
+}
+
+bool check(const TrajectoryStore& store, const QVector<QVector<QVector3D>>& expected, const char* stage)
+{
+    bool ok = true;
+    for (int f = 0; f < expected.size(); ++f) {
+        const PositionSpan span = store.positions(f);
+        for (int i = 0; i < kAtoms; ++i) {
+            if ((span[i] - expected[f][i]).length() > kTolerance) {
+                std::cerr << stage << ": frame " << f << " atom " << i << " off by "
+                          << (span[i] - expected[f][i]).length() << " A" << std::endl;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    std::cout << "TrajectoryStore Delta Edit Test" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    QVector<QVector<MoleculeViewer::Atom>> frames(kFrames);
+    QVector<QVector<QVector3D>> expected(kFrames);
+    for (int f = 0; f < kFrames; ++f) {
+        expected[f] = makeFrame(f);
+        frames[f].resize(kAtoms);
+        for (int i = 0; i < kAtoms; ++i) {
+            frames[f][i].element = i == 0 ? QStringLiteral("C") : QStringLiteral("H");
+            frames[f][i].position = expected[f][i];
+        }
+    }
+
+    TrajectoryStore store;
+    if (!store.setFrames(frames, TrajectoryStore::Compression::Delta)) {
+        std::cerr << "setFrames failed" << std::endl;
+        return 1;
+    }
+    bool ok = check(store, expected, "packed");
+
+    // Mid-interval delta frame: one atom moves 40 A, beyond the int16 offset range
+    // (32.7 A), so frame 10 becomes a keyframe.
+    constexpr int kEdited = 10;
+    expected[kEdited][2] += QVector3D(40.0f, 0.0f, 0.0f);
+    store.setPositions(kEdited, expected[kEdited].constData(), kAtoms);
+    ok = check(store, expected, "after edit") && ok;
+
+    // Centring-like shift of every frame; each frame must move by exactly its own offset.
+    store.transformFrames([&](int f, QVector<QVector3D>& coords) {
+        const QVector3D shift(-1.0f - f, 2.0f, 0.5f);
+        for (QVector3D& p : coords)
+            p += shift;
+        for (QVector3D& p : expected[f])
+            p += shift;
+    });
+    ok = check(store, expected, "after transformFrames") && ok;
+
+    // Moving the edited frame back lets it rejoin the earlier keyframe's group.
+    expected[kEdited] = makeFrame(kEdited);
+    store.setPositions(kEdited, expected[kEdited].constData(), kAtoms);
+    ok = check(store, expected, "after revert") && ok;
+    store.transformFrames([&](int f, QVector<QVector3D>& coords) {
+        for (QVector3D& p : coords)
+            p += QVector3D(0.25f, 0.0f, 0.0f);
+        for (QVector3D& p : expected[f])
+            p += QVector3D(0.25f, 0.0f, 0.0f);
+    });
+    ok = check(store, expected, "after second transformFrames") && ok;
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}